@@ -50,6 +50,10 @@ namespace nux
     , min_size_(AREA_MIN_WIDTH, AREA_MIN_HEIGHT)
     , max_size_(AREA_MAX_WIDTH, AREA_MAX_HEIGHT)
     , layout_done_(true)
+    , layout_queued_(false)
+    , content_size_dirty_(true)
+    , content_size_layout_done_(false)
+    , content_size_compliance_(0)
   {
     window_thread_ = GetWindowThread();
     visible_ = true;
@@ -116,14 +120,13 @@ namespace nux
       max_size_.height = min_size_.height;
     }
 
-    if (geometry_.width < min_size_.width)
+    if (geometry_.width < min_size_.width || geometry_.height < min_size_.height)
     {
-      geometry_.width = min_size_.width;
-    }
+      geometry_.width = Max<int>(geometry_.width, min_size_.width);
+      geometry_.height = Max<int>(geometry_.height, min_size_.height);
 
-    if (geometry_.height < min_size_.height )
-    {
-      geometry_.height = min_size_.height;
+      if (parent_area_)
+        parent_area_->ChildGeometryChanged(this);
     }
   }
 
@@ -146,14 +149,13 @@ namespace nux
       min_size_.height = max_size_.height;
     }
 
-    if (geometry_.width > max_size_.width)
+    if (geometry_.width > max_size_.width || geometry_.height > max_size_.height)
     {
-      geometry_.width = max_size_.width;
-    }
+      geometry_.width = Min<int>(geometry_.width, max_size_.width);
+      geometry_.height = Min<int>(geometry_.height, max_size_.height);
 
-    if (geometry_.height > max_size_.height)
-    {
-      geometry_.height = max_size_.height;
+      if (parent_area_)
+        parent_area_->ChildGeometryChanged(this);
     }
   }
 
@@ -193,6 +195,9 @@ namespace nux
   {
     geometry_.width = min_size_.width;
 
+    if (parent_area_)
+      parent_area_->ChildGeometryChanged(this);
+
     ReconfigureParentLayout();
   }
 
@@ -200,6 +205,9 @@ namespace nux
   {
     geometry_.height = min_size_.height;
 
+    if (parent_area_)
+      parent_area_->ChildGeometryChanged(this);
+
     ReconfigureParentLayout();
   }
 
@@ -207,6 +215,9 @@ namespace nux
   {
     geometry_.width = max_size_.width;
 
+    if (parent_area_)
+      parent_area_->ChildGeometryChanged(this);
+
     ReconfigureParentLayout();
   }
 
@@ -214,6 +225,9 @@ namespace nux
   {
     geometry_.height = max_size_.height;
 
+    if (parent_area_)
+      parent_area_->ChildGeometryChanged(this);
+
     ReconfigureParentLayout();
   }
 
@@ -287,7 +301,11 @@ namespace nux
   void Area::SetScaleFactor(unsigned int sf)
   {
     // re implemented by Layout
+    if (scale_factor_ == sf)
+      return;
+
     scale_factor_ = sf;
+    InvalidateContentSize();
   }
 
   bool Area::SetParentObject(Area *parent)
@@ -312,6 +330,7 @@ namespace nux
 
     parent_area_ = parent;
     Reference();
+    InvalidateContentSize();
 
     return true;
   }
@@ -326,6 +345,7 @@ namespace nux
 
     if (parent_area_)
     {
+      parent_area_->InvalidateContentSize();
       parent_area_ = 0;
       UnReference();
     }
@@ -398,6 +418,9 @@ namespace nux
     ReconfigureParentLayout();
     GeometryChanged(detected_position_change, detected_size_change);
 
+    if (parent_area_)
+      parent_area_->ChildGeometryChanged(this);
+
     geometry_changed.emit(this, geometry_);
 
     if (detected_position_change)
@@ -497,8 +520,19 @@ namespace nux
     return on_geometry_change_reconfigure_parent_layout_;
   }
 
+  void Area::InvalidateContentSize()
+  {
+    // The parents are always visited: a hidden child keeps its flag set while its parent computes its size.
+    for (Area *area = this; area; area = area->parent_area_)
+      area->content_size_dirty_ = true;
+  }
+
   void Area::ReconfigureParentLayout(Area *child)
   {
+    // Changes made by the layout computation itself are part of the cached results.
+    if (parent_area_ && !(window_thread_ && window_thread_->IsComputingLayout()))
+      parent_area_->InvalidateContentSize();
+
     if (on_geometry_change_reconfigure_parent_layout_ == false)
       return;
 
@@ -632,6 +666,7 @@ namespace nux
       return;
 
     visible_ = visible;
+    InvalidateContentSize();
 
     OnVisibleChanged.emit(this, visible_);
   }
@@ -676,7 +711,11 @@ namespace nux
 
   void Area::SetPositioning(MinorDimensionPosition p)
   {
+    if (minor_axis_position_ == p)
+      return;
+
     minor_axis_position_ = p;
+    InvalidateContentSize();
   }
 
   MinorDimensionSize Area::GetExtend()
@@ -686,7 +725,11 @@ namespace nux
 
   void Area::SetExtend(MinorDimensionSize ext)
   {
+    if (minor_axis_size_ == ext)
+      return;
+
     minor_axis_size_ = ext;
+    InvalidateContentSize();
   }
 
   float Area::GetPercentage()
@@ -696,7 +739,11 @@ namespace nux
 
   void Area::SetPercentage(float p)
   {
+    if (minor_axis_size_scale_ == p)
+      return;
+
     minor_axis_size_scale_ = p;
+    InvalidateContentSize();
   }
 
   bool Area::IsLayoutDone()
@@ -742,11 +789,17 @@ namespace nux
   void Area::Set2DMatrix(const Matrix4 &mat)
   {
     _2d_xform = mat;
+
+    if (parent_area_)
+      parent_area_->ChildGeometryChanged(this);
   }
 
   void Area::Set2DTranslation(float tx, float ty, float tz)
   {
     _2d_xform.Translate(tx, ty, tz);
+
+    if (parent_area_)
+      parent_area_->ChildGeometryChanged(this);
   }
 
   Matrix4 Area::Get2DMatrix() const
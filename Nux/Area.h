@@ -519,6 +519,13 @@ namespace nux
     */
     virtual Area* FindAreaUnderMouse(const Point& mouse_position, NuxEventType event_type);
 
+    //! Return true if the hit tests of this area never return an area outside of its geometry.
+    /*!
+        A layout with a hit-test index only calls FindAreaUnderMouse and GetInputAreaHitByGesture on the
+        children under the pointer. Areas overriding these functions to return areas outside of their own
+        geometry must return false here.
+    */
+    virtual bool IsHitTestConfinedToGeometry() const { return true; }
 
     virtual Area* FindKeyFocusArea(unsigned int key_symbol,
         unsigned long x11_key_code,
@@ -576,6 +583,14 @@ namespace nux
     */
     bool ReconfigureParentLayoutOnGeometryChange();
 
+    //! Invalidate the cached content size of this area and of all its parents.
+    /*!
+        Layouts keep the result of the last size computation of each of their children and reuse it as long as
+        the child is laid out with the same size and size constraints. Call this function when a change that is
+        not visible to the parent layouts alters the size this area would compute.
+    */
+    void InvalidateContentSize();
+
     //! Enable keyboard event processing.
     /*!
         @param accept_key_event Set it to true if the area accepts keyboard events.
@@ -619,6 +634,9 @@ namespace nux
     */
     virtual void GeometryChanged(bool /* position_has_changed */, bool /* size_has_changed */) {}
 
+    //! Called when the geometry or the 2D matrix of a child of this area has changed.
+    virtual void ChildGeometryChanged(Area* /* child */) {}
+
     //! Request a Layout recompute after a change of size
     /*
         When an object size changes, it is necessary for its parent structure to initiate a layout
@@ -780,6 +798,16 @@ protected:
     MinorDimensionSize      minor_axis_size_;       //!< Area dimension hint
     float                   minor_axis_size_scale_; //!< Area size percentage value.
     bool                    layout_done_;           //!< Area layout status flag.
+    bool                    layout_queued_;         //!< True while the area is in the layout queue of the WindowThread.
+
+    // Result of the last size computation requested by the parent layout. See Layout::ComputeChildContentSize.
+    bool                    content_size_dirty_;            //!< True if the cached content size cannot be used.
+    Size                    content_size_request_;          //!< Size of the area before the cached computation.
+    Size                    content_size_min_;              //!< Minimum size of the area during the cached computation.
+    Size                    content_size_max_;              //!< Maximum size of the area during the cached computation.
+    bool                    content_size_layout_done_;      //!< Layout status of the area before the cached computation.
+    Size                    content_size_result_;           //!< Size of the area after the cached computation.
+    long                    content_size_compliance_;       //!< Value returned by the cached computation.
 
 
     Matrix4                 _2d_xform;        //!< 2D transformation matrix for this area and its children. Contains only translations.
@@ -490,6 +490,11 @@ namespace nux
     return GetWindowThread()->GetWindowCompositor().GetBackupTextureData(this, width, height, format);
   }
 
+  bool BaseWindow::GetBackupTextureDataAsync(TextureReadback::Callback const& callback)
+  {
+    return GetWindowThread()->GetWindowCompositor().GetBackupTextureDataAsync(this, callback);
+  }
+
   void BaseWindow::PresentInEmbeddedModeOnThisFrame(bool force)
   {
     nuxAssertMsg (GetWindowThread()->IsEmbeddedWindow(),
@@ -28,6 +28,7 @@
 #include "ScrollView.h"
 
 #include "NuxGraphics/Events.h"
+#include "NuxGraphics/TextureReadback.h"
 #if defined(USE_X11)
 #  include "NuxGraphics/XInputWindow.h"
 #endif
@@ -178,6 +179,12 @@ namespace nux
     //! Get the backup texture data of this BaseWindow,
     void* GetBackupTextureData(int &width, int &height, int &format);
 
+    //! Read the backup texture data of this BaseWindow without stalling the rendering.
+    /*!
+        \sa WindowCompositor::GetBackupTextureDataAsync.
+    */
+    bool GetBackupTextureDataAsync(TextureReadback::Callback const& callback);
+
     //! Emit a signal when the BaseWindow becomes visible.
     sigc::signal<void, BaseWindow*> sigVisible;
     //! Emit a signal when the BaseWindow becomes hidden.
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#include <algorithm>
+
+#include "Nux.h"
+#include "DamageRegion.h"
+
+namespace nux
+{
+namespace
+{
+  bool IsEmptyRect(Geometry const& rect)
+  {
+    return rect.width <= 0 || rect.height <= 0;
+  }
+
+  int RectArea(Geometry const& rect)
+  {
+    return rect.width * rect.height;
+  }
+
+  bool RectsOverlap(Geometry const& a, Geometry const& b)
+  {
+    // Unlike Rect::IsIntersecting, rectangles that only share an edge don't overlap.
+    return (a.x < b.x + b.width) && (b.x < a.x + a.width) &&
+      (a.y < b.y + b.height) && (b.y < a.y + a.height);
+  }
+
+  Geometry RectUnion(Geometry const& a, Geometry const& b)
+  {
+    int x0 = std::min(a.x, b.x);
+    int y0 = std::min(a.y, b.y);
+    int x1 = std::max(a.x + a.width, b.x + b.width);
+    int y1 = std::max(a.y + a.height, b.y + b.height);
+
+    return Geometry(x0, y0, x1 - x0, y1 - y0);
+  }
+}
+
+  const int DamageRegion::MAX_RECTS;
+
+  DamageRegion::DamageRegion()
+  {
+    rects_.reserve(MAX_RECTS);
+  }
+
+  void DamageRegion::Add(Geometry const& rect)
+  {
+    if (IsEmptyRect(rect))
+      return;
+
+    Geometry pending = rect;
+    bool merged = true;
+
+    while (merged)
+    {
+      merged = false;
+
+      for (auto it = rects_.begin(); it != rects_.end(); ++it)
+      {
+        Geometry bounds = RectUnion(*it, pending);
+
+        if (RectArea(bounds) <= RectArea(*it) + RectArea(pending))
+        {
+          // The merged rectangle may now be able to absorb other rectangles of the region.
+          pending = bounds;
+          rects_.erase(it);
+          merged = true;
+          break;
+        }
+      }
+
+      if (!merged && rects_.size() >= (size_t) MAX_RECTS)
+      {
+        auto cheapest = rects_.begin();
+        int cheapest_growth = RectArea(RectUnion(*cheapest, pending)) - RectArea(*cheapest);
+
+        for (auto it = rects_.begin() + 1; it != rects_.end(); ++it)
+        {
+          int growth = RectArea(RectUnion(*it, pending)) - RectArea(*it);
+
+          if (growth < cheapest_growth)
+          {
+            cheapest = it;
+            cheapest_growth = growth;
+          }
+        }
+
+        pending = RectUnion(*cheapest, pending);
+        rects_.erase(cheapest);
+        merged = true;
+      }
+    }
+
+    rects_.push_back(pending);
+  }
+
+  void DamageRegion::Add(DamageRegion const& region)
+  {
+    for (auto const& rect : region.rects_)
+      Add(rect);
+  }
+
+  void DamageRegion::Clip(Geometry const& bounds)
+  {
+    std::vector<Geometry> rects;
+    rects.swap(rects_);
+
+    for (auto const& rect : rects)
+    {
+      if (RectsOverlap(rect, bounds))
+        Add(rect.Intersect(bounds));
+    }
+  }
+
+  void DamageRegion::Clear()
+  {
+    rects_.clear();
+  }
+
+  bool DamageRegion::IsEmpty() const
+  {
+    return rects_.empty();
+  }
+
+  bool DamageRegion::IsIntersecting(Geometry const& rect) const
+  {
+    for (auto const& r : rects_)
+    {
+      if (RectsOverlap(r, rect))
+        return true;
+    }
+
+    return false;
+  }
+
+  Geometry DamageRegion::GetBounds() const
+  {
+    if (rects_.empty())
+      return Geometry(0, 0, 0, 0);
+
+    Geometry bounds = rects_[0];
+
+    for (auto const& rect : rects_)
+      bounds = RectUnion(bounds, rect);
+
+    return bounds;
+  }
+
+  int DamageRegion::GetArea() const
+  {
+    int area = 0;
+
+    for (auto const& rect : rects_)
+      area += RectArea(rect);
+
+    return area;
+  }
+
+  std::vector<Geometry> const& DamageRegion::GetRects() const
+  {
+    return rects_;
+  }
+}
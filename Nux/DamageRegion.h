@@ -0,0 +1,72 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#ifndef DAMAGEREGION_H
+#define DAMAGEREGION_H
+
+#include <vector>
+
+#include "NuxCore/Rect.h"
+
+namespace nux
+{
+  //! A set of rectangles that need to be repainted.
+  /*!
+      Rectangles added to the region are coalesced: a rectangle is merged with an existing one when
+      their bounding box doesn't cover more pixels than the two rectangles do separately. The region
+      never holds more than MAX_RECTS rectangles; past that, the new rectangle is merged with the
+      rectangle whose bounding box grows the least.
+  */
+  class DamageRegion
+  {
+  public:
+    //! Maximum number of rectangles kept in the region.
+    static const int MAX_RECTS = 16;
+
+    DamageRegion();
+
+    //! Add a rectangle to the region. Empty rectangles are ignored.
+    void Add(Geometry const& rect);
+    //! Add all the rectangles of another region to this region.
+    void Add(DamageRegion const& region);
+
+    //! Intersect all the rectangles of the region with the provided bounds.
+    void Clip(Geometry const& bounds);
+    void Clear();
+
+    bool IsEmpty() const;
+    bool IsIntersecting(Geometry const& rect) const;
+
+    //! Return the smallest rectangle containing the whole region.
+    Geometry GetBounds() const;
+    //! Return the number of pixels covered by the rectangles of the region.
+    /*!
+        Rectangles of the region may overlap, the overlapping pixels are counted once per rectangle.
+    */
+    int GetArea() const;
+
+    std::vector<Geometry> const& GetRects() const;
+
+  private:
+    std::vector<Geometry> rects_;
+  };
+}
+
+#endif // DAMAGEREGION_H
@@ -0,0 +1,347 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#include "Nux.h"
+#include "ImageLoader.h"
+#include "NuxGraphics/GLTextureResourceManager.h"
+#include "NuxGraphics/ImageScaling.h"
+#include "NuxGraphics/ImageSurface.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace nux
+{
+DECLARE_LOGGER(logger, "nux.image.loader");
+
+  ImageLoader::Request::Request()
+    : max_size(-1)
+    , cancelled(false)
+    , bitmap(nullptr)
+  {}
+
+  ImageLoader::ImageLoader(WindowThread* window_thread, int threads)
+    : window_thread_(window_thread)
+    , thread_count_(threads)
+    , upload_budget_(DEFAULT_UPLOAD_BUDGET)
+    , next_handle_(0)
+    , decoding_(0)
+    , stopping_(false)
+  {
+    if (thread_count_ <= 0)
+    {
+      thread_count_ = std::max<int>(std::thread::hardware_concurrency(), 1);
+      if (thread_count_ > MAX_THREADS)
+        thread_count_ = MAX_THREADS;
+    }
+
+    upload_signal_ = new TimerFunctor();
+    upload_signal_->tick.connect(sigc::mem_fun(this, &ImageLoader::UploadCallback));
+
+    // The workers write to the pipe when an image is decoded, the main loop wakes up to upload it.
+    if (pipe2(wake_up_pipe_, O_CLOEXEC | O_NONBLOCK) == -1)
+    {
+      LOG_ERROR(logger) << "Can't create the wake up pipe, the images are uploaded by Finish only.";
+      wake_up_pipe_[0] = wake_up_pipe_[1] = -1;
+    }
+    else
+    {
+      window_thread_->WatchFdForEvents(wake_up_pipe_[0], std::bind(&ImageLoader::WakeUpCallback, this));
+    }
+  }
+
+  ImageLoader::~ImageLoader()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    work_available_.notify_all();
+
+    for (auto& thread : threads_)
+      thread.join();
+
+    for (auto const& request : completed_)
+      delete request->bitmap;
+
+    window_thread_->GetTimerHandler().RemoveTimerHandler(upload_timer_handle_);
+    delete upload_signal_;
+
+    if (wake_up_pipe_[0] != -1)
+    {
+      window_thread_->UnwatchFd(wake_up_pipe_[0]);
+      close(wake_up_pipe_[0]);
+      close(wake_up_pipe_[1]);
+    }
+  }
+
+  ImageLoader::Handle ImageLoader::Load(std::string const& filename, Callback const& callback, int max_size)
+  {
+    Handle handle = ++next_handle_;
+    if (handle == 0)
+      handle = ++next_handle_;
+
+    if (max_size <= 0)
+      max_size = -1;
+
+    RequestKey key(filename, max_size);
+    auto it = requests_.find(key);
+    if (it != requests_.end())
+    {
+      it->second->callbacks.push_back(std::make_pair(handle, callback));
+      handles_[handle] = it->second;
+      return handle;
+    }
+
+    RequestPtr request = std::make_shared<Request>();
+    request->filename = filename;
+    request->max_size = max_size;
+    request->callbacks.push_back(std::make_pair(handle, callback));
+    requests_[key] = request;
+    handles_[handle] = request;
+
+    if (threads_.empty())
+      StartThreads();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(request);
+    }
+    work_available_.notify_one();
+
+    return handle;
+  }
+
+  void ImageLoader::Cancel(Handle handle)
+  {
+    auto it = handles_.find(handle);
+    if (it == handles_.end())
+      return;
+
+    RequestPtr request = it->second;
+    handles_.erase(it);
+
+    auto& callbacks = request->callbacks;
+    for (auto callback = callbacks.begin(); callback != callbacks.end(); ++callback)
+    {
+      if (callback->first == handle)
+      {
+        callbacks.erase(callback);
+        break;
+      }
+    }
+
+    if (!callbacks.empty())
+      return;
+
+    auto pending = requests_.find(RequestKey(request->filename, request->max_size));
+    if (pending != requests_.end() && pending->second == request)
+      requests_.erase(pending);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    request->cancelled = true;
+  }
+
+  bool ImageLoader::IsPending(Handle handle) const
+  {
+    return handles_.find(handle) != handles_.end();
+  }
+
+  int ImageLoader::GetPendingCount() const
+  {
+    return handles_.size();
+  }
+
+  ObjectPtr<BaseTexture> ImageLoader::GetPlaceholderTexture()
+  {
+    if (!placeholder_.IsValid())
+    {
+      NTextureData data(BITFMT_R8G8B8A8, 1, 1, 1);
+      BaseTexture* texture = window_thread_->GetGraphicsDisplay().GetGpuDevice()->CreateSystemCapableTexture();
+      texture->Update(&data);
+
+      placeholder_ = ObjectPtr<BaseTexture>(texture);
+      texture->UnReference();
+    }
+
+    return placeholder_;
+  }
+
+  void ImageLoader::SetUploadBudget(int microseconds)
+  {
+    upload_budget_ = std::max(0, microseconds);
+  }
+
+  int ImageLoader::GetUploadBudget() const
+  {
+    return upload_budget_;
+  }
+
+  void ImageLoader::Finish()
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_done_.wait(lock, [this] { return decoding_ == 0 && queue_.empty(); });
+    }
+
+    UploadCompleted(G_MAXINT64);
+  }
+
+  void ImageLoader::StartThreads()
+  {
+    for (int i = 0; i < thread_count_; ++i)
+      threads_.push_back(std::thread(&ImageLoader::WorkerThread, this));
+  }
+
+  void ImageLoader::WorkerThread()
+  {
+    while (true)
+    {
+      RequestPtr request;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_available_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+        if (stopping_)
+          return;
+
+        request = queue_.front();
+        queue_.pop_front();
+
+        if (request->cancelled)
+        {
+          if (queue_.empty() && decoding_ == 0)
+            work_done_.notify_all();
+          continue;
+        }
+
+        ++decoding_;
+      }
+
+      NBitmapData* bitmap = LoadImageFile(request->filename.c_str());
+
+      if (bitmap && request->max_size > 0 && bitmap->IsTextureData())
+        FitTextureData(*static_cast<NTextureData*>(bitmap), request->max_size, request->max_size);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        request->bitmap = bitmap;
+        completed_.push_back(request);
+        --decoding_;
+      }
+      work_done_.notify_all();
+
+      if (wake_up_pipe_[1] != -1)
+      {
+        // The pipe only needs to be readable. It is full if the main loop is late, that's fine too.
+        char byte = 0;
+        if (write(wake_up_pipe_[1], &byte, 1) == -1 && errno != EAGAIN)
+          LOG_WARN(logger) << "Can't wake up the main loop: " << strerror(errno);
+      }
+    }
+  }
+
+  void ImageLoader::WakeUpCallback()
+  {
+    char buffer[64];
+    while (read(wake_up_pipe_[0], buffer, sizeof(buffer)) > 0)
+      ;
+
+    UploadCompleted(g_get_monotonic_time() + upload_budget_);
+  }
+
+  void ImageLoader::UploadCallback(void* /* data */)
+  {
+    window_thread_->GetTimerHandler().RemoveTimerHandler(upload_timer_handle_);
+    UploadCompleted(g_get_monotonic_time() + upload_budget_);
+  }
+
+  void ImageLoader::UploadCompleted(gint64 deadline)
+  {
+    while (true)
+    {
+      RequestPtr request;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (completed_.empty())
+          return;
+
+        request = completed_.front();
+        completed_.pop_front();
+      }
+
+      Complete(request);
+
+      if (g_get_monotonic_time() >= deadline)
+        break;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (completed_.empty())
+        return;
+    }
+
+    // Continue on a later iteration of the main loop, so that frames can be drawn between the uploads.
+    if (!upload_timer_handle_.Activated())
+      upload_timer_handle_ = window_thread_->GetTimerHandler().AddOneShotTimer(UPLOAD_PERIOD, upload_signal_, this, window_thread_);
+  }
+
+  void ImageLoader::Complete(RequestPtr const& request)
+  {
+    std::unique_ptr<NBitmapData> bitmap(request->bitmap);
+    request->bitmap = nullptr;
+
+    if (request->callbacks.empty())
+      return;
+
+    auto it = requests_.find(RequestKey(request->filename, request->max_size));
+    if (it != requests_.end() && it->second == request)
+      requests_.erase(it);
+
+    ObjectPtr<BaseTexture> texture;
+    if (bitmap)
+    {
+      BaseTexture* created = CreateTextureFromBitmapData(bitmap.get());
+      if (created)
+      {
+        texture = ObjectPtr<BaseTexture>(created);
+        created->UnReference();
+      }
+    }
+
+    // The callbacks can load or cancel other requests.
+    std::vector<std::pair<Handle, Callback> > callbacks;
+    callbacks.swap(request->callbacks);
+
+    for (auto const& callback : callbacks)
+    {
+      auto handle = handles_.find(callback.first);
+      if (handle == handles_.end())
+        continue;
+
+      handles_.erase(handle);
+      callback.second(texture);
+    }
+  }
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#ifndef IMAGELOADER_H
+#define IMAGELOADER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TimerProc.h"
+
+namespace nux
+{
+  class BaseTexture;
+  class NBitmapData;
+  class WindowThread;
+
+  //! Load image files without blocking the main loop of a WindowThread.
+  /*!
+      The files are decoded to NTextureData by a pool of worker threads. The decoded images are uploaded to
+      textures on the thread of the WindowThread, when the main loop wakes up: the uploads of an iteration of the
+      main loop stop after the upload budget, the remaining images are uploaded on the next iterations.
+
+      Requests for a file that is still being loaded at the same size share the decode and the texture. A
+      completed file is decoded again by the next request.
+
+      All the functions must be called on the thread of the WindowThread.
+  */
+  class ImageLoader : public sigc::trackable
+  {
+  public:
+    //! Called with the texture of the image, or a null pointer if the file could not be decoded.
+    typedef std::function<void(ObjectPtr<BaseTexture> const&)> Callback;
+
+    //! Identifier of a request. 0 is never a valid request.
+    typedef unsigned int Handle;
+
+    /*!
+        @param window_thread The thread that uploads the textures and calls the callbacks.
+        @param threads Number of worker threads. If 0, a few threads depending on the processor.
+    */
+    ImageLoader(WindowThread* window_thread, int threads = 0);
+    ~ImageLoader();
+
+    //! Start loading an image file.
+    /*!
+        @param filename Path of the file.
+        @param callback Called on the thread of the WindowThread when the texture is ready. It is never called
+            from Load.
+        @param max_size If the width or height of the image exceeds that value, the worker reduces the image
+            before the upload, respecting the aspect ratio. -1 keeps the size of the file.
+        @return A handle to cancel the request.
+    */
+    Handle Load(std::string const& filename, Callback const& callback, int max_size = -1);
+
+    //! Cancel a request. The callback of the request is not called.
+    /*!
+        The file is not decoded if no other request wants it and no worker has started decoding it yet.
+        Does nothing if the request is already completed.
+    */
+    void Cancel(Handle handle);
+
+    //! Return true if the request has not completed and has not been cancelled.
+    bool IsPending(Handle handle) const;
+
+    //! Number of requests that have not completed and have not been cancelled.
+    int GetPendingCount() const;
+
+    //! Texture to show while an image is loading: a single transparent texel.
+    ObjectPtr<BaseTexture> GetPlaceholderTexture();
+
+    //! Set the time spent uploading textures in an iteration of the main loop, in microseconds.
+    /*!
+        At least one texture is uploaded in each iteration.
+    */
+    void SetUploadBudget(int microseconds);
+    int GetUploadBudget() const;
+
+    //! Wait until all the requests are decoded, then upload them and call their callbacks.
+    /*!
+        Ignores the upload budget.
+    */
+    void Finish();
+
+    static const int DEFAULT_UPLOAD_BUDGET = 4000;
+    static const int MAX_THREADS = 4;
+
+  private:
+    ImageLoader(ImageLoader const&);
+    ImageLoader& operator = (ImageLoader const&);
+
+    //! A file that is being loaded.
+    struct Request
+    {
+      Request();
+
+      std::string filename;
+      int max_size;
+      std::vector<std::pair<Handle, Callback> > callbacks;
+      bool cancelled;       //!< No request wants the file anymore. Guarded by mutex_.
+      NBitmapData* bitmap;  //!< The decoded image. Guarded by mutex_.
+    };
+    typedef std::shared_ptr<Request> RequestPtr;
+    typedef std::pair<std::string, int> RequestKey;
+
+    void StartThreads();
+    void WorkerThread();
+    void WakeUpCallback();
+    void UploadCallback(void* data);
+
+    //! Upload the decoded requests until the deadline, in microseconds of g_get_monotonic_time.
+    void UploadCompleted(gint64 deadline);
+    void Complete(RequestPtr const& request);
+
+    WindowThread* window_thread_;
+    int thread_count_;
+    int upload_budget_;
+
+    Handle next_handle_;
+    std::map<RequestKey, RequestPtr> requests_;
+    std::map<Handle, RequestPtr> handles_;
+    ObjectPtr<BaseTexture> placeholder_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable work_done_;
+    std::deque<RequestPtr> queue_;
+    std::deque<RequestPtr> completed_;
+    int decoding_;
+    bool stopping_;
+    std::vector<std::thread> threads_;
+
+    int wake_up_pipe_[2];
+    TimeOutSignal* upload_signal_;
+    TimerHandle upload_timer_handle_;
+
+    //! Period of the uploads that did not fit in the budget, about a frame.
+    static const int UPLOAD_PERIOD = 16;
+  };
+}
+
+#endif // IMAGELOADER_H
@@ -29,6 +29,50 @@ namespace nux
   NUX_IMPLEMENT_OBJECT_TYPE(Layout);
   NUX_IMPLEMENT_OBJECT_TYPE(SpaceLayout);
 
+  namespace
+  {
+    // Each thread draws its own windows.
+    __thread Layout::DrawStatistics draw_statistics = { 0, 0 };
+
+    // The rectangle a child draws in, in the coordinates of its parent. Returns false for the children that
+    // can't be culled: the ones rendering to a texture have to keep it up to date.
+    bool GetChildDrawRect(Area* child, Rect& rect)
+    {
+      if (child->RedirectRenderingToTexture())
+        return false;
+
+      Matrix4 matrix = child->Get2DMatrix();
+      rect = child->GetGeometry();
+      rect.OffsetPosition(static_cast<int>(matrix.m[0][3]), static_cast<int>(matrix.m[1][3]));
+      return true;
+    }
+
+    // The rectangle a child is hit tested in, in the coordinates of its parent. Returns false for the children
+    // that can return areas outside of it.
+    bool GetChildHitTestRect(Area* child, Rect& rect)
+    {
+      if (!child->IsHitTestConfinedToGeometry())
+        return false;
+
+      Matrix4 matrix = child->Get2DMatrix();
+      if (matrix.m[0][0] != 1.0f || matrix.m[0][1] != 0.0f || matrix.m[1][0] != 0.0f || matrix.m[1][1] != 1.0f)
+        return false;
+
+      rect = child->GetGeometry();
+      rect.OffsetPosition(static_cast<int>(matrix.m[0][3]), static_cast<int>(matrix.m[1][3]));
+      return true;
+    }
+
+    // The hit tests against the index are conservative by one pixel: fractional translations are not rounded
+    // the same way in the absolute geometry of the children.
+    Rect InflatedHitTestRect(Rect const& rect)
+    {
+      return Rect(rect.x - 1, rect.y - 1, rect.width + 2, rect.height + 2);
+    }
+
+    const int MAX_HIT_TEST_GRID_SIZE = 128;
+  }
+
   Layout::Layout(NUX_FILE_LINE_DECL)
     :   Area(NUX_FILE_LINE_PARAM)
   {
@@ -43,6 +87,14 @@ namespace nux
     m_ContentStacking   = eStackExpand;
     draw_cmd_queued_        = false;
     child_draw_cmd_queued_  = false;
+    draw_index_enabled_     = false;
+    draw_index_valid_       = false;
+    hit_test_index_enabled_ = false;
+    hit_test_index_valid_   = false;
+    hit_test_cell_width_    = 1;
+    hit_test_cell_height_   = 1;
+    hit_test_columns_       = 0;
+    hit_test_rows_          = 0;
 
     SetMinimumSize(1, 1);
   }
@@ -86,6 +138,7 @@ namespace nux
 #endif
     left_padding_ = padding < 0 ? 0 : padding;
     right_padding_ = padding < 0 ? 0 : padding;
+    InvalidateContentSize();
   }
 
   void Layout::SetLeftAndRightPadding(int left, int right)
@@ -95,6 +148,7 @@ namespace nux
 #endif
     left_padding_ = left < 0 ? 0 : left;
     right_padding_ = right < 0 ? 0 : right;
+    InvalidateContentSize();
   }
 
   void Layout::SetTopAndBottomPadding(int padding)
@@ -104,6 +158,7 @@ namespace nux
 #endif
     top_padding_ = padding < 0 ? 0 : padding;
     bottom_padding_ = padding < 0 ? 0 : padding;
+    InvalidateContentSize();
   }
 
   void Layout::SetTopAndBottomPadding(int top, int bottom)
@@ -113,6 +168,7 @@ namespace nux
 #endif
     top_padding_ = top < 0 ? 0 : top;
     bottom_padding_ = bottom < 0 ? 0 : bottom;
+    InvalidateContentSize();
   }
 
   void Layout::SetPadding(int padding)
@@ -121,6 +177,7 @@ namespace nux
     bottom_padding_ = top_padding_;
     right_padding_ = top_padding_;
     left_padding_ = top_padding_;
+    InvalidateContentSize();
   }
 
   void Layout::SetPadding(int top_bottom_padding, int left_right_padding)
@@ -130,6 +187,7 @@ namespace nux
 
     right_padding_ = left_right_padding < 0 ? 0 : left_right_padding;
     left_padding_ = right_padding_;
+    InvalidateContentSize();
   }
 
 
@@ -139,6 +197,7 @@ namespace nux
     right_padding_ = right < 0 ? 0 : right;
     bottom_padding_ = bottom < 0 ? 0 : bottom;
     left_padding_ = left < 0 ? 0 : left;
+    InvalidateContentSize();
   }
 
   //! Deprecated. Use SetLeftAndRightPadding.
@@ -153,6 +212,38 @@ namespace nux
     SetTopAndBottomPadding(padding);
   }
 
+  long Layout::ComputeChildContentSize(Area *child)
+  {
+    if (!child->content_size_dirty_ &&
+        child->content_size_layout_done_ == child->layout_done_ &&
+        child->content_size_request_ == Size(child->geometry_.width, child->geometry_.height) &&
+        child->content_size_min_ == child->min_size_ &&
+        child->content_size_max_ == child->max_size_)
+    {
+      child->SetBaseSize(child->content_size_result_.width, child->content_size_result_.height);
+      return child->content_size_compliance_;
+    }
+
+    Size request(child->geometry_.width, child->geometry_.height);
+    bool layout_done = child->layout_done_;
+
+    // Cleared before the computation so an invalidation coming from inside it is not lost.
+    child->content_size_dirty_ = false;
+    long ret = child->ComputeContentSize();
+
+    if (!child->content_size_dirty_)
+    {
+      child->content_size_request_ = request;
+      child->content_size_min_ = child->min_size_;
+      child->content_size_max_ = child->max_size_;
+      child->content_size_layout_done_ = layout_done;
+      child->content_size_result_ = Size(child->geometry_.width, child->geometry_.height);
+      child->content_size_compliance_ = ret;
+    }
+
+    return ret;
+  }
+
   void Layout::RemoveChildObject(Area *bo)
   {
     std::list<Area *>::iterator it;
@@ -165,6 +256,7 @@ namespace nux
       ViewRemoved.emit(this, bo);
       bo->UnParentObject();
       _layout_element_list.erase(it);
+      InvalidateChildIndices();
     }
   }
 
@@ -246,6 +338,7 @@ namespace nux
       _layout_element_list.insert(pos, layout);
     }
 
+    InvalidateChildIndices();
     ViewAdded.emit(this, layout);
   }
 
@@ -342,6 +435,7 @@ namespace nux
       _layout_element_list.insert(pos, bo);
     }
 
+    InvalidateChildIndices();
     ViewAdded.emit(this, bo);
     //--->> Removed because it cause problem with The splitter widget: ComputeContentSize();
   }
@@ -361,6 +455,7 @@ namespace nux
     }
 
     _layout_element_list.clear();
+    InvalidateChildIndices();
   }
 
   bool Layout::SearchInAllSubNodes(Area *bo)
@@ -477,6 +572,16 @@ namespace nux
     if (mouse_inside == false)
       return NULL;
 
+    if (hit_test_index_enabled_)
+    {
+      return FindIndexedChild(mouse_position, [&] (Area* child) -> Area*
+      {
+        if (child->IsVisible() && child->GetInputEventSensitivity())
+          return child->FindAreaUnderMouse(mouse_position, event_type);
+        return NULL;
+      });
+    }
+
     std::list<Area *>::iterator it;
     for (it = _layout_element_list.begin(); it != _layout_element_list.end(); it++)
     {
@@ -493,8 +598,6 @@ namespace nux
 
   void Layout::ProcessDraw(GraphicsEngine &graphics_engine, bool force_draw)
   {
-    std::list<Area *>::iterator it;
-
     if (RedirectRenderingToTexture())
     {
       if (update_backup_texture_ || force_draw || draw_cmd_queued_)
@@ -503,23 +606,7 @@ namespace nux
         BeginBackupTextureRendering(graphics_engine, force_draw);
         {
           graphics_engine.PushModelViewMatrix(Get2DMatrix());
-
-          for (it = _layout_element_list.begin(); it != _layout_element_list.end(); it++)
-          {
-            if (!(*it)->IsVisible())
-              continue;
-
-            if ((*it)->IsView())
-            {
-              View* view = static_cast<View*>(*it);
-              view->ProcessDraw(graphics_engine, force_draw);
-            }
-            else if ((*it)->IsLayout())
-            {
-              Layout* layout = static_cast<Layout*>(*it);
-              layout->ProcessDraw(graphics_engine, force_draw);
-            }
-          }
+          DrawChildren(graphics_engine, force_draw, NULL);
           graphics_engine.PopModelViewMatrix();
         }
         EndBackupTextureRendering(graphics_engine, force_draw);
@@ -565,22 +652,12 @@ namespace nux
 
       graphics_engine.PushClippingRectangle(clip_geo);
 
-      for (it = _layout_element_list.begin(); it != _layout_element_list.end(); it++)
-      {
-        if (!(*it)->IsVisible())
-          continue;
-
-        if ((*it)->IsView())
-        {
-          View* view = static_cast<View*>(*it);
-          view->ProcessDraw(graphics_engine, force_draw);
-        }
-        else if ((*it)->IsLayout())
-        {
-          Layout* layout = static_cast<Layout*>(*it);
-          layout->ProcessDraw(graphics_engine, force_draw);
-        }
-      }
+      // Skip the children outside of the clipping rectangle.
+      Rect visible_rect;
+      if (graphics_engine.GetModelViewClippingRegion(visible_rect))
+        DrawChildren(graphics_engine, force_draw, &visible_rect);
+      else
+        DrawChildren(graphics_engine, force_draw, NULL);
 
       graphics_engine.PopClippingRectangle();
       graphics_engine.PopModelViewMatrix();
@@ -765,6 +842,7 @@ namespace nux
   void Layout::SetContentDistribution(LayoutContentDistribution stacking)
   {
     m_ContentStacking = stacking;
+    InvalidateContentSize();
   }
 
   LayoutContentDistribution Layout::GetContentDistribution()
@@ -838,6 +916,286 @@ namespace nux
       QueueDraw();
   }
 
+  void Layout::ChildGeometryChanged(Area* /* child */)
+  {
+    InvalidateChildIndices();
+  }
+
+  void Layout::InvalidateChildIndices()
+  {
+    draw_index_valid_ = false;
+    hit_test_index_valid_ = false;
+  }
+
+  Layout::DrawStatistics const& Layout::GetDrawStatistics()
+  {
+    return draw_statistics;
+  }
+
+  void Layout::ResetDrawStatistics()
+  {
+    draw_statistics.drawn_children = 0;
+    draw_statistics.culled_children = 0;
+  }
+
+  void Layout::SetDrawIndexEnabled(bool enabled)
+  {
+    draw_index_enabled_ = enabled;
+    draw_index_valid_ = false;
+    draw_index_.clear();
+    draw_index_bottom_.clear();
+    draw_index_uncullable_.clear();
+  }
+
+  bool Layout::IsDrawIndexEnabled() const
+  {
+    return draw_index_enabled_;
+  }
+
+  void Layout::DrawChild(GraphicsEngine& graphics_engine, Area* child, bool force_draw)
+  {
+    if (child->IsView())
+    {
+      View* view = static_cast<View*>(child);
+      view->ProcessDraw(graphics_engine, force_draw);
+    }
+    else if (child->IsLayout())
+    {
+      Layout* layout = static_cast<Layout*>(child);
+      layout->ProcessDraw(graphics_engine, force_draw);
+    }
+    else
+    {
+      return;
+    }
+
+    ++draw_statistics.drawn_children;
+  }
+
+  void Layout::DrawChildren(GraphicsEngine& graphics_engine, bool force_draw, Rect const* visible_rect)
+  {
+    if (visible_rect && draw_index_enabled_)
+    {
+      DrawIndexedChildren(graphics_engine, force_draw, *visible_rect);
+      return;
+    }
+
+    for (auto child : _layout_element_list)
+    {
+      // Hidden children outside of the clipping rectangle are counted as culled, like with the draw index.
+      Rect rect;
+      if (visible_rect && GetChildDrawRect(child, rect) && !rect.IsIntersecting(*visible_rect))
+      {
+        ++draw_statistics.culled_children;
+        continue;
+      }
+
+      if (!child->IsVisible())
+        continue;
+
+      DrawChild(graphics_engine, child, force_draw);
+    }
+  }
+
+  void Layout::BuildDrawIndex()
+  {
+    draw_index_.clear();
+    draw_index_bottom_.clear();
+    draw_index_uncullable_.clear();
+
+    int order = 0;
+    for (auto child : _layout_element_list)
+    {
+      ChildIndexEntry entry;
+      entry.order = order++;
+      entry.area = child;
+
+      if (GetChildDrawRect(child, entry.rect))
+        draw_index_.push_back(entry);
+      else
+        draw_index_uncullable_.push_back(entry);
+    }
+
+    std::stable_sort(draw_index_.begin(), draw_index_.end(),
+                     [] (ChildIndexEntry const& a, ChildIndexEntry const& b) { return a.rect.y < b.rect.y; });
+
+    int bottom = INT_MIN;
+    draw_index_bottom_.reserve(draw_index_.size());
+    for (auto const& entry : draw_index_)
+    {
+      bottom = std::max(bottom, entry.rect.y + entry.rect.height);
+      draw_index_bottom_.push_back(bottom);
+    }
+
+    draw_index_valid_ = true;
+  }
+
+  void Layout::DrawIndexedChildren(GraphicsEngine& graphics_engine, bool force_draw, Rect const& visible_rect)
+  {
+    if (!draw_index_valid_)
+      BuildDrawIndex();
+
+    // The entries from the first one that goes below the top of the visible rectangle, to the last one that
+    // starts above its bottom.
+    auto first = std::lower_bound(draw_index_bottom_.begin(), draw_index_bottom_.end(), visible_rect.y) - draw_index_bottom_.begin();
+    auto last = std::upper_bound(draw_index_.begin(), draw_index_.end(), visible_rect.y + visible_rect.height,
+                                 [] (int y, ChildIndexEntry const& entry) { return y < entry.rect.y; }) - draw_index_.begin();
+
+    draw_candidates_.clear();
+    for (auto i = first; i < last; ++i)
+    {
+      if (draw_index_[i].rect.IsIntersecting(visible_rect))
+        draw_candidates_.push_back(&draw_index_[i]);
+    }
+    draw_statistics.culled_children += draw_index_.size() - draw_candidates_.size();
+
+    for (auto const& entry : draw_index_uncullable_)
+      draw_candidates_.push_back(&entry);
+
+    // Draw in the order of the children.
+    std::sort(draw_candidates_.begin(), draw_candidates_.end(),
+              [] (ChildIndexEntry const* a, ChildIndexEntry const* b) { return a->order < b->order; });
+
+    for (auto entry : draw_candidates_)
+    {
+      if (entry->area->IsVisible())
+        DrawChild(graphics_engine, entry->area, force_draw);
+    }
+  }
+
+  void Layout::SetHitTestIndexEnabled(bool enabled)
+  {
+    hit_test_index_enabled_ = enabled;
+    hit_test_index_valid_ = false;
+    hit_test_entries_.clear();
+    hit_test_unconfined_.clear();
+    hit_test_cells_.clear();
+  }
+
+  bool Layout::IsHitTestIndexEnabled() const
+  {
+    return hit_test_index_enabled_;
+  }
+
+  void Layout::BuildHitTestIndex()
+  {
+    hit_test_entries_.clear();
+    hit_test_unconfined_.clear();
+    hit_test_cells_.clear();
+    hit_test_columns_ = 0;
+    hit_test_rows_ = 0;
+    hit_test_index_valid_ = true;
+
+    int order = 0;
+    for (auto child : _layout_element_list)
+    {
+      ChildIndexEntry entry;
+      entry.order = order++;
+      entry.area = child;
+
+      if (GetChildHitTestRect(child, entry.rect))
+        hit_test_entries_.push_back(entry);
+      else
+        hit_test_unconfined_.push_back(entry);
+    }
+
+    if (hit_test_entries_.empty())
+      return;
+
+    // The cells are about the average size of the children, so that each one lists few of them.
+    int left = INT_MAX, top = INT_MAX, right = INT_MIN, bottom = INT_MIN;
+    long long total_width = 0, total_height = 0;
+    for (auto const& entry : hit_test_entries_)
+    {
+      Rect rect = InflatedHitTestRect(entry.rect);
+      left = std::min(left, rect.x);
+      top = std::min(top, rect.y);
+      right = std::max(right, rect.x + rect.width);
+      bottom = std::max(bottom, rect.y + rect.height);
+      total_width += rect.width;
+      total_height += rect.height;
+    }
+
+    hit_test_bounds_ = Rect(left, top, right - left, bottom - top);
+    hit_test_cell_width_ = std::max(1, static_cast<int>(total_width / hit_test_entries_.size()));
+    hit_test_cell_height_ = std::max(1, static_cast<int>(total_height / hit_test_entries_.size()));
+    hit_test_cell_width_ = std::max(hit_test_cell_width_, (hit_test_bounds_.width + MAX_HIT_TEST_GRID_SIZE - 1) / MAX_HIT_TEST_GRID_SIZE);
+    hit_test_cell_height_ = std::max(hit_test_cell_height_, (hit_test_bounds_.height + MAX_HIT_TEST_GRID_SIZE - 1) / MAX_HIT_TEST_GRID_SIZE);
+    hit_test_columns_ = (hit_test_bounds_.width + hit_test_cell_width_ - 1) / hit_test_cell_width_;
+    hit_test_rows_ = (hit_test_bounds_.height + hit_test_cell_height_ - 1) / hit_test_cell_height_;
+    hit_test_cells_.resize(hit_test_columns_ * hit_test_rows_);
+
+    for (int i = 0; i < static_cast<int>(hit_test_entries_.size()); ++i)
+    {
+      Rect rect = InflatedHitTestRect(hit_test_entries_[i].rect);
+      int first_column = (rect.x - hit_test_bounds_.x) / hit_test_cell_width_;
+      int last_column = (rect.x + rect.width - 1 - hit_test_bounds_.x) / hit_test_cell_width_;
+      int first_row = (rect.y - hit_test_bounds_.y) / hit_test_cell_height_;
+      int last_row = (rect.y + rect.height - 1 - hit_test_bounds_.y) / hit_test_cell_height_;
+
+      for (int row = first_row; row <= last_row; ++row)
+      {
+        for (int column = first_column; column <= last_column; ++column)
+          hit_test_cells_[row * hit_test_columns_ + column].push_back(i);
+      }
+    }
+  }
+
+  template <typename HitTest>
+  Area* Layout::FindIndexedChild(Point const& position, HitTest const& hit_test)
+  {
+    if (!hit_test_index_valid_)
+      BuildHitTestIndex();
+
+    static std::vector<int> const no_entries;
+    std::vector<int> const* cell = &no_entries;
+    Point local = position;
+
+    if (!hit_test_entries_.empty())
+    {
+      // The children share the transformations of this layout and its parents, any of them gives the offset
+      // from the absolute coordinates to the ones of the index.
+      ChildIndexEntry const& reference = hit_test_entries_.front();
+      Geometry absolute = reference.area->GetAbsoluteGeometry();
+      local.x += reference.rect.x - absolute.x;
+      local.y += reference.rect.y - absolute.y;
+
+      if (hit_test_bounds_.IsInside(local))
+      {
+        int column = (local.x - hit_test_bounds_.x) / hit_test_cell_width_;
+        int row = (local.y - hit_test_bounds_.y) / hit_test_cell_height_;
+        cell = &hit_test_cells_[row * hit_test_columns_ + column];
+      }
+    }
+
+    // Visit the children of the cell and the unconfined ones in the order of the children.
+    auto entry = cell->begin();
+    auto unconfined = hit_test_unconfined_.begin();
+    while (entry != cell->end() || unconfined != hit_test_unconfined_.end())
+    {
+      Area* child;
+      if (unconfined == hit_test_unconfined_.end() ||
+          (entry != cell->end() && hit_test_entries_[*entry].order < unconfined->order))
+      {
+        ChildIndexEntry const& candidate = hit_test_entries_[*entry++];
+        if (!InflatedHitTestRect(candidate.rect).IsInside(local))
+          continue;
+
+        child = candidate.area;
+      }
+      else
+      {
+        child = (unconfined++)->area;
+      }
+
+      Area* area_hit = hit_test(child);
+      if (area_hit)
+        return area_hit;
+    }
+
+    return NULL;
+  }
+
 #ifdef NUX_GESTURES_SUPPORT
   Area* Layout::GetInputAreaHitByGesture(const GestureEvent &event)
   {
@@ -847,6 +1205,21 @@ namespace nux
     if (!IsGestureInsideArea(event))
       return nullptr;
 
+    // A direct touch hits the areas that contain all of its touches, the first one is enough to use the index.
+    if (hit_test_index_enabled_ && (!event.IsDirectTouch() || !event.GetTouches().empty()))
+    {
+      Point position;
+      if (event.IsDirectTouch())
+        position = Point(static_cast<int>(event.GetTouches()[0].x), static_cast<int>(event.GetTouches()[0].y));
+      else
+        position = Point(static_cast<int>(event.GetFocus().x), static_cast<int>(event.GetFocus().y));
+
+      return FindIndexedChild(position, [&event] (Area* child)
+      {
+        return child->GetInputAreaHitByGesture(event);
+      });
+    }
+
     for (const auto area : _layout_element_list)
     {
       Area *area_hit = area->GetInputAreaHitByGesture(event);
@@ -263,14 +263,61 @@ namespace nux
     */
     virtual void ResetQueueDraw(); 
 
+    //! Counters of the children visited by Layout::ProcessDraw, for profiling.
+    struct DrawStatistics
+    {
+      unsigned int drawn_children;  //!< Children drawn.
+      unsigned int culled_children; //!< Children skipped because they are outside of the clipping rectangle, hidden or not.
+    };
+
+    //! Get the counters of the children drawn and culled by the layouts of the calling thread since the last reset.
+    static DrawStatistics const& GetDrawStatistics();
+    static void ResetDrawStatistics();
+
+    //! Index the children by position so that drawing only visits the visible ones.
+    /*!
+        Drawing a layout always skips the children that are outside of the clipping rectangle. With the
+        index, these children are not even visited, which is worth it for layouts with many children of
+        which few are visible, like the content of a ScrollView. The index is rebuilt after the children
+        or their geometry change.
+    */
+    void SetDrawIndexEnabled(bool enabled);
+    bool IsDrawIndexEnabled() const;
+
+    //! Index the children in a grid so that hit tests only visit the ones under the pointer.
+    /*!
+        FindAreaUnderMouse and GetInputAreaHitByGesture walk the children in order until one of them
+        returns an area. With the index, only the children whose geometry contains the pointer are
+        walked, plus the ones that are not confined to their geometry (see
+        Area::IsHitTestConfinedToGeometry). The index is rebuilt after the children or their geometry
+        change.
+    */
+    void SetHitTestIndexEnabled(bool enabled);
+    bool IsHitTestIndexEnabled() const;
+
   protected:
     void BeginBackupTextureRendering(GraphicsEngine& graphics_engine, bool force_draw);
     void EndBackupTextureRendering(GraphicsEngine& graphics_engine, bool force_draw);
 
     virtual void GeometryChangePending(bool position_about_to_change, bool size_about_to_change);
     virtual void GeometryChanged(bool position_has_changed, bool size_has_changed);
+    virtual void ChildGeometryChanged(Area* child);
 
     virtual bool AcceptKeyNavFocus();
+
+    //! Must be called when the list of children changes.
+    void InvalidateChildIndices();
+
+    //! Compute the size of a child element.
+    /*!
+        Call the ComputeContentSize function of the child, unless the child, its size and its size constraints
+        have not changed since the last time it was computed by this function. In that case, the child is given
+        the size it computed back then and its subtree is left untouched.
+
+        @param child A child element of this layout.
+        @return The value returned by the ComputeContentSize function of the child.
+    */
+    long ComputeChildContentSize(Area *child);
     
     bool draw_cmd_queued_; //<! The rendering of the layout needs to be refreshed.
     bool child_draw_cmd_queued_; //<! A child of this layout has requested a draw.
@@ -297,6 +344,47 @@ namespace nux
     std::string m_name;
 
     LayoutContentDistribution m_ContentStacking;
+
+  private:
+    struct ChildIndexEntry
+    {
+      Rect rect;
+      int order;
+      Area* area;
+    };
+
+    void DrawChildren(GraphicsEngine& graphics_engine, bool force_draw, Rect const* visible_rect);
+    void DrawIndexedChildren(GraphicsEngine& graphics_engine, bool force_draw, Rect const& visible_rect);
+    void DrawChild(GraphicsEngine& graphics_engine, Area* child, bool force_draw);
+    void BuildDrawIndex();
+
+    template <typename HitTest>
+    Area* FindIndexedChild(Point const& position, HitTest const& hit_test);
+    void BuildHitTestIndex();
+
+    bool draw_index_enabled_;
+    bool draw_index_valid_;
+    //! The cullable children sorted by their top edge.
+    std::vector<ChildIndexEntry> draw_index_;
+    //! The largest bottom edge of draw_index_ up to each entry.
+    std::vector<int> draw_index_bottom_;
+    //! The children that are always drawn, like the ones rendering to a texture.
+    std::vector<ChildIndexEntry> draw_index_uncullable_;
+    std::vector<ChildIndexEntry const*> draw_candidates_;
+
+    bool hit_test_index_enabled_;
+    bool hit_test_index_valid_;
+    //! The children confined to their geometry, in order.
+    std::vector<ChildIndexEntry> hit_test_entries_;
+    //! The children that are always hit tested.
+    std::vector<ChildIndexEntry> hit_test_unconfined_;
+    //! A grid over the bounds of hit_test_entries_, each cell lists the entries that overlap it in order.
+    std::vector<std::vector<int> > hit_test_cells_;
+    Rect hit_test_bounds_;
+    int hit_test_cell_width_;
+    int hit_test_cell_height_;
+    int hit_test_columns_;
+    int hit_test_rows_;
   };
 
 
@@ -95,6 +95,7 @@ namespace nux
       _layout_element_list.insert(pos, layout);
     }
 
+    InvalidateChildIndices();
     ViewAdded.emit(this, layout);
   }
 
@@ -185,6 +186,7 @@ namespace nux
       _layout_element_list.insert(pos, bo);
     }
 
+    InvalidateChildIndices();
     ViewAdded.emit(this, bo);
     //--->> Removed because it cause problem with The splitter widget: ComputeContentSize();
   }
@@ -210,6 +212,7 @@ namespace nux
     return;
 #endif
     space_between_children_ = space >= 0 ? space : 0;
+    InvalidateContentSize();
   }
 
 }
@@ -43,6 +43,12 @@ namespace nux
     return window_thread->GetNextEvent();
   }
 
+  // The data is freed with its source, when the timeout is dispatched or removed.
+  static void nux_timeout_data_free(gpointer user_data)
+  {
+    delete NUX_STATIC_CAST(TimeoutData*, user_data);
+  }
+
   gboolean nux_timeout_dispatch(gpointer user_data)
   {
     bool repeat = false;
@@ -68,9 +74,6 @@ namespace nux
       g_main_loop_quit(dd->window_thread->main_loop_glib_);
     }
 
-    if (!repeat)
-      delete dd;
-
     return repeat;
   }
 
@@ -398,7 +401,7 @@ namespace nux
     {
       TimeoutData* dd = new TimeoutData;
       dd->window_thread = this;
-      dd->id = g_timeout_add(duration, nux_timeout_dispatch, dd);
+      dd->id = g_timeout_add_full(G_PRIORITY_DEFAULT, duration, nux_timeout_dispatch, dd, nux_timeout_data_free);
 
       return dd->id;
     }
@@ -419,7 +422,7 @@ namespace nux
       dd->window_thread = this;
       dd->id = 0;
       //set the callback for this source
-      g_source_set_callback(timeout_source, nux_timeout_dispatch, dd, NULL);
+      g_source_set_callback(timeout_source, nux_timeout_dispatch, dd, nux_timeout_data_free);
 
       //attach source to context
       dd->id = g_source_attach(timeout_source, main_loop_glib_context_);
@@ -428,6 +431,15 @@ namespace nux
     }
   }
 
+  void WindowThread::RemoveGLibTimeout(unsigned int id)
+  {
+    GMainContext* context = IsEmbeddedWindow() ? NULL : main_loop_glib_context_;
+    GSource* timeout_source = g_main_context_find_source_by_id(context, id);
+
+    if (timeout_source)
+      g_source_destroy(timeout_source);
+  }
+
 #if defined(NUX_OS_WINDOWS)
   bool WindowThread::AddChildWindowGlibLoop(WindowThread* wnd_thread)
 #else
@@ -32,6 +32,7 @@
 #include "NuxGraphics/GraphicsDisplay.h"
 
 #include "StaticText.h"
+#include "TextRenderingCache.h"
 
 #if defined(NUX_OS_WINDOWS)
   #include "D2DTextRenderer.h"
@@ -75,7 +76,6 @@ namespace nux
     font_name_ = "Tahoma";
 
 #elif defined(NUX_STATIC_TEXT_USE_CAIRO)
-    cairo_graphics_ = NULL;
     font_size_ = 10;
     font_name_ = "Ubuntu";
     std::ostringstream os;
@@ -95,11 +95,6 @@ namespace nux
 
   StaticText::~StaticText()
   {
-#if defined(NUX_STATIC_TEXT_USE_CAIRO)
-    if (cairo_graphics_ != 0)
-      delete(cairo_graphics_);
-#endif
-
     if (dw_texture_.IsValid())
       dw_texture_.Release();
   }
@@ -233,7 +228,11 @@ namespace nux
     unsigned int alpha = 0, src = 0, dest = 0;
     graphics_engine.GetRenderStates().GetBlend(alpha, src, dest);
 
+#if defined(NUX_STATIC_TEXT_USE_CAIRO)
+    graphics_engine.GetRenderStates().SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+#else
     graphics_engine.GetRenderStates().SetBlend(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+#endif
 
     TexCoordXForm texxform;
     texxform.SetWrap(TEXWRAP_CLAMP, TEXWRAP_CLAMP);
@@ -262,6 +261,16 @@ namespace nux
       }
     }
 
+#if defined(NUX_STATIC_TEXT_USE_CAIRO)
+    // The texture only holds the coverage of the glyphs.
+    graphics_engine.QRP_ColorModTexAlpha(x,
+      y,
+      dw_texture_->GetWidth(),
+      dw_texture_->GetHeight(),
+      dw_texture_,
+      texxform,
+      text_color_);
+#else
     graphics_engine.QRP_1Tex(x,
       y,
       dw_texture_->GetWidth(),
@@ -269,6 +278,7 @@ namespace nux
       dw_texture_,
       texxform,
       text_color_);
+#endif
 
     graphics_engine.GetRenderStates().SetBlend(alpha, src, dest);
     graphics_engine.PopClippingRectangle();
@@ -295,6 +305,7 @@ namespace nux
     Size sz = GetTextSizeNoClip();
     // Calling SetBaseSize will trigger a layout request of this view and all of its parents.
     SetBaseSize(sz.width, sz.height);
+    update_text_rendering_ = true;
   }
 
   void StaticText::SetTextPointSize(int font_size)
@@ -370,6 +381,7 @@ namespace nux
     Size sz = GetTextSizeNoClip();
     // Calling SetBaseSize will trigger a layout request of this view and all of its parents.
     SetBaseSize(sz.width, sz.height);
+    update_text_rendering_ = true;
     QueueDraw();
   }
 
@@ -416,8 +428,34 @@ namespace nux
       UpdateTextRendering();
     }
 
+#if defined(NUX_STATIC_TEXT_USE_CAIRO)
+    // The view renders an alpha only texture; the RGBA texture is only rasterized for the callers that need it.
+    if (dw_texture_.IsValid() && !rgba_texture_.IsValid())
+    {
+      rgba_texture_ = TextRenderingCache::Instance().GetTexture(text_, pango_font_name_,
+                                                                clip_to_width_ ? clip_to_width_ : text_width_,
+                                                                dw_texture_->GetWidth(), dw_texture_->GetHeight(),
+                                                                TextRenderingCache::RGBA);
+    }
+
+    return rgba_texture_;
+#else
+    return dw_texture_;
+#endif
+  }
+
+#if defined(NUX_STATIC_TEXT_USE_CAIRO)
+  ObjectPtr<nux::IOpenGLBaseTexture> StaticText::GetTextAlphaTexture()
+  {
+    if (update_text_rendering_)
+    {
+      // If the text rendering needs to be updated, do it here.
+      UpdateTextRendering();
+    }
+
     return dw_texture_;
   }
+#endif
 
   Size StaticText::GetTextSizeNoClip()
   {
@@ -730,67 +768,18 @@ namespace nux
 #elif defined(NUX_STATIC_TEXT_USE_CAIRO)
   Size StaticText::ComputeTextSize(bool assign, bool with_clipping)
   {
-    cairo_surface_t*      pango_surface = NULL;
-    cairo_t*              cairo_ctx     = NULL;
-    PangoLayout*          pango_layout  = NULL;
-    PangoFontDescription* font_desc     = NULL;
-    PangoContext*         pango_ctx     = NULL;
-    PangoRectangle        ink_rect      = {0, 0, 0, 0};
-    PangoRectangle        logical_rect  = {0, 0, 0, 0};
-    int                   dpi           = 96;
-
-    // Create Cairo surface.
-    pango_surface = cairo_image_surface_create(CAIRO_FORMAT_A1, 1, 1);
-    
-    // Create Cairo context.
-    cairo_ctx = cairo_create(pango_surface);
-    
-    // Create layout.
-    pango_layout = pango_cairo_create_layout(cairo_ctx);
-    {
-      pango_layout_set_wrap     (pango_layout, PANGO_WRAP_WORD_CHAR);
-      pango_layout_set_ellipsize(pango_layout, PANGO_ELLIPSIZE_END);
-      pango_layout_set_markup   (pango_layout, text_.c_str(), -1);
-    }
-
-    // Create font description: "[FAMILY-LIST] [STYLE-OPTIONS] [SIZE]"
-    font_desc = pango_font_description_from_string(pango_font_name_.c_str());
-    {
-      pango_font_description_set_weight(font_desc, PANGO_WEIGHT_NORMAL);
-      pango_layout_set_font_description(pango_layout, font_desc);
-    }
-
-    // Get Pango context
-    pango_ctx = pango_layout_get_context(pango_layout); // is not ref'ed
-
-    // Set font options
-    CairoFontOptions font_options;
-    {
-      cairo_font_options_set_antialias      (font_options, CAIRO_ANTIALIAS_DEFAULT);
-      cairo_font_options_set_subpixel_order(font_options, CAIRO_SUBPIXEL_ORDER_DEFAULT);
-      cairo_font_options_set_hint_style     (font_options, CAIRO_HINT_STYLE_DEFAULT);
-      cairo_font_options_set_hint_metrics   (font_options, CAIRO_HINT_METRICS_ON);
-      cairo_set_font_options(cairo_ctx, font_options);
-
-      pango_cairo_context_set_font_options(pango_ctx, font_options);
-    }
-
-    // use some default DPI-value
-    pango_cairo_context_set_resolution(pango_ctx, dpi);
-
-    pango_layout_context_changed(pango_layout);
-    pango_layout_get_extents(pango_layout, &ink_rect, &logical_rect);
+    TextRenderingCache::Extents extents = TextRenderingCache::Instance().GetExtents(text_, pango_font_name_);
 
-    int text_width = std::ceil((float)logical_rect.width / PANGO_SCALE);
-    int text_height = std::ceil((float)logical_rect.height / PANGO_SCALE);
+    int text_width = extents.width;
+    int text_height = extents.height;
 
     if (assign)
     {
       text_width_ = text_width;
       text_height_ = text_height;
 
-      padding_x_ = text_width_ - logical_rect.width / PANGO_SCALE;
-      padding_y_ = text_height_ - logical_rect.height / PANGO_SCALE;
+      padding_x_ = extents.padding_x;
+      padding_y_ = extents.padding_y;
 
       if (with_clipping && (clip_to_width_ > 0))
       {
@@ -801,75 +790,16 @@ namespace nux
       text_height = text_height_;
     }
 
-    // clean up
-    pango_font_description_free(font_desc);
-    g_object_unref(pango_layout);
-    cairo_destroy(cairo_ctx);
-    cairo_surface_destroy(pango_surface);
-
     return Size(text_width, text_height);
   }
 
-  void StaticText::RasterizeText(void* cairo_context, Color /* color */)
-  {
-    cairo_t* cairo_ctx = (cairo_t*) cairo_context;
-
-    PangoLayout*          pango_layout  = NULL;
-    PangoFontDescription* font_desc     = NULL;
-    PangoContext*         pango_ctx     = NULL;
-    int                   dpi            = 96;
-
-    // Create layout.
-    pango_layout = pango_cairo_create_layout(cairo_ctx);
-    {
-      pango_layout_set_wrap     (pango_layout, PANGO_WRAP_WORD_CHAR);
-      pango_layout_set_ellipsize(pango_layout, PANGO_ELLIPSIZE_END);
-      pango_layout_set_markup   (pango_layout, text_.c_str(), -1);
-
-      // Sets the width to which the lines of the PangoLayout should wrap or ellipsized. The default value is -1: no width set.
-      pango_layout_set_width(pango_layout, (clip_to_width_ ? clip_to_width_ : text_width_) * PANGO_SCALE);
-    }
-
-    // Create font description: "[FAMILY-LIST] [STYLE-OPTIONS] [SIZE]"
-    font_desc = pango_font_description_from_string(pango_font_name_.c_str());
-    {
-      pango_font_description_set_weight(font_desc, PANGO_WEIGHT_NORMAL);
-      pango_layout_set_font_description(pango_layout, font_desc);
-    }
-
-    // Get Pango context
-    pango_ctx = pango_layout_get_context(pango_layout); // is not ref'ed
-
-    // Set font options
-    CairoFontOptions font_options;
-    {
-      cairo_font_options_set_antialias      (font_options, CAIRO_ANTIALIAS_DEFAULT);
-      cairo_font_options_set_subpixel_order (font_options, CAIRO_SUBPIXEL_ORDER_DEFAULT);
-      cairo_font_options_set_hint_style     (font_options, CAIRO_HINT_STYLE_DEFAULT);
-      cairo_font_options_set_hint_metrics   (font_options, CAIRO_HINT_METRICS_ON);
-      cairo_set_font_options(cairo_ctx, font_options);
-
-      pango_cairo_context_set_font_options(pango_ctx, font_options);
-    }
-
-    pango_cairo_context_set_resolution(pango_ctx, dpi);
-
-    cairo_set_source_rgba(cairo_ctx, 1.0, 1.0, 1.0, 1.0);
-
-    pango_layout_context_changed(pango_layout);
-
-    cairo_move_to(cairo_ctx, padding_x_, padding_y_);
-    pango_cairo_show_layout(cairo_ctx, pango_layout);
-
-    // clean up
-    pango_font_description_free(font_desc);
-    g_object_unref(pango_layout);
-  }
-
   void StaticText::UpdateTextRendering()
   {
     Size sz = ComputeTextSize();
 
+    if (rgba_texture_.IsValid())
+      rgba_texture_.Release();
+
     if (sz.width == 0 || sz.height == 0)
     {
       // Nothing to render
@@ -880,32 +810,10 @@ namespace nux
       return;
     }
 
-    cairo_graphics_ = new CairoGraphics(CAIRO_FORMAT_ARGB32, sz.width, sz.height);
-    cairo_t* cairo_ctx = cairo_graphics_->GetContext();
-    cairo_set_operator(cairo_ctx, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(cairo_ctx);
-    cairo_set_operator(cairo_ctx, CAIRO_OPERATOR_OVER);
-
-    RasterizeText(cairo_ctx, text_color_);
-
-    NBitmapData* bitmap = cairo_graphics_->GetBitmap();
-
-    // NTexture2D is the high level representation of an image that is backed by
-    // an actual opengl texture.
-
-    BaseTexture* rasterized_text_texture = NULL;
-
-    rasterized_text_texture = GetGraphicsDisplay()->GetGpuDevice()->CreateSystemCapableTexture();
-    rasterized_text_texture->Update(bitmap);
-    dw_texture_ = rasterized_text_texture->GetDeviceTexture();
-
-    rasterized_text_texture->UnReference();
-    rasterized_text_texture = NULL;
-
-    delete bitmap;
-    cairo_destroy(cairo_ctx);
-    delete cairo_graphics_;
-    cairo_graphics_ = NULL;
+    // Labels with the same text share the same alpha texture. The text color is applied in Draw.
+    dw_texture_ = TextRenderingCache::Instance().GetTexture(text_, pango_font_name_,
+                                                            clip_to_width_ ? clip_to_width_ : text_width_,
+                                                            sz.width, sz.height);
 
     update_text_rendering_ = false;
   }
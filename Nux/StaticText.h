@@ -34,8 +34,6 @@
 
 namespace nux
 {
-  class CairoGraphics;
-
   /*!
       A View that renders as static text.
   */
@@ -144,12 +142,23 @@ namespace nux
     //! Returns the device texture for the text.
     /*!
         Returns the device texture for the text. The device texture may be used \n
-        for direct rendering.
+        for direct rendering. It is an RGBA texture of the text in white.
 
         @return A smart point for the device texture.
     */
     ObjectPtr<nux::IOpenGLBaseTexture> GetTextTexture();
 
+#if defined(NUX_STATIC_TEXT_USE_CAIRO)
+    //! Returns the alpha only device texture for the text.
+    /*!
+        Returns the alpha only texture that the view renders. It is shared by all the \n
+        StaticText views with the same text and font. Render it with GraphicsEngine::QRP_ColorModTexAlpha.
+
+        @return A smart point for the device texture.
+    */
+    ObjectPtr<nux::IOpenGLBaseTexture> GetTextAlphaTexture();
+#endif
+
     sigc::signal<void, StaticText*> text_changed;
 
   protected:
@@ -193,12 +202,10 @@ namespace nux
 #elif defined (NUX_STATIC_TEXT_USE_CAIRO)
     float dpy_;
     std::string pango_font_name_;  //!< Input to pango_font_description_from_string.
+    ObjectPtr<nux::IOpenGLBaseTexture> rgba_texture_; //!< Texture returned by GetTextTexture, created on demand.
 
     Size ComputeTextSize(bool assign = true, bool with_clipping = true);
-    void RasterizeText(void* cairo_context, Color color);
     void UpdateTextRendering();
-
-    CairoGraphics* cairo_graphics_;
 #endif
 
   private:
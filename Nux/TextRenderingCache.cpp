@@ -0,0 +1,219 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include "Nux.h"
+
+#include "cairo/cairo.h"
+#include "pango/pango.h"
+#include "pango/pangocairo.h"
+#include "NuxGraphics/CairoGraphics.h"
+#include "NuxGraphics/GraphicsDisplay.h"
+
+#include "TextRenderingCache.h"
+
+namespace nux
+{
+  namespace
+  {
+    const int TEXT_DPI = 96;
+    const size_t MIN_TEXTURES_SWEEP_SIZE = 64;
+
+    void SetFontOptions(cairo_t* cairo_ctx, PangoContext* pango_ctx)
+    {
+      CairoFontOptions font_options;
+      cairo_font_options_set_antialias      (font_options, CAIRO_ANTIALIAS_DEFAULT);
+      cairo_font_options_set_subpixel_order (font_options, CAIRO_SUBPIXEL_ORDER_DEFAULT);
+      cairo_font_options_set_hint_style     (font_options, CAIRO_HINT_STYLE_DEFAULT);
+      cairo_font_options_set_hint_metrics   (font_options, CAIRO_HINT_METRICS_ON);
+      cairo_set_font_options(cairo_ctx, font_options);
+
+      if (pango_ctx)
+        pango_cairo_context_set_font_options(pango_ctx, font_options);
+    }
+  }
+
+  const size_t TextRenderingCache::MAX_EXTENTS;
+
+  TextRenderingCache::Extents::Extents()
+    : width(0)
+    , height(0)
+    , padding_x(0)
+    , padding_y(0)
+  {}
+
+  TextRenderingCache& TextRenderingCache::Instance()
+  {
+    static TextRenderingCache cache;
+    return cache;
+  }
+
+  TextRenderingCache::TextRenderingCache()
+    : textures_sweep_size_(MIN_TEXTURES_SWEEP_SIZE)
+    , rasterization_count_(0)
+  {
+    surface_ = cairo_image_surface_create(CAIRO_FORMAT_A1, 1, 1);
+    cairo_ctx_ = cairo_create(surface_);
+    layout_ = pango_cairo_create_layout(cairo_ctx_);
+
+    pango_layout_set_wrap     (layout_, PANGO_WRAP_WORD_CHAR);
+    pango_layout_set_ellipsize(layout_, PANGO_ELLIPSIZE_END);
+
+    PangoContext* pango_ctx = pango_layout_get_context(layout_); // is not ref'ed
+    SetFontOptions(cairo_ctx_, pango_ctx);
+    pango_cairo_context_set_resolution(pango_ctx, TEXT_DPI);
+    pango_layout_context_changed(layout_);
+  }
+
+  TextRenderingCache::~TextRenderingCache()
+  {
+    for (auto const& font : font_descriptions_)
+      pango_font_description_free(font.second);
+
+    g_object_unref(layout_);
+    cairo_destroy(cairo_ctx_);
+    cairo_surface_destroy(surface_);
+  }
+
+  void TextRenderingCache::SetLayoutText(std::string const& markup, std::string const& font_name, int layout_width)
+  {
+    PangoFontDescription*& font_desc = font_descriptions_[font_name];
+
+    if (!font_desc)
+    {
+      // Create font description: "[FAMILY-LIST] [STYLE-OPTIONS] [SIZE]"
+      font_desc = pango_font_description_from_string(font_name.c_str());
+      pango_font_description_set_weight(font_desc, PANGO_WEIGHT_NORMAL);
+    }
+
+    pango_layout_set_markup(layout_, markup.c_str(), -1);
+    pango_layout_set_font_description(layout_, font_desc);
+    // The default value is -1: no width set.
+    pango_layout_set_width(layout_, layout_width > 0 ? layout_width * PANGO_SCALE : -1);
+  }
+
+  TextRenderingCache::Extents TextRenderingCache::LookupExtents(std::string const& markup, std::string const& font_name)
+  {
+    ExtentsKey key(markup, font_name);
+    auto it = extents_.find(key);
+
+    if (it != extents_.end())
+      return it->second;
+
+    PangoRectangle ink_rect     = {0, 0, 0, 0};
+    PangoRectangle logical_rect = {0, 0, 0, 0};
+
+    SetLayoutText(markup, font_name, -1);
+    pango_layout_get_extents(layout_, &ink_rect, &logical_rect);
+
+    Extents extents;
+    extents.width = std::ceil((float)logical_rect.width / PANGO_SCALE);
+    extents.height = std::ceil((float)logical_rect.height / PANGO_SCALE);
+    extents.padding_x = extents.width - logical_rect.width / PANGO_SCALE;
+    extents.padding_y = extents.height - logical_rect.height / PANGO_SCALE;
+
+    if (extents_.size() >= MAX_EXTENTS)
+      extents_.clear();
+
+    extents_[key] = extents;
+    return extents;
+  }
+
+  TextRenderingCache::Extents TextRenderingCache::GetExtents(std::string const& markup, std::string const& font_name)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return LookupExtents(markup, font_name);
+  }
+
+  ObjectPtr<IOpenGLBaseTexture> TextRenderingCache::GetTexture(std::string const& markup, std::string const& font_name,
+                                                               int layout_width, int width, int height,
+                                                               TextureFormat format)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    GpuDevice* gpu_device = GetGraphicsDisplay()->GetGpuDevice();
+    TextureKey key(gpu_device, markup, font_name, layout_width, width, height, format);
+    ObjectWeakPtr<IOpenGLBaseTexture>& cached_texture = textures_[key];
+
+    if (cached_texture.IsValid())
+      return ObjectPtr<IOpenGLBaseTexture>(cached_texture.GetPointer());
+
+    Extents extents = LookupExtents(markup, font_name);
+
+    CairoGraphics cairo_graphics(format == ALPHA ? CAIRO_FORMAT_A8 : CAIRO_FORMAT_ARGB32, width, height);
+    cairo_t* cairo_ctx = cairo_graphics.GetContext();
+    cairo_set_operator(cairo_ctx, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(cairo_ctx);
+    cairo_set_operator(cairo_ctx, CAIRO_OPERATOR_OVER);
+    SetFontOptions(cairo_ctx, NULL);
+
+    SetLayoutText(markup, font_name, layout_width);
+    pango_cairo_update_layout(cairo_ctx, layout_);
+
+    cairo_set_source_rgba(cairo_ctx, 1.0, 1.0, 1.0, 1.0);
+    cairo_move_to(cairo_ctx, extents.padding_x, extents.padding_y);
+    pango_cairo_show_layout(cairo_ctx, layout_);
+
+    // Bring the layout back to the measurement context.
+    pango_cairo_update_layout(cairo_ctx_, layout_);
+
+    NBitmapData* bitmap = cairo_graphics.GetBitmap();
+
+    BaseTexture* rasterized_text_texture = gpu_device->CreateSystemCapableTexture();
+    rasterized_text_texture->Update(bitmap);
+    ObjectPtr<IOpenGLBaseTexture> texture = rasterized_text_texture->GetDeviceTexture();
+    rasterized_text_texture->UnReference();
+
+    delete bitmap;
+    cairo_destroy(cairo_ctx);
+
+    cached_texture = texture;
+    ++rasterization_count_;
+
+    if (textures_.size() >= textures_sweep_size_)
+      RemoveReleasedTextures();
+
+    return texture;
+  }
+
+  void TextRenderingCache::RemoveReleasedTextures()
+  {
+    for (auto it = textures_.begin(); it != textures_.end();)
+    {
+      if (it->second.IsValid())
+        ++it;
+      else
+        it = textures_.erase(it);
+    }
+
+    textures_sweep_size_ = std::max(MIN_TEXTURES_SWEEP_SIZE, 2 * textures_.size());
+  }
+
+  void TextRenderingCache::Clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    extents_.clear();
+    RemoveReleasedTextures();
+  }
+
+  int TextRenderingCache::GetRasterizationCount() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rasterization_count_;
+  }
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#ifndef TEXTRENDERINGCACHE_H
+#define TEXTRENDERINGCACHE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+typedef struct _cairo cairo_t;
+typedef struct _cairo_surface cairo_surface_t;
+typedef struct _PangoLayout PangoLayout;
+typedef struct _PangoFontDescription PangoFontDescription;
+
+namespace nux
+{
+  class GpuDevice;
+  class IOpenGLBaseTexture;
+
+  //! Process wide cache of the text measurements and text textures of StaticText.
+  /*!
+      Text is measured with a single PangoLayout that is reused for all the requests and the extents are kept
+      per markup and font. StaticText renders alpha only textures: the color of the text is applied
+      when the texture is rendered, so labels that only differ by their color share the same texture. The
+      textures are held weakly; a texture is released as soon as the last label using it lets it go.
+  */
+  class TextRenderingCache
+  {
+  public:
+    //! Pixel format of the text textures.
+    enum TextureFormat
+    {
+      ALPHA,  //!< Alpha only texture.
+      RGBA    //!< Premultiplied RGBA texture of the text in white.
+    };
+
+    //! Size of a text without wrapping or ellipsizing.
+    struct Extents
+    {
+      Extents();
+
+      int width;        //!< Logical width of the text, rounded up.
+      int height;       //!< Logical height of the text, rounded up.
+      float padding_x;  //!< Difference between the rounded and the exact width.
+      float padding_y;  //!< Difference between the rounded and the exact height.
+    };
+
+    static TextRenderingCache& Instance();
+
+    //! Return the extents of a text.
+    /*!
+        @param markup The Pango markup of the text.
+        @param font_name Input to pango_font_description_from_string.
+    */
+    Extents GetExtents(std::string const& markup, std::string const& font_name);
+
+    //! Return the texture of a text.
+    /*!
+        The texture is created with the GpuDevice of the calling thread if no label already uses it.
+
+        @param markup The Pango markup of the text.
+        @param font_name Input to pango_font_description_from_string.
+        @param layout_width Width at which the text is wrapped or ellipsized.
+        @param width Width of the texture.
+        @param height Height of the texture.
+        @param format Pixel format of the texture.
+        @return The texture of the text.
+    */
+    ObjectPtr<IOpenGLBaseTexture> GetTexture(std::string const& markup, std::string const& font_name,
+                                             int layout_width, int width, int height,
+                                             TextureFormat format = ALPHA);
+
+    //! Drop the cached extents. The textures in use are kept.
+    void Clear();
+
+    //! Number of textures that have been rasterized since the cache was created.
+    int GetRasterizationCount() const;
+
+    //! Maximum number of cached extents. The extents are all dropped when the limit is reached.
+    static const size_t MAX_EXTENTS = 4096;
+
+  private:
+    TextRenderingCache();
+    ~TextRenderingCache();
+    TextRenderingCache(TextRenderingCache const&);
+    TextRenderingCache& operator = (TextRenderingCache const&);
+
+    Extents LookupExtents(std::string const& markup, std::string const& font_name);
+    void SetLayoutText(std::string const& markup, std::string const& font_name, int layout_width);
+    void RemoveReleasedTextures();
+
+    typedef std::pair<std::string, std::string> ExtentsKey;
+    typedef std::tuple<GpuDevice*, std::string, std::string, int, int, int, TextureFormat> TextureKey;
+
+    mutable std::mutex mutex_;
+
+    cairo_surface_t* surface_;
+    cairo_t* cairo_ctx_;
+    PangoLayout* layout_;
+
+    std::map<std::string, PangoFontDescription*> font_descriptions_;
+    std::map<ExtentsKey, Extents> extents_;
+    std::map<TextureKey, ObjectWeakPtr<IOpenGLBaseTexture> > textures_;
+    size_t textures_sweep_size_;
+
+    int rasterization_count_;
+  };
+}
+
+#endif // TEXTRENDERINGCACHE_H
@@ -21,6 +21,7 @@
 
 #include "Nux.h"
 #include "TextureArea.h"
+#include "ImageLoader.h"
 #include "NuxGraphics/ImageSurface.h"
 
 namespace nux
@@ -29,6 +30,7 @@ namespace nux
 
   TextureArea::TextureArea(NUX_FILE_LINE_DECL)
   : View(NUX_FILE_LINE_PARAM)
+  , image_load_handle_(0)
   {
     mouse_down.connect(sigc::mem_fun(this, &TextureArea::RecvMouseDown));
     mouse_up.connect(sigc::mem_fun(this, &TextureArea::RecvMouseUp));
@@ -43,6 +45,8 @@ namespace nux
 
   TextureArea::~TextureArea()
   {
+    CancelImageLoad();
+
     if (paint_layer_)
       delete paint_layer_;
   }
@@ -76,6 +80,7 @@ namespace nux
   void TextureArea::SetTexture(BaseTexture *texture)
   {
     NUX_RETURN_IF_NULL(texture);
+    CancelImageLoad();
     delete paint_layer_;
 
     TexCoordXForm texxform;
@@ -88,20 +93,41 @@ namespace nux
 
   void TextureArea::SetColor(const Color &color)
   {
+    CancelImageLoad();
     delete paint_layer_;
     paint_layer_ = new ColorLayer(color);
     QueueDraw();
   }
 
-  void TextureArea::LoadImageFile(const std::string &filename)
+  void TextureArea::LoadImageFile(const std::string &filename, int max_size)
   {
-    if (paint_layer_)
+    CancelImageLoad();
+
+    BaseTexture *texture = LoadTextureFromFile(filename, max_size);
+    SetImageTexture(texture);
+
+    if (texture)
+      texture->UnReference();
+  }
+
+  void TextureArea::LoadImageFileAsync(const std::string &filename, int max_size)
+  {
+    CancelImageLoad();
+
+    ImageLoader &loader = GetWindowThread()->GetImageLoader();
+    SetImageTexture(loader.GetPlaceholderTexture().GetPointer());
+
+    image_load_handle_ = loader.Load(filename, [this] (ObjectPtr<BaseTexture> const& texture)
     {
-      delete paint_layer_;
-      paint_layer_ = NULL;
-    }
+      image_load_handle_ = 0;
+      SetImageTexture(texture.GetPointer());
+      QueueDraw();
+    }, max_size);
+  }
 
-    BaseTexture *texture = LoadTextureFromFile(filename);
+  void TextureArea::SetImageTexture(BaseTexture *texture)
+  {
+    NUX_SAFE_DELETE(paint_layer_);
 
     if (texture)
     {
@@ -112,7 +138,6 @@ namespace nux
       rop.DstBlend = GL_ONE_MINUS_SRC_ALPHA;
 
       paint_layer_ = new TextureLayer(texture->GetDeviceTexture(), texxform, color::White, true, rop);
-      texture->UnReference();
     }
     else
     {
@@ -120,8 +145,23 @@ namespace nux
     }
   }
 
+  void TextureArea::CancelImageLoad()
+  {
+    if (image_load_handle_ == 0)
+      return;
+
+    // The loader is destroyed with the window thread, with its requests. Don't create it again when the
+    // window thread destroys its views.
+    WindowThread *window_thread = GetWindowThread();
+    if (window_thread && window_thread->HasImageLoader())
+      window_thread->GetImageLoader().Cancel(image_load_handle_);
+
+    image_load_handle_ = 0;
+  }
+
   void TextureArea::SetPaintLayer(AbstractPaintLayer *layer)
   {
+    CancelImageLoad();
     NUX_SAFE_DELETE(paint_layer_);
     paint_layer_ = layer->Clone();
 
@@ -61,7 +61,25 @@ namespace nux
     */
     void SetPaintLayer(AbstractPaintLayer *layer);
 
-    void LoadImageFile(const std::string &filename);
+    /*!
+        Load an image file and use it to create a TextureLayer.
+
+        @param filename Path of the image file.
+        @param max_size If the width or height of the image exceeds that value, the image is reduced before the
+            upload, respecting the aspect ratio. -1 keeps the size of the file.
+    */
+    void LoadImageFile(const std::string &filename, int max_size = -1);
+
+    /*!
+        Load an image file with the ImageLoader of the window thread, without blocking the main loop.
+        The placeholder texture of the loader is shown until the image is ready. Loading another image or
+        setting the texture, the color or the paint layer cancels the load.
+
+        @param filename Path of the image file.
+        @param max_size If the width or height of the image exceeds that value, the image is reduced before the
+            upload, respecting the aspect ratio. -1 keeps the size of the file.
+    */
+    void LoadImageFileAsync(const std::string &filename, int max_size = -1);
 
     /*!
         Get a copy of the paint layer of this area. The layer must be destroyed with delete when it is no longer needed.
@@ -94,7 +112,12 @@ namespace nux
     void RecvMouseDrag(int x, int y, int dx, int dy, unsigned long button_flags, unsigned long key_flags);
 
   private:
+    //! Replace the paint layer with a blended layer of \a texture, or with a black layer if \a texture is null.
+    void SetImageTexture(BaseTexture *texture);
+    void CancelImageLoad();
+
     AbstractPaintLayer *paint_layer_;
+    unsigned int image_load_handle_;  //!< Request of LoadImageFileAsync, 0 if no image is loading.
 
     Matrix4 rotation_2d_;  //!< 2D rotation matrix for this area. Used for rendering only.
   };
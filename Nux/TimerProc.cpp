@@ -30,21 +30,14 @@ class BaseWindow;
 namespace nux
 {
 
-  typedef struct
-  {
-    long    sec;         // seconds
-    long    usec;        // and microseconds
-  } TimeStruct;
-
-  /**
-      Return true if t1 is a time reference that will happen after time t2 has expired.
-  */
-  static bool TimeIsGreater(TimeStruct t1, TimeStruct t2);
-  static void TimeRightNow(TimeStruct *tv);
-//static unsigned int TimeDiff(TimeStruct t1, TimeStruct t2);
-
   static NThreadSafeCounter TimerUID = 0x01234567;
 
+  //! Current time of the monotonic clock, in milliseconds.
+  static gint64 MonotonicTime()
+  {
+    return g_get_monotonic_time() / 1000;
+  }
+
   class TimerObject
   {
   public:
@@ -52,10 +45,9 @@ namespace nux
 
     bool operator == (const TimerObject &timer_object);
 
-    //! Delay before the callback expires
-    TimeStruct      when;
     int             Type;
     gint64          ms_time; // milliseconds 
+    gint64          deadline; //!< Monotonic time at which the timer expires(in milliseconds).
     void           *CallbackData;
     TimeOutSignal  *timeout_signal;
 
@@ -69,14 +61,16 @@ namespace nux
     int             ProgressIterationCount; //!< Number of times the timer has been executed.
     bool            marked_for_removal_;
     BaseWindow      *Window;                 //!< BaseWindow from where the timer was created.
-    unsigned int           glibid;
     unsigned int           uid;
     TimerHandler::TimerState      state_;
+    TimerHandler   *handler;                //!< The TimerHandler the timer has been added to, or null once it is stopped.
+    int             heap_index;             //!< Position in the heap of running timers, or -1.
   };
 
   TimerObject::TimerObject()
     : Type(0)
     , ms_time(0)
+    , deadline(0)
     , CallbackData(nullptr)
     , timeout_signal(nullptr)
     , Param(0)
@@ -88,9 +82,10 @@ namespace nux
     , ProgressIterationCount(0)
     , marked_for_removal_(0)
     , Window(nullptr)
-    , glibid(0)
     , uid(0)
     , state_(TimerHandler::TIMER_STATE_STOPED)
+    , handler(nullptr)
+    , heap_index(-1)
   {}
 
   TimerHandle::TimerHandle()
@@ -172,29 +167,40 @@ namespace nux
     return 0;
   }
 
+
 ////////////////////////////////////////////////////
   TimerHandler::TimerHandler(WindowThread* window_thread)
   : window_thread_(window_thread)
   , is_processing_timers_(false)
+  , num_timers_(0)
+  , wake_up_id_(0)
+  , wake_up_time_(0)
+  , slack_(0)
   {}
 
   void TimerHandler::StartEarlyTimerObjects()
   {
+    gint64 now = MonotonicTime();
+
     for (auto const& timer_object : early_timer_handlers_)
     {
-      timer_object->ms_time = g_get_monotonic_time() / 1000;
-      timer_object->glibid = GetWindowThread()->AddTimeout(timer_object->Period);
+      if (timer_object->handler != this || timer_object->heap_index < 0)
+        continue;
+
+      // The timers start counting when the main loop is running.
+      Unschedule(timer_object);
+      timer_object->ms_time = now;
+      Schedule(timer_object, now + timer_object->Period);
     }
 
     early_timer_handlers_.clear();
+    ArmWakeUp();
   }
 
   TimerHandle TimerHandler::AddOneShotTimer(unsigned int Period, TimeOutSignal* timeout_signal, void* Data, WindowThread* window_thread)
   {
     TimerHandle timer_object(new TimerObject);
 
-    timer_object->ms_time = g_get_monotonic_time() / 1000;
-
     timer_object->CallbackData  = Data;
     timer_object->timeout_signal = timeout_signal;
     timer_object->Period        = Period;
@@ -207,23 +213,6 @@ namespace nux
 
     AddHandle(timer_object);
 
-    {
-      if (window_thread)
-        timer_object->glibid = window_thread->AddTimeout(Period);
-      else
-        timer_object->glibid = GetWindowThread()->AddTimeout(Period);
-
-      if (timer_object->glibid == 0)
-      {
-        early_timer_handlers_.push_back(timer_object);
-        // Probably trying to set a timeout before Glib main context and loop have been created.
-        // Sometimes later, this timer will be examined when ExecTimerHandler is called.
-        // This happens when trying to set a callback before the main loop has been initialized.
-      }
-
-      //nuxDebugMsg("[TimerHandler::AddOneShotTimer] Adding Timeout ID: %d", timer_object->glibid);
-    }
-
     return timer_object;
   }
 
@@ -231,7 +220,6 @@ namespace nux
   {
     TimerHandle timer_object(new TimerObject);
 
-    timer_object->ms_time = g_get_monotonic_time() / 1000;
     timer_object->CallbackData = Data;
     timer_object->timeout_signal = timeout_signal;
 
@@ -241,20 +229,6 @@ namespace nux
     timer_object->state_    = TimerHandler::TIMER_STATE_RUNNING;
     AddHandle(timer_object);
 
-    {
-      timer_object->glibid = GetWindowThread()->AddTimeout(Period);
-
-      if (timer_object->glibid == 0)
-      {
-        early_timer_handlers_.push_back(timer_object);
-        // Probably trying to set a timeout before Glib main context and loop have been created.
-        // Sometimes later, this timer will be examined when ExecTimerHandler is called.
-        // This happens when trying to set a callback before the mainloop has been initialized.
-      }
-
-      //nuxDebugMsg("[TimerHandler::AddOneShotTimer] Adding Timeout ID: %d", timer_object->glibid);
-    }
-
     return timer_object;
   }
 
@@ -262,7 +236,6 @@ namespace nux
   {
     TimerHandle timer_object(new TimerObject);
 
-    timer_object->ms_time = g_get_monotonic_time() / 1000;
     timer_object->CallbackData = Data;
     timer_object->timeout_signal = timeout_signal;
 
@@ -272,24 +245,9 @@ namespace nux
     timer_object->state_              = TimerHandler::TIMER_STATE_RUNNING;
     AddHandle(timer_object);
 
-    {
-      timer_object->glibid = GetWindowThread()->AddTimeout(Period);
-
-      if (timer_object->glibid == 0)
-      {
-        early_timer_handlers_.push_back(timer_object);
-        // Probably trying to set a timeout before Glib main context and loop have been created.
-        // Sometimes later, this timer will be examined when ExecTimerHandler is called.
-        // This happens when trying to set a callback before the mainloop has been initialized.
-      }
-
-      //nuxDebugMsg("[TimerHandler::AddOneShotTimer] Adding Timeout ID: %d", timer_object->glibid);
-    }
-
     return timer_object;
   }
 
-// Sort timers and add them to the queue
   void TimerHandler::AddHandle(TimerHandle const& timer_handle)
   {
     if (!timer_handle.Activated())
@@ -299,362 +257,362 @@ namespace nux
     timer_handle->uid = TimerUID.GetValue();
     TimerUID.Increment();
 
-    auto tmp = timer_handler_queue_.begin();
+    timer_handle->handler = this;
+    ++num_timers_;
 
-    while (tmp != timer_handler_queue_.end() && timer_handle->ms_time >= (*tmp)->ms_time)
-      ++tmp;
+    gint64 now = MonotonicTime();
+    timer_handle->ms_time = now;
+    Schedule(timer_handle, now + timer_handle->Period);
+    ArmWakeUp();
 
-    timer_handler_queue_.insert(tmp, timer_handle);
+    if (wake_up_id_ == 0)
+    {
+      // Probably trying to set a timeout before Glib main context and loop have been created.
+      // The timer is started by StartEarlyTimerObjects once the main loop is running.
+      early_timer_handlers_.push_back(timer_handle);
+    }
   }
 
   unsigned int TimerHandler::GetNumPendingHandler()
   {
-    return timer_handler_queue_.size();
+    return num_timers_;
   }
 
-  bool TimerHandler::RemoveTimerHandler(TimerHandle &handle)
+  static bool IsEarlier(TimerHandle const& a, TimerHandle const& b)
   {
-    if (!handle.Activated() || timer_handler_queue_.empty())
-      return false;
+    // Timers with the same deadline expire in the order they were added.
+    if (a->deadline != b->deadline)
+      return a->deadline < b->deadline;
+
+    return a->uid < b->uid;
+  }
+
+  void TimerHandler::Schedule(TimerHandle const& timer_handle, gint64 deadline)
+  {
+    timer_handle->deadline = deadline;
+    timer_handle->heap_index = timer_queue_.size();
+    timer_queue_.push_back(timer_handle);
+    SiftUp(timer_queue_.size() - 1);
+  }
+
+  void TimerHandler::Unschedule(TimerHandle const& timer_handle)
+  {
+    // Keep a reference: timer_handle may be an element of the heap.
+    TimerHandle timer_object(timer_handle);
+    int index = timer_object->heap_index;
 
-    for (auto it = timer_handler_queue_.begin(); it != timer_handler_queue_.end(); ++it)
+    if (index < 0)
+      return;
+
+    SwapTimers(index, timer_queue_.size() - 1);
+    timer_queue_.pop_back();
+    timer_object->heap_index = -1;
+
+    if (std::size_t(index) < timer_queue_.size())
     {
-      if (*it == handle)
-      {
-        if (!is_processing_timers_)
-        {
-          handle = nullptr;
-          timer_handler_queue_.erase(it);
-          return true;
-        }
-        else
-        {
-          handle->marked_for_removal_ = true;
-        }
-      }
+      SiftDown(index);
+      SiftUp(index);
     }
+  }
 
-    return false;
+  void TimerHandler::SiftUp(std::size_t index)
+  {
+    while (index > 0)
+    {
+      std::size_t parent = (index - 1) / 2;
+
+      if (!IsEarlier(timer_queue_[index], timer_queue_[parent]))
+        break;
+
+      SwapTimers(index, parent);
+      index = parent;
+    }
+  }
+
+  void TimerHandler::SiftDown(std::size_t index)
+  {
+    while (true)
+    {
+      std::size_t earliest = index;
+      std::size_t left = 2 * index + 1;
+      std::size_t right = left + 1;
+
+      if (left < timer_queue_.size() && IsEarlier(timer_queue_[left], timer_queue_[earliest]))
+        earliest = left;
+
+      if (right < timer_queue_.size() && IsEarlier(timer_queue_[right], timer_queue_[earliest]))
+        earliest = right;
+
+      if (earliest == index)
+        break;
+
+      SwapTimers(index, earliest);
+      index = earliest;
+    }
+  }
+
+  void TimerHandler::SwapTimers(std::size_t a, std::size_t b)
+  {
+    std::swap(timer_queue_[a], timer_queue_[b]);
+    timer_queue_[a]->heap_index = a;
+    timer_queue_[b]->heap_index = b;
+  }
+
+  void TimerHandler::ArmWakeUp()
+  {
+    if (timer_queue_.empty())
+      return;
+
+    gint64 wake_up_time = timer_queue_.front()->deadline + slack_;
+
+    // A timeout that fires earlier is already armed. It arms the next one when it is dispatched.
+    if (wake_up_id_ && wake_up_time_ <= wake_up_time)
+      return;
+
+    gint64 delay = std::max<gint64>(wake_up_time - MonotonicTime(), 0);
+
+    // The timeout armed for a later time would only wake up the main loop for nothing.
+    if (wake_up_id_)
+      window_thread_->RemoveTimeout(wake_up_id_);
+
+    wake_up_id_ = window_thread_->AddTimeout(delay);
+    wake_up_time_ = wake_up_time;
+  }
+
+  void TimerHandler::SetTimerSlack(unsigned int milliseconds)
+  {
+    slack_ = milliseconds;
+  }
+
+  unsigned int TimerHandler::GetTimerSlack() const
+  {
+    return slack_;
+  }
+
+  bool TimerHandler::RemoveTimerHandler(TimerHandle &handle)
+  {
+    if (!handle.Activated() || handle->handler != this)
+      return false;
+
+    Unschedule(handle);
+
+    // If the timer is being dispatched, it expires once its callback returns.
+    handle->marked_for_removal_ = true;
+    handle->handler = nullptr;
+    --num_timers_;
+
+    handle = nullptr;
+    return true;
   }
 
   bool TimerHandler::PauseTimer(TimerHandle& handle)
   {
-    if (!handle.Activated() || timer_handler_queue_.empty())
+    if (!handle.Activated() || handle->handler != this)
       return false;
 
     if (handle->state_ != TimerHandler::TIMER_STATE_RUNNING)
       return false;
 
-    for (auto const& h : timer_handler_queue_)
-    {
-      if (h == handle)
-      {
-        handle->state_ = TimerHandler::TIMER_STATE_PAUSED;
+    handle->state_ = TimerHandler::TIMER_STATE_PAUSED;
+    Unschedule(handle);
 
-        if (!is_processing_timers_)
-        {
-          gint64 ms_time_now = g_get_monotonic_time() / 1000;
-
-          if (handle->Type == TIMERTYPE_PERIODIC)
-          {
-            handle->ElapsedTime += (ms_time_now - handle->ms_time);
-            handle->ProgressDelta = float(handle->ElapsedTime) / float(handle->Period);
+    if (!is_processing_timers_)
+    {
+      gint64 ms_time_now = MonotonicTime();
 
-            if (handle->Param + handle->ProgressDelta > 1.0f)
-              handle->ProgressDelta = 1.0f - handle->Param;
+      if (handle->Type == TIMERTYPE_PERIODIC)
+      {
+        handle->ElapsedTime += (ms_time_now - handle->ms_time);
+        handle->ProgressDelta = float(handle->ElapsedTime) / float(handle->Period);
 
-            handle->Param = float(handle->ElapsedTime) / float(handle->Period);
-          }
-        }
+        if (handle->Param + handle->ProgressDelta > 1.0f)
+          handle->ProgressDelta = 1.0f - handle->Param;
 
-        return true;
+        handle->Param = float(handle->ElapsedTime) / float(handle->Period);
       }
     }
 
-    return false;
+    return true;
   }
 
   bool TimerHandler::ResumeTimer(TimerHandle& handle)
   {
-    if (handle.Activated() || timer_handler_queue_.empty())
+    if (!handle.Activated() || handle->handler != this)
       return false;
 
     if (handle->state_ != TimerHandler::TIMER_STATE_PAUSED)
       return false;
 
-    for (auto const& h : timer_handler_queue_)
-    {
-      if (h == handle)
-      {
-        handle->state_ = TimerHandler::TIMER_STATE_RUNNING;
+    handle->state_ = TimerHandler::TIMER_STATE_RUNNING;
 
-        if (handle->Type == TIMERTYPE_PERIODIC)
-        {
-          handle->glibid = GetWindowThread()->AddTimeout(handle->Period * (1.0f - handle->Param));
-        }
-        else
-        {
-          handle->glibid = GetWindowThread()->AddTimeout(handle->Period);
-        }
+    gint64 delay = handle->Period;
 
-        handle->ms_time = g_get_monotonic_time() / 1000;
+    if (handle->Type == TIMERTYPE_PERIODIC)
+      delay = handle->Period * (1.0f - handle->Param);
 
-        if (handle->glibid == 0)
-          early_timer_handlers_.push_back(handle);
+    handle->ms_time = MonotonicTime();
+    Schedule(handle, handle->ms_time + delay);
+    ArmWakeUp();
 
-        return true;
-      }
-    }
+    if (wake_up_id_ == 0)
+      early_timer_handlers_.push_back(handle);
 
-    return false;
+    return true;
   }
 
   int TimerHandler::ExecTimerHandler(unsigned int timer_id)
   {
-    if (timer_handler_queue_.empty())
-      return 0;
+    if (timer_id == wake_up_id_)
+      wake_up_id_ = 0;
 
-    bool repeat = false;
-    is_processing_timers_ = true;
+    // Collect all the timers that are due first, so that the timers that run again are not dispatched twice.
+    gint64 now = MonotonicTime();
+    std::vector<TimerHandle> expired_timers;
 
-    for (auto it = timer_handler_queue_.begin(); it != timer_handler_queue_.end(); ++it)
+    while (!timer_queue_.empty() && timer_queue_.front()->deadline <= now)
     {
-      auto const& timer_object = *it;
-
-      if (timer_object->glibid == timer_id && !timer_object->marked_for_removal_)
-      {
-        if (timer_object->state_ != TIMER_STATE_RUNNING)
-        {
-          return false;
-        }
-        // Find the first timer object that
-
-        timer_object->ElapsedTime += timer_object->Period;
-
-        if (timer_object->Type == TIMERTYPE_PERIODIC)
-        {
-          timer_object->ProgressDelta = float(timer_object->ElapsedTime) / float(timer_object->Period) - timer_object->Param;
-          // Clamp progress delta so(timer_object->Param + timer_object->ProgressDelta) <= 1.0f
-          if (timer_object->Param + timer_object->ProgressDelta > 1.0f)
-            timer_object->ProgressDelta = 1.0f - timer_object->Param;
-
-          timer_object->Param = float(timer_object->ElapsedTime) / float(timer_object->Period);
-        }
-        else if (timer_object->Type == TIMERTYPE_DURATION)
-        {
-          timer_object->ProgressDelta = float(timer_object->ElapsedTime) / float(timer_object->Duration) - timer_object->Param;
-          // Clamp progress delta so(timer_object->Param + timer_object->ProgressDelta) <= 1.0f
-          if (timer_object->Param + timer_object->ProgressDelta > 1.0f)
-            timer_object->ProgressDelta = 1.0f - timer_object->Param;
-
-          if (timer_object->ProgressDelta < 0.0f)
-            timer_object->ProgressDelta = 0.0f;
-
-          timer_object->Param = float(timer_object->ElapsedTime) / float(timer_object->Duration);
-        }
-        else if (timer_object->Type == TIMERTYPE_ITERATION)
-        {
-          timer_object->ProgressIterationCount += 1;
-          int duration = timer_object->Period * timer_object->ScheduledIteration;
-
-          timer_object->ProgressDelta = float(timer_object->ElapsedTime) / float(duration) - timer_object->Param;
-          // Clamp progress delta so(timer_object->Param + timer_object->ProgressDelta) <= 1.0f
-          if (timer_object->Param + timer_object->ProgressDelta > 1.0f)
-            timer_object->ProgressDelta = 1.0f - timer_object->Param;
-
-          timer_object->Param = float(timer_object->ElapsedTime) / float(duration);
-        }
-        else
-        {
-          nuxAssertMsg(0, "[TimerHandler::ExecTimerHandler] Unknown timer type.");
-        }
-
-        if (timer_object->Param > 1.0f)
-        {
-          // correction.
-          timer_object->Param = 1.0f;
-        }
-
-        timer_object->marked_for_removal_ = false;
-
-        if (timer_object->timeout_signal)
-        {
-          // Execute the signal
-          GetWindowThread()->GetWindowCompositor().SetProcessingTopView(timer_object->Window);
-          timer_object->timeout_signal->tick.emit(timer_object->CallbackData);
-          GetWindowThread()->GetWindowCompositor().SetProcessingTopView(NULL);
-          // Reset glibid to 0. glibid is not null, if this element ever happened to be at the head of the queue
-          // and we set a timer for it.
-          //nuxDebugMsg("[TimerHandler::ExecTimerHandler] Executed Timeout ID: %d", timer_object->glibid);
-          //timer_object->glibid = 0;
-        }
-
-        bool expired_handler = false;
-
-        if (timer_object->marked_for_removal_)
-        {
-          // RemoveTimerHandler was called during the callback execution
-          expired_handler = true;
-        }
-        else if (timer_object->Type == TIMERTYPE_PERIODIC)
-        {
-          // A one shot timer expires after the first execution.
-          expired_handler = true;
-        }
-        else if ((timer_object->Type == TIMERTYPE_DURATION) && (timer_object->Param >= 1.0f))
-        {
-          // A timer delay timer expires after the duration of the timer as expired.
-          expired_handler = true;
-        }
-        else if ((timer_object->Type == TIMERTYPE_ITERATION) && (timer_object->ProgressIterationCount >= timer_object->ScheduledIteration))
-        {
-          // An iterative timer expires after the timer as been executedN times.
-          expired_handler = true;
-        }
-
-        if (!expired_handler && (timer_object->state_ == TIMER_STATE_PAUSED))
-        {
-          // The state has been changed to "paused".
-          return false;
-        }
-
-        if (expired_handler)
-        {
-          if (timer_object->timeout_signal)
-          {
-            GetWindowThread()->GetWindowCompositor().SetProcessingTopView(timer_object->Window);
-            timer_object->timeout_signal->expired.emit(timer_object->CallbackData);
-            GetWindowThread()->GetWindowCompositor().SetProcessingTopView(NULL);
-          }
-
-          timer_object->state_ = TIMER_STATE_STOPED;
-          timer_handler_queue_.erase(it);
-        }
-        else
-        {
-          repeat = true;
-        }
-
-        break;
-      }
+      TimerHandle timer_object = timer_queue_.front();
+      Unschedule(timer_object);
+      expired_timers.push_back(timer_object);
     }
 
-    // Purge handles that have been marked for removal
-    for (auto it = timer_handler_queue_.begin(); it != timer_handler_queue_.end();)
-    {
-      auto const& timer_object = *it;
+    is_processing_timers_ = true;
 
-      if (timer_object->marked_for_removal_)
-      {
-        it = timer_handler_queue_.erase(it);
+    for (auto const& timer_object : expired_timers)
+    {
+      // The callback of a previous timer may have removed or paused this one.
+      if (timer_object->handler != this || timer_object->state_ != TIMER_STATE_RUNNING)
         continue;
-      }
 
-      ++it;
+      if (ProcessTimer(timer_object))
+        Schedule(timer_object, now + timer_object->Period);
     }
 
     is_processing_timers_ = false;
-    return repeat;
-  }
 
-  bool TimerHandler::FindTimerHandle(TimerHandle &timer_object)
-  {
-    auto it = std::find(timer_handler_queue_.begin(), timer_handler_queue_.end(), timer_object);
-
-    return (it != timer_handler_queue_.end());
+    ArmWakeUp();
+    return false;
   }
 
-//----------------------------------------------------------------------------
-  int TimerHandler::DelayUntilNextTimerExpires()
+  bool TimerHandler::ProcessTimer(TimerHandle const& timer_object)
   {
-    if (timer_handler_queue_.empty())
-      return 0;
+    timer_object->ElapsedTime += timer_object->Period;
 
-    TimeStruct now;
-    TimeStruct delay;
+    if (timer_object->Type == TIMERTYPE_PERIODIC)
+    {
+      timer_object->ProgressDelta = float(timer_object->ElapsedTime) / float(timer_object->Period) - timer_object->Param;
+      // Clamp progress delta so(timer_object->Param + timer_object->ProgressDelta) <= 1.0f
+      if (timer_object->Param + timer_object->ProgressDelta > 1.0f)
+        timer_object->ProgressDelta = 1.0f - timer_object->Param;
 
-    TimeRightNow(&now);
-    auto const& first = timer_handler_queue_.front();
+      timer_object->Param = float(timer_object->ElapsedTime) / float(timer_object->Period);
+    }
+    else if (timer_object->Type == TIMERTYPE_DURATION)
+    {
+      timer_object->ProgressDelta = float(timer_object->ElapsedTime) / float(timer_object->Duration) - timer_object->Param;
+      // Clamp progress delta so(timer_object->Param + timer_object->ProgressDelta) <= 1.0f
+      if (timer_object->Param + timer_object->ProgressDelta > 1.0f)
+        timer_object->ProgressDelta = 1.0f - timer_object->Param;
 
-    if (TimeIsGreater(now, first->when))
+      if (timer_object->ProgressDelta < 0.0f)
+        timer_object->ProgressDelta = 0.0f;
+
+      timer_object->Param = float(timer_object->ElapsedTime) / float(timer_object->Duration);
+    }
+    else if (timer_object->Type == TIMERTYPE_ITERATION)
     {
-      return 0;
+      timer_object->ProgressIterationCount += 1;
+      int duration = timer_object->Period * timer_object->ScheduledIteration;
+
+      timer_object->ProgressDelta = float(timer_object->ElapsedTime) / float(duration) - timer_object->Param;
+      // Clamp progress delta so(timer_object->Param + timer_object->ProgressDelta) <= 1.0f
+      if (timer_object->Param + timer_object->ProgressDelta > 1.0f)
+        timer_object->ProgressDelta = 1.0f - timer_object->Param;
+
+      timer_object->Param = float(timer_object->ElapsedTime) / float(duration);
     }
     else
     {
-      delay.sec = first->when.sec - now.sec;
-      delay.usec = first->when.usec - now.usec;
+      nuxAssertMsg(0, "[TimerHandler::ProcessTimer] Unknown timer type.");
+    }
 
-      // make sure that usec cannot be less than -1000000 before applying this code
-      if (delay.usec < 0)
-      {
-        delay.usec += 1000000;
-        delay.sec--;
-      }
+    if (timer_object->Param > 1.0f)
+    {
+      // correction.
+      timer_object->Param = 1.0f;
+    }
+
+    timer_object->marked_for_removal_ = false;
 
-      return  (delay.sec * 1000000 + delay.usec) / 1000; // return delay in milliseconds
+    if (timer_object->timeout_signal)
+    {
+      // Execute the signal
+      GetWindowThread()->GetWindowCompositor().SetProcessingTopView(timer_object->Window);
+      timer_object->timeout_signal->tick.emit(timer_object->CallbackData);
+      GetWindowThread()->GetWindowCompositor().SetProcessingTopView(NULL);
     }
-  }
 
-  /*unsigned int TimeDiff( TimeStruct t1, TimeStruct t2)
-  {
-      int sec;
-      int usec;
-      if (t1.sec >= t2.sec)
-      {
-          sec = t1.sec - t2.sec;
-          usec = t1.usec - t2.usec;
-          while ((usec < 0) && (sec > 0))
-          {
-              usec += 1000000;
-              sec -= 1;
-          }
-          if (usec < 0)
-              usec = -usec;
-      }
+    bool expired_handler = false;
 
-      if (t1.sec < t2.sec)
-      {
-          sec = t2.sec - t1.sec;
-          usec = t2.usec - t1.usec;
-          while ((usec < 0) && (sec > 0))
-          {
-              usec += 1000000;
-              sec -= 1;
-          }
-          if (usec < 0)
-              usec = -usec;
-      }
-      return sec*1000 + usec/1000; // time diff is millisecond
-  }*/
+    if (timer_object->marked_for_removal_)
+    {
+      // RemoveTimerHandler was called during the callback execution
+      expired_handler = true;
+    }
+    else if (timer_object->Type == TIMERTYPE_PERIODIC)
+    {
+      // A one shot timer expires after the first execution.
+      expired_handler = true;
+    }
+    else if ((timer_object->Type == TIMERTYPE_DURATION) && (timer_object->Param >= 1.0f))
+    {
+      // A timer delay timer expires after the duration of the timer as expired.
+      expired_handler = true;
+    }
+    else if ((timer_object->Type == TIMERTYPE_ITERATION) && (timer_object->ProgressIterationCount >= timer_object->ScheduledIteration))
+    {
+      // An iterative timer expires after the timer as been executedN times.
+      expired_handler = true;
+    }
 
-  bool TimeIsGreater( TimeStruct t1, TimeStruct t2)
-  {
-    if ((t1.sec > t2.sec) || ((t1.sec == t2.sec) && (t1.usec > t2.usec)))
-      return true;
+    if (!expired_handler)
+    {
+      // The timer runs again, unless its state has been changed to "paused".
+      return timer_object->state_ == TIMER_STATE_RUNNING;
+    }
 
-    if ((t1.sec == t2.sec) && (t1.usec == t2.usec))
-      return true;
+    if (timer_object->timeout_signal)
+    {
+      GetWindowThread()->GetWindowCompositor().SetProcessingTopView(timer_object->Window);
+      timer_object->timeout_signal->expired.emit(timer_object->CallbackData);
+      GetWindowThread()->GetWindowCompositor().SetProcessingTopView(NULL);
+    }
+
+    timer_object->state_ = TIMER_STATE_STOPED;
+
+    if (timer_object->handler == this)
+    {
+      timer_object->handler = nullptr;
+      --num_timers_;
+    }
 
     return false;
   }
 
-  void TimeRightNow(TimeStruct *tv)
-  {
-#if defined(NUX_OS_WINDOWS)
-    struct _timeb timebuffer;
-    // Time in seconds since midnight(00:00:00), January 1, 1970, coordinated universal time(UTC).
-    _ftime(&timebuffer);
-    tv->sec = timebuffer.time;
-    tv->usec = timebuffer.millitm * 1000;
-#elif defined(NUX_OS_LINUX)
-    timeval unix_timeval;
-    gettimeofday(&unix_timeval, NULL);
-    tv->sec = unix_timeval.tv_sec;
-    tv->usec = unix_timeval.tv_usec;
-#else
-#error TimeRightNow is not implemented for this platform.
-#endif
+  bool TimerHandler::FindTimerHandle(TimerHandle &timer_object)
+  {
+    return timer_object.Activated() && timer_object->handler == this;
+  }
+
+//----------------------------------------------------------------------------
+  int TimerHandler::DelayUntilNextTimerExpires()
+  {
+    if (timer_queue_.empty())
+      return 0;
+
+    gint64 delay = timer_queue_.front()->deadline + slack_ - MonotonicTime();
+
+    return std::max<gint64>(delay, 0);
   }
 
 }
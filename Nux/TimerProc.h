@@ -68,6 +68,12 @@ namespace nux
   };
 
   //! A timer manager class created by WindowThread.
+  /*!
+      The running timers are kept in a min-heap ordered by their deadline on the monotonic clock. A single
+      main loop timeout is armed for the earliest deadline, and every timer that is due when it fires is
+      dispatched in the same batch. With a non zero slack, the wake up is delayed by up to the slack so that
+      timers that expire close to each other are dispatched together.
+  */
   class TimerHandler
   {
   public:
@@ -161,12 +167,28 @@ namespace nux
 
     //! Return the delay until the next timer expires.
     /*!
+      The delay includes the timer slack.
+
       @return Delay to next timer expiration in milliseconds.
     */
     int DelayUntilNextTimerExpires();
 
+    //! Dispatch the timers that are due.
+    /*!
+      Called by the main loop when the timeout armed by this object fires.
+
+      @param timer_id The main loop identifier of the timeout.
+      @return Always false: a new timeout is armed for the next deadline if needed.
+    */
     int ExecTimerHandler (unsigned int timer_id);
 
+    //! Set how long the expiration of a timer may be delayed to dispatch it along with other timers.
+    /*!
+      @param milliseconds The slack. 0, the default, wakes up the main loop at the exact deadline of each timer.
+    */
+    void SetTimerSlack(unsigned int milliseconds);
+    unsigned int GetTimerSlack() const;
+
     //! Start the timers that were sett before the system was fully initialized.
     void StartEarlyTimerObjects();
 
@@ -183,8 +205,30 @@ namespace nux
     void AddHandle(TimerHandle const&);
     unsigned int GetNumPendingHandler();
 
-    std::deque<TimerHandle> timer_handler_queue_;
+    //! Put a timer in the heap of running timers.
+    void Schedule(TimerHandle const& timer_handle, gint64 deadline);
+    //! Take a timer out of the heap of running timers, if it is in it.
+    void Unschedule(TimerHandle const& timer_handle);
+    void SiftUp(std::size_t index);
+    void SiftDown(std::size_t index);
+    void SwapTimers(std::size_t a, std::size_t b);
+
+    //! Update the progress of a timer that expired and emit its signals.
+    /*!
+        @return True if the timer has to run again.
+    */
+    bool ProcessTimer(TimerHandle const& timer_handle);
+
+    //! Make sure the main loop wakes up for the earliest deadline.
+    void ArmWakeUp();
+
+    std::vector<TimerHandle> timer_queue_;          //!< Min-heap of the running timers, ordered by deadline.
+    unsigned int num_timers_;                       //!< Number of running and paused timers.
     std::list<TimerHandle> early_timer_handlers_;  //!< timer objects that couldn't be started because the main loop is not runing yet.
+
+    unsigned int wake_up_id_;                       //!< Main loop timeout armed for wake_up_time_, or 0.
+    gint64 wake_up_time_;
+    unsigned int slack_;
   };
 
 }
@@ -368,7 +368,7 @@ namespace nux
         if (((*it)->IsLayout() || (*it)->IsView()) /*&& ((*it)->IsLayoutDone() == false)*/ /*&& ((*it)->GetScaleFactor() != 0)*/)
         {
           Geometry pre_geo = (*it)->GetGeometry();
-          ret = (*it)->ComputeContentSize();
+          ret = ComputeChildContentSize(*it);
           Geometry post_geo = (*it)->GetGeometry();
 
           bool larger_width    = pre_geo.width < post_geo.width;
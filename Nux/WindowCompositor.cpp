@@ -46,6 +46,8 @@ DECLARE_LOGGER(logger, "nux.window");
   , window_thread_(window_thread)
   , currently_rendering_windows_(nullptr)
   , current_global_clip_rect_(nullptr)
+  , present_whole_window_(true)
+  , previous_frame_had_overlay_(false)
   {
     m_OverlayWindow             = NULL;
     _tooltip_window             = NULL;
@@ -65,6 +67,7 @@ DECLARE_LOGGER(logger, "nux.window");
     _mouse_position_on_owner = Point(0, 0);
 
     platform_support_for_depth_texture_ = GetGraphicsDisplay()->GetGpuDevice()->GetGpuInfo().Support_Depth_Buffer();
+    partial_redraw_enabled_ = (g_getenv("NUX_DISABLE_PARTIAL_REDRAW") == NULL);
 
     m_FrameBufferObject = GetGraphicsDisplay()->GetGpuDevice()->CreateFrameBufferObject();
     // Do not leave the Fbo binded. Deactivate it.
@@ -92,6 +95,9 @@ DECLARE_LOGGER(logger, "nux.window");
 #ifdef NUX_GESTURES_SUPPORT
     gesture_broker_.reset(new DefaultGestureBroker(this));
 #endif
+
+    readback_timer_functor_ = new TimerFunctor();
+    readback_timer_functor_->tick.connect(sigc::mem_fun(this, &WindowCompositor::OnReadbackTimer));
   }
 
   void WindowCompositor::BeforeDestructor()
@@ -101,6 +107,10 @@ DECLARE_LOGGER(logger, "nux.window");
 
   WindowCompositor::~WindowCompositor()
   {
+    window_thread_->GetTimerHandler().RemoveTimerHandler(readback_timer_handle_);
+    delete readback_timer_functor_;
+    texture_readback_.reset();
+
     _window_to_texture_map.clear();
     m_FrameBufferObject.Release();
     m_MainColorRT.Release();
@@ -1397,6 +1407,9 @@ DECLARE_LOGGER(logger, "nux.window");
 
   void WindowCompositor::Draw(bool SizeConfigurationEvent, bool force_draw)
   {
+    if (texture_readback_)
+      texture_readback_->Poll();
+
     inside_rendering_cycle_ = true;
     if (!window_thread_->GetGraphicsDisplay().isWindowMinimized())
     {
@@ -1410,6 +1423,7 @@ DECLARE_LOGGER(logger, "nux.window");
       window_thread_->GetGraphicsEngine().ResetModelViewMatrixStack();
       window_thread_->GetGraphicsEngine().Push2DTranslationModelViewMatrix(0.0f, 0.0f, 0.0f);
 
+      ComputePresentationRegion(force_draw || SizeConfigurationEvent);
 
       if (force_draw || SizeConfigurationEvent)
       {
@@ -1544,6 +1558,92 @@ DECLARE_LOGGER(logger, "nux.window");
     //GetGraphicsDisplay()->GetGraphicsEngine()->SetContext(0, 0, buffer_width, buffer_height);
   }
 
+  void WindowCompositor::ComputePresentationRegion(bool force_draw)
+  {
+    if (window_thread_->IsEmbeddedWindow())
+    {
+      // The host compositor decides which areas of the screen are repainted.
+      present_whole_window_ = true;
+      return;
+    }
+
+    Geometry window_geo(0, 0, m_Width, m_Height);
+
+    view_damage_ = window_thread_->TakeDamageRegion();
+    view_damage_.Clip(window_geo);
+
+    // Menus, tooltips and overlays are drawn directly to the back buffer.
+    bool has_overlay = !m_TooltipText.empty() || OverlayDrawingCommand;
+#if !defined(NUX_MINIMAL)
+    has_overlay = has_overlay || !_menu_chain->empty();
+#endif
+
+    // The top views are presented over the main window in every frame. The main window has to be
+    // presented where they are, as well as where they were in the previous frame.
+    DamageRegion top_views_region;
+
+    for (auto const& window_list : {&_view_window_list, &_modal_view_window_list})
+    {
+      for (auto const& window : *window_list)
+      {
+        if (window.IsValid() && window->IsVisible())
+          top_views_region.Add(window->GetGeometry());
+      }
+    }
+
+    DamageRegion frame_damage = view_damage_;
+    frame_damage.Add(top_views_region);
+    frame_damage.Add(previous_top_views_region_);
+    frame_damage.Clip(window_geo);
+    previous_top_views_region_ = top_views_region;
+
+    int buffer_age = window_thread_->GetGraphicsDisplay().GetBufferAge();
+
+    // An age of 0 means that the content of the back buffer is undefined. The damage of the frames
+    // presented since the back buffer was last used has to be known to repair it.
+    present_whole_window_ = force_draw ||
+      !partial_redraw_enabled_ ||
+      m_MenuRemoved ||
+      has_overlay ||
+      previous_frame_had_overlay_ ||
+      (buffer_age == 0) ||
+      (buffer_age > (int) damage_history_.size() + 1);
+
+    previous_frame_had_overlay_ = has_overlay;
+
+    if (present_whole_window_)
+    {
+      frame_damage.Clear();
+      frame_damage.Add(window_geo);
+    }
+
+    unswapped_damage_.Add(frame_damage);
+    presentation_region_ = frame_damage;
+
+    if (!present_whole_window_)
+    {
+      for (int i = 0; i < buffer_age - 1; ++i)
+        presentation_region_.Add(damage_history_[i]);
+    }
+  }
+
+  void WindowCompositor::OnBufferSwapped()
+  {
+    damage_history_.push_front(unswapped_damage_);
+    unswapped_damage_.Clear();
+
+    if (damage_history_.size() > (size_t) MAX_DAMAGE_HISTORY)
+      damage_history_.pop_back();
+  }
+
+  int WindowCompositor::GetLastPresentedArea() const
+  {
+    if (present_whole_window_)
+      return m_Width * m_Height;
+
+    return presentation_region_.GetArea();
+  }
+
   void WindowCompositor::RenderTopViewContent(BaseWindow* window, bool force_draw)
   {
     GetPainter().EmptyBackgroundStack();
@@ -1801,8 +1901,15 @@ DECLARE_LOGGER(logger, "nux.window");
           GetPainter().PushLayer(window_thread_->GetGraphicsEngine(), Geometry(0, 0, buffer_width, buffer_height), m_Background);
           //GetPainter().PushBackground(window_thread_->GetGraphicsEngine(), Geometry(0, 0, buffer_width, buffer_height), m_Background, false);
 
+          // Only the views that requested a draw are rendered. Keep them from drawing outside of the damaged areas.
+          if (partial_redraw_enabled_)
+            window_thread_->GetGraphicsEngine().PushClippingRectangle(view_damage_.GetBounds());
+
           window_thread_->ProcessDraw(window_thread_->GetGraphicsEngine(), false);
 
+          if (partial_redraw_enabled_)
+            window_thread_->GetGraphicsEngine().PopClippingRectangle();
+
           nuxAssert(window_thread_->GetGraphicsEngine().GetNumberOfClippingRegions() == 0);
           GetPainter().PopBackground();
           GetPainter().EmptyBackgroundStack();
@@ -1822,8 +1929,20 @@ DECLARE_LOGGER(logger, "nux.window");
     window_thread_->GetGraphicsEngine().SetViewport(0, 0, window_width, window_height);
     window_thread_->GetGraphicsEngine().SetOrthographicProjectionMatrix(window_width, window_height);
 
-    PresentBufferToScreen(m_MainColorRT, 0, 0, false);
-
+    if (present_whole_window_)
+    {
+      PresentBufferToScreen(m_MainColorRT, 0, 0, false);
+    }
+    else
+    {
+      // The rest of the back buffer already holds the content of the main window.
+      for (auto const& rect : presentation_region_.GetRects())
+      {
+        window_thread_->GetGraphicsEngine().SetGlobalClippingRectangle(rect);
+        PresentBufferToScreen(m_MainColorRT, 0, 0, false);
+      }
+      window_thread_->GetGraphicsEngine().DisableGlobalClippingRectangle();
+    }
   }
 
   void WindowCompositor::PresentBufferToScreen(ObjectPtr<IOpenGLBaseTexture> HWTexture, int x, int y, bool RenderToMainTexture, bool /* BluredBackground */, float opacity, bool premultiply)
@@ -2298,6 +2417,39 @@ DECLARE_LOGGER(logger, "nux.window");
     return (*it).second.color_rt->GetSurfaceData(0, width, height, format);
   }
 
+  bool WindowCompositor::GetBackupTextureDataAsync(BaseWindow* base_window, TextureReadback::Callback const& callback)
+  {
+    NUX_RETURN_VALUE_IF_NULL(base_window, false);
+
+    std::map<BaseWindow*, struct RenderTargetTextures>::iterator it = _window_to_texture_map.find(base_window);
+
+    if (it == _window_to_texture_map.end() || (*it).second.color_rt.IsNull())
+    {
+      return false;
+    }
+
+    if (!texture_readback_)
+      texture_readback_.reset(new TextureReadback());
+
+    if (!texture_readback_->Read((*it).second.color_rt, 0, callback))
+      return false;
+
+    // The reads are polled at each rendering cycle, and by a timer in between.
+    if (!readback_timer_handle_.Activated())
+      readback_timer_handle_ = window_thread_->GetTimerHandler().AddOneShotTimer(READBACK_POLL_PERIOD, readback_timer_functor_, this);
+
+    return true;
+  }
+
+  void WindowCompositor::OnReadbackTimer(void* /* data */)
+  {
+    window_thread_->GetTimerHandler().RemoveTimerHandler(readback_timer_handle_);
+    texture_readback_->Poll();
+
+    if (texture_readback_->GetPendingReadCount())
+      readback_timer_handle_ = window_thread_->GetTimerHandler().AddOneShotTimer(READBACK_POLL_PERIOD, readback_timer_functor_, this);
+  }
+
 
   void WindowCompositor::ResetDnDArea()
   {
@@ -23,14 +23,18 @@
 #ifndef WINDOWCOMPOSITOR_H
 #define WINDOWCOMPOSITOR_H
 
+#include <deque>
 #include <functional>
 
 #include "BaseWindow.h"
+#include "DamageRegion.h"
+#include "TimerProc.h"
 
 #include <sigc++/trackable.h>
 #include <sigc++/connection.h>
 
 #include <NuxCore/ObjectPtr.h>
+#include "NuxGraphics/TextureReadback.h"
 
 #ifdef NUX_GESTURES_SUPPORT
 #include <unordered_map>
@@ -298,6 +302,13 @@ namespace nux
 
     void SetBackgroundPaintLayer(AbstractPaintLayer* bkg);
 
+    //! Return the number of pixels of the main window texture presented to the back buffer in the last frame.
+    /*!
+        Only the areas damaged since the back buffer was last presented are repainted when the back buffer age
+        is known. Otherwise the whole window is presented.
+    */
+    int GetLastPresentedArea() const;
+
     /*!
         A special BaseWindow that is always on top of all other BaseWindow. It is even above the BaseWindow that is selected.
     */
@@ -312,6 +323,15 @@ namespace nux
     //! Get the backup texture data of this BaseWindow,
     void* GetBackupTextureData(BaseWindow* base_window, int& width, int& height, int& format);
 
+    //! Read the backup texture of this BaseWindow without stalling the rendering.
+    /*!
+        The copy is polled from a one-shot timer of the WindowThread every 16 ms, and the callback is called from
+        that timer once the GPU has copied the texture. No redraw is queued for it.
+
+        @return False if the BaseWindow has no backup texture. The callback is not called then.
+    */
+    bool GetBackupTextureDataAsync(BaseWindow* base_window, TextureReadback::Callback const& callback);
+
     //! Reset the DND focus area
     /*!
         Set the DND focus area to NULL.
@@ -581,9 +601,42 @@ namespace nux
     std::unique_ptr<GestureBroker> gesture_broker_;
 #endif
 
+    //! Created by the first asynchronous read of a backup texture.
+    std::unique_ptr<TextureReadback> texture_readback_;
+    TimerFunctor* readback_timer_functor_;
+    TimerHandle readback_timer_handle_;
+    //! Period in milliseconds of the polling of the asynchronous reads.
+    static const int READBACK_POLL_PERIOD = 16;
+    void OnReadbackTimer(void* data);
+
     WindowList* currently_rendering_windows_;
     Geometry* current_global_clip_rect_;
 
+    //! Compute the areas of the back buffer that are presented in the current frame.
+    void ComputePresentationRegion(bool force_draw);
+    //! Called by the WindowThread after the back buffer has been swapped.
+    void OnBufferSwapped();
+
+    //! Maximum number of swapped frames whose damage is kept to repair older back buffers.
+    static const int MAX_DAMAGE_HISTORY = 4;
+
+    //! False if the NUX_DISABLE_PARTIAL_REDRAW environment variable is set.
+    bool partial_redraw_enabled_;
+    //! True if the whole main window is presented in the current frame.
+    bool present_whole_window_;
+    //! Areas of the main window that are redrawn by the views in the current frame.
+    DamageRegion view_damage_;
+    //! Areas of the back buffer that are presented in the current frame.
+    DamageRegion presentation_region_;
+    //! Damage of the frames rendered since the back buffer was last swapped.
+    DamageRegion unswapped_damage_;
+    //! Damage of the last swapped frames, the most recent first.
+    std::deque<DamageRegion> damage_history_;
+    //! Areas covered by the top views in the previous frame.
+    DamageRegion previous_top_views_region_;
+    //! True if a menu, a tooltip or an overlay was drawn directly to the back buffer in the previous frame.
+    bool previous_frame_had_overlay_;
+
     //! Perform some action before destruction.
     /*!
         Perform some action before destruction. This function should only be 
@@ -28,6 +28,7 @@
 #include "ClientArea.h"
 #include "WindowCompositor.h"
 #include "TimerProc.h"
+#include "ImageLoader.h"
 #include "SystemThread.h"
 #include "FloatingWindow.h"
 
@@ -109,6 +110,8 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
     _inside_timer_loop = false;
     async_wake_up_signal_ = new TimerFunctor();
     async_wake_up_signal_->tick.connect(sigc::mem_fun(this, &WindowThread::AsyncWakeUpCallback));
+    shader_warm_up_signal_ = new TimerFunctor();
+    shader_warm_up_signal_->tick.connect(sigc::mem_fun(this, &WindowThread::ShaderWarmUpCallback));
   }
 
   WindowThread::~WindowThread()
@@ -127,6 +130,7 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
 #endif
 
     delete async_wake_up_signal_;
+    delete shader_warm_up_signal_;
 
 #if defined(USE_X11)
     if (x11display_ && ownx11display_)
@@ -146,6 +150,11 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
     return AddGLibTimeout(timeout_delay);
   }
 
+  void WindowThread::RemoveTimeout(unsigned int timeout_id)
+  {
+    RemoveGLibTimeout(timeout_id);
+  }
+
   TimerHandle WindowThread::SetAsyncTimerCallback(int time_ms, TimeOutSignal* timeout_signal, void *user_data)
   {
     if (timeout_signal == NULL)
@@ -163,6 +172,15 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
     _pending_wake_up_timer = false;
   }
 
+  void WindowThread::ShaderWarmUpCallback(void* /* data */)
+  {
+    this->GetTimerHandler().RemoveTimerHandler(shader_warm_up_timer_handle_);
+
+    // Spread the compilation over several iterations of the main loop.
+    if (GetGraphicsEngine().WarmUpShaderPrograms(SHADER_WARM_UP_PROGRAMS) > 0)
+      shader_warm_up_timer_handle_ = this->GetTimerHandler().AddOneShotTimer(SHADER_WARM_UP_PERIOD, shader_warm_up_signal_, this);
+  }
+
   void WindowThread::ProcessDraw(GraphicsEngine &graphics_engine, bool force_draw)
   {
     if (main_layout_)
@@ -266,12 +284,14 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
   {
     NUX_RETURN_VALUE_IF_NULL(area, false);
 
-    std::list<Area *>::iterator it;
-    it = find(_queued_layout_list.begin(), _queued_layout_list.end(), area);
-    if (it == _queued_layout_list.end())
-    {
-      _queued_layout_list.push_back(area);
-    }
+    area->InvalidateContentSize();
+
+    if (area->layout_queued_)
+      return true;
+
+    area->layout_queued_ = true;
+    queued_layout_areas_.insert(area);
+    pending_layout_areas_.push_back(area);
 
     return true;
   }
@@ -280,49 +300,89 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
   {
     NUX_RETURN_VALUE_IF_NULL(area, false);
 
-    std::list<Area *>::iterator it;
-    it = find(_queued_layout_list.begin(), _queued_layout_list.end(), area);
+    if (!area->layout_queued_)
+      return false;
 
-    if (it != _queued_layout_list.end())
-    {
-      _queued_layout_list.erase(it);
-      return true;
-    }
-    return false;
+    area->layout_queued_ = false;
+    queued_layout_areas_.erase(area);
+    // The area may still be in pending_layout_areas_. ComputeQueuedLayout skips the areas that
+    // are no longer in queued_layout_areas_.
+    return true;
   }
 
   void WindowThread::RemoveQueuedLayout()
   {
-    _queued_layout_list.clear();
+    for (auto area : queued_layout_areas_)
+      area->layout_queued_ = false;
+
+    queued_layout_areas_.clear();
+    pending_layout_areas_.clear();
   }
 
   void WindowThread::ComputeQueuedLayout()
   {
     StartLayoutCycle();
-    std::list<Area *>::iterator it;
 
-    for (it = _queued_layout_list.begin(); it != _queued_layout_list.end(); ++it)
+    std::vector<std::pair<int, Area *> > areas;
+    std::unordered_set<Area *> pass_areas;
+
+    // Areas queued while a pass is being processed are handled by the next pass.
+    while (!pending_layout_areas_.empty())
     {
-      Area *area = *it;
+      areas.clear();
+      pass_areas.clear();
 
-      if (area->Type().IsDerivedFromType(View::StaticObjectType))
+      for (auto area : pending_layout_areas_)
       {
-        View *view  = NUX_STATIC_CAST(View *, area);
+        if (queued_layout_areas_.find(area) == queued_layout_areas_.end())
+          continue;
 
-        if (!view->CanBreakLayout())
-          view->QueueDraw();
-      }
-      else if (area->Type().IsDerivedFromType(Layout::StaticObjectType))
-      {
-        Layout *layout = NUX_STATIC_CAST(Layout *, area);
-        layout->QueueDraw();
+        if (!area->Type().IsDerivedFromType(View::StaticObjectType) &&
+            !area->Type().IsDerivedFromType(Layout::StaticObjectType))
+          continue;
+
+        int depth = 0;
+        for (Area *parent = area->GetParentObject(); parent; parent = parent->GetParentObject())
+          ++depth;
+
+        areas.push_back(std::make_pair(depth, area));
+        pass_areas.insert(area);
       }
-      else
+      pending_layout_areas_.clear();
+
+      std::stable_sort(areas.begin(), areas.end(),
+                       [] (std::pair<int, Area *> const& a, std::pair<int, Area *> const& b) { return a.first < b.first; });
+
+      for (auto const& entry : areas)
       {
-        continue;
-      }
+        Area *area = entry.second;
+
+        // The area may have been destroyed by the size computation of a previous one.
+        if (queued_layout_areas_.find(area) == queued_layout_areas_.end())
+          continue;
+
+        bool ancestor_queued = false;
+        for (Area *parent = area->GetParentObject(); parent && !ancestor_queued; parent = parent->GetParentObject())
+          ancestor_queued = parent->layout_queued_ && (pass_areas.find(parent) != pass_areas.end());
+
+        if (ancestor_queued)
+          continue;
 
-      (*it)->ComputeContentSize();
+        if (area->Type().IsDerivedFromType(View::StaticObjectType))
+        {
+          View *view  = NUX_STATIC_CAST(View *, area);
+
+          if (!view->CanBreakLayout())
+            view->QueueDraw();
+        }
+        else
+        {
+          Layout *layout = NUX_STATIC_CAST(Layout *, area);
+          layout->QueueDraw();
+        }
+
+        area->ComputeContentSize();
+      }
     }
 
     StopLayoutCycle();
@@ -372,6 +432,7 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
       layout->QueueDraw();
     }
 
+    area->InvalidateContentSize();
     area->ComputeContentSize();
 
     if (!alreadyComputingLayout)
@@ -710,6 +771,7 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
         {
           // Something was rendered! Swap the rendering buffer!
           graphics_display_->SwapBuffer(true);
+          window_compositor_->OnBufferSwapped();
         }
 
         ClearRedrawFlag();
@@ -1039,6 +1101,11 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
 
     xim_controller_ = std::make_shared<XIMController>(graphics_display_->GetX11Display());
 
+    // The window owns its OpenGL context, the programs can be compiled from the main loop. Embedded windows
+    // only draw when the host gives them its context.
+    if (g_getenv("NUX_DISABLE_SHADER_WARM_UP") == NULL)
+      shader_warm_up_timer_handle_ = timer_manager_->AddOneShotTimer(0, shader_warm_up_signal_, this);
+
     SetThreadState(THREADRUNNING);
     thread_ctor_called_ = true;
     return true;
@@ -1091,6 +1158,9 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
     timer_manager_ = new TimerHandler(this);
     window_compositor_ = new WindowCompositor(this);
 
+    // The application shares the OpenGL context: the bindings are only tracked in RenderInterfaceFromForeignCmd.
+    graphics_display_->GetGpuDevice()->GetRenderStates().SetBindingTracking(false);
+
     SetThreadState(THREADRUNNING);
     thread_ctor_called_ = true;
 
@@ -1157,6 +1227,9 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
 
     xim_controller_ = std::make_shared<XIMController>(graphics_display_->GetX11Display());
 
+    // The compositor shares the OpenGL context: the bindings are only tracked in RenderInterfaceFromForeignCmd.
+    graphics_display_->GetGpuDevice()->GetRenderStates().SetBindingTracking(false);
+
     SetThreadState(THREADRUNNING);
     thread_ctor_called_ = true;
 
@@ -1189,6 +1262,10 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
       main_layout_->UnReference();
     }
 
+    // The views destroyed with the layout cancel their loads first. The loader unwatches its pipe and removes
+    // its timer, so it goes before the timer manager.
+    image_loader_.reset();
+
     NUX_SAFE_DELETE(window_compositor_);
     NUX_SAFE_DELETE(timer_manager_);
     NUX_SAFE_DELETE(painter_);
@@ -1273,6 +1350,12 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
     }
 
     dirty_areas_.push_back(geo);
+
+    if (!IsEmbeddedWindow())
+    {
+      damage_region_.Add(geo);
+      damaged_views_.push_back(ObjectWeakPtr<View>(view));
+    }
   }
 
   void WindowThread::ClearDrawList()
@@ -1285,6 +1368,21 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
     return dirty_areas_;
   }
 
+  DamageRegion WindowThread::TakeDamageRegion()
+  {
+    DamageRegion damage;
+    std::swap(damage, damage_region_);
+
+    for (auto const& view : damaged_views_)
+    {
+      if (view.IsValid())
+        damage.Add(view->GetAbsoluteGeometry());
+    }
+
+    damaged_views_.clear();
+    return damage;
+  }
+
   bool WindowThread::AddToPresentationList(BaseWindow* bw, bool force)
   {
     if (!bw)
@@ -1484,6 +1582,7 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
       return;
 
     IOpenGLShaderProgram::SetShaderTracking(true);
+    GetWindowThread()->GetGraphicsEngine().GetRenderStates().SetBindingTracking(true);
 
     // Set Nux opengl states. The other plugin in compiz have changed the GPU opengl states.
     // Nux keep tracks of its own opengl states and restore them before doing any drawing.
@@ -1508,9 +1607,14 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
       force_rendering_ = false;
     }
 
+    // The quads still queued must be drawn before the compositor takes the OpenGL context back.
+    GetWindowThread()->GetGraphicsEngine().FlushQuadBatch();
+
     CHECKGL( glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
 
     IOpenGLShaderProgram::SetShaderTracking(false);
+    // The compositor changes the bindings behind Nux until the next frame.
+    GetWindowThread()->GetGraphicsEngine().GetRenderStates().SetBindingTracking(false);
   }
 
   void WindowThread::ForeignFrameEnded()
@@ -1704,6 +1808,19 @@ DECLARE_LOGGER(logger, "nux.windows.thread");
     return *timer_manager_;
   }
 
+  ImageLoader& WindowThread::GetImageLoader()
+  {
+    if (!image_loader_)
+      image_loader_.reset(new ImageLoader(this));
+
+    return *image_loader_;
+  }
+
+  bool WindowThread::HasImageLoader() const
+  {
+    return image_loader_ != nullptr;
+  }
+
   UXTheme& WindowThread::GetTheme() const
   {
     if (!theme_)
@@ -23,7 +23,10 @@
 #ifndef WINDOWTHREAD_H
 #define WINDOWTHREAD_H
 
+#include <unordered_set>
+
 #include "TimerProc.h"
+#include "DamageRegion.h"
 
 #ifdef NUX_GESTURES_SUPPORT
 #include "GeisAdapter.h"
@@ -47,6 +50,7 @@ namespace nux
   class SystemThread;
   class UXTheme;
   class TimerHandler;
+  class ImageLoader;
 #if !defined(NUX_MINIMAL)
   class Timeline;
 #endif
@@ -144,6 +148,17 @@ namespace nux
     */
     TimerHandler &GetTimerHandler() const;
 
+    /*!
+        Get the loader of image files. It is created on the first call.
+        @return The image loader of this thread.
+    */
+    ImageLoader &GetImageLoader();
+
+    /*!
+        @return True if the image loader has been created and not destroyed yet.
+    */
+    bool HasImageLoader() const;
+
     /*!
         Get the UI resource manager (load textures and other data for user interface rendering).
         @param The ui resource manager.
@@ -194,7 +209,7 @@ namespace nux
     //! Remove an area from the list of object whose size was scheduled to be computed before the rendering cycle.
     /*!
         @param area The object to remove form the list.
-        @return True if the object was in the _queued_layout_list and has been removed.
+        @return True if the object was in the layout queue and has been removed.
         \sa ComputeQueuedLayout, QueueObjectLayout.
     */
     bool RemoveObjectFromLayoutQueue(Area *area);
@@ -352,6 +367,14 @@ namespace nux
 
     std::vector<Geometry> const& GetDrawList() const;
 
+    //! Return the areas of the window that have changed since the last call and reset them.
+    /*!
+        The region contains the geometries the views had when they were added to the draw list, as
+        well as their current geometries, as a view may be moved or resized after requesting a draw.
+        The damage isn't tracked in embedded mode.
+    */
+    DamageRegion TakeDamageRegion();
+
     // PresentationList - this is a maintained list of areas that
     // will be presented to the reference framebuffer or backbuffer
     // in embedded mode on the next frame
@@ -539,6 +562,19 @@ namespace nux
     TimeOutSignal *async_wake_up_signal_;
     TimerHandle async_wake_up_timer_handle_;
 
+    //! Compile a few shader programs of the GraphicsEngine, until they are all compiled.
+    /*!
+        Started by ThreadCtor, so that the programs are ready before the QRP functions need them. It can be
+        turned off by setting the NUX_DISABLE_SHADER_WARM_UP environment variable.
+    */
+    void ShaderWarmUpCallback(void *user_ptr);
+
+    TimeOutSignal *shader_warm_up_signal_;
+    TimerHandle shader_warm_up_timer_handle_;
+
+    static const int SHADER_WARM_UP_PERIOD = 10;
+    static const int SHADER_WARM_UP_PROGRAMS = 2;
+
     //! Informs the system of the start of a layout cycle.
     /*!
         This call merely sets a flag to true or false. This flag is used to decided if some actions should be 
@@ -557,6 +593,8 @@ namespace nux
     /*
         The objects whose size is to be computed are added to a list with a call to QueueObjectLayout.
         Size computation is performed just before the rendering cycle.
+        The queued objects are processed from the top of the hierarchy down. An object is skipped if one of
+        its ancestors is processed in the same pass, as the size computation of the ancestor covers it.
         \sa QueueObjectLayout
     */
     void ComputeQueuedLayout();
@@ -573,13 +611,19 @@ namespace nux
     bool _inside_timer_loop;
     bool _pending_wake_up_timer;
 
-    //! This list contains the layout that need to be recomputed following the resizing of one of the sub element.
+    //! The areas that need to be recomputed following the resizing of one of their sub element.
     /*!
-        This list contains the layout that need to be recomputed following the resizing of one of the sub element.
+        An area stays in the set until the end of the layout cycle, with its Area::layout_queued_ flag set.
+        Queuing it again during the cycle has no effect.
     */
-    std::list<Area *> _queued_layout_list;
+    std::unordered_set<Area *> queued_layout_areas_;
+    //! The queued areas that have not been processed yet by the current layout cycle.
+    std::vector<Area *> pending_layout_areas_;
     std::vector<Geometry> dirty_areas_;
 
+    DamageRegion damage_region_;
+    std::vector<ObjectWeakPtr<View> > damaged_views_;
+
     typedef nux::ObjectWeakPtr<nux::BaseWindow> WeakBaseWindowPtr;
 
     std::vector<WeakBaseWindowPtr> presentation_list_embedded_;
@@ -701,11 +745,14 @@ namespace nux
     static gboolean ExternalSourceCallback(gpointer user_data);
 
     unsigned int AddGLibTimeout(unsigned int duration);
+    void RemoveGLibTimeout(unsigned int id);
 
 #ifdef NUX_GESTURES_SUPPORT
     std::unique_ptr<GeisAdapter> geis_adapter_;
 #endif
 
+    std::unique_ptr<ImageLoader> image_loader_;
+
 #if defined(NUX_OS_LINUX) && defined(USE_X11)
     std::shared_ptr<XIMController> xim_controller_;
 #endif
@@ -719,12 +766,21 @@ namespace nux
     */
     unsigned int AddTimeout(unsigned int timeout_delay);
 
+    /*!
+        Remove a timeout added with AddTimeout before it fires.
+        This function is used internally by Nux.
+
+        @param timeout_id The index returned by AddTimeout.
+    */
+    void RemoveTimeout(unsigned int timeout_id);
+
     static const int MINIMUM_WINDOW_WIDTH;  //!< Minimum width allowed for a window.
     static const int MINIMUM_WINDOW_HEIGHT; //!< Minimum height allowed for a window.
 
     friend class TimerHandler;
     friend class BasePainter;
     friend class SystemThread;
+    friend class TestWindowThreadLayoutQueue;
 
     friend WindowThread *CreateGUIThread(const char *WindowTitle,
                                           int width,
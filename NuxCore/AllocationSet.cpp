@@ -0,0 +1,197 @@
+// -*- Mode: C++; indent-tabs-mode: nil; tab-width: 2 -*-
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include "NuxCore.h"
+#include "AllocationSet.h"
+
+namespace nux
+{
+namespace
+{
+  const std::size_t MIN_CAPACITY = 16;
+}
+
+  const int AllocationSet::SHARD_BITS;
+  const int AllocationSet::SHARD_COUNT;
+
+  AllocationSet::Shard::Shard()
+    : size(0)
+  {}
+
+  std::size_t AllocationSet::Shard::Find(std::size_t hash, std::size_t key) const
+  {
+    std::size_t mask = slots.size() - 1;
+    std::size_t index = hash & mask;
+
+    while (slots[index] != key && slots[index] != 0)
+      index = (index + 1) & mask;
+
+    return index;
+  }
+
+  void AllocationSet::Shard::Rehash(std::size_t capacity)
+  {
+    std::vector<std::size_t> old_slots(capacity, 0);
+    old_slots.swap(slots);
+
+    for (std::size_t key : old_slots)
+    {
+      if (key)
+        slots[Find(Hash(key), key)] = key;
+    }
+  }
+
+  void AllocationSet::Shard::EraseSlot(std::size_t index)
+  {
+    // Move back the keys that follow in the same cluster so that lookups never need tombstones.
+    std::size_t mask = slots.size() - 1;
+    std::size_t next = index;
+
+    while (true)
+    {
+      next = (next + 1) & mask;
+      if (slots[next] == 0)
+        break;
+
+      std::size_t home = Hash(slots[next]) & mask;
+      bool in_between = (index <= next) ? (index < home && home <= next) : (index < home || home <= next);
+
+      if (!in_between)
+      {
+        slots[index] = slots[next];
+        index = next;
+      }
+    }
+
+    slots[index] = 0;
+  }
+
+  AllocationSet::AllocationSet()
+  {
+  }
+
+  AllocationSet::~AllocationSet()
+  {
+  }
+
+  std::size_t AllocationSet::Hash(std::size_t key)
+  {
+    // Fibonacci hashing. The low bits of the addresses are always 0 because of the alignment of the allocations.
+    if (sizeof(std::size_t) == 8)
+      return (key >> 4) * static_cast<std::size_t>(11400714819323198485ull);
+
+    return (key >> 4) * static_cast<std::size_t>(2654435769u);
+  }
+
+  AllocationSet::Shard& AllocationSet::GetShard(std::size_t hash)
+  {
+    return shards_[hash >> (sizeof(std::size_t) * 8 - SHARD_BITS)];
+  }
+
+  AllocationSet::Shard const& AllocationSet::GetShard(std::size_t hash) const
+  {
+    return shards_[hash >> (sizeof(std::size_t) * 8 - SHARD_BITS)];
+  }
+
+  bool AllocationSet::Insert(const void* ptr)
+  {
+    std::size_t key = reinterpret_cast<std::size_t>(ptr);
+    std::size_t hash = Hash(key);
+    Shard& shard = GetShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // Keep the load factor under 3/4.
+    if ((shard.size + 1) * 4 > shard.slots.size() * 3)
+      shard.Rehash(std::max(MIN_CAPACITY, shard.slots.size() * 2));
+
+    std::size_t index = shard.Find(hash, key);
+    if (shard.slots[index] == key)
+      return false;
+
+    shard.slots[index] = key;
+    ++shard.size;
+    return true;
+  }
+
+  bool AllocationSet::Erase(const void* ptr)
+  {
+    std::size_t key = reinterpret_cast<std::size_t>(ptr);
+    std::size_t hash = Hash(key);
+    Shard& shard = GetShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (shard.size == 0)
+      return false;
+
+    std::size_t index = shard.Find(hash, key);
+    if (shard.slots[index] != key)
+      return false;
+
+    shard.EraseSlot(index);
+    --shard.size;
+
+    // Give the memory back once most of the objects are gone.
+    if (shard.slots.size() > MIN_CAPACITY && shard.size * 8 < shard.slots.size())
+      shard.Rehash(shard.slots.size() / 2);
+
+    return true;
+  }
+
+  bool AllocationSet::Contains(const void* ptr) const
+  {
+    std::size_t key = reinterpret_cast<std::size_t>(ptr);
+    std::size_t hash = Hash(key);
+    Shard const& shard = GetShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    return shard.size && shard.slots[shard.Find(hash, key)] == key;
+  }
+
+  std::size_t AllocationSet::GetSize() const
+  {
+    std::size_t size = 0;
+
+    for (Shard const& shard : shards_)
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      size += shard.size;
+    }
+
+    return size;
+  }
+
+  std::vector<void*> AllocationSet::GetAddresses() const
+  {
+    std::vector<void*> addresses;
+
+    for (Shard const& shard : shards_)
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      for (std::size_t key : shard.slots)
+      {
+        if (key)
+          addresses.push_back(reinterpret_cast<void*>(key));
+      }
+    }
+
+    return addresses;
+  }
+}
@@ -0,0 +1,91 @@
+// -*- Mode: C++; indent-tabs-mode: nil; tab-width: 2 -*-
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#ifndef NUXCORE_ALLOCATION_SET_H
+#define NUXCORE_ALLOCATION_SET_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace nux
+{
+  //! Set of memory addresses with constant time insertion, removal and lookup.
+  /*!
+      The addresses are spread over SHARD_COUNT open addressing hash tables according to their hash, each
+      guarded by its own lock, so that threads allocating and releasing objects rarely wait for each other.
+      Used by ObjectStats to remember which objects were allocated on the heap.
+  */
+  class AllocationSet
+  {
+  public:
+    static const int SHARD_BITS = 6;
+    static const int SHARD_COUNT = 1 << SHARD_BITS;
+
+    AllocationSet();
+    ~AllocationSet();
+
+    //! Add an address to the set.
+    /*!
+        @return False if the address was already in the set.
+    */
+    bool Insert(const void* ptr);
+
+    //! Remove an address from the set.
+    /*!
+        @return False if the address was not in the set.
+    */
+    bool Erase(const void* ptr);
+
+    bool Contains(const void* ptr) const;
+
+    //! Return the number of addresses in the set.
+    std::size_t GetSize() const;
+
+    //! Return a copy of the addresses in the set, in no particular order.
+    std::vector<void*> GetAddresses() const;
+
+  private:
+    AllocationSet(AllocationSet const&);
+    AllocationSet& operator = (AllocationSet const&);
+
+    //! An open addressing hash table with linear probing. Empty slots hold 0.
+    struct Shard
+    {
+      Shard();
+
+      std::size_t Find(std::size_t hash, std::size_t key) const;
+      void Rehash(std::size_t capacity);
+      void EraseSlot(std::size_t index);
+
+      mutable std::mutex mutex;
+      std::vector<std::size_t> slots;
+      std::size_t size;
+    };
+
+    static std::size_t Hash(std::size_t key);
+    Shard& GetShard(std::size_t hash);
+    Shard const& GetShard(std::size_t hash) const;
+
+    Shard shards_[SHARD_COUNT];
+  };
+}
+
+#endif // NUXCORE_ALLOCATION_SET_H
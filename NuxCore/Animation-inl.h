@@ -116,25 +116,51 @@ VALUE_TYPE const& AnimateValue<VALUE_TYPE>::GetCurrentValue() const
 
 template <typename VALUE_TYPE>
 void AnimateValue<VALUE_TYPE>::Advance(int msec)
+{
+  double progress;
+  EasingCurve curve;
+  if (PrepareAdvance(msec, progress, curve))
+    ApplyEasedProgress(curve.ValueForProgress(progress));
+}
+
+template <typename VALUE_TYPE>
+bool AnimateValue<VALUE_TYPE>::PrepareAdvance(int msec, double& progress, EasingCurve& curve)
 {
   if (CurrentState() != Running)
-    return;
+    return false;
 
   msec_current_ += msec;
   if (msec_current_ >= msec_duration_)
   {
     msec_current_ = msec_duration_;
+    progress = 1;
+  }
+  else
+  {
+    progress = msec_current_ / static_cast<double>(msec_duration_);
+  }
+  curve = easing_curve_;
+  return true;
+}
+
+template <typename VALUE_TYPE>
+void AnimateValue<VALUE_TYPE>::ApplyEasedProgress(double eased_progress)
+{
+  // The handlers of another animation may have paused this one.
+  if (CurrentState() != Running)
+    return;
+
+  if (msec_current_ >= msec_duration_)
+  {
     current_value_ = finish_value_;
     updated.emit(current_value_);
     Stop();
   }
   else
   {
-    double progress = msec_current_ / static_cast<double>(msec_duration_);
-    double value = easing_curve_.ValueForProgress(progress);
     // These operators work for most if not all the property types we care
     // about.  Should we need more, we'll reevaluate then.
-    VALUE_TYPE new_value = start_value_ + ((finish_value_ - start_value_) * value);
+    VALUE_TYPE new_value = start_value_ + ((finish_value_ - start_value_) * eased_progress);
 
     if (new_value != current_value_)
     {
@@ -83,3 +83,12 @@ na::Animation::State na::Animation::CurrentState() const
 {
   return state_;
 }
+
+bool na::Animation::PrepareAdvance(int msec, double&, EasingCurve&)
+{
+  Advance(msec);
+  return false;
+}
+
+void na::Animation::ApplyEasedProgress(double)
+{}
@@ -63,6 +63,15 @@ public:
 protected:
   virtual void Restart() = 0;
 
+  friend class AnimationController;
+  // The AnimationController advances all the animations of a tick before
+  // updating them.  An animation that returns true from PrepareAdvance gives
+  // the progress its easing curve has to evaluate, the controller evaluates
+  // the curves of all the animations together and passes the eased progress
+  // back to ApplyEasedProgress.  By default the animation just advances.
+  virtual bool PrepareAdvance(int msec, double& progress, EasingCurve& curve);
+  virtual void ApplyEasedProgress(double eased_progress);
+
 private:
   State state_;
 };
@@ -100,6 +109,9 @@ public:
 protected:
   virtual void Restart();
 
+  virtual bool PrepareAdvance(int msec, double& progress, EasingCurve& curve);
+  virtual void ApplyEasedProgress(double eased_progress);
+
 private:
   int msec_current_;
   int msec_duration_;
@@ -26,6 +26,7 @@
 
 #include "Logger.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace na = nux::animation;
@@ -72,80 +73,171 @@ struct na::AnimationController::Impl
   Impl()
     : last_tick_(0)
     , ticking_(false)
+    , removed_(0)
     {}
 
   void Add(Animation* anim)
     {
       // never add the same twice
-      Animations::iterator end = animations_.end();
-      Animations::iterator i = std::find(animations_.begin(), end, anim);
-      if (i == end)
+      if (indices_.find(anim) != indices_.end())
+        return;
+
+      if (ticking_)
       {
-        animations_.push_back(anim);
+        if (std::find(pending_.begin(), pending_.end(), anim) == pending_.end())
+          pending_.push_back(anim);
+        return;
       }
+
+      if (removed_ > animations_.size() / 2)
+        Compact();
+
+      indices_[anim] = animations_.size();
+      animations_.push_back(anim);
     }
 
   void Remove(Animation* anim)
     {
-      // never add the same twice
-      Animations::iterator end = animations_.end();
-      Animations::iterator i = std::find(animations_.begin(), end, anim);
-      if (i != end)
+      Indices::iterator i = indices_.find(anim);
+      if (i != indices_.end())
       {
-        animations_.erase(i);
+        // Only clear the slot, so that the other animations keep their index
+        // while ticking.  The slots are compacted on the next tick.
+        animations_[i->second] = nullptr;
+        indices_.erase(i);
+        ++removed_;
       }
+      if (!pending_.empty())
+        pending_.erase(std::remove(pending_.begin(), pending_.end(), anim), pending_.end());
     }
 
   bool HasRunningAnimations() const
     {
       Animations::const_iterator end = animations_.end();
       Animations::const_iterator it = std::find_if(animations_.begin(), end, [](Animations::value_type item) {
-        return item->CurrentState() == Animation::Running;
+        return item && item->CurrentState() == Animation::Running;
       });
 
       return it != end;
     }
 
+  void Compact()
+    {
+      // Keeps the order the animations were added in.
+      std::size_t count = 0;
+      for (std::size_t slot = 0; slot < animations_.size(); ++slot)
+      {
+        if (Animation* anim = animations_[slot])
+        {
+          if (slot != count)
+          {
+            indices_[anim] = count;
+            animations_[count] = anim;
+          }
+          ++count;
+        }
+      }
+      animations_.resize(count);
+      removed_ = 0;
+    }
+
+  void EvaluateCurves()
+    {
+      std::size_t count = batch_slots_.size();
+      batch_values_.resize(count);
+      evaluated_.assign(count, false);
+
+      // One pass per kind of curve, there are usually only a few of them.
+      for (std::size_t first = 0; first < count; ++first)
+      {
+        if (evaluated_[first])
+          continue;
+
+        EasingCurve const& curve = batch_curves_[first];
+        group_.clear();
+        group_progress_.clear();
+        for (std::size_t i = first; i < count; ++i)
+        {
+          if (!evaluated_[i] && batch_curves_[i] == curve)
+          {
+            group_.push_back(i);
+            group_progress_.push_back(batch_progress_[i]);
+            evaluated_[i] = true;
+          }
+        }
+
+        group_values_.resize(group_.size());
+        curve.ValuesForProgress(&group_progress_[0], &group_values_[0], group_.size());
+        for (std::size_t i = 0; i < group_.size(); ++i)
+          batch_values_[group_[i]] = group_values_[i];
+      }
+    }
+
   void Tick(long long tick)
     {
       ticking_ = true;
 
       int ms_since_last_tick = static_cast<int>((tick - last_tick_) / 1000);
       last_tick_ = tick;
-      for (Animations::iterator i = animations_.begin(),
-             end = animations_.end(); i != end; ++i)
+
+      if (removed_)
+        Compact();
+
+      // Advance all the animations first, the ones with an easing curve give
+      // the progress to evaluate.
+      batch_slots_.clear();
+      batch_progress_.clear();
+      batch_curves_.clear();
+      for (std::size_t slot = 0; slot < animations_.size(); ++slot)
       {
-        // only if it isn't pending.
-        if (do_not_tick_.empty() ||
-            do_not_tick_.find((*i)) == do_not_tick_.end())
+        double progress;
+        EasingCurve curve;
+        Animation* anim = animations_[slot];
+        if (anim && anim->PrepareAdvance(ms_since_last_tick, progress, curve))
         {
-          (*i)->Advance(ms_since_last_tick);
+          batch_slots_.push_back(slot);
+          batch_progress_.push_back(progress);
+          batch_curves_.push_back(curve);
         }
       }
 
-      ticking_ = false;
+      EvaluateCurves();
 
-      for (AnimationActions::iterator i = pending_.begin(),
-             end = pending_.end(); i != end; ++i)
+      // Then update the values.  The animations removed by the handlers of
+      // the previous ones have their slot cleared and are skipped.
+      for (std::size_t i = 0; i < batch_slots_.size(); ++i)
       {
-        if (i->second)
-          Add(i->first);
-        else
-          Remove(i->first);
+        if (Animation* anim = animations_[batch_slots_[i]])
+          anim->ApplyEasedProgress(batch_values_[i]);
       }
-      pending_.clear();
-      do_not_tick_.clear();
+
+      ticking_ = false;
+
+      Animations pending;
+      pending.swap(pending_);
+      for (Animations::iterator i = pending.begin(), end = pending.end(); i != end; ++i)
+        Add(*i);
     }
 
   long long last_tick_;
   typedef std::vector<Animation*> Animations;
   Animations animations_;
-  typedef std::vector<std::pair<Animation*, bool>> AnimationActions;
-  AnimationActions pending_;
+  typedef std::unordered_map<Animation*, std::size_t> Indices;
+  Indices indices_;
+  // Animations added while ticking, they are added after the tick.
+  Animations pending_;
   bool ticking_;
+  std::size_t removed_;
 
-  typedef std::set<Animation*> DoNotTickActions;
-  DoNotTickActions do_not_tick_;
+  // The animations advanced during a tick, in struct of arrays form.
+  std::vector<std::size_t> batch_slots_;
+  std::vector<double> batch_progress_;
+  std::vector<EasingCurve> batch_curves_;
+  std::vector<double> batch_values_;
+  std::vector<bool> evaluated_;
+  std::vector<std::size_t> group_;
+  std::vector<double> group_progress_;
+  std::vector<double> group_values_;
 };
 
 na::AnimationController::AnimationController(na::TickSource& tick_source)
@@ -167,27 +259,12 @@ void na::AnimationController::OnTick(long long tick)
 
 void na::AnimationController::AddAnimation(na::Animation* animation)
 {
-  if (pimpl->ticking_)
-  {
-    pimpl->pending_.push_back(std::make_pair(animation, true));
-  }
-  else
-  {
-    pimpl->Add(animation);
-  }
+  pimpl->Add(animation);
 }
 
 void na::AnimationController::RemoveAnimation(na::Animation* animation)
 {
-  if (pimpl->ticking_)
-  {
-    pimpl->pending_.push_back(std::make_pair(animation, false));
-    pimpl->do_not_tick_.insert(animation);
-  }
-  else
-  {
-    pimpl->Remove(animation);
-  }
+  pimpl->Remove(animation);
 }
 
 bool na::AnimationController::HasRunningAnimations() const
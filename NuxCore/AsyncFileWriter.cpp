@@ -23,7 +23,10 @@
 #include "NuxCore.h"
 #include "AsyncFileWriter.h"
 
-#include <sstream>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
 
 #include <gio/gio.h>
 
@@ -32,9 +35,31 @@
 namespace nux
 {
 
+namespace
+{
+// The data waiting to be written is copied in a chain of buffers of this
+// size, a few of the written buffers are kept for reuse.
+const std::size_t BUFFER_SIZE = 16 * 1024;
+const std::size_t MAX_FREE_BUFFERS = 4;
+const std::size_t DEFAULT_MEMORY_LIMIT = 4 * 1024 * 1024;
+#if GLIB_CHECK_VERSION(2, 60, 0)
+const std::size_t MAX_GATHERED_BUFFERS = 16;
+#endif
+
+struct Buffer
+{
+  std::size_t size;
+  // The bytes before the offset are already written.
+  std::size_t offset;
+  char data[BUFFER_SIZE];
+};
+}
+
 /**
- * CAUTION: right now this class is not thread aware.  It assumes that all the
- * write calls are coming from a single thread.  Perhaps we need to fix this?
+ * All the members are protected by the mutex.  The GIO calls are only made
+ * from the thread running the main context, other threads schedule an idle
+ * source to start them.  The signals are emitted without holding the mutex,
+ * as the closed signal handler may delete the writer.
  */
 class AsyncFileWriter::Impl
 {
@@ -45,31 +70,59 @@ public:
   void Write(std::string const& data);
   void Close();
 
+  void ScheduleProcess();
   void ProcessAsync();
+  void ConsumeWritten(std::size_t bytes_written);
+  void DropPendingBuffers();
+  Buffer* NewBuffer();
+  void ReleaseBuffer(Buffer* buffer);
 
+  static gboolean ProcessIdleCallback(Impl* impl);
   static void AppendAsyncCallback(GFile* source, GAsyncResult* res, Impl* impl);
+#if GLIB_CHECK_VERSION(2, 60, 0)
+  static void WritevAsyncCallback(GOutputStream* source, GAsyncResult* res, Impl* impl);
+#else
   static void WriteAsyncCallback(GOutputStream* source, GAsyncResult* res, Impl* impl);
+#endif
   static void CloseAsyncCallback(GOutputStream* source, GAsyncResult* res, Impl* impl);
+  static bool ReportError(GError* error);
 
   AsyncFileWriter* owner_;
+  GMainContext* context_;
   GCancellable* cancel_;
   GFile* file_;
   GFileOutputStream* output_stream_;
+  GSource* process_source_;
   bool close_pending_;
   bool pending_async_call_;
+  bool failed_;
 
-  std::stringstream pending_content_;
-  std::string data_to_write_;
+  std::mutex mutex_;
+  std::condition_variable space_available_;
+  std::deque<Buffer*> pending_buffers_;
+  std::vector<Buffer*> free_buffers_;
+  std::size_t memory_limit_;
+  OverflowPolicy overflow_policy_;
+  std::size_t dropped_bytes_;
+#if GLIB_CHECK_VERSION(2, 60, 0)
+  GOutputVector vectors_[MAX_GATHERED_BUFFERS];
+#endif
 };
 
 
 AsyncFileWriter::Impl::Impl(AsyncFileWriter* owner, std::string const& filename)
   : owner_(owner)
+  , context_(g_main_context_ref_thread_default())
   , cancel_(g_cancellable_new())
   , file_(g_file_new_for_path(filename.c_str()))
   , output_stream_(0)
+  , process_source_(0)
   , close_pending_(false)
   , pending_async_call_(true)
+  , failed_(false)
+  , memory_limit_(DEFAULT_MEMORY_LIMIT)
+  , overflow_policy_(BLOCK_WRITERS)
+  , dropped_bytes_(0)
 {
   g_file_append_to_async(file_,
                          G_FILE_CREATE_NONE,
@@ -81,6 +134,11 @@ AsyncFileWriter::Impl::Impl(AsyncFileWriter* owner, std::string const& filename)
 
 AsyncFileWriter::Impl::~Impl()
 {
+  if (process_source_)
+  {
+    g_source_destroy(process_source_);
+    g_source_unref(process_source_);
+  }
   if (pending_async_call_)
   {
     g_cancellable_cancel(cancel_);
@@ -89,13 +147,12 @@ AsyncFileWriter::Impl::~Impl()
   if (output_stream_)
   {
     // If we had an output stream, sync write any pending content.
-    if (pending_content_.tellp())
+    for (auto buffer : pending_buffers_)
     {
-      std::string data(pending_content_.str());
       gsize bytes_written;
       g_output_stream_write_all((GOutputStream*)output_stream_,
-                                data.c_str(),
-                                data.size(),
+                                buffer->data + buffer->offset,
+                                buffer->size - buffer->offset,
                                 &bytes_written,
                                 NULL, NULL);
     }
@@ -103,8 +160,28 @@ AsyncFileWriter::Impl::~Impl()
     g_object_unref(output_stream_);
   }
 
+  for (auto buffer : pending_buffers_)
+    delete buffer;
+  for (auto buffer : free_buffers_)
+    delete buffer;
+
   g_object_unref(file_);
   g_object_unref(cancel_);
+  g_main_context_unref(context_);
+}
+
+bool AsyncFileWriter::Impl::ReportError(GError* error)
+{
+  if (!error)
+    return false;
+
+  // Cancelled callbacks call back, but have a cancelled error code.
+  bool cancelled = (error->code == G_IO_ERROR_CANCELLED);
+  if (!cancelled) {
+    std::cerr << error->message << "\n";
+  }
+  g_error_free(error);
+  return true;
 }
 
 void AsyncFileWriter::Impl::AppendAsyncCallback(GFile* source,
@@ -114,42 +191,168 @@ void AsyncFileWriter::Impl::AppendAsyncCallback(GFile* source,
   GError* error = NULL;
   GFileOutputStream* stream = g_file_append_to_finish(source, res, &error);
   if (error) {
-    // Cancelled callbacks call back, but have a cancelled error code.
-    if (error->code != G_IO_ERROR_CANCELLED) {
-      std::cerr << error->message << "\n";
+    bool cancelled = (error->code == G_IO_ERROR_CANCELLED);
+    ReportError(error);
+    if (!cancelled) {
+      // The file can't be written: don't let the writers wait for it.
+      std::lock_guard<std::mutex> lock(impl->mutex_);
+      impl->failed_ = true;
+      impl->DropPendingBuffers();
     }
-    g_error_free(error);
     return;
   }
-  impl->output_stream_ = stream;
-  impl->pending_async_call_ = false;
+
+  {
+    std::lock_guard<std::mutex> lock(impl->mutex_);
+    impl->output_stream_ = stream;
+    impl->pending_async_call_ = false;
+  }
   impl->owner_->opened.emit();
+
+  std::lock_guard<std::mutex> lock(impl->mutex_);
   impl->ProcessAsync();
 }
 
+Buffer* AsyncFileWriter::Impl::NewBuffer()
+{
+  Buffer* buffer;
+  if (free_buffers_.empty())
+  {
+    buffer = new Buffer;
+  }
+  else
+  {
+    buffer = free_buffers_.back();
+    free_buffers_.pop_back();
+  }
+  buffer->size = 0;
+  buffer->offset = 0;
+  return buffer;
+}
+
+void AsyncFileWriter::Impl::ReleaseBuffer(Buffer* buffer)
+{
+  if (free_buffers_.size() < MAX_FREE_BUFFERS)
+    free_buffers_.push_back(buffer);
+  else
+    delete buffer;
+}
+
 void AsyncFileWriter::Impl::Write(std::string const& data)
 {
-  if (close_pending_) return;
-  // TODO: lock the pending_content_ access
-  pending_content_ << data;
-  ProcessAsync();
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  for (;;)
+  {
+    if (close_pending_)
+      return;
+
+    if (failed_)
+    {
+      dropped_bytes_ += data.size();
+      return;
+    }
+
+    std::size_t available = 0;
+    if (!pending_buffers_.empty())
+      available = BUFFER_SIZE - pending_buffers_.back()->size;
+
+    if (data.size() <= available || pending_buffers_.empty())
+      break;
+
+    std::size_t needed = (data.size() - available + BUFFER_SIZE - 1) / BUFFER_SIZE;
+    if ((pending_buffers_.size() + needed) * BUFFER_SIZE <= memory_limit_)
+      break;
+
+    if (overflow_policy_ == DROP_WRITES || g_main_context_is_owner(context_))
+    {
+      dropped_bytes_ += data.size();
+      return;
+    }
+    space_available_.wait(lock);
+  }
+
+  const char* source = data.data();
+  std::size_t remaining = data.size();
+  while (remaining)
+  {
+    if (pending_buffers_.empty() || pending_buffers_.back()->size == BUFFER_SIZE)
+      pending_buffers_.push_back(NewBuffer());
+
+    // A GIO write may be reading the start of the last buffer, the new bytes
+    // go after the ones it was given.
+    Buffer* buffer = pending_buffers_.back();
+    std::size_t count = std::min(remaining, BUFFER_SIZE - buffer->size);
+    std::memcpy(buffer->data + buffer->size, source, count);
+    buffer->size += count;
+    source += count;
+    remaining -= count;
+  }
+
+  ScheduleProcess();
+}
+
+void AsyncFileWriter::Impl::ScheduleProcess()
+{
+  // The completion callback of the pending call processes the new data.
+  if (output_stream_ == NULL || pending_async_call_ || process_source_)
+    return;
+
+  if (g_main_context_is_owner(context_))
+  {
+    ProcessAsync();
+    return;
+  }
+
+  process_source_ = g_idle_source_new();
+  g_source_set_priority(process_source_, G_PRIORITY_DEFAULT);
+  g_source_set_callback(process_source_,
+                        (GSourceFunc)&AsyncFileWriter::Impl::ProcessIdleCallback,
+                        this, NULL);
+  g_source_attach(process_source_, context_);
+}
+
+gboolean AsyncFileWriter::Impl::ProcessIdleCallback(Impl* impl)
+{
+  std::lock_guard<std::mutex> lock(impl->mutex_);
+  g_source_unref(impl->process_source_);
+  impl->process_source_ = 0;
+  impl->ProcessAsync();
+  return FALSE;
 }
 
 void AsyncFileWriter::Impl::ProcessAsync()
 {
   if (output_stream_ == NULL || pending_async_call_) return;
 
-  if (pending_content_.tellp())
+  if (!pending_buffers_.empty())
   {
-    // TODO: lock the pending_content_ access
-    data_to_write_ = pending_content_.str();
+#if GLIB_CHECK_VERSION(2, 60, 0)
+    // Gather as many buffers as we can in a single write.
+    std::size_t count = 0;
+    for (auto i = pending_buffers_.begin(), end = pending_buffers_.end();
+         i != end && count < MAX_GATHERED_BUFFERS; ++i, ++count)
+    {
+      vectors_[count].buffer = (*i)->data + (*i)->offset;
+      vectors_[count].size = (*i)->size - (*i)->offset;
+    }
+    g_output_stream_writev_async((GOutputStream*)output_stream_,
+                                 vectors_,
+                                 count,
+                                 G_PRIORITY_DEFAULT,
+                                 cancel_,
+                                 (GAsyncReadyCallback)&AsyncFileWriter::Impl::WritevAsyncCallback,
+                                 this);
+#else
+    Buffer* buffer = pending_buffers_.front();
     g_output_stream_write_async((GOutputStream*)output_stream_,
-                                data_to_write_.c_str(),
-                                data_to_write_.size(),
+                                buffer->data + buffer->offset,
+                                buffer->size - buffer->offset,
                                 G_PRIORITY_DEFAULT,
                                 cancel_,
                                 (GAsyncReadyCallback)&AsyncFileWriter::Impl::WriteAsyncCallback,
                                 this);
+#endif
     pending_async_call_ = true;
   }
   else if (close_pending_)
@@ -163,41 +366,78 @@ void AsyncFileWriter::Impl::ProcessAsync()
   }
 }
 
+void AsyncFileWriter::Impl::ConsumeWritten(std::size_t bytes_written)
+{
+  while (!pending_buffers_.empty())
+  {
+    Buffer* buffer = pending_buffers_.front();
+    std::size_t count = std::min(bytes_written, buffer->size - buffer->offset);
+    buffer->offset += count;
+    bytes_written -= count;
+
+    if (buffer->offset < buffer->size)
+      break;
+
+    pending_buffers_.pop_front();
+    ReleaseBuffer(buffer);
+  }
+  space_available_.notify_all();
+}
+
+void AsyncFileWriter::Impl::DropPendingBuffers()
+{
+  for (auto buffer : pending_buffers_)
+  {
+    dropped_bytes_ += buffer->size - buffer->offset;
+    ReleaseBuffer(buffer);
+  }
+  pending_buffers_.clear();
+  space_available_.notify_all();
+}
+
+#if GLIB_CHECK_VERSION(2, 60, 0)
+void AsyncFileWriter::Impl::WritevAsyncCallback(GOutputStream* source,
+                                                GAsyncResult* res,
+                                                Impl* impl)
+{
+  GError* error = NULL;
+  gsize bytes_written = 0;
+  g_output_stream_writev_finish(source, res, &bytes_written, &error);
+#else
 void AsyncFileWriter::Impl::WriteAsyncCallback(GOutputStream* source,
                                                GAsyncResult* res,
                                                Impl* impl)
 {
   GError* error = NULL;
-  gssize g_bytes_written = g_output_stream_write_finish(source, res, &error);
+  // The result is signed from gio, but only negative if there is an error.
+  // The error should be set too if there was an error, so no negative bytes
+  // written get past here.
+  gsize bytes_written = g_output_stream_write_finish(source, res, &error);
+#endif
   if (error) {
-    // Cancelled callbacks call back, but have a cancelled error code.
-    if (error->code != G_IO_ERROR_CANCELLED) {
-      std::cerr << error->message << "\n";
+    bool cancelled = (error->code == G_IO_ERROR_CANCELLED);
+    ReportError(error);
+    if (!cancelled) {
+      // Don't let the writers wait for data that will never be written.
+      std::lock_guard<std::mutex> lock(impl->mutex_);
+      impl->failed_ = true;
+      impl->DropPendingBuffers();
     }
-    g_error_free(error);
     return;
   }
-  // g_bytes_written is signed from gio, but only negative if there is an error.
-  // The error should be set too if there was an error, so no negative bytes
-  // written get past here.
-  std::size_t bytes_written = g_bytes_written;
+
+  std::lock_guard<std::mutex> lock(impl->mutex_);
   impl->pending_async_call_ = false;
-  // TODO: lock the pending_content_ access
-  std::string data = impl->pending_content_.str();
-  if (bytes_written >= data.size()) {
-    // There should be no reason why bytes_written should be greater than the
-    // number of bytes in the stream, but this is paranoia.
-    impl->pending_content_.str("");
-  } else {
-    impl->pending_content_.str(data.substr(bytes_written));
-  }
+  impl->ConsumeWritten(bytes_written);
   impl->ProcessAsync();
 }
 
 void AsyncFileWriter::Impl::Close()
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   close_pending_ = true;
-  ProcessAsync();
+  space_available_.notify_all();
+  ScheduleProcess();
 }
 
 void AsyncFileWriter::Impl::CloseAsyncCallback(GOutputStream* source,
@@ -206,16 +446,15 @@ void AsyncFileWriter::Impl::CloseAsyncCallback(GOutputStream* source,
 {
   GError* error = NULL;
   g_output_stream_close_finish(source, res, &error);
-  if (error) {
-    // Cancelled callbacks call back, but have a cancelled error code.
-    if (error->code != G_IO_ERROR_CANCELLED) {
-      std::cerr << error->message << "\n";
-    }
-    g_error_free(error);
+  if (ReportError(error))
     return;
+
+  {
+    std::lock_guard<std::mutex> lock(impl->mutex_);
+    g_object_unref(impl->output_stream_);
+    impl->output_stream_ = 0;
   }
-  g_object_unref(impl->output_stream_);
-  impl->output_stream_ = 0;
+  // The handlers may delete the writer.
   impl->owner_->closed.emit();
 }
 
@@ -240,8 +479,23 @@ void AsyncFileWriter::Close()
 
 bool AsyncFileWriter::IsClosing() const
 {
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);
   return pimpl->close_pending_;
 }
 
+void AsyncFileWriter::SetMemoryLimit(std::size_t bytes, OverflowPolicy policy)
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);
+  pimpl->memory_limit_ = bytes;
+  pimpl->overflow_policy_ = policy;
+  pimpl->space_available_.notify_all();
+}
+
+std::size_t AsyncFileWriter::GetDroppedBytes() const
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);
+  return pimpl->dropped_bytes_;
+}
+
 
 } // namespace nux
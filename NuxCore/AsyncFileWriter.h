@@ -22,6 +22,7 @@
 #ifndef NUXCORE_ASYNC_FILE_WRITER_H
 #define NUXCORE_ASYNC_FILE_WRITER_H
 
+#include <cstddef>
 #include <string>
 #include <sigc++/sigc++.h>
 
@@ -32,11 +33,22 @@ namespace nux
  * Write to a file asynchronously.
  *
  * This uses the GIO async functions, and as such depend on the gobject main
- * loop.
+ * loop.  The writes can come from any thread, the GIO calls and the signals
+ * happen in the main context that was the thread default one when the writer
+ * was created.
  */
 class AsyncFileWriter
 {
 public:
+  // What happens to a write that would go over the memory limit.
+  enum OverflowPolicy
+  {
+    // Wait for the pending data to be written.  The thread running the main
+    // context of the writer can't wait, its writes are dropped.
+    BLOCK_WRITERS,
+    DROP_WRITES
+  };
+
   AsyncFileWriter(std::string const& filename);
   // Destructor kills any pending async requests, and close the file
   // synchronously if it is open.
@@ -50,6 +62,12 @@ public:
 
   bool IsClosing() const;
 
+  // Limits the memory used by the data waiting to be written, 4 MiB with the
+  // BLOCK_WRITERS policy by default.  A write bigger than the limit is still
+  // accepted when nothing else is pending.
+  void SetMemoryLimit(std::size_t bytes, OverflowPolicy policy);
+  std::size_t GetDroppedBytes() const;
+
   sigc::signal<void> opened;
   sigc::signal<void> closed;
 
@@ -172,10 +172,72 @@ na::EasingCurve::EasingCurve(Type type)
   : func_(GetEasingFunction(type))
 {}
 
-double na::EasingCurve::ValueForProgress(double progress)
+double na::EasingCurve::ValueForProgress(double progress) const
 {
   if (progress <= 0) return 0;
   if (progress >= 1) return 1;
 
   return func_(progress);
 }
+
+void na::EasingCurve::ValuesForProgress(double const* progress, double* values,
+                                        std::size_t count) const
+{
+  // The curves below give exactly zero and one at the ends, so clamping the
+  // progress gives the same values as ValueForProgress.  The operations are
+  // the ones of the scalar functions to get the same results.
+  if (func_ == linear)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      double p = progress[i];
+      values[i] = p < 0 ? 0 : (p > 1 ? 1 : p);
+    }
+  }
+  else if (func_ == in_quad)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      double p = progress[i];
+      p = p < 0 ? 0 : (p > 1 ? 1 : p);
+      values[i] = p * p;
+    }
+  }
+  else if (func_ == out_quad)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      double p = progress[i];
+      p = 1 - (p < 0 ? 0 : (p > 1 ? 1 : p));
+      values[i] = 1 - p * p;
+    }
+  }
+  else if (func_ == in_out_quad)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      double p = progress[i];
+      p = p < 0 ? 0 : (p > 1 ? 1 : p);
+      double out_progress = 1 - (p - 0.5) * 2;
+      double in_progress = p * 2;
+      double out_value = 1 - (out_progress * out_progress / 2);
+      double in_value = in_progress * in_progress / 2;
+      values[i] = p > 0.5 ? out_value : in_value;
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      values[i] = ValueForProgress(progress[i]);
+  }
+}
+
+bool na::EasingCurve::operator==(EasingCurve const& other) const
+{
+  return func_ == other.func_;
+}
+
+bool na::EasingCurve::operator!=(EasingCurve const& other) const
+{
+  return func_ != other.func_;
+}
@@ -22,6 +22,7 @@
 #ifndef NUX_CORE_EASING_CURVE_H
 #define NUX_CORE_EASING_CURVE_H
 
+#include <cstddef>
 
 namespace nux
 {
@@ -62,7 +63,15 @@ public:
   //
   // The returned value may be greater than one, or less than zero for some
   // special curves.
-  double ValueForProgress(double progress);
+  double ValueForProgress(double progress) const;
+
+  // Same as ValueForProgress for count values at once.  The common curves
+  // are evaluated in loops the compiler can vectorize.
+  void ValuesForProgress(double const* progress, double* values,
+                         std::size_t count) const;
+
+  bool operator==(EasingCurve const& other) const;
+  bool operator!=(EasingCurve const& other) const;
 
 private:
   EasingFunction func_;
@@ -27,9 +27,14 @@
 #include "System.h"
 #include "LoggingWriter.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <iostream>
-#include <sstream>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace nux {
@@ -99,15 +104,49 @@ std::string TimestampString(std::time_t timestamp)
   return buffer;
 }
 
-std::string ShortenedFilename(std::string const& filename)
+void AppendMessage(std::string& out,
+                   Level severity,
+                   std::string const& timestamp,
+                   std::string const& module,
+                   std::string const& filename,
+                   int line_number,
+                   std::string const& message)
 {
   std::string::size_type pos = filename.rfind('/');
-  if (pos == std::string::npos)
-    return filename;
 
-  return filename.substr(pos+1);
+  out += severity_string(severity);
+  out += ' ';
+  out += timestamp;
+  out += ' ';
+  out += module;
+  out += ' ';
+  if (pos == std::string::npos)
+    out += filename;
+  else
+    out.append(filename, pos + 1, std::string::npos);
+  out += ':';
+  out += std::to_string(line_number);
+  out += ' ';
+  out += message;
 }
 
+// A message waiting in the ring buffer of the asynchronous mode.  The strings
+// keep their capacity between uses, so copying a message into a record does
+// not allocate once the ring has warmed up.
+struct Record
+{
+  std::atomic<std::size_t> sequence;
+  Level severity;
+  std::string module;
+  std::string filename;
+  int line_number;
+  std::time_t timestamp;
+  std::string message;
+};
+
+const std::size_t RECORD_RESERVED_SIZE = 128;
+const int LOGGING_THREAD_PERIOD_MS = 10;
+
 } // anon namespace
 
 class Writer::Impl
@@ -124,22 +163,292 @@ public:
 
   void SetOutputStream(std::ostream& out);
 
+  void SetAsynchronous(bool asynchronous, std::size_t capacity);
+  bool IsAsynchronous() const;
+  void Flush();
+
+  std::atomic<std::size_t> dropped_messages_;
+
 private:
+  bool PushMessage(Level severity,
+                   std::string const& module,
+                   std::string const& filename,
+                   int line_number,
+                   std::time_t timestamp,
+                   std::string const& message);
+
+  void LoggingThread();
+  void WriteQueuedMessages();
+  std::string const& CachedTimestamp(std::time_t timestamp);
+
   typedef std::vector<StreamWrapper::Ptr> OutputStreams;
   OutputStreams output_streams_;
+  std::mutex output_streams_mutex_;
+
+  // Bounded MPSC queue: the producers claim a record by advancing
+  // enqueue_position_, and each record sequence number tells whether it is
+  // free, filled or still owned by the logging thread.
+  std::unique_ptr<Record[]> records_;
+  std::size_t mask_;
+  std::atomic<std::size_t> enqueue_position_;
+  std::atomic<std::size_t> dequeue_position_;
+
+  std::atomic<bool> asynchronous_;
+  std::atomic<int> active_producers_;
+
+  std::thread logging_thread_;
+  std::mutex mutex_;
+  std::condition_variable wake_up_;
+  std::condition_variable written_;
+  bool wake_up_pending_;
+  bool running_;
+
+  // Only used by the logging thread.
+  std::string batch_;
+  std::size_t reported_dropped_messages_;
+  std::time_t cached_time_;
+  std::string cached_timestamp_;
 };
 
 Writer::Impl::Impl()
+  : dropped_messages_(0)
+  , mask_(0)
+  , enqueue_position_(0)
+  , dequeue_position_(0)
+  , asynchronous_(false)
+  , active_producers_(0)
+  , wake_up_pending_(false)
+  , running_(false)
+  , reported_dropped_messages_(0)
+  , cached_time_(-1)
 {
   output_streams_.push_back(StreamWrapper::Ptr(new StreamWrapper(std::cout)));
 }
 
 void Writer::Impl::SetOutputStream(std::ostream& out)
 {
+  // Messages already queued go to the previous streams.
+  Flush();
+
+  std::lock_guard<std::mutex> lock(output_streams_mutex_);
   output_streams_.clear();
   output_streams_.push_back(StreamWrapper::Ptr(new StreamWrapper(out)));
 }
 
+void Writer::Impl::SetAsynchronous(bool asynchronous, std::size_t capacity)
+{
+  if (asynchronous == logging_thread_.joinable())
+    return;
+
+  if (asynchronous)
+  {
+    std::size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+
+    records_.reset(new Record[size]);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      records_[i].sequence.store(i, std::memory_order_relaxed);
+      records_[i].module.reserve(RECORD_RESERVED_SIZE);
+      records_[i].filename.reserve(RECORD_RESERVED_SIZE);
+      records_[i].message.reserve(RECORD_RESERVED_SIZE);
+    }
+    mask_ = size - 1;
+    enqueue_position_.store(0, std::memory_order_relaxed);
+    dequeue_position_.store(0, std::memory_order_relaxed);
+
+    running_ = true;
+    logging_thread_ = std::thread(&Writer::Impl::LoggingThread, this);
+    asynchronous_.store(true, std::memory_order_release);
+  }
+  else
+  {
+    asynchronous_.store(false, std::memory_order_seq_cst);
+
+    // Wait for the producers that saw the asynchronous mode to finish their
+    // copy, the logging thread then writes everything left in the ring.
+    while (active_producers_.load(std::memory_order_seq_cst) != 0)
+      std::this_thread::yield();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+    wake_up_.notify_one();
+    logging_thread_.join();
+    records_.reset();
+  }
+}
+
+bool Writer::Impl::IsAsynchronous() const
+{
+  return asynchronous_.load(std::memory_order_relaxed);
+}
+
+void Writer::Impl::Flush()
+{
+  if (!logging_thread_.joinable())
+  {
+    std::lock_guard<std::mutex> lock(output_streams_mutex_);
+    for (OutputStreams::iterator i = output_streams_.begin(), end = output_streams_.end();
+         i != end; ++i)
+    {
+      (*i)->out.flush();
+    }
+    return;
+  }
+
+  std::size_t target = enqueue_position_.load(std::memory_order_acquire);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  wake_up_pending_ = true;
+  wake_up_.notify_one();
+  written_.wait(lock, [this, target] {
+    return dequeue_position_.load(std::memory_order_acquire) >= target;
+  });
+}
+
+bool Writer::Impl::PushMessage(Level severity,
+                               std::string const& module,
+                               std::string const& filename,
+                               int line_number,
+                               std::time_t timestamp,
+                               std::string const& message)
+{
+  std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+  Record* record;
+
+  for (;;)
+  {
+    record = &records_[position & mask_];
+    std::size_t sequence = record->sequence.load(std::memory_order_acquire);
+    std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+    if (difference == 0)
+    {
+      if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                  std::memory_order_relaxed))
+        break;
+    }
+    else if (difference < 0)
+    {
+      // The ring is full.
+      return false;
+    }
+    else
+    {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+
+  record->severity = severity;
+  record->module.assign(module);
+  record->filename.assign(filename);
+  record->line_number = line_number;
+  record->timestamp = timestamp;
+  record->message.assign(message);
+  record->sequence.store(position + 1, std::memory_order_release);
+
+  // The logging thread wakes up periodically, only hurry it when the ring is
+  // filling up. The flag is set under the mutex so that the wake up is not
+  // lost between the check of the wait predicate and the wait.
+  if (position - dequeue_position_.load(std::memory_order_relaxed) > mask_ / 2)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      wake_up_pending_ = true;
+    }
+    wake_up_.notify_one();
+  }
+
+  return true;
+}
+
+void Writer::Impl::LoggingThread()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  for (;;)
+  {
+    bool running = running_;
+
+    lock.unlock();
+    WriteQueuedMessages();
+    lock.lock();
+
+    written_.notify_all();
+
+    if (!running)
+      break;
+
+    if (!wake_up_pending_)
+    {
+      wake_up_.wait_for(lock, std::chrono::milliseconds(LOGGING_THREAD_PERIOD_MS),
+                        [this] { return wake_up_pending_ || !running_; });
+    }
+    wake_up_pending_ = false;
+  }
+}
+
+std::string const& Writer::Impl::CachedTimestamp(std::time_t timestamp)
+{
+  if (timestamp != cached_time_)
+  {
+    cached_time_ = timestamp;
+    cached_timestamp_ = TimestampString(timestamp);
+  }
+  return cached_timestamp_;
+}
+
+void Writer::Impl::WriteQueuedMessages()
+{
+  std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+
+  batch_.clear();
+
+  for (;;)
+  {
+    Record& record = records_[position & mask_];
+    if (record.sequence.load(std::memory_order_acquire) != position + 1)
+      break;
+
+    AppendMessage(batch_, record.severity, CachedTimestamp(record.timestamp),
+                  record.module, record.filename, record.line_number,
+                  record.message);
+    batch_ += '\n';
+
+    record.sequence.store(position + mask_ + 1, std::memory_order_release);
+    ++position;
+  }
+
+  std::size_t dropped = dropped_messages_.load(std::memory_order_relaxed);
+  if (dropped != reported_dropped_messages_)
+  {
+    std::time_t now = std::time(0);
+    AppendMessage(batch_, Warning, CachedTimestamp(now), "nux.logging",
+                  __FILE__, __LINE__,
+                  std::to_string(dropped - reported_dropped_messages_) +
+                  " messages dropped, the logging ring buffer is full");
+    batch_ += '\n';
+    reported_dropped_messages_ = dropped;
+  }
+
+  if (!batch_.empty())
+  {
+    std::lock_guard<std::mutex> lock(output_streams_mutex_);
+    for (OutputStreams::iterator i = output_streams_.begin(), end = output_streams_.end();
+         i != end; ++i)
+    {
+      std::ostream& out = (*i)->out;
+      out.write(batch_.data(), batch_.size());
+      out.flush();
+    }
+  }
+
+  dequeue_position_.store(position, std::memory_order_release);
+}
+
 void Writer::Impl::WriteMessage(Level severity,
                                 std::string const& module,
                                 std::string const& filename,
@@ -147,27 +456,36 @@ void Writer::Impl::WriteMessage(Level severity,
                                 std::time_t timestamp,
                                 std::string const& message)
 {
+  active_producers_.fetch_add(1, std::memory_order_seq_cst);
+  if (asynchronous_.load(std::memory_order_seq_cst))
+  {
+    if (!PushMessage(severity, module, filename, line_number, timestamp, message))
+      dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+
+    active_producers_.fetch_sub(1, std::memory_order_release);
+    return;
+  }
+  active_producers_.fetch_sub(1, std::memory_order_release);
+
   // If we want to have some form of custom formatter, here is where we do it.
   // Right now, format the line independently, and then write it to each
   // output stream.
-  std::stringstream sout;
-  sout << severity_string(severity)
-       << " " << TimestampString(timestamp)
-       << " " << module
-       << " " << ShortenedFilename(filename)
-       << ":" << line_number
-       << " " << message;
+  std::string line;
+  AppendMessage(line, severity, TimestampString(timestamp), module, filename,
+                line_number, message);
+
+  std::lock_guard<std::mutex> lock(output_streams_mutex_);
   for (OutputStreams::iterator i = output_streams_.begin(), end = output_streams_.end();
        i != end; ++i)
   {
     std::ostream& out = (*i)->out;
-    out << sout.rdbuf() << std::endl;
+    out << line << std::endl;
   }
 
 #if defined(NUX_OS_WINDOWS) && defined(NUX_DEBUG)
   // Quick hack to print messages to Visual Studio output.
   // Should create a Visual Studio StreamWrapper instead!
-  OutputDebugString (sout.str().c_str());
+  OutputDebugString (line.c_str());
 #endif
 
 }
@@ -183,6 +501,7 @@ Writer::Writer()
 
 Writer::~Writer()
 {
+  pimpl->SetAsynchronous(false, 0);
   delete pimpl;
 #ifdef NUX_DEBUG
   std::cerr << "nux::logging::Writer::~Writer()\n";
@@ -215,5 +534,25 @@ void Writer::SetOutputStream(std::ostream& out)
   pimpl->SetOutputStream(out);
 }
 
+void Writer::SetAsynchronous(bool asynchronous, std::size_t capacity)
+{
+  pimpl->SetAsynchronous(asynchronous, capacity);
+}
+
+bool Writer::IsAsynchronous() const
+{
+  return pimpl->IsAsynchronous();
+}
+
+void Writer::Flush()
+{
+  pimpl->Flush();
+}
+
+std::size_t Writer::GetDroppedMessageCount() const
+{
+  return pimpl->dropped_messages_.load(std::memory_order_relaxed);
+}
+
 }
 }
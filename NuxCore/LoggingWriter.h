@@ -24,6 +24,7 @@
 
 #include <iosfwd>
 #include <ctime>
+#include <cstddef>
 #include <boost/utility.hpp>
 
 #include "Logger.h"
@@ -37,6 +38,13 @@
  * As far as logging the timestamp goes, we only go to second precision in the
  * logging format itself.  If a high performance timer is needed it should be
  * managed by the caller.
+ *
+ * In the asynchronous mode WriteMessage only copies its arguments into a
+ * fixed size ring buffer without taking any lock.  A logging thread formats
+ * the messages and writes them to the output streams in batches, so the
+ * output streams must be usable from that thread.  When the ring is full the
+ * message is dropped and counted, and the logging thread reports how many
+ * messages were lost.
  */
 
 namespace nux {
@@ -57,6 +65,16 @@ public:
 
   void SetOutputStream(std::ostream& out);
 
+  // The capacity is rounded up to a power of two.
+  void SetAsynchronous(bool asynchronous, std::size_t capacity = 4096);
+  bool IsAsynchronous() const;
+
+  // Blocks until every message written before the call is output.
+  void Flush();
+
+  // The number of messages dropped because the ring buffer was full.
+  std::size_t GetDroppedMessageCount() const;
+
 private:
   Writer();
 
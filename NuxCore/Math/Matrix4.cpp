@@ -31,9 +31,102 @@
 namespace nux
 {
 
+#if defined(NUX_MATRIX4_SIMD)
+  namespace simd
+  {
+    // Products of 2x2 matrices stored in a vector as {m00, m01, m10, m11}.
 
-#if 0
+    //! Return a * b.
+    inline Float4 Mat2Mul(Float4 a, Float4 b)
+    {
+      return Add(Mul(a, Shuffle<0, 3, 0, 3>(b, b)), Mul(Shuffle<1, 0, 3, 2>(a, a), Shuffle<2, 1, 2, 1>(b, b)));
+    }
 
+    //! Return adjugate(a) * b.
+    inline Float4 Mat2AdjMul(Float4 a, Float4 b)
+    {
+      return Sub(Mul(Shuffle<3, 3, 0, 0>(a, a), b), Mul(Shuffle<1, 1, 2, 2>(a, a), Shuffle<2, 3, 0, 1>(b, b)));
+    }
+
+    //! Return a * adjugate(b).
+    inline Float4 Mat2MulAdj(Float4 a, Float4 b)
+    {
+      return Sub(Mul(a, Shuffle<3, 0, 3, 0>(b, b)), Mul(Shuffle<1, 0, 3, 2>(a, a), Shuffle<2, 1, 2, 1>(b, b)));
+    }
+  }
+
+  template<>
+  void Matrix4x4<float>::TransformPoints(const Vector4 *in, Vector4 *out, int count) const
+  {
+    simd::Float4 columns[4];
+    simd::LoadColumns(m, columns);
+
+    for (int i = 0; i < count; ++i)
+      simd::Store(&out[i].x, simd::Combine(columns, simd::Load(&in[i].x)));
+  }
+
+  template<>
+  void Matrix4x4<float>::Inverse()
+  {
+    using namespace simd;
+
+    // The matrix is split in 2x2 blocks | A B |, inverted block wise with the adjugates of the blocks.
+    //                                   | C D |
+    Float4 r0 = Load(m[0]);
+    Float4 r1 = Load(m[1]);
+    Float4 r2 = Load(m[2]);
+    Float4 r3 = Load(m[3]);
+
+    Float4 A = Shuffle<0, 1, 0, 1>(r0, r1);
+    Float4 B = Shuffle<2, 3, 2, 3>(r0, r1);
+    Float4 C = Shuffle<0, 1, 0, 1>(r2, r3);
+    Float4 D = Shuffle<2, 3, 2, 3>(r2, r3);
+
+    // Determinants of A, B, C and D.
+    Float4 det_sub = Sub(Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+                         Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+    Float4 det_A = SplatLane<0>(det_sub);
+    Float4 det_B = SplatLane<1>(det_sub);
+    Float4 det_C = SplatLane<2>(det_sub);
+    Float4 det_D = SplatLane<3>(det_sub);
+
+    Float4 D_C = Mat2AdjMul(D, C);
+    Float4 A_B = Mat2AdjMul(A, B);
+
+    // Blocks of the adjugate of the matrix, before the signs and the transposition of the blocks.
+    Float4 X = Sub(Mul(det_D, A), Mat2Mul(B, D_C));
+    Float4 W = Sub(Mul(det_A, D), Mat2Mul(C, A_B));
+    Float4 Y = Sub(Mul(det_B, C), Mat2MulAdj(D, A_B));
+    Float4 Z = Sub(Mul(det_C, B), Mat2MulAdj(A, D_C));
+
+    // |M| = |A| |D| + |B| |C| - trace(adjugate(A) B adjugate(D) C)
+    Float4 trace = Mul(A_B, Shuffle<0, 2, 1, 3>(D_C, D_C));
+    trace = Add(trace, Shuffle<2, 3, 0, 1>(trace, trace));
+    trace = Add(trace, Shuffle<1, 0, 3, 2>(trace, trace));
+
+    float det = First(Sub(Add(Mul(det_A, det_D), Mul(det_B, det_C)), trace));
+
+    if (det == 0.0f)
+    {
+      // Determinant is null. Matrix cannot be inverted.
+#ifdef NUX_DEBUG
+      NUX_HARDWARE_BREAK;
+#endif
+      return;
+    }
+
+    const float signs[4] = {1.0f, -1.0f, -1.0f, 1.0f};
+    Float4 scale = Mul(Load(signs), Splat(1.0f / det));
+    X = Mul(X, scale);
+    Y = Mul(Y, scale);
+    Z = Mul(Z, scale);
+    W = Mul(W, scale);
+
+    Store(m[0], Shuffle<3, 1, 3, 1>(X, Y));
+    Store(m[1], Shuffle<2, 0, 2, 0>(X, Y));
+    Store(m[2], Shuffle<3, 1, 3, 1>(Z, W));
+    Store(m[3], Shuffle<2, 0, 2, 0>(Z, W));
+  }
 #endif
 
 }
@@ -28,6 +28,14 @@
 #include "Vector3.h"
 #include "Vector4.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define NUX_MATRIX4_SIMD
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NUX_MATRIX4_SIMD
+#endif
+
 namespace nux
 {
 
@@ -72,6 +80,9 @@ namespace nux
     Vector4      operator * (const Vector4 &) const;
     Matrix4x4<T> operator - ();
 
+    //! Multiply count vectors by the matrix. in and out can be the same array.
+    void TransformPoints(const Vector4 *in, Vector4 *out, int count) const;
+
     // Get the (i, j) element of the current matrix.
     T &operator() (unsigned int i, unsigned int j);
     T operator () (unsigned int i, unsigned int j) const;
@@ -121,9 +132,27 @@ namespace nux
     static Matrix4x4<T> ROTATEZ(T angle);
     static Matrix4x4<T> TRANSLATE(T x, T y, T z);
     static Matrix4x4<T> SCALE(T x, T y, T z);
-    T m[4][4];
+
+    // The rows are aligned for the vector code of Matrix4x4<float>.
+    NUX_DATA_ALIGN(T m[4][4], 16);
   };
 
+#if defined(NUX_MATRIX4_SIMD)
+  // Vector implementations of Matrix4x4<float>, defined at the end of this file and in Matrix4.cpp. The products
+  // add the terms in the same order as the generic code.
+  template<>
+  inline Matrix4x4<float> Matrix4x4<float>::operator * (const Matrix4x4<float>& iM) const;
+
+  template<>
+  inline Vector4 Matrix4x4<float>::operator * (const Vector4 &V) const;
+
+  template<>
+  void Matrix4x4<float>::TransformPoints(const Vector4 *in, Vector4 *out, int count) const;
+
+  template<>
+  void Matrix4x4<float>::Inverse();
+#endif
+
 
   /***************************************************************************************\
   Function:       Matrix4x4<T>::Matrix4x4<T>
@@ -685,6 +714,26 @@ namespace nux
     return oV;
   }
 
+  /***************************************************************************************\
+  Function:       Matrix4x4<T>::TransformPoints
+
+  Description:    Multiply an array of vectors by the matrix.
+
+  Parameters:     - in
+                  - out
+                  - count
+
+  Return Value:   None.
+
+  Comments:       in and out can be the same array.
+  \***************************************************************************************/
+  template<typename T>
+  void Matrix4x4<T>::TransformPoints(const Vector4 *in, Vector4 *out, int count) const
+  {
+    for (int i = 0; i < count; ++i)
+      out[i] = (*this) * in[i];
+  }
+
   /***************************************************************************************\
   Function:       Matrix4x4<T>::operator - ()
 
@@ -1511,6 +1560,185 @@ namespace nux
     return oM;
   }
 
+#if defined(NUX_MATRIX4_SIMD)
+  namespace simd
+  {
+    // The few vector operations used by Matrix4x4<float>. The loads and stores accept unaligned addresses: arrays
+    // of Vector4 are not aligned.
+#if defined(__SSE2__)
+    typedef __m128 Float4;
+
+    inline Float4 Load(const float *p)
+    {
+      return _mm_loadu_ps(p);
+    }
+
+    inline void Store(float *p, Float4 v)
+    {
+      _mm_storeu_ps(p, v);
+    }
+
+    inline Float4 Splat(float f)
+    {
+      return _mm_set1_ps(f);
+    }
+
+    inline Float4 Add(Float4 a, Float4 b)
+    {
+      return _mm_add_ps(a, b);
+    }
+
+    inline Float4 Sub(Float4 a, Float4 b)
+    {
+      return _mm_sub_ps(a, b);
+    }
+
+    inline Float4 Mul(Float4 a, Float4 b)
+    {
+      return _mm_mul_ps(a, b);
+    }
+
+    inline float First(Float4 v)
+    {
+      return _mm_cvtss_f32(v);
+    }
+
+    //! Return {a[x], a[y], b[z], b[w]}.
+    template <int x, int y, int z, int w>
+    inline Float4 Shuffle(Float4 a, Float4 b)
+    {
+      return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x));
+    }
+
+    //! Return a vector of v[lane].
+    template <int lane>
+    inline Float4 SplatLane(Float4 v)
+    {
+      return _mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane));
+    }
+
+    //! Load the columns of a row major matrix.
+    inline void LoadColumns(const float m[4][4], Float4 columns[4])
+    {
+      Float4 r0 = Load(m[0]);
+      Float4 r1 = Load(m[1]);
+      Float4 r2 = Load(m[2]);
+      Float4 r3 = Load(m[3]);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+      columns[0] = r0;
+      columns[1] = r1;
+      columns[2] = r2;
+      columns[3] = r3;
+    }
+#else
+    typedef float32x4_t Float4;
+
+    inline Float4 Load(const float *p)
+    {
+      return vld1q_f32(p);
+    }
+
+    inline void Store(float *p, Float4 v)
+    {
+      vst1q_f32(p, v);
+    }
+
+    inline Float4 Splat(float f)
+    {
+      return vdupq_n_f32(f);
+    }
+
+    inline Float4 Add(Float4 a, Float4 b)
+    {
+      return vaddq_f32(a, b);
+    }
+
+    inline Float4 Sub(Float4 a, Float4 b)
+    {
+      return vsubq_f32(a, b);
+    }
+
+    inline Float4 Mul(Float4 a, Float4 b)
+    {
+      return vmulq_f32(a, b);
+    }
+
+    inline float First(Float4 v)
+    {
+      return vgetq_lane_f32(v, 0);
+    }
+
+    //! Return {a[x], a[y], b[z], b[w]}.
+    template <int x, int y, int z, int w>
+    inline Float4 Shuffle(Float4 a, Float4 b)
+    {
+      Float4 result = vdupq_n_f32(vgetq_lane_f32(a, x));
+      result = vsetq_lane_f32(vgetq_lane_f32(a, y), result, 1);
+      result = vsetq_lane_f32(vgetq_lane_f32(b, z), result, 2);
+      return vsetq_lane_f32(vgetq_lane_f32(b, w), result, 3);
+    }
+
+    //! Return a vector of v[lane].
+    template <int lane>
+    inline Float4 SplatLane(Float4 v)
+    {
+      return vdupq_n_f32(vgetq_lane_f32(v, lane));
+    }
+
+    //! Load the columns of a row major matrix.
+    inline void LoadColumns(const float m[4][4], Float4 columns[4])
+    {
+      // vld4q deinterleaves the elements: the lane i of vector j is m[i][j].
+      float32x4x4_t deinterleaved = vld4q_f32(&m[0][0]);
+
+      columns[0] = deinterleaved.val[0];
+      columns[1] = deinterleaved.val[1];
+      columns[2] = deinterleaved.val[2];
+      columns[3] = deinterleaved.val[3];
+    }
+#endif
+
+    //! Return v[0] * c[0] + v[1] * c[1] + v[2] * c[2] + v[3] * c[3], added in this order.
+    inline Float4 Combine(const Float4 c[4], Float4 v)
+    {
+      Float4 result = Mul(SplatLane<0>(v), c[0]);
+      result = Add(result, Mul(SplatLane<1>(v), c[1]));
+      result = Add(result, Mul(SplatLane<2>(v), c[2]));
+      return Add(result, Mul(SplatLane<3>(v), c[3]));
+    }
+  }
+
+  template<>
+  inline Matrix4x4<float> Matrix4x4<float>::operator * (const Matrix4x4<float>& iM) const
+  {
+    // Each row of the output is a combination of the rows of iM.
+    simd::Float4 rows[4] = {simd::Load(iM.m[0]), simd::Load(iM.m[1]), simd::Load(iM.m[2]), simd::Load(iM.m[3])};
+    simd::Float4 r0 = simd::Combine(rows, simd::Load(m[0]));
+    simd::Float4 r1 = simd::Combine(rows, simd::Load(m[1]));
+    simd::Float4 r2 = simd::Combine(rows, simd::Load(m[2]));
+    simd::Float4 r3 = simd::Combine(rows, simd::Load(m[3]));
+
+    Matrix4x4<float> oM;
+    simd::Store(oM.m[0], r0);
+    simd::Store(oM.m[1], r1);
+    simd::Store(oM.m[2], r2);
+    simd::Store(oM.m[3], r3);
+    return oM;
+  }
+
+  template<>
+  inline Vector4 Matrix4x4<float>::operator * (const Vector4 &V) const
+  {
+    simd::Float4 columns[4];
+    simd::LoadColumns(m, columns);
+
+    Vector4 oV;
+    simd::Store(&oV.x, simd::Combine(columns, simd::Load(&V.x)));
+    return oV;
+  }
+#endif
+
   typedef Matrix4x4<float> Matrix4;
 
 }
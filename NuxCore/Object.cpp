@@ -46,15 +46,16 @@ DECLARE_LOGGER(logger, "nux.core.object");
     {
       std::cerr << "[ObjectStats::Destructor] "
                 << _number_of_objects << " undeleted objects.\n\t"
-                << _allocation_list.size() << " items in allocation list.\n";
+                << _allocations.GetSize() << " items in allocation list.\n";
     }
 
     int index = 0;
+    std::vector<void*> allocations = _allocations.GetAddresses();
 
 #if defined(NUX_OS_WINDOWS)
     // Visual Studio does not support range based for loops.
-    for (AllocationList::iterator ptr = _allocation_list.begin();
-         ptr != _allocation_list.end(); ++ptr)
+    for (std::vector<void*>::iterator ptr = allocations.begin();
+         ptr != allocations.end(); ++ptr)
     {
       Object* obj = static_cast<Object*>(*ptr);
 
@@ -68,7 +69,7 @@ DECLARE_LOGGER(logger, "nux.core.object");
       std::cerr << sout.str().c_str();
     }
 #else
-    for (auto ptr : _allocation_list)
+    for (auto ptr : allocations)
     {
       Object* obj = static_cast<Object*>(ptr);
       std::cerr << "\t" << ++index << " Undeleted object: Type "
@@ -79,11 +80,80 @@ DECLARE_LOGGER(logger, "nux.core.object");
 #endif
   }
 
+#if defined(NUX_NO_OBJECT_TRACKING)
+namespace
+{
+  // Without the set of allocations, Trackable::operator new remembers the blocks it returned until the
+  // constructor of their Trackable runs and finds its address inside one of them. There is more than one
+  // pending block at a time when the arguments of a constructor allocate objects themselves.
+  struct PendingAllocation
+  {
+    const char* begin;
+    const char* end;
+  };
+
+  const int MAX_PENDING_ALLOCATIONS = 8;
+  __thread PendingAllocation pending_allocations[MAX_PENDING_ALLOCATIONS];
+  __thread int pending_allocation_count = 0;
+
+  void AddPendingAllocation(void* ptr, size_t size)
+  {
+    if (pending_allocation_count == MAX_PENDING_ALLOCATIONS)
+    {
+      std::copy(pending_allocations + 1, pending_allocations + MAX_PENDING_ALLOCATIONS, pending_allocations);
+      --pending_allocation_count;
+    }
+
+    pending_allocations[pending_allocation_count].begin = static_cast<const char*>(ptr);
+    pending_allocations[pending_allocation_count].end = static_cast<const char*>(ptr) + size;
+    ++pending_allocation_count;
+  }
+
+  void RemovePendingAllocation(int index)
+  {
+    std::copy(pending_allocations + index + 1, pending_allocations + pending_allocation_count, pending_allocations + index);
+    --pending_allocation_count;
+  }
+
+  bool ClaimPendingAllocation(const void* object)
+  {
+    const char* address = static_cast<const char*>(object);
+
+    for (int i = pending_allocation_count - 1; i >= 0; --i)
+    {
+      if (pending_allocations[i].begin <= address && address < pending_allocations[i].end)
+      {
+        RemovePendingAllocation(i);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void ReleasePendingAllocation(const void* ptr)
+  {
+    for (int i = pending_allocation_count - 1; i >= 0; --i)
+    {
+      if (pending_allocations[i].begin == ptr)
+      {
+        RemovePendingAllocation(i);
+        return;
+      }
+    }
+  }
+}
+#endif
+
   std::new_handler Trackable::_new_current_handler = 0;
 
   Trackable::Trackable()
   {
+#if defined(NUX_NO_OBJECT_TRACKING)
+    _heap_allocated = ClaimPendingAllocation(this);
+#else
     _heap_allocated = -1;
+#endif
 
     _owns_the_reference = false;
   }
@@ -148,10 +218,14 @@ DECLARE_LOGGER(logger, "nux.core.object");
     {
       ptr = ::operator new (size);
 
-      GObjectStats._allocation_list.push_front (ptr);
       NUX_STATIC_CAST (Trackable *, ptr)->_size_of_this_object = size;
+#if defined(NUX_NO_OBJECT_TRACKING)
+      AddPendingAllocation(ptr, size);
+#else
+      GObjectStats._allocations.Insert(ptr);
       GObjectStats._total_allocated_size += size;
       ++GObjectStats._number_of_objects;
+#endif
     }
     catch (std::bad_alloc &)
     {
@@ -175,13 +249,15 @@ DECLARE_LOGGER(logger, "nux.core.object");
 
   void Trackable::operator delete (void *ptr)
   {
-    ObjectStats::AllocationList::iterator i = std::find (GObjectStats._allocation_list.begin(), GObjectStats._allocation_list.end(), ptr);
-
-    if (i != GObjectStats._allocation_list.end() )
+#if defined(NUX_NO_OBJECT_TRACKING)
+    // The constructor did not run if it threw before reaching Trackable.
+    ReleasePendingAllocation(ptr);
+    ::operator delete (ptr);
+#else
+    if (GObjectStats._allocations.Erase(ptr))
     {
       GObjectStats._total_allocated_size -= NUX_STATIC_CAST (Trackable *, ptr)->_size_of_this_object;
       --GObjectStats._number_of_objects;
-      GObjectStats._allocation_list.erase (i);
       ::operator delete (ptr);
     }
 #ifdef NUX_DEBUG
@@ -190,6 +266,7 @@ DECLARE_LOGGER(logger, "nux.core.object");
       // Complain quite loudly as this should never happen.
       LOG_ERROR(logger) << "Attempting to delete a pointer we can't find.";
     }
+#endif
 #endif
   }
 
@@ -205,18 +282,15 @@ DECLARE_LOGGER(logger, "nux.core.object");
 
   bool Trackable::IsDynamic() const
   {
+#if defined(NUX_NO_OBJECT_TRACKING)
+    // Found out by the constructor.
+    return _heap_allocated;
+#else
     // Get pointer to beginning of the memory occupied by this.
     const void *ptr = dynamic_cast<const void *> (this);
 
-    // Search for ptr in allocation_list
-#if defined(NUX_OS_WINDOWS) && !defined(NUX_VISUAL_STUDIO_2010)
-    std::list<void*>::iterator i = std::find(GObjectStats._allocation_list.begin(),
-      GObjectStats._allocation_list.end(), ptr);
-#else
-    auto i = std::find(GObjectStats._allocation_list.begin(),
-                       GObjectStats._allocation_list.end(), ptr);
+    return GObjectStats._allocations.Contains(ptr);
 #endif
-    return i != GObjectStats._allocation_list.end();
   }
 
   int Trackable::GetObjectSize ()
@@ -227,10 +301,10 @@ DECLARE_LOGGER(logger, "nux.core.object");
 //////////////////////////////////////////////////////////////////////
 
   Object::Object(bool OwnTheReference, NUX_FILE_LINE_DECL)
-    : reference_count_(new NThreadSafeCounter())
-    , objectptr_count_(new NThreadSafeCounter())
+    : reference_count_(1)
+    , objectptr_count_(0)
+    , weak_references_(NULL)
   {
-    reference_count_->Set(1);
     SetOwnedReference(OwnTheReference);
 #ifdef NUX_DEBUG
     std::ostringstream sout;
@@ -248,19 +322,19 @@ DECLARE_LOGGER(logger, "nux.core.object");
     if (IsHeapAllocated())
     {
       // If the object has properly been UnReference, it should have gone
-      // through Destroy(). if that is the case then _reference_count should
-      // be NULL or its value (returned by GetValue ()) should be equal to 0;
+      // through Destroy(). if that is the case then reference_count_ should
+      // be equal to 0;
       // We can use this to detect when delete is called directly on an
       // object.
-      if (reference_count_->GetValue() > 0)
+      if (reference_count_ > 0)
       {
         LOG_WARN(logger) << "Invalid object destruction, still has "
-                         << reference_count_->GetValue() << " references."
+                         << reference_count_ << " references."
                          << "\nObject allocated at: " << GetAllocationLocation() << "\n";
       }
     }
-    delete reference_count_;
-    delete objectptr_count_;
+
+    ExpireWeakReferences();
   }
 
   bool Object::Reference()
@@ -278,7 +352,7 @@ DECLARE_LOGGER(logger, "nux.core.object");
       // The ref count remains at 1. Exit the method.
       return true;
     }
-    reference_count_->Increment();
+    reference_count_.fetch_add(1, std::memory_order_relaxed);
     return true;
   }
 
@@ -291,7 +365,7 @@ DECLARE_LOGGER(logger, "nux.core.object");
       return false;
     }
 
-    if (objectptr_count_->GetValue() == reference_count_->GetValue())
+    if (objectptr_count_ == reference_count_)
     {
       // There are ObjectPtr's hosting this object. Release all of them to
       // destroy this object.  This prevent from calling UnReference () many
@@ -306,9 +380,7 @@ DECLARE_LOGGER(logger, "nux.core.object");
       return false;
     }
 
-    reference_count_->Decrement();
-
-    if (reference_count_->GetValue() == 0)
+    if (reference_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
     {
       Destroy();
       return true;
@@ -349,7 +421,7 @@ DECLARE_LOGGER(logger, "nux.core.object");
     LOG_TRACE(logger) << "Depth: " << delete_depth << ", about to delete "
                       << obj_type << " allocated at " << GetAllocationLocation();
 #endif
-    // Weak smart pointers will clear their pointers when they get this signal.
+    ExpireWeakReferences();
     object_destroyed.emit(this);
     delete this;
 #ifdef NUX_DEBUG
@@ -358,14 +430,42 @@ DECLARE_LOGGER(logger, "nux.core.object");
 #endif
   }
 
+  ObjectWeakReferences* Object::GetWeakReferences()
+  {
+    ObjectWeakReferences* weak_references = weak_references_.load(std::memory_order_acquire);
+
+    if (!weak_references)
+    {
+      ObjectWeakReferences* created = new ObjectWeakReferences();
+
+      if (weak_references_.compare_exchange_strong(weak_references, created, std::memory_order_acq_rel))
+        weak_references = created;
+      else
+        delete created;
+    }
+
+    return weak_references;
+  }
+
+  void Object::ExpireWeakReferences()
+  {
+    ObjectWeakReferences* weak_references = weak_references_.exchange(NULL, std::memory_order_acq_rel);
+
+    if (weak_references)
+    {
+      weak_references->alive_.store(false, std::memory_order_release);
+      weak_references->UnReference();
+    }
+  }
+
 int Object::GetReferenceCount() const
 {
-  return reference_count_->GetValue();
+  return reference_count_;
 }
 
 int Object::ObjectPtrCount() const
 {
-  return objectptr_count_->GetValue();
+  return objectptr_count_;
 }
 
 std::string Object::GetAllocationLocation() const
@@ -24,11 +24,13 @@
 #ifndef NUXCORE_OBJECT_H
 #define NUXCORE_OBJECT_H
 
+#include <atomic>
 #include <string>
 
 #include <sigc++/trackable.h>
 #include <sigc++/signal.h>
 #include <boost/utility.hpp>
+#include "AllocationSet.h"
 #include "ObjectType.h"
 #include "Property.h"
 #include "PropertyTraits.h"
@@ -53,10 +55,14 @@ namespace nux
   {
     NUX_DECLARE_GLOBAL_OBJECT (ObjectStats, GlobalSingletonInitializer);
   public:
-    typedef std::list<void*> AllocationList;
-    AllocationList _allocation_list;
-    int _total_allocated_size;  //! Total allocated memory size in bytes.
-    int _number_of_objects;     //! Number of allocated objects;
+    //! Addresses of the objects allocated with Trackable::operator new.
+    /*!
+        The objects are not tracked, and the statistics are not updated, if Nux is built with
+        NUX_NO_OBJECT_TRACKING defined.
+    */
+    AllocationSet _allocations;
+    std::atomic<int> _total_allocated_size;  //! Total allocated memory size in bytes.
+    std::atomic<int> _number_of_objects;     //! Number of allocated objects;
   };
 
 #define GObjectStats NUX_GLOBAL_OBJECT_INSTANCE(nux::ObjectStats)
@@ -167,6 +173,45 @@ namespace nux
     int _size_of_this_object;
   };
 
+  //! Tells the ObjectWeakPtr of an Object whether it still exists.
+  /*!
+      Allocated the first time a weak pointer is created for the object, and shared by the object and
+      its weak pointers. Released by the last of them.
+  */
+  class ObjectWeakReferences
+  {
+  public:
+    ObjectWeakReferences()
+      : alive_(true)
+      , count_(1)
+    {}
+
+    bool IsAlive() const
+    {
+      return alive_.load(std::memory_order_acquire);
+    }
+
+    void Reference()
+    {
+      count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void UnReference()
+    {
+      if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete this;
+    }
+
+  private:
+    ObjectWeakReferences(ObjectWeakReferences const&);
+    ObjectWeakReferences& operator = (ObjectWeakReferences const&);
+
+    std::atomic<bool> alive_;
+    std::atomic<int> count_;
+
+    friend class Object;
+  };
+
 //! The base class of Nux objects.
   class Object: public Trackable
   {
@@ -234,12 +279,19 @@ namespace nux
     //! Destroy the object.
     void Destroy();
 
+    //! Return the weak references of the object, after allocating them if needed.
+    ObjectWeakReferences* GetWeakReferences();
+    //! Tell the weak pointers that the object is gone.
+    void ExpireWeakReferences();
+
     Object (const Object &);
     Object &operator = (const Object &);
 
-    NThreadSafeCounter* reference_count_;
+    std::atomic<int> reference_count_;
     //!< Number of ObjectPtr hosting the object.
-    NThreadSafeCounter* objectptr_count_;
+    std::atomic<int> objectptr_count_;
+    //!< Allocated by the first ObjectWeakPtr on this object.
+    std::atomic<ObjectWeakReferences*> weak_references_;
 
     std::string allocation_location_;
     std::string allocation_stacktrace_;
@@ -24,6 +24,8 @@
 #ifndef NUXCORE_OBJECTPTR_H
 #define NUXCORE_OBJECTPTR_H
 
+#include <utility>
+
 #include <sigc++/connection.h>
 #include <sigc++/functors/mem_fun.h>
 
@@ -52,11 +54,18 @@ namespace nux
     {
       if (ptr_)
       {
-        ptr_->objectptr_count_->Increment();
+        ptr_->objectptr_count_.fetch_add(1, std::memory_order_relaxed);
         ptr_->Reference();
       }
     }
 
+    //! Move constructor
+    ObjectPtr(ObjectPtr<T>&& other)
+      : ptr_(other.ptr_)
+    {
+      other.ptr_ = NULL;
+    }
+
     //! Copy constructor
     /*!
         This method takes advantage of the nux type information using the
@@ -72,7 +81,7 @@ namespace nux
           other.ptr_->Type().IsDerivedFromType(T::StaticObjectType))
       {
         ptr_ = static_cast<T*>(other.ptr_);
-        ptr_->objectptr_count_->Increment();
+        ptr_->objectptr_count_.fetch_add(1, std::memory_order_relaxed);
         ptr_->Reference();
       }
     }
@@ -97,7 +106,7 @@ namespace nux
         }
 
         ptr_ = ptr;
-        ptr_->objectptr_count_->Increment();
+        ptr_->objectptr_count_.fetch_add(1, std::memory_order_relaxed);
         ptr_->Reference();
       }
     }
@@ -124,7 +133,7 @@ namespace nux
         }
 
         ptr_ = static_cast<T*>(ptr);
-        ptr_->objectptr_count_->Increment();
+        ptr_->objectptr_count_.fetch_add(1, std::memory_order_relaxed);
         ptr_->Reference();
       }
     }
@@ -179,6 +188,17 @@ namespace nux
         return *this;
     }
 
+    //! Move assignment of a smart pointer of type T.
+    /*!
+        @param other Smart pointer of type T. It is null after the call.
+    */
+    ObjectPtr& operator=(ObjectPtr<T>&& other)
+    {
+        ObjectPtr<T> temp(std::move(other));
+        Swap(temp);
+        return *this;
+    }
+
     //! Assignment of a smart pointer of type O that inherits from type T.
     /*!
         @param other Smart pointer of type O.
@@ -313,11 +333,13 @@ namespace nux
     template <typename U>
     bool operator == (ObjectWeakPtr<U> const& other) const
     {
-      if (other.ptr_ &&
-          (!other.ptr_->Type().IsDerivedFromType (T::StaticObjectType) ) )
+      U* ptr = other.GetPointer();
+
+      if (ptr &&
+          (!ptr->Type().IsDerivedFromType (T::StaticObjectType) ) )
         return false;
 
-      return ptr_ == static_cast<T*>(other.ptr_);
+      return ptr_ == static_cast<T*>(ptr);
     }
 
     //! Release the hosted pointer from this object.
@@ -342,7 +364,7 @@ namespace nux
       }
 
       // Decrease the number of strong reference on the hosted pointer.
-      ptr_->objectptr_count_->Decrement();
+      ptr_->objectptr_count_.fetch_sub(1, std::memory_order_relaxed);
       bool destroyed = ptr_->UnReference();
       ptr_ = NULL;
       return destroyed;
@@ -361,10 +383,10 @@ namespace nux
 //! A weak smart pointer class. Implemented as an intrusive smart pointer.
   /*!
       A weak smart pointer is built from a smart pointer or another weak smart
-      pointer. It increments and decrements the total reference count of an
-      pointer. Even is the original pointer is destroyed, weak smart pointers
-      still point to the RefCounts pointers of the original pointer and can
-      use it to check if the pointer is still valid or not.
+      pointer. It does not keep the hosted object alive. The hosted object and
+      its weak smart pointers share an ObjectWeakReferences, allocated the first
+      time a weak smart pointer is created for the object, that outlives the
+      object and tells the weak smart pointers whether it has been destroyed.
   */
   template <typename T>
   class ObjectWeakPtr
@@ -373,6 +395,7 @@ namespace nux
     //! Constructor
     ObjectWeakPtr()
       : ptr_(NULL)
+      , weak_references_(NULL)
     {
     }
 
@@ -386,9 +409,10 @@ namespace nux
         longer have a reference on ptr.
     */
     explicit ObjectWeakPtr(T* ptr)
-      : ptr_(ptr)
+      : ptr_(NULL)
+      , weak_references_(NULL)
     {
-      ConnectListener();
+      Attach(ptr);
     }
 
     //! Construction with a base pointer of type O that inherits from type T.
@@ -403,12 +427,12 @@ namespace nux
     template <typename O>
     explicit ObjectWeakPtr(O* ptr, bool /* WarnMissuse */ = false)
       : ptr_(NULL)
+      , weak_references_(NULL)
     {
       if (ptr &&
           (ptr->Type().IsDerivedFromType(T::StaticObjectType)))
       {
-        ptr_ = static_cast<T*>(ptr);
-        ConnectListener();
+        Attach(static_cast<T*>(ptr));
       }
     }
 
@@ -417,9 +441,10 @@ namespace nux
         @param other Parameter with type T.
     */
     ObjectWeakPtr(ObjectWeakPtr<T> const& other)
-      : ptr_(other.ptr_)
+      : ptr_(NULL)
+      , weak_references_(NULL)
     {
-      ConnectListener();
+      Share(other.GetPointer(), other.weak_references_);
     }
 
     //! Copy constructor
@@ -429,12 +454,14 @@ namespace nux
     template <typename O>
     ObjectWeakPtr(const ObjectWeakPtr<O>& other)
       : ptr_(NULL)
+      , weak_references_(NULL)
     {
-      if (other.ptr_ &&
-          (other.ptr_->Type().IsDerivedFromType(T::StaticObjectType)))
+      O* ptr = other.GetPointer();
+
+      if (ptr &&
+          (ptr->Type().IsDerivedFromType(T::StaticObjectType)))
       {
-        ptr_ = static_cast<T*>(other.ptr_);
-        ConnectListener();
+        Share(static_cast<T*>(ptr), other.weak_references_);
       }
     }
 
@@ -445,12 +472,12 @@ namespace nux
     template <typename O>
     ObjectWeakPtr(const ObjectPtr<O> &other)
       : ptr_(NULL)
+      , weak_references_(NULL)
     {
       if (other.ptr_ &&
           (other.ptr_->Type().IsDerivedFromType(T::StaticObjectType)))
       {
-        ptr_ = static_cast<T*>(other.ptr_);
-        ConnectListener();
+        Attach(static_cast<T*>(other.ptr_));
       }
     }
 
@@ -460,14 +487,11 @@ namespace nux
     */
     ObjectWeakPtr& operator = (ObjectWeakPtr<T> const& other)
     {
-      Disconnect();
-      ptr_ = other.ptr_;
-      ConnectListener();
+      ObjectWeakPtr<T> temp(other);
+      Swap(temp);
       return *this;
     }
 
-    // Warning: We are not sure that other.ptr_ is valid.
-    // Warning: Cannot call other.ptr_->Type().IsDerivedFromType (T::StaticObjectType)
     //! Assignment of a weak smart pointer of Type O that inherits from type T.
     /*!
         @param other Weak smart pointer of type O.
@@ -475,13 +499,8 @@ namespace nux
     template <typename O>
     ObjectWeakPtr &operator = (const ObjectWeakPtr<O>& other)
     {
-      Disconnect();
-      if (other.ptr_ &&
-          other.ptr_->Type().IsDerivedFromType(T::StaticObjectType))
-      {
-        ptr_ = static_cast<T*>(other.ptr_);
-        ConnectListener();
-      }
+      ObjectWeakPtr<T> temp(other);
+      Swap(temp);
       return *this;
     }
 
@@ -492,13 +511,8 @@ namespace nux
     template <typename O>
     ObjectWeakPtr &operator = (const ObjectPtr<O>& other)
     {
-      Disconnect();
-      if (other.ptr_ &&
-          other.ptr_->Type().IsDerivedFromType(T::StaticObjectType))
-      {
-        ptr_ = static_cast<T*>(other.ptr_);
-        ConnectListener();
-      }
+      ObjectWeakPtr<T> temp(other);
+      Swap(temp);
       return *this;
     }
 
@@ -511,60 +525,54 @@ namespace nux
     */
     ObjectWeakPtr& operator = (T* ptr)
     {
-      Disconnect();
-      ptr_ = ptr;
-      ConnectListener();
+      ObjectWeakPtr<T> temp(ptr);
+      Swap(temp);
       return *this;
     }
 
     template <typename O>
     ObjectWeakPtr &operator = (O* ptr)
     {
-      Disconnect();
-      if (ptr &&
-          ptr->Type().IsDerivedFromType(T::StaticObjectType))
-      {
-        ptr_ = static_cast<T*>(ptr);
-        ConnectListener();
-      }
+      ObjectWeakPtr<T> temp(ptr);
+      Swap(temp);
       return *this;
     }
 
     ~ObjectWeakPtr()
     {
-      Disconnect();
+      Detach();
     }
 
     T& operator* () const
     {
-      nuxAssert (ptr_ != 0);
-      return *(const_cast<T*>(ptr_));
+      nuxAssert (IsValid());
+      return *GetPointer();
     }
 
     T* operator -> () const
     {
-      nuxAssert (ptr_ != 0);
-      return const_cast<T*>(ptr_);
+      nuxAssert (IsValid());
+      return GetPointer();
     }
 
     bool operator < (T *ptr) const
     {
-      return (ptr_ < ptr);
+      return (GetPointer() < ptr);
     }
 
     bool operator > (T *ptr) const
     {
-      return (ptr_ > ptr);
+      return (GetPointer() > ptr);
     }
 
     bool operator < (ObjectWeakPtr<T> other) const
     {
-      return (ptr_ < other.ptr_);
+      return (GetPointer() < other.GetPointer());
     }
 
     bool operator > (ObjectWeakPtr<T> other) const
     {
-      return (ptr_ > other.ptr_);
+      return (GetPointer() > other.GetPointer());
     }
 
     template <typename U>
@@ -574,7 +582,7 @@ namespace nux
     }
     bool operator == (T *ptr) const
     {
-      return ptr_ == ptr;
+      return GetPointer() == ptr;
     }
 
     template<typename U>
@@ -583,7 +591,7 @@ namespace nux
       if (ptr && (!ptr->Type().IsDerivedFromType (T::StaticObjectType) ) )
         return false;
 
-      return ptr_ == static_cast<T*>(ptr);
+      return GetPointer() == static_cast<T*>(ptr);
     }
 
     /*!
@@ -593,10 +601,12 @@ namespace nux
     template<typename U>
     bool operator == (const ObjectWeakPtr<U>& other) const
     {
-      if (other.ptr_ && (!other.ptr_->Type().IsDerivedFromType (T::StaticObjectType) ) )
+      U* ptr = other.GetPointer();
+
+      if (ptr && (!ptr->Type().IsDerivedFromType (T::StaticObjectType) ) )
         return false;
 
-      return ptr_ == static_cast<T*>(other.ptr_);
+      return GetPointer() == static_cast<T*>(ptr);
     }
 
     /*!
@@ -609,7 +619,7 @@ namespace nux
       if (other.ptr_ && (!other.ptr_->Type().IsDerivedFromType (T::StaticObjectType) ) )
         return false;
 
-      return ptr_ == static_cast<T*>(other.ptr_);
+      return GetPointer() == static_cast<T*>(other.ptr_);
     }
 
     //! Return true is the hosted pointer is not null or has not been destroyed.
@@ -618,7 +628,7 @@ namespace nux
     */
     bool operator() () const
     {
-      return bool(ptr_);
+      return IsValid();
     }
 
     //! Return true is the hosted pointer is not null or has not been destroyed.
@@ -627,7 +637,7 @@ namespace nux
     */
     bool IsValid() const
     {
-      return (ptr_ != NULL);
+      return weak_references_ && weak_references_->IsAlive();
     }
 
     //! Return true is the hosted pointer is null or has been destroyed.
@@ -641,56 +651,63 @@ namespace nux
 
     //! Release the hosted pointer from this object.
     /*!
-        Release the hosted pointer from this object. After this call, the following members are null:
-          _reference_count
-          _weak_reference_count
-          ptr_
-        This call decreases the count of weak reference before setting _weak_reference_count to null.
+        Release the hosted pointer from this object. After this call, the
+        hosted pointer is null.
 
-        @return True this was the last weak reference on the hosted object.
+        @return Always false.
     */
     bool Release()
     {
-        Disconnect();
-        ptr_ = NULL;
+        Detach();
         return false;
     }
 
     //! Return the stored pointer.
     /*!
         Caller of this function should Reference the pointer if they intend to keep it.
-        @param Return the stored pointer.
+        @param Return the stored pointer, or null if the object has been destroyed.
     */
     T* GetPointer () const
     {
-      return ptr_;
+      return IsValid() ? ptr_ : NULL;
     }
 
   private:
-    void Disconnect()
+    void Swap(ObjectWeakPtr<T>& other)
     {
-      if (destroy_listener_.connected())
-        destroy_listener_.disconnect();
+      std::swap(ptr_, other.ptr_);
+      std::swap(weak_references_, other.weak_references_);
     }
 
-    void ConnectListener()
+    //! Start pointing to a live object.
+    void Attach(T* ptr)
     {
-      if (ptr_)
+      if (ptr)
+        Share(ptr, ptr->GetWeakReferences());
+    }
+
+    //! Start pointing to an object through weak references already obtained from it.
+    void Share(T* ptr, ObjectWeakReferences* weak_references)
+    {
+      if (ptr)
       {
-        auto slot = sigc::mem_fun(this, &ObjectWeakPtr<T>::TargetDestroyed);
-        destroy_listener_ = ptr_->object_destroyed.connect(slot);
+        ptr_ = ptr;
+        weak_references_ = weak_references;
+        weak_references_->Reference();
       }
     }
 
-    void TargetDestroyed(Object* /* ptr */)
+    void Detach()
     {
-        ptr_ = NULL;
-        // rese the connetion too
-        destroy_listener_ = sigc::connection();
+      if (weak_references_)
+        weak_references_->UnReference();
+
+      ptr_ = NULL;
+      weak_references_ = NULL;
     }
 
     T* ptr_;
-    sigc::connection destroy_listener_;
+    ObjectWeakReferences* weak_references_;
 
     template <typename O>
     friend class ObjectWeakPtr;
@@ -736,13 +753,13 @@ namespace nux
   template<typename T>
   inline bool operator == (T *ptr, const ObjectWeakPtr<T>& a)
   {
-    return a.ptr_ == ptr;
+    return a.GetPointer() == ptr;
   }
 
   template<typename T>
   inline bool operator != (T *ptr, const ObjectWeakPtr<T>& a)
   {
-    return a.ptr_ != ptr;
+    return a.GetPointer() != ptr;
   }
 
 }
@@ -24,6 +24,7 @@
 #include "NuxCore/Rect.h"
 #include "BitmapFormats.h"
 #include "CairoGraphics.h"
+#include "ImageBlur.h"
 
 namespace nux
 {
@@ -421,153 +422,18 @@ namespace nux
     return true;
   }
 
-  static inline void _blurinner(guchar* pixel,
-                                 gint*   zR,
-                                 gint*   zG,
-                                 gint*   zB,
-                                 gint*   zA,
-                                 gint    alpha,
-                                 gint    aprec,
-                                 gint    zprec)
-  {
-    gint R;
-    gint G;
-    gint B;
-    guchar A;
-
-    R = *pixel;
-    G = *(pixel + 1);
-    B = *(pixel + 2);
-    A = *(pixel + 3);
-
-    *zR += (alpha * ((R << zprec) - *zR)) >> aprec;
-    *zG += (alpha * ((G << zprec) - *zG)) >> aprec;
-    *zB += (alpha * ((B << zprec) - *zB)) >> aprec;
-    *zA += (alpha * ((A << zprec) - *zA)) >> aprec;
-
-    *pixel       = *zR >> zprec;
-    *(pixel + 1) = *zG >> zprec;
-    *(pixel + 2) = *zB >> zprec;
-    *(pixel + 3) = *zA >> zprec;
-  }
-
-  static inline void _blurrow(guchar* pixels,
-                               gint    width,
-                               gint    /* height */,  // TODO: This seems very strange. Why is height not used as it is in _blurcol() ?
-                               gint    channels,
-                               gint    line,
-                               gint    alpha,
-                               gint    aprec,
-                               gint    zprec)
-  {
-    gint    zR;
-    gint    zG;
-    gint    zB;
-    gint    zA;
-    gint    index;
-    guchar* scanline;
-
-    scanline = &(pixels[line * width * channels]);
-
-    zR = *scanline << zprec;
-    zG = *(scanline + 1) << zprec;
-    zB = *(scanline + 2) << zprec;
-    zA = *(scanline + 3) << zprec;
-
-    for (index = 0; index < width; index ++)
-      _blurinner(&scanline[index * channels], &zR, &zG, &zB, &zA, alpha, aprec,
-      zprec);
-
-    for (index = width - 2; index >= 0; index--)
-      _blurinner(&scanline[index * channels], &zR, &zG, &zB, &zA, alpha, aprec,
-      zprec);
-  }
-
-  static inline void _blurcol(guchar* pixels,
-                               gint    width,
-                               gint    height,
-                               gint    channels,
-                               gint    x,
-                               gint    alpha,
-                               gint    aprec,
-                               gint    zprec)
-  {
-    gint zR;
-    gint zG;
-    gint zB;
-    gint zA;
-    gint index;
-    guchar* ptr;
-
-    ptr = pixels;
-
-    ptr += x * channels;
-
-    zR = *((guchar*) ptr    ) << zprec;
-    zG = *((guchar*) ptr + 1) << zprec;
-    zB = *((guchar*) ptr + 2) << zprec;
-    zA = *((guchar*) ptr + 3) << zprec;
-
-    for (index = width; index < (height - 1) * width; index += width)
-      _blurinner((guchar*) &ptr[index * channels], &zR, &zG, &zB, &zA, alpha,
-      aprec, zprec);
-
-    for (index = (height - 2) * width; index >= 0; index -= width)
-      _blurinner((guchar*) &ptr[index * channels], &zR, &zG, &zB, &zA, alpha,
-      aprec, zprec);
-  }
-
-  //
-  // pixels   image-data
-  // width    image-width
-  // height   image-height
-  // channels image-channels
-  //
-  // in-place blur of image 'img' with kernel of approximate radius 'radius'
-  //
-  // blurs with two sided exponential impulse response
-  //
-  // aprec = precision of alpha parameter in fixed-point format 0.aprec
-  //
-  // zprec = precision of state parameters zR,zG,zB and zA in fp format 8.zprec
-  //
-  void _expblur(guchar* pixels,
-                 gint    width,
-                 gint    height,
-                 gint    channels,
-                 gint    radius,
-                 gint    aprec,
-                 gint    zprec)
-  {
-    gint alpha;
-    gint row = 0;
-    gint col = 0;
-
-    if (radius < 1)
-      return;
-
-    // calculate the alpha such that 90% of 
-    // the kernel is within the radius.
-    // (Kernel extends to infinity)
-    alpha = (gint) ((1 << aprec) * (1.0f - expf(-2.3f / (radius + 1.f))));
-
-    for (; row < height; row++)
-      _blurrow(pixels, width, height, channels, row, alpha, aprec, zprec);
-
-    for (; col < width; col++)
-      _blurcol(pixels, width, height, channels, col, alpha, aprec, zprec);
-
-    return;
-  }
-
   // if called like BlurSurface(radius) or BlurSurface(radius, NULL) it will
   // try to blur the image-surface of the internal cairo-context
   bool CairoGraphics::BlurSurface(unsigned int radius, cairo_surface_t* surf)
+  {
+    return BlurSurfaceRegion(radius, Rect(0, 0, G_MAXINT / 2, G_MAXINT / 2), surf);
+  }
+
+  bool CairoGraphics::BlurSurfaceRegion(unsigned int radius, Rect const& region, cairo_surface_t* surf)
   {
     cairo_surface_t* surface;
     guchar*          pixels;
-    guint            width;
-    guint            height;
+    gint             stride;
     cairo_format_t   format;
 
     if (surf)
@@ -576,29 +442,31 @@ namespace nux
       surface = cairo_get_target(_cr);
 
     // don't do anything if we're not dealing with an image-surface
-      if (cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE)
+    if (cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE)
       return false;
 
     // before we mess with the surface execute any pending drawing
     cairo_surface_flush(surface);
 
     pixels = cairo_image_surface_get_data(surface);
-    width  = cairo_image_surface_get_width(surface);
-    height = cairo_image_surface_get_height(surface);
+    stride = cairo_image_surface_get_stride(surface);
     format = cairo_image_surface_get_format(surface);
 
+    Rect rect = region.Intersect(Rect(0, 0, cairo_image_surface_get_width(surface), cairo_image_surface_get_height(surface)));
+
+    if (rect.IsNull())
+      return true;
+
     switch(format)
     {
       case CAIRO_FORMAT_ARGB32:
-        _expblur(pixels, width, height, 4, radius, 16, 7);
-      break;
-
       case CAIRO_FORMAT_RGB24:
-        _expblur(pixels, width, height, 3, radius, 16, 7);
+        // RGB24 pixels also use 32 bits.
+        ExpBlur(pixels + rect.y * stride + rect.x * 4, rect.width, rect.height, stride, 4, radius);
       break;
 
       case CAIRO_FORMAT_A8:
-        _expblur(pixels, width, height, 1, radius, 16, 7);
+        ExpBlur(pixels + rect.y * stride + rect.x, rect.width, rect.height, stride, 1, radius);
       break;
 
       default :
@@ -607,7 +475,7 @@ namespace nux
     }
 
     // inform cairo we altered the surfaces contents
-    cairo_surface_mark_dirty(surface);
+    cairo_surface_mark_dirty_rectangle(surface, rect.x, rect.y, rect.width, rect.height);
 
     return true;
   }
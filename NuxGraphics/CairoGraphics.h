@@ -118,6 +118,18 @@ private:
 
     bool BlurSurface(unsigned int radius, cairo_surface_t* surf = NULL);
 
+    //! Blur a sub-rectangle of an image surface.
+    /*!
+        The sub-rectangle is blurred as if it was a separate image: the pixels around it are left untouched
+        and do not contribute to the result.
+
+        @param radius Approximate radius of the blur kernel.
+        @param region The sub-rectangle to blur. It is clipped to the surface.
+        @param surf The surface to blur. If NULL, the target surface of the cairo context is blurred.
+        @return False if the surface is not an image surface.
+    */
+    bool BlurSurfaceRegion(unsigned int radius, Rect const& region, cairo_surface_t* surf = NULL);
+
     bool IntersectRectClipRegion(double x, double y, double w, double h);
 
     bool IntersectGeneralClipRegion(std::list<Rect> &region);
@@ -463,8 +463,8 @@ std::string FontAsmFrgRect("!!ARBfp1.0        \n\
       CurX += abcA + abcB + abcC;
     }
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    _graphics_engine.GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    _graphics_engine.GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     int in_attrib_position = 0;
     int in_attrib_tex_uv = 0;
@@ -494,12 +494,12 @@ std::string FontAsmFrgRect("!!ARBfp1.0        \n\
 
       if (FontTexture != -1)
       {
-        CHECKGL(glUniform1iARB(FontTexture, 0));
+        _shader_prog->SetUniform1i(FontTexture, 0);
       }
 
       if (TextColor != -1)
       {
-        CHECKGL(glUniform4fARB(TextColor, color.red, color.green, color.blue, color.alpha));
+        _shader_prog->SetUniform4f(TextColor, color.red, color.green, color.blue, color.alpha);
       }
     }
 #ifndef NUX_OPENGLES_20
@@ -537,25 +537,25 @@ std::string FontAsmFrgRect("!!ARBfp1.0        \n\
 
     if (in_attrib_offset != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(in_attrib_offset));
+      _graphics_engine.GetRenderStates().EnableVertexAttribArray(in_attrib_offset);
       CHECKGL(glVertexAttribPointerARB(in_attrib_offset, 4, GL_FLOAT, GL_FALSE, 16, Offset));
     }
 
     if (in_attrib_position != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(in_attrib_position));
+      _graphics_engine.GetRenderStates().EnableVertexAttribArray(in_attrib_position);
       CHECKGL(glVertexAttribPointerARB(in_attrib_position, 4, GL_FLOAT, GL_FALSE, 16, Position));
     }
 
     if (in_attrib_scale != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(in_attrib_scale));
+      _graphics_engine.GetRenderStates().EnableVertexAttribArray(in_attrib_scale);
       CHECKGL(glVertexAttribPointerARB(in_attrib_scale, 4, GL_FLOAT, GL_FALSE, 16, Scale));
     }
 
     if (in_attrib_tex_uv != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(in_attrib_tex_uv));
+      _graphics_engine.GetRenderStates().EnableVertexAttribArray(in_attrib_tex_uv);
       CHECKGL(glVertexAttribPointerARB(in_attrib_tex_uv, 4, GL_FLOAT, GL_FALSE, 16, UV));
     }
 
@@ -563,16 +563,16 @@ std::string FontAsmFrgRect("!!ARBfp1.0        \n\
       CHECKGL(glDrawElements( GL_TRIANGLES, NumCharToDraw * 6, GL_UNSIGNED_SHORT, Index ));
 
     if (in_attrib_position != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(in_attrib_position));
+      _graphics_engine.GetRenderStates().DisableVertexAttribArray(in_attrib_position);
 
     if (in_attrib_offset != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(in_attrib_offset));
+      _graphics_engine.GetRenderStates().DisableVertexAttribArray(in_attrib_offset);
 
     if (in_attrib_scale != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(in_attrib_scale));
+      _graphics_engine.GetRenderStates().DisableVertexAttribArray(in_attrib_scale);
 
     if (in_attrib_tex_uv != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(in_attrib_tex_uv));
+      _graphics_engine.GetRenderStates().DisableVertexAttribArray(in_attrib_tex_uv);
 
     if (_graphics_engine.UsingGLSLCodePath())
     {
@@ -107,11 +107,20 @@ namespace nux
   } s_StateLUT;
 
 
+  GpuRenderStates::BindingStats::BindingStats()
+    : issued(0)
+    , suppressed(0)
+  {
+  }
+
   GpuRenderStates::GpuRenderStates(GpuBrand board, GpuInfo* info)
   {
     gpu_brand_ = board;
     gpu_info_ = info;
     Memcpy(&render_state_changes_, &s_StateLUT.default_render_state, sizeof(render_state_changes_));
+
+    binding_tracking_ = true;
+    InvalidateBindings();
   }
 
   GpuRenderStates::~GpuRenderStates()
@@ -119,6 +128,71 @@ namespace nux
 
   }
 
+  void GpuRenderStates::SetStateChangeCallback(std::function<void()> const& callback)
+  {
+    state_change_callback_ = callback;
+  }
+
+  void GpuRenderStates::SetBindingTracking(bool enabled)
+  {
+    binding_tracking_ = enabled;
+    InvalidateBindings();
+  }
+
+  bool GpuRenderStates::IsBindingTrackingEnabled() const
+  {
+    return binding_tracking_;
+  }
+
+  void GpuRenderStates::InvalidateBindings()
+  {
+    program_ = UNKNOWN_BINDING;
+    active_texture_unit_ = UNKNOWN_BINDING;
+
+    for (int i = 0; i < MAX_TEXTURE_UNITS; ++i)
+    {
+      for (int j = 0; j < MAX_TEXTURE_TARGETS; ++j)
+        textures_[i][j] = UNKNOWN_BINDING;
+    }
+
+    array_buffer_ = UNKNOWN_BINDING;
+    element_array_buffer_ = UNKNOWN_BINDING;
+    known_vertex_attrib_arrays_ = 0;
+    enabled_vertex_attrib_arrays_ = 0;
+    scissor_known_ = false;
+  }
+
+  void GpuRenderStates::ForgetTexture(unsigned int texture)
+  {
+    for (int i = 0; i < MAX_TEXTURE_UNITS; ++i)
+    {
+      for (int j = 0; j < MAX_TEXTURE_TARGETS; ++j)
+      {
+        if (textures_[i][j] == texture)
+          textures_[i][j] = 0;
+      }
+    }
+  }
+
+  void GpuRenderStates::ForgetBuffer(unsigned int buffer)
+  {
+    if (array_buffer_ == buffer)
+      array_buffer_ = 0;
+
+    if (element_array_buffer_ == buffer)
+      element_array_buffer_ = 0;
+  }
+
+  void GpuRenderStates::ResetBindingStats()
+  {
+    binding_stats_ = BindingStats();
+  }
+
+  GpuRenderStates::BindingStats const& GpuRenderStates::GetBindingStats() const
+  {
+    return binding_stats_;
+  }
+
   void GpuRenderStates::ResetDefault()
   {
     HW__EnableCulling( s_StateLUT.default_render_state[GFXRS_CULLFACEENABLE].iValue );
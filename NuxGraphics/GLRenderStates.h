@@ -26,6 +26,8 @@
 #include "NuxCore/NuxCore.h"
 #include "GpuDevice.h"
 
+#include <functional>
+
 namespace nux
 {
 
@@ -250,10 +252,61 @@ namespace nux
     inline void SetPolygonOffset(unsigned int bEnable,
                                   float Factor = 0.0f, float Units = 0.0f);
 
+    //! Set a function that is called before any render state is changed in OpenGL.
+    /*!
+        The GraphicsEngine uses it to render its pending batch of quads with the states they were added with.
+    */
+    void SetStateChangeCallback(std::function<void()> const& callback);
+
+    // Bindings
+    //! Statistics of the binding calls made through the render states.
+    struct BindingStats
+    {
+      BindingStats();
+
+      int issued;       //!< Binding calls that reached OpenGL.
+      int suppressed;   //!< Binding calls dropped because they would not change the OpenGL state.
+    };
+
+    //! Enable or disable the tracking of the bindings.
+    /*!
+        While the tracking is enabled, the program, texture, vertex and index buffer, vertex attribute array and
+        scissor calls made through the render states are dropped when the state they set is already current.
+        Disable it while code that is not aware of the render states (the compositor in embedded mode) changes
+        the bindings. Changing the tracking forgets the known bindings.
+    */
+    void SetBindingTracking(bool enabled);
+    bool IsBindingTrackingEnabled() const;
+    //! Forget the known bindings. The next call to each binding function reaches OpenGL.
+    void InvalidateBindings();
+
+    inline void UseProgram(unsigned int program);
+    inline void ActiveTexture(unsigned int texture_unit);
+    //! Bind a texture to the active texture unit.
+    inline void BindTexture(unsigned int target, unsigned int texture);
+    //! Bind a buffer. Only the GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER bindings are tracked.
+    inline void BindBuffer(unsigned int target, unsigned int buffer);
+    inline void EnableVertexAttribArray(unsigned int index);
+    inline void DisableVertexAttribArray(unsigned int index);
+    inline void SetScissor(int x, int y, int width, int height);
+
+    //! Forget the bindings of a texture or a buffer that is about to be deleted.
+    /*!
+        OpenGL reverts the bindings of a deleted object to 0, and its name may be reused by a new object.
+    */
+    void ForgetTexture(unsigned int texture);
+    void ForgetBuffer(unsigned int buffer);
+
+    void ResetBindingStats();
+    BindingStats const& GetBindingStats() const;
+
   private:
 
     GpuBrand gpu_brand_;
     GpuInfo* gpu_info_;
+    std::function<void()> state_change_callback_;
+
+    inline void NotifyStateChange();
 
 #ifndef NUX_OPENGLES_20
     inline void HW__EnableAlphaTest(unsigned int b);
@@ -332,6 +385,37 @@ namespace nux
   private:
     RenderStateMap render_state_changes_[GFXRS_MAX_RENDERSTATES];
     RenderStateMap sampler_state_changes_[4][GFXSS_MAX_SAMPLERSTATES];
+
+    enum
+    {
+      TEXTURE_TARGET_2D,
+      TEXTURE_TARGET_CUBE_MAP,
+#ifndef NUX_OPENGLES_20
+      TEXTURE_TARGET_1D,
+      TEXTURE_TARGET_3D,
+      TEXTURE_TARGET_RECTANGLE,
+#endif
+      MAX_TEXTURE_TARGETS
+    };
+
+    static const int MAX_TEXTURE_UNITS = 32;
+    //! Value of a binding that is not known.
+    static const unsigned int UNKNOWN_BINDING = 0xFFFFFFFF;
+
+    inline bool IsBindingKnown(unsigned int& binding, unsigned int value);
+    inline int TextureTargetIndex(unsigned int target) const;
+
+    bool binding_tracking_;
+    unsigned int program_;
+    unsigned int active_texture_unit_;
+    unsigned int textures_[MAX_TEXTURE_UNITS][MAX_TEXTURE_TARGETS];
+    unsigned int array_buffer_;
+    unsigned int element_array_buffer_;
+    unsigned int known_vertex_attrib_arrays_;    //!< Bit mask of the vertex attribute arrays whose state is known.
+    unsigned int enabled_vertex_attrib_arrays_;  //!< Bit mask of the known vertex attribute arrays that are enabled.
+    bool scissor_known_;
+    int scissor_[4];
+    BindingStats binding_stats_;
   };
 
 
@@ -792,9 +876,170 @@ namespace nux
   }
 #endif
 
+  inline void GpuRenderStates::NotifyStateChange()
+  {
+    if (state_change_callback_)
+      state_change_callback_();
+  }
+
+  inline bool GpuRenderStates::IsBindingKnown(unsigned int& binding, unsigned int value)
+  {
+    if (binding_tracking_ && binding == value)
+    {
+      ++binding_stats_.suppressed;
+      return true;
+    }
+
+    ++binding_stats_.issued;
+
+    if (binding_tracking_)
+      binding = value;
+    else
+      binding = UNKNOWN_BINDING;
+
+    return false;
+  }
+
+  inline int GpuRenderStates::TextureTargetIndex(unsigned int target) const
+  {
+    switch (target)
+    {
+    case GL_TEXTURE_2D:
+      return TEXTURE_TARGET_2D;
+    case GL_TEXTURE_CUBE_MAP:
+      return TEXTURE_TARGET_CUBE_MAP;
+#ifndef NUX_OPENGLES_20
+    case GL_TEXTURE_1D:
+      return TEXTURE_TARGET_1D;
+    case GL_TEXTURE_3D:
+      return TEXTURE_TARGET_3D;
+    case GL_TEXTURE_RECTANGLE_ARB:
+      return TEXTURE_TARGET_RECTANGLE;
+#endif
+    default:
+      return -1;
+    }
+  }
+
+  inline void GpuRenderStates::UseProgram(unsigned int program)
+  {
+    if (IsBindingKnown(program_, program))
+      return;
+
+    CHECKGL(glUseProgramObjectARB(program));
+  }
+
+  inline void GpuRenderStates::ActiveTexture(unsigned int texture_unit)
+  {
+    if (IsBindingKnown(active_texture_unit_, texture_unit))
+      return;
+
+    CHECKGL(glActiveTextureARB(texture_unit));
+  }
+
+  inline void GpuRenderStates::BindTexture(unsigned int target, unsigned int texture)
+  {
+    unsigned int unit = active_texture_unit_ - GL_TEXTURE0;
+    int target_index = TextureTargetIndex(target);
+
+    if (unit < MAX_TEXTURE_UNITS && target_index >= 0)
+    {
+      if (IsBindingKnown(textures_[unit][target_index], texture))
+        return;
+    }
+    else
+    {
+      // The unit is not known, or the target is not tracked.
+      ++binding_stats_.issued;
+    }
+
+    CHECKGL(glBindTexture(target, texture));
+  }
+
+  inline void GpuRenderStates::BindBuffer(unsigned int target, unsigned int buffer)
+  {
+    if (target == GL_ARRAY_BUFFER_ARB)
+    {
+      if (IsBindingKnown(array_buffer_, buffer))
+        return;
+    }
+    else if (target == GL_ELEMENT_ARRAY_BUFFER_ARB)
+    {
+      if (IsBindingKnown(element_array_buffer_, buffer))
+        return;
+    }
+    else
+    {
+      ++binding_stats_.issued;
+    }
+
+    CHECKGL(glBindBufferARB(target, buffer));
+  }
+
+  inline void GpuRenderStates::EnableVertexAttribArray(unsigned int index)
+  {
+    unsigned int bit = (index < 32) ? (1u << index) : 0;
+
+    if (binding_tracking_ && (known_vertex_attrib_arrays_ & enabled_vertex_attrib_arrays_ & bit))
+    {
+      ++binding_stats_.suppressed;
+      return;
+    }
+
+    ++binding_stats_.issued;
+    CHECKGL(glEnableVertexAttribArrayARB(index));
+
+    if (binding_tracking_)
+    {
+      known_vertex_attrib_arrays_ |= bit;
+      enabled_vertex_attrib_arrays_ |= bit;
+    }
+  }
+
+  inline void GpuRenderStates::DisableVertexAttribArray(unsigned int index)
+  {
+    unsigned int bit = (index < 32) ? (1u << index) : 0;
+
+    if (binding_tracking_ && (known_vertex_attrib_arrays_ & ~enabled_vertex_attrib_arrays_ & bit))
+    {
+      ++binding_stats_.suppressed;
+      return;
+    }
+
+    ++binding_stats_.issued;
+    CHECKGL(glDisableVertexAttribArrayARB(index));
+
+    if (binding_tracking_)
+    {
+      known_vertex_attrib_arrays_ |= bit;
+      enabled_vertex_attrib_arrays_ &= ~bit;
+    }
+  }
+
+  inline void GpuRenderStates::SetScissor(int x, int y, int width, int height)
+  {
+    if (binding_tracking_ && scissor_known_ &&
+        scissor_[0] == x && scissor_[1] == y && scissor_[2] == width && scissor_[3] == height)
+    {
+      ++binding_stats_.suppressed;
+      return;
+    }
+
+    ++binding_stats_.issued;
+    CHECKGL(glScissor(x, y, width, height));
+
+    scissor_known_ = binding_tracking_;
+    scissor_[0] = x;
+    scissor_[1] = y;
+    scissor_[2] = width;
+    scissor_[3] = height;
+  }
+
 #ifndef NUX_OPENGLES_20
   inline void GpuRenderStates::HW__EnableAlphaTest(unsigned int b)
   {
+    NotifyStateChange();
+
     if (b)
     {
       CHECKGL(glEnable(GL_ALPHA_TEST));
@@ -810,6 +1055,8 @@ namespace nux
   inline void GpuRenderStates::HW__SetAlphaTestFunc(unsigned int AlphaTestFunc_,
       BYTE  AlphaTestRef_)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (AlphaTestFunc_ == GL_NEVER) ||
       (AlphaTestFunc_ == GL_LESS) ||
@@ -829,6 +1076,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__EnableAlphaBlend(unsigned int b)
   {
+    NotifyStateChange();
+
     if (b)
     {
       CHECKGL(glEnable(GL_BLEND));
@@ -847,6 +1096,8 @@ namespace nux
     unsigned int SrcFactorAlpha_,
     unsigned int DestFactorAlpha_)
   {
+    NotifyStateChange();
+
     nuxAssertMsg((SrcBlendFactor_ == GL_ZERO) || (SrcBlendFactor_ == GL_ONE) || (SrcBlendFactor_ == GL_SRC_COLOR) || (SrcBlendFactor_ == GL_ONE_MINUS_SRC_COLOR) || (SrcBlendFactor_ == GL_DST_COLOR) || (SrcBlendFactor_ == GL_ONE_MINUS_DST_COLOR) || (SrcBlendFactor_ == GL_SRC_ALPHA) || (SrcBlendFactor_ == GL_ONE_MINUS_SRC_ALPHA) || (SrcBlendFactor_ == GL_DST_ALPHA) || (SrcBlendFactor_ == GL_ONE_MINUS_DST_ALPHA) || (SrcBlendFactor_ == GL_CONSTANT_COLOR) || (SrcBlendFactor_ == GL_ONE_MINUS_CONSTANT_COLOR) || (SrcBlendFactor_ == GL_CONSTANT_ALPHA) || (SrcBlendFactor_ == GL_ONE_MINUS_CONSTANT_ALPHA) || (SrcBlendFactor_ == GL_SRC_ALPHA_SATURATE),
                    "Error(HW__SetSeparateAlphaBlendFactors): Invalid Blend RenderState");
     nuxAssertMsg((DestBlendFactor_ == GL_ZERO) || (DestBlendFactor_ == GL_ONE) || (DestBlendFactor_ == GL_SRC_COLOR) || (DestBlendFactor_ == GL_ONE_MINUS_SRC_COLOR) || (DestBlendFactor_ == GL_DST_COLOR) || (DestBlendFactor_ == GL_ONE_MINUS_DST_COLOR) || (DestBlendFactor_ == GL_SRC_ALPHA) || (DestBlendFactor_ == GL_ONE_MINUS_SRC_ALPHA) || (DestBlendFactor_ == GL_DST_ALPHA) || (DestBlendFactor_ == GL_ONE_MINUS_DST_ALPHA) || (DestBlendFactor_ == GL_CONSTANT_COLOR) || (DestBlendFactor_ == GL_ONE_MINUS_CONSTANT_COLOR) || (DestBlendFactor_ == GL_CONSTANT_ALPHA) || (DestBlendFactor_ == GL_ONE_MINUS_CONSTANT_ALPHA),
@@ -872,6 +1123,8 @@ namespace nux
     unsigned int BlendOpRGB_,
     unsigned int BlendOpAlpha_)
   {
+    NotifyStateChange();
+
 #ifdef NUX_OPENGLES_20
     nuxAssertMsg(
       (BlendOpRGB_ == GL_FUNC_ADD) ||
@@ -922,6 +1175,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__EnableCulling(unsigned int b)
   {
+    NotifyStateChange();
+
     if (b)
     {
       CHECKGL(glEnable(GL_CULL_FACE));
@@ -937,6 +1192,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetFrontFace(unsigned int FrontFace_)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (FrontFace_ == GL_CW) ||
       (FrontFace_ == GL_CCW),
@@ -948,6 +1205,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetCullFace(unsigned int CullFace_)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (CullFace_ == GL_FRONT) ||
       (CullFace_ == GL_BACK) ||
@@ -960,6 +1219,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetEnableDepthTest(unsigned int b)
   {
+    NotifyStateChange();
+
     if (b)
     {
       CHECKGL(glEnable(GL_DEPTH_TEST));
@@ -974,6 +1235,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetDepthRange(float zNear, float zFar)
   {
+    NotifyStateChange();
+
     CHECKGL(glDepthRange(zNear, zFar));
     SET_RS_VALUE(render_state_changes_[GFXRS_ZNEAR], static_cast<unsigned int> (Clamp(zNear, 0.0f, 1.0f)));
     SET_RS_VALUE(render_state_changes_[GFXRS_ZFAR], static_cast<unsigned int> (Clamp(zFar, 0.0f, 1.0f)));
@@ -981,6 +1244,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetDepthFunc(unsigned int Func)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (Func == GL_NEVER) ||
       (Func == GL_LESS) ||
@@ -998,6 +1263,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__EnableStencil(unsigned int b)
   {
+    NotifyStateChange();
+
     if (b)
     {
       CHECKGL(glEnable(GL_STENCIL_TEST));
@@ -1012,6 +1279,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetStencilFunc(unsigned int func, int ref, unsigned int mask)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (func == GL_NEVER) ||
       (func == GL_LESS) ||
@@ -1032,6 +1301,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetStencilOp(unsigned int stencil_fail, unsigned int stencil_pass_depth_fail, unsigned int stencil_pass_depth_pass)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (stencil_fail == GL_KEEP) ||
       (stencil_fail == GL_ZERO) ||
@@ -1075,6 +1346,8 @@ namespace nux
 #if 0
   inline void GpuRenderStates::HW__EnableTwoSidedStencil(unsigned int b)
   {
+    NotifyStateChange();
+
     if (b)
     {
       if (gpu_brand_ == GPU_BRAND_AMD)
@@ -1103,6 +1376,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetStencilFrontFaceWriteMask(unsigned int WriteMask_)
   {
+    NotifyStateChange();
+
     CHECKGL(glActiveStencilFaceEXT(GL_FRONT));
     CHECKGL(glStencilMask(WriteMask_));
     SET_RS_VALUE(render_state_changes_[GFXRS_FRONT_STENCILWRITEMASK], WriteMask_);
@@ -1110,6 +1385,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetStencilBackFaceWriteMask(unsigned int WriteMask_)
   {
+    NotifyStateChange();
+
     CHECKGL(glActiveStencilFaceEXT(GL_BACK));
     CHECKGL(glStencilMask(WriteMask_));
     SET_RS_VALUE(render_state_changes_[GFXRS_BACK_STENCILWRITEMASK], WriteMask_);
@@ -1119,6 +1396,8 @@ namespace nux
       unsigned int Ref_,
       unsigned int Mask_)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (Func_ == GL_NEVER) ||
       (Func_ == GL_LESS) ||
@@ -1143,6 +1422,8 @@ namespace nux
     unsigned int Ref_,
     unsigned int Mask_)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (Func_ == GL_NEVER) ||
       (Func_ == GL_LESS) ||
@@ -1174,6 +1455,8 @@ namespace nux
     unsigned int ZFailOp_,
     unsigned int ZPassOp_)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (FailOp_ == GL_KEEP) ||
       (FailOp_ == GL_ZERO) ||
@@ -1227,6 +1510,8 @@ namespace nux
     unsigned int ZFailOp_,
     unsigned int ZPassOp_)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (FailOp_ == GL_KEEP) ||
       (FailOp_ == GL_ZERO) ||
@@ -1279,6 +1564,8 @@ namespace nux
 #ifndef NUX_OPENGLES_20
   inline void GpuRenderStates::HW__EnableLineSmooth(unsigned int EnableLineSmooth)
   {
+    NotifyStateChange();
+
 
     if (EnableLineSmooth)
     {
@@ -1295,6 +1582,8 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetLineWidth(unsigned int width,  unsigned int Hint)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (Hint == GL_NICEST) ||
       (Hint == GL_FASTEST) ||
@@ -1316,6 +1605,8 @@ namespace nux
     unsigned int bBlue,
     unsigned int bAlpha)
   {
+    NotifyStateChange();
+
     CHECKGL(glColorMask(bRed, bGreen, bBlue, bAlpha));
     SET_RS_VALUE(render_state_changes_[GFXRS_COLORWRITEENABLE_R], bRed);
     SET_RS_VALUE(render_state_changes_[GFXRS_COLORWRITEENABLE_G], bGreen);
@@ -1325,12 +1616,16 @@ namespace nux
 
   inline void GpuRenderStates::HW__SetDepthMask(unsigned int bDepth)
   {
+    NotifyStateChange();
+
     CHECKGL(glDepthMask(bDepth));
     SET_RS_VALUE(render_state_changes_[GFXRS_ZWRITEENABLE], bDepth);
   }
 
   inline void GpuRenderStates::HW__EnableScissor(unsigned int bScissor)
   {
+    NotifyStateChange();
+
     if (bScissor)
     {
       CHECKGL(glEnable(GL_SCISSOR_TEST));
@@ -1346,6 +1641,8 @@ namespace nux
 #ifndef NUX_OPENGLES_20
   inline void GpuRenderStates::HW__SetPolygonMode(unsigned int FrontMode, unsigned int BackMode)
   {
+    NotifyStateChange();
+
     nuxAssertMsg(
       (FrontMode == GL_FILL) ||
       (FrontMode == GL_LINE) ||
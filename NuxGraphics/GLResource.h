@@ -245,6 +245,9 @@ namespace nux
     VBO_USAGE_STATIC    = GL_STATIC_DRAW,
     VBO_USAGE_DYNAMIC   = GL_DYNAMIC_DRAW,
     VBO_USAGE_STREAM    = GL_STREAM_DRAW,
+#ifndef NUX_OPENGLES_20
+    VBO_USAGE_STREAM_READ = GL_STREAM_READ, //!< For pixel buffers read by the CPU.
+#endif
     VBO_USAGE_FORCE_DWORD    = 0x7fffffff /* force 32-bit size enum */
   };
 
@@ -398,8 +398,8 @@ GLSh_ColorPicker::GLSh_ColorPicker(color::Channel color_channel)
     if (GetGraphicsDisplay()->GetGraphicsEngine()->UsingGLSLCodePath() && (GetGraphicsDisplay()->GetGpuDevice()->GetGPUBrand() != GPU_BRAND_INTEL))
 #endif
     {
-      CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-      CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
       sprog->Begin();
 
       int VertexLocation = sprog->GetAttributeLocation("AVertex");
@@ -414,28 +414,28 @@ GLSh_ColorPicker::GLSh_ColorPicker(color::Channel color_channel)
       int RectDimension   = sprog->GetUniformLocationARB("RectDimension");
 
       if (ColorBase != -1)
-        CHECKGL(glUniform4fARB(ColorBase, _R, _G, _B, _A));
+        sprog->SetUniform4f(ColorBase, _R, _G, _B, _A);
 
       if (RectPosition != -1)
-        CHECKGL(glUniform4fARB(RectPosition, x + _ScreenOffsetX, WindowHeight - y - height - _ScreenOffsetY, z, 0.0f));
+        sprog->SetUniform4f(RectPosition, x + _ScreenOffsetX, WindowHeight - y - height - _ScreenOffsetY, z, 0.0f);
 
       if (RectDimension != -1)
-        CHECKGL(glUniform4fARB(RectDimension, width, height, 0.0f, 0.0f));
+        sprog->SetUniform4f(RectDimension, width, height, 0.0f, 0.0f);
 
-      CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().EnableVertexAttribArray(VertexLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 16, VtxBuffer));
 
       CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-      CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
       sprog->End();
     }
 #ifndef NUX_OPENGLES_20
     else
     {
-      CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-      CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
       m_AsmProg->Begin();
 
       CHECKGL(glMatrixMode(GL_MODELVIEW));
@@ -451,12 +451,12 @@ GLSh_ColorPicker::GLSh_ColorPicker(color::Channel color_channel)
       CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 1, width, height, 0.0f, 0.0f));
       CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 2, _R, _G, _B, _A));
 
-      CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().EnableVertexAttribArray(VertexLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 16, VtxBuffer));
 
       CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-      CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
       m_AsmProg->End();
     }
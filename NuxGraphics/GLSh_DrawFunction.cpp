@@ -143,8 +143,8 @@ namespace nux
 
     if (GetGraphicsDisplay()->GetGraphicsEngine()->UsingGLSLCodePath() && (GetGraphicsDisplay()->GetGpuDevice()->GetGPUBrand() != GPU_BRAND_INTEL))
     {
-      CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-      CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
       sprog->Begin();
 
       int VertexLocation = sprog->GetAttributeLocation("AVertex");
@@ -161,31 +161,31 @@ namespace nux
       int TextureFunction = sprog->GetUniformLocationARB("TextureFunction");
 
       if (ColorBase != -1)
-        CHECKGL(glUniform4fARB(ColorBase, background_color_.red, background_color_.green, background_color_.blue, background_color_.alpha));
+        sprog->SetUniform4f(ColorBase, background_color_.red, background_color_.green, background_color_.blue, background_color_.alpha);
 
       if (RectPosition != -1)
-        CHECKGL(glUniform4fARB(RectPosition, x + _ScreenOffsetX, WindowHeight - y - height - _ScreenOffsetY, z, 0.0f));
+        sprog->SetUniform4f(RectPosition, x + _ScreenOffsetX, WindowHeight - y - height - _ScreenOffsetY, z, 0.0f);
 
       if (RectDimension != -1)
-        CHECKGL(glUniform4fARB(RectDimension, width, height, 0.0f, 0.0f));
+        sprog->SetUniform4f(RectDimension, width, height, 0.0f, 0.0f);
 
       if (TextureFunction != -1)
-        CHECKGL(glUniform1iARB(TextureFunction, 0));
+        sprog->SetUniform1i(TextureFunction, 0);
 
-      CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().EnableVertexAttribArray(VertexLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 16, VtxBuffer));
 
       CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-      CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
       sprog->End();
     }
 #ifndef NUX_OPENGLES_20
     else
     {
-      CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-      CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
       m_AsmProg->Begin();
 
       CHECKGL(glMatrixMode(GL_MODELVIEW));
@@ -203,12 +203,12 @@ namespace nux
       CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 1, width, height, 0.0f, 0.0f));
       CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 2, background_color_.red, background_color_.green, background_color_.blue, background_color_.alpha));
 
-      CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().EnableVertexAttribArray(VertexLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 16, VtxBuffer));
 
       CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-      CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
       m_AsmProg->End();
     }
@@ -21,6 +21,7 @@
 
 
 #include "GpuDevice.h"
+#include "GraphicsDisplay.h"
 #include "GLTemplatePrimitiveBuffer.h"
 
 namespace nux
@@ -193,13 +194,13 @@ namespace nux
       if (AttributeIndex == 0)
       {
         VertexAttributeBuffer[AttributeIndex]->BindVertexBuffer();
-        CHECKGL(glEnableVertexAttribArrayARB(AttributeLocation));
+        GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().EnableVertexAttribArray(AttributeLocation);
         CHECKGL(glVertexAttribPointerARB((GLuint) AttributeLocation, 4, GL_FLOAT, GL_FALSE, 0, NUX_BUFFER_OFFSET(0)));
       }
       else
       {
         VertexAttributeBuffer[AttributeIndex]->BindVertexBuffer();
-        CHECKGL(glEnableVertexAttribArrayARB(AttributeLocation));
+        GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().EnableVertexAttribArray(AttributeLocation);
         CHECKGL(glVertexAttribPointerARB((GLuint) AttributeLocation, 4, GL_FLOAT, GL_FALSE, 0, NUX_BUFFER_OFFSET(0)));
       }
     }
@@ -258,7 +259,7 @@ namespace nux
 
     if (m_ShaderType == SHADER_TYPE_GLSL)
     {
-      CHECKGL(glDisableVertexAttribArrayARB(AttributeLocation));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().DisableVertexAttribArray(AttributeLocation);
     }
     else
     {
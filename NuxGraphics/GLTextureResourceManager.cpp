@@ -25,6 +25,8 @@
 #include "GpuDevice.h"
 #include "GraphicsEngine.h"
 #include "GLTextureResourceManager.h"
+#include "ImageKernels.h"
+#include "ImageScaling.h"
 #include "NuxCore/Logger.h"
 
 namespace nux
@@ -89,85 +91,29 @@ namespace
     // of alpha premultiplication if requested.
     // FIXME(loicm) Implies a useless copy. NTextureData should be able to
     //     take ownership of pre-allocated memory.
-    // FIXME(loicm) Add support for big-endian systems. For performance
-    //     reasons, pixels are loaded by block of 4 bytes with the color
-    //     components bit-shifted considering little-endian ordering. Nux
-    //     doesn't seem to be big-endian aware anyway.
-    // FIXME(loicm) Surface::Write32b does branching, splits the 32-bit value
-    //     as four 8-bit values(using bit-shifts) that are then stored
-    //     separately, that's slow considering it's meant to be used a lot in
-    //     deep loops.
     NTextureData* data = new NTextureData(BITFMT_R8G8B8A8, width, height, 1);
     ImageSurface& surface = data->GetSurface(0);
+    const unsigned char* pixels = gdk_pixbuf_get_pixels(pixbuf);
+    unsigned char* dest = surface.GetPtrRawData();
+    const int pitch = surface.GetPitch();
+
     if (gdk_pixbuf_get_has_alpha(pixbuf) == TRUE)
     {
-      unsigned char* pixels_u8 = gdk_pixbuf_get_pixels(pixbuf);
-      unsigned int* pixels_u32 = reinterpret_cast<unsigned int*> (pixels_u8);
-
-      unsigned char* dest_u8 = surface.GetPtrRawData ();
-      const int pitch = surface.GetPitch ();
-
       if (premultiply == true)
       {
         // Copy from pixbuf(RGBA) to surface(premultiplied RGBA).
-        for (unsigned int i = 0; i < height; i++)
-        {
-          unsigned int* dest_u32 = reinterpret_cast<unsigned int*>(dest_u8);
-          for (unsigned int j = 0; j < width; j++)
-          {
-            const unsigned int pixel = pixels_u32[j];
-            const unsigned int a = pixel >> 24;
-            if (a == 0)
-            {
-              dest_u32[j] = 0;
-            }
-            else
-            {
-              const unsigned int b = (((pixel >> 16) & 0xff) * a) / 255;
-              const unsigned int g = (((pixel >> 8) & 0xff) * a) / 255;
-              const unsigned int r = ((pixel & 0xff) * a) / 255;
-              const unsigned int p = a << 24 | b << 16 | g << 8 | r;
-
-              dest_u32[j] = p;
-            }
-          }
-          pixels_u8 += rowstride;
-          pixels_u32 = reinterpret_cast<unsigned int*> (pixels_u8);
-          dest_u8 += pitch;
-        }
+        PremultiplyAlpha(pixels, rowstride, dest, pitch, width, height, BITFMT_R8G8B8A8);
       }
       else
       {
         // Copy from pixbuf(RGBA) to surface(RGBA).
-        for (unsigned int i = 0; i < height; i++)
-        {
-          Memcpy (dest_u8, pixels_u8, width * 4);
-          pixels_u8 += rowstride;
-          dest_u8 += pitch;
-        }
+        ConvertPixels(pixels, rowstride, BITFMT_R8G8B8A8, dest, pitch, BITFMT_R8G8B8A8, width, height);
       }
     }
     else
     {
       // Copy from pixbuf(RGB) to surface(RGBA).
-      unsigned char* pixels = gdk_pixbuf_get_pixels(pixbuf);
-      unsigned char* dest_u8 = surface.GetPtrRawData();
-      const int pitch = surface.GetPitch();
-
-      for (unsigned int i = 0; i < height; i++)
-      {
-        unsigned int* dest_u32 = reinterpret_cast<unsigned int*>(dest_u8);
-        for (unsigned int j = 0; j < width; j++)
-        {
-          const unsigned char r = pixels[j*3];
-          const unsigned char g = pixels[j*3+1];
-          const unsigned char b = pixels[j*3+2];
-          const unsigned int p = 0xff000000 | b << 16 | g << 8 | r;
-          dest_u32[j] = p;
-        }
-        pixels += rowstride;
-        dest_u8 += pitch;
-      }
+      ConvertPixels(pixels, rowstride, BITFMT_R8G8B8, dest, pitch, BITFMT_R8G8B8A8, width, height);
     }
 
     // Create a 2D texture and upload the pixels.
@@ -282,11 +228,14 @@ namespace
     return get_null_texture();
   }
 
-  BaseTexture* LoadTextureFromFile(const std::string& filename)
+  BaseTexture* LoadTextureFromFile(const std::string& filename, int max_size)
   {
     NBitmapData* bitmap = LoadImageFile(filename.c_str());
     NUX_RETURN_VALUE_IF_NULL(bitmap, get_null_texture("No Data for '"+filename+"'"));
 
+    if (max_size > 0 && bitmap->IsTextureData())
+      FitTextureData(*static_cast<NTextureData*>(bitmap), max_size, max_size);
+
     BaseTexture* texture = CreateTextureFromBitmapData(bitmap);
     delete bitmap;
     return texture;
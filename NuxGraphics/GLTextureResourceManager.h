@@ -70,7 +70,16 @@ namespace nux
   BaseTexture* CreateTextureFromFile(const char* TextureFilename);
   BaseTexture* CreateTextureFromBitmapData(const NBitmapData* BitmapData);
 
-  BaseTexture* LoadTextureFromFile(const std::string& filename);
+  /*!
+   * Create a texture from an image file loaded with LoadImageFile.
+   *
+   * @max_size If the width or height of the image exceeds that value, the
+   * image is reduced before the upload, respecting the aspect ratio. Use the
+   * size the texture is drawn at. A value of -1 means that no maximal value is
+   * required.
+   * @return The resulting texture.
+   */
+  BaseTexture* LoadTextureFromFile(const std::string& filename, int max_size = -1);
 
   //! Abstract base class for textures.
   class BaseTexture: public ResourceData
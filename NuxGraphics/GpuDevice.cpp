@@ -31,6 +31,8 @@
 #include "GLDeviceFrameBufferObject.h"
 #include "GLTemplatePrimitiveBuffer.h"
 #include "GraphicsEngine.h"
+#include "TextureUploadRing.h"
+#include "ShaderProgramCache.h"
 
 #include <algorithm>
 #include <boost/algorithm/string/split.hpp>
@@ -207,6 +209,7 @@ namespace nux
     , _opengl_max_fb_attachment(0)
     , _opengl_max_vertex_attributes(0)
     , _support_ext_swap_control(false)
+    , _support_ext_buffer_age(false)
     , _support_arb_vertex_program(false)
     , _support_arb_fragment_program(false)
     , _support_arb_shader_objects(false)
@@ -221,6 +224,10 @@ namespace nux
     , _support_arb_texture_rectangle(false)
     , _support_nv_texture_rectangle(false)
     , _support_arb_pixel_buffer_object(false)
+    , _support_arb_sync(false)
+    , _support_arb_map_buffer_range(false)
+    , _support_arb_buffer_storage(false)
+    , _support_arb_get_program_binary(false)
     , _support_ext_blend_equation_separate(false)
     , _support_depth_buffer(false)
 #ifndef NUX_OPENGLES_20
@@ -277,6 +284,9 @@ namespace nux
     _support_ext_swap_control                 = WGLEW_EXT_swap_control;
 #elif defined(NUX_OS_LINUX) && !defined(NUX_OPENGLES_20)
     _support_ext_swap_control                 = GLXEW_SGI_swap_control;
+#  ifdef GLX_EXT_buffer_age
+    _support_ext_buffer_age                   = GLXEW_EXT_buffer_age;
+#  endif
 #endif
 
 #ifndef NUX_OPENGLES_20
@@ -294,6 +304,12 @@ namespace nux
     _support_arb_texture_rectangle            = GLEW_ARB_texture_rectangle;
     _support_nv_texture_rectangle             = GLEW_NV_texture_rectangle;
     _support_arb_pixel_buffer_object          = GLEW_ARB_pixel_buffer_object;
+    _support_arb_sync                         = GLEW_ARB_sync;
+    _support_arb_map_buffer_range             = GLEW_ARB_map_buffer_range;
+#  ifdef GL_ARB_buffer_storage
+    _support_arb_buffer_storage               = GLEW_ARB_buffer_storage;
+#  endif
+    _support_arb_get_program_binary           = GLEW_ARB_get_program_binary;
     _support_ext_blend_equation_separate      = GLEW_EXT_blend_equation_separate;
     _support_ext_texture_srgb                 = GLEW_EXT_texture_sRGB;
     _support_ext_texture_srgb_decode          = false; //GLEW_EXT_texture_sRGB_decode;
@@ -314,6 +330,10 @@ namespace nux
     _support_arb_texture_rectangle            = false;
     _support_nv_texture_rectangle             = false;
     _support_arb_pixel_buffer_object          = false;
+    _support_arb_sync                         = false;
+    _support_arb_map_buffer_range             = false;
+    _support_arb_buffer_storage               = false;
+    _support_arb_get_program_binary           = false;
     _support_ext_blend_equation_separate      = true;
 #endif
   }
@@ -361,6 +381,8 @@ namespace nux
     , pixel_store_alignment_(4)
     , gpu_render_states_(NULL)
     , gpu_info_(NULL)
+    , texture_upload_ring_(NULL)
+    , shader_program_cache_(NULL)
   {
     gpu_brand_            = GPU_VENDOR_UNKNOWN;
 
@@ -678,6 +700,12 @@ namespace nux
     gpu_info_->Setup();
     gpu_render_states_ = new GpuRenderStates(gpu_brand_, gpu_info_);
 
+    texture_upload_ring_ = new TextureUploadRing(*gpu_info_);
+    if (g_getenv("NUX_DISABLE_TEXTURE_UPLOAD_RING"))
+      texture_upload_ring_->SetEnabled(false);
+
+    shader_program_cache_ = new ShaderProgramCache(*gpu_info_);
+
 #if defined(NUX_OS_WINDOWS)
     OGL_EXT_SWAP_CONTROL                = WGLEW_EXT_swap_control;
 #elif defined(NUX_OS_LINUX) && !defined(NUX_OPENGLES_20)
@@ -731,8 +759,9 @@ namespace nux
 
   GpuDevice::~GpuDevice()
   {
+    NUX_SAFE_DELETE(texture_upload_ring_);
+    NUX_SAFE_DELETE(shader_program_cache_);
     NUX_SAFE_DELETE(gpu_info_);
-    NUX_SAFE_DELETE(gpu_render_states_);
 
     _FrameBufferObject.Release();
     active_framebuffer_object_.Release();
@@ -743,6 +772,9 @@ namespace nux
     {
       _StreamSource[i].ResetStreamSource();
     }
+
+    // The resources released above forget their bindings in the render states.
+    NUX_SAFE_DELETE(gpu_render_states_);
     // NVidia CG
 #if (NUX_ENABLE_CG_SHADERS)
     cgDestroyContext(m_Cgcontext);
@@ -792,6 +824,16 @@ namespace nux
     return *gpu_info_;
   }
 
+  TextureUploadRing& GpuDevice::GetTextureUploadRing()
+  {
+    return *texture_upload_ring_;
+  }
+
+  ShaderProgramCache& GpuDevice::GetShaderProgramCache()
+  {
+    return *shader_program_cache_;
+  }
+
   void GpuDevice::ResetRenderStates()
   {
     gpu_render_states_->ResetStateChangeToDefault();
@@ -804,14 +846,14 @@ namespace nux
 
   void GpuDevice::InvalidateTextureUnit(int TextureUnitIndex)
   {
-    CHECKGL(glActiveTextureARB(TextureUnitIndex));
+    GetRenderStates().ActiveTexture(TextureUnitIndex);
 
-    CHECKGL(glBindTexture(GL_TEXTURE_2D, 0));
+    GetRenderStates().BindTexture(GL_TEXTURE_2D, 0);
 #ifndef NUX_OPENGLES_20
-    CHECKGL(glBindTexture(GL_TEXTURE_1D, 0));
-    CHECKGL(glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
-    CHECKGL(glBindTexture(GL_TEXTURE_3D, 0));
-    CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, 0));
+    GetRenderStates().BindTexture(GL_TEXTURE_1D, 0);
+    GetRenderStates().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    GetRenderStates().BindTexture(GL_TEXTURE_3D, 0);
+    GetRenderStates().BindTexture(GL_TEXTURE_RECTANGLE_ARB, 0);
 #endif
 
     // From lowest priority to highest priority:
@@ -1075,6 +1117,9 @@ namespace nux
     GLenum binding = GL_DRAW_FRAMEBUFFER_EXT;
 #endif
 
+    if (GetGraphicsDisplay()->GetGraphicsEngine())
+      GetGraphicsDisplay()->GetGraphicsEngine()->FlushQuadBatch();
+
     active_framebuffer_object_.Release();
     CHECKGL(glBindFramebufferEXT(binding, 0));
     CHECKGL(glBindRenderbufferEXT(GL_RENDERBUFFER_EXT, 0));
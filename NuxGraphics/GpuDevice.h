@@ -32,6 +32,8 @@
 namespace nux
 {
   class GpuRenderStates;
+  class TextureUploadRing;
+  class ShaderProgramCache;
 
   //! Brand of GPUs.
   typedef enum
@@ -90,6 +92,7 @@ namespace nux
     bool SupportOpenGL41() const    {return _support_opengl_version_41;}
 
     bool Support_EXT_Swap_Control()              const    {return _support_ext_swap_control;}
+    bool Support_EXT_Buffer_Age()                const    {return _support_ext_buffer_age;}
     bool Support_ARB_Texture_Rectangle()         const    {return _support_arb_texture_rectangle;}
     bool Support_ARB_Vertex_Program()            const    {return _support_arb_vertex_program;}
     bool Support_ARB_Fragment_Program()          const    {return _support_arb_fragment_program;}
@@ -104,6 +107,10 @@ namespace nux
     bool Support_EXT_Texture_Rectangle()         const    {return _support_ext_texture_rectangle;}
     bool Support_NV_Texture_Rectangle()          const    {return _support_nv_texture_rectangle;}
     bool Support_ARB_Pixel_Buffer_Object()       const    {return _support_arb_pixel_buffer_object;}
+    bool Support_ARB_Sync()                      const    {return _support_arb_sync;}
+    bool Support_ARB_Map_Buffer_Range()          const    {return _support_arb_map_buffer_range;}
+    bool Support_ARB_Buffer_Storage()            const    {return _support_arb_buffer_storage;}
+    bool Support_ARB_Get_Program_Binary()        const    {return _support_arb_get_program_binary;}
     bool Support_EXT_Blend_Equation_Separate()   const    {return _support_ext_blend_equation_separate;}
     bool Support_Depth_Buffer()                  const    {return _support_depth_buffer;}
 
@@ -143,6 +150,7 @@ namespace nux
     int _opengl_max_vertex_attributes;
 
     bool _support_ext_swap_control;
+    bool _support_ext_buffer_age;
     bool _support_arb_vertex_program;
     bool _support_arb_fragment_program;
     bool _support_arb_shader_objects;
@@ -157,6 +165,10 @@ namespace nux
     bool _support_arb_texture_rectangle; //!< Promoted from GL_EXT_TEXTURE_RECTANGLE to ARB.
     bool _support_nv_texture_rectangle;
     bool _support_arb_pixel_buffer_object;
+    bool _support_arb_sync;
+    bool _support_arb_map_buffer_range;
+    bool _support_arb_buffer_storage;
+    bool _support_arb_get_program_binary;
     bool _support_ext_blend_equation_separate;
     bool _support_depth_buffer;
 
@@ -360,6 +372,12 @@ namespace nux
 
     const GpuInfo& GetGpuInfo() const;
 
+    //! Return the ring the texture updates of IOpenGLSurface::LockRect are streamed through.
+    TextureUploadRing& GetTextureUploadRing();
+
+    //! Return the disk cache of the shader program binaries.
+    ShaderProgramCache& GetShaderProgramCache();
+
     void ResetRenderStates();
 
     void VerifyRenderStates();
@@ -432,6 +450,8 @@ namespace nux
 
     GpuRenderStates* gpu_render_states_;
     GpuInfo* gpu_info_;
+    TextureUploadRing* texture_upload_ring_;
+    ShaderProgramCache* shader_program_cache_;
 
   public:
 
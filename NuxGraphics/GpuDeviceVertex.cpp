@@ -68,12 +68,12 @@ namespace nux
 
   void GpuDevice::InvalidateVertexBuffer()
   {
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
   }
 
   void GpuDevice::InvalidateIndexBuffer()
   {
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
   }
 
   int GpuDevice::DrawIndexedPrimitive(ObjectPtr<IOpenGLIndexBuffer> IndexBuffer,
@@ -105,7 +105,7 @@ namespace nux
       }
 
       VertexDeclaration->GetVertexBuffer(vtxelement.Stream)->BindVertexBuffer();
-      glEnableVertexAttribArrayARB(shader_attribute_location);
+      GetRenderStates().EnableVertexAttribArray(shader_attribute_location);
 
       CHECKGL(glVertexAttribPointer(shader_attribute_location,
         vtxelement.NumComponent,
@@ -164,7 +164,7 @@ namespace nux
       for (int index = 0; index < 16; index++)
       {
         if (VertexDeclaration->_valid_vertex_input[index])
-          glDisableVertexAttribArrayARB(index);
+          GetRenderStates().DisableVertexAttribArray(index);
       }
 
       InvalidateVertexBuffer();
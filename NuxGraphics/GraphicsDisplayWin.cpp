@@ -736,6 +736,9 @@ namespace nux
 
     if (glswap)
     {
+      if (m_GraphicsContext)
+        m_GraphicsContext->FlushQuadBatch();
+
       SwapBuffers(device_context_);
     }
 
@@ -2365,6 +2368,11 @@ namespace nux
     return GetGpuDevice()->GetGpuInfo().Support_EXT_Swap_Control();
   }
 
+  int GraphicsDisplay::GetBufferAge() const
+  {
+    return 0;
+  }
+
 //---------------------------------------------------------------------------------------------------------
   void GraphicsDisplay::EnableVSyncSwapControl()
   {
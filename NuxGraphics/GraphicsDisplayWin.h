@@ -149,6 +149,12 @@ namespace nux
     void MakeGLContextCurrent(bool b = true);
     void SwapBuffer(bool glswap = true);
 
+    //! Return the age of the back buffer.
+    /*!
+        Always 0 on Windows: the content of the back buffer is undefined and the whole frame must be redrawn.
+    */
+    int GetBufferAge() const;
+
     // Event methods
     /*!
       Returns true if there was a pending event to be fetched and false otherwise
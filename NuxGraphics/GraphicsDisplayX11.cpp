@@ -1016,6 +1016,9 @@ namespace nux
 
     if (glswap)
     {
+      if (m_GraphicsContext)
+        m_GraphicsContext->FlushQuadBatch();
+
 #ifndef NUX_OPENGLES_20
       if (_has_glx_13)
         glXSwapBuffers(m_X11Display, glx_window_);
@@ -1029,6 +1032,21 @@ namespace nux
     m_FrameTime = m_Timer.PassedMilliseconds();
   }
 
+  int GraphicsDisplay::GetBufferAge() const
+  {
+#if !defined(NUX_OPENGLES_20) && defined(GLX_EXT_buffer_age)
+    if (!GetGpuDevice()->GetGpuInfo().Support_EXT_Buffer_Age())
+      return 0;
+
+    unsigned int age = 0;
+    GLXDrawable drawable = _has_glx_13 ? glx_window_ : m_X11Window;
+    glXQueryDrawable(m_X11Display, drawable, GLX_BACK_BUFFER_AGE_EXT, &age);
+    return age;
+#else
+    return 0;
+#endif
+  }
+
   void GraphicsDisplay::DestroyOpenGLWindow()
   {
     if (gfx_interface_created_ == true)
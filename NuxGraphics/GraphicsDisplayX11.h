@@ -222,6 +222,15 @@ namespace nux
     void MakeGLContextCurrent();
     void SwapBuffer(bool glswap = true);
 
+    //! Return the age of the back buffer.
+    /*!
+        The age is the number of frames since the content of the back buffer was presented. An age of 1
+        means that the back buffer holds the previous frame. An age of 0 means that the content of the
+        back buffer is undefined and that the whole frame must be redrawn. This is always the case when
+        GLX_EXT_buffer_age isn't supported.
+    */
+    int GetBufferAge() const;
+
     // Event methods
     /*!
       Returns true if there was a pending event to be fetched and false otherwise
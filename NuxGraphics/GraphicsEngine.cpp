@@ -34,6 +34,7 @@
 #include "FontTexture.h"
 #include "FontRenderer.h"
 #include "GraphicsEngine.h"
+#include "TextureUploadRing.h"
 
 namespace nux
 {
@@ -161,6 +162,8 @@ namespace nux
     _clip_offset_y = 0;
 
     _font_renderer = 0;
+    quad_batcher_ = 0;
+    quad_batching_enabled_ = false;
 
     _use_glsl_shaders = false;
     _global_clipping_enabled = false;
@@ -179,6 +182,16 @@ namespace nux
 
 
     GlWindow.m_GraphicsContext = this;
+
+    quad_batcher_ = new QuadBatcher(*this);
+    if (UsingGLSLCodePath() &&
+        _graphics_display.GetGpuDevice()->GetGpuInfo().Support_ARB_Vertex_Buffer_Object() &&
+        (g_getenv("NUX_DISABLE_QUAD_BATCHING") == NULL))
+    {
+      quad_batching_enabled_ = true;
+    }
+    GetRenderStates().SetStateChangeCallback(std::bind(&GraphicsEngine::FlushQuadBatch, this));
+
     ResetStats();
 
     _projection_matrix.Identity();
@@ -252,6 +265,10 @@ namespace nux
 
   GraphicsEngine::~GraphicsEngine()
   {
+    GetRenderStates().SetStateChangeCallback(std::function<void()>());
+    quad_batcher_->Discard();
+    NUX_SAFE_DELETE(quad_batcher_);
+
     _offscreen_color_rt0.Release();
     _offscreen_color_rt1.Release();
     _offscreen_depth_rt0.Release();
@@ -475,7 +492,7 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
   {
     NUX_RETURN_IF_FALSE(DeviceTexture.IsValid());
 
-    CHECKGL(glActiveTextureARB(TextureUnit));
+    GetRenderStates().ActiveTexture(TextureUnit);
     DeviceTexture->BindTextureToUnit(TextureUnit);
   }
 
@@ -484,7 +501,7 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
     if ((TextureUnit < GL_TEXTURE0) || (TextureUnit > GL_TEXTURE31))
       return;
 
-    CHECKGL(glActiveTextureARB(TextureUnit));
+    GetRenderStates().ActiveTexture(TextureUnit);
     CHECKGL(glEnable(TextureMode));
   }
 
@@ -493,9 +510,9 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
     if ((TextureUnit < GL_TEXTURE0) || (TextureUnit > GL_TEXTURE31))
       return;
 
-    CHECKGL(glActiveTextureARB(TextureUnit));
+    GetRenderStates().ActiveTexture(TextureUnit);
     CHECKGL(glDisable(TextureMode));
-    CHECKGL(glBindTexture(TextureMode, 0));
+    GetRenderStates().BindTexture(TextureMode, 0);
   }
 
   void GraphicsEngine::DisableAllTextureMode(int TextureUnit)
@@ -648,6 +665,39 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
     ApplyClippingRectangle();
   }
 
+  bool GraphicsEngine::GetModelViewClippingRegion(Rect& rect) const
+  {
+    Matrix4 const& m = _model_view_matrix;
+    if (m.m[0][0] != 1.0f || m.m[0][1] != 0.0f || m.m[1][0] != 0.0f || m.m[1][1] != 1.0f)
+      return false;
+
+    // The clipping rectangles are pushed through ModelViewXFormRect, and
+    // offset by the viewport in a frame buffer object.
+    int offset_x = m.m[0][3];
+    int offset_y = m.m[1][3];
+
+    ObjectPtr<IOpenGLFrameBufferObject> fbo = _graphics_display.m_DeviceFactory->GetCurrentFrameBufferObject();
+    if (fbo.IsValid())
+    {
+      if (fbo->GetNumberOfClippingRegions() == 0)
+        return false;
+
+      rect = fbo->GetClippingRegion();
+      offset_x += _viewport.x;
+      offset_y += fbo->GetHeight() - (_viewport.y + _viewport.height);
+    }
+    else
+    {
+      if (ClippingRect.empty())
+        return false;
+
+      rect = _clipping_rect;
+    }
+
+    rect.Set(rect.x - offset_x - 1, rect.y - offset_y - 1, rect.width + 2, rect.height + 2);
+    return true;
+  }
+
   Rect GraphicsEngine::GetClippingRegion() const
   {
     if (_graphics_display.m_DeviceFactory->GetCurrentFrameBufferObject().IsValid())
@@ -1096,6 +1146,7 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
       _viewport.height = 1;
     }
 
+    FlushQuadBatch();
     CHECKGL(glViewport(origin_x, origin_y, _viewport.width, _viewport.height));
   }
 
@@ -1150,6 +1201,8 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
     NUX_RETURN_IF_FALSE(w >= 0);
     NUX_RETURN_IF_FALSE(h >= 0);
 
+    FlushQuadBatch();
+
     _scissor.x = x;
     _scissor.y = y;
     _scissor.width = w;
@@ -1172,7 +1225,7 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
       // jaytaoko: This is a hack for what looks like a bug(#726033) in the radeon opensource driver
       // on R300/400/500. Rather than passing a null region to glScissor, we give the clip area a 1 pixel width.
       //_scissor.width = 1;
-      CHECKGL(glScissor(0, 0, 1, 1));
+      GetRenderStates().SetScissor(0, 0, 1, 1);
       return;
     }
 
@@ -1181,11 +1234,11 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
       // jaytaoko: This is a hack for what looks like a bug(#726033) in the radeon opensource driver
       // on R300/400/500. Rather than passing a null region to glScissor, we give the clip area a 1 pixel height.
       //_scissor.height = 1;
-      CHECKGL(glScissor(0, 0, 1, 1));
+      GetRenderStates().SetScissor(0, 0, 1, 1);
       return;
     }
 
-    CHECKGL(glScissor(_scissor.x, _scissor.y, _scissor.width, _scissor.height));
+    GetRenderStates().SetScissor(_scissor.x, _scissor.y, _scissor.width, _scissor.height);
   }
 
   Rect const& GraphicsEngine::GetScissorRect() const
@@ -1204,6 +1257,8 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
 
   void GraphicsEngine::ClearAreaColorDepthStencil(int x, int y, int width, int height, Color clear_color, float /* cleardepth */, int clearstencil)
   {
+    FlushQuadBatch();
+
     // enable stencil buffer
     CHECKGL(glEnable(GL_STENCIL_TEST));
     // write a one to the stencil buffer everywhere we are about to draw
@@ -1215,6 +1270,7 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
     //CHECKGL(glDepthFunc(GL_ALWAYS));
 
     QRP_Color(x, y, width, height, clear_color);
+    FlushQuadBatch();
 
     //CHECKGL(glDepthFunc(GL_LESS));
     //CHECKGL(glDisable(GL_DEPTH_TEST));
@@ -1228,6 +1284,8 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
 
   void GraphicsEngine::ClearAreaDepthStencil(int x, int y, int width, int height, float /* cleardepth */, int clearstencil)
   {
+    FlushQuadBatch();
+
     // enable stencil buffer
     CHECKGL(glEnable(GL_STENCIL_TEST));
     // write a one to the stencil buffer everywhere we are about to draw
@@ -1240,6 +1298,7 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
     //CHECKGL(glDepthFunc(GL_ALWAYS));
 
     QRP_Color(x, y, width, height, color::Black);
+    FlushQuadBatch();
 
     //CHECKGL(glDepthFunc(GL_LESS));
     //CHECKGL(glDisable(GL_DEPTH_TEST));
@@ -1256,6 +1315,62 @@ int GraphicsEngine::RenderColorTextLineEdit(ObjectPtr<FontTexture> Font, const P
     m_triangle_stats        = 0;
     m_triangle_tex_stats    = 0;
     m_line_stats            = 0;
+
+    if (quad_batcher_)
+      quad_batcher_->ResetStats();
+
+    _graphics_display.GetGpuDevice()->GetTextureUploadRing().ResetStats();
+    GetRenderStates().ResetBindingStats();
+  }
+
+  void GraphicsEngine::FlushQuadBatch()
+  {
+    if (quad_batcher_)
+      quad_batcher_->Flush();
+  }
+
+  void GraphicsEngine::EnableQuadBatching(bool enable)
+  {
+    if (!enable)
+      FlushQuadBatch();
+
+    quad_batching_enabled_ = enable && UsingGLSLCodePath() &&
+      _graphics_display.GetGpuDevice()->GetGpuInfo().Support_ARB_Vertex_Buffer_Object();
+  }
+
+  bool GraphicsEngine::IsQuadBatchingEnabled() const
+  {
+    return quad_batching_enabled_;
+  }
+
+  int GraphicsEngine::GetBatchedQuadCount() const
+  {
+    return quad_batcher_ ? quad_batcher_->GetQuadCount() : 0;
+  }
+
+  int GraphicsEngine::GetQuadBatchDrawCallCount() const
+  {
+    return quad_batcher_ ? quad_batcher_->GetDrawCallCount() : 0;
+  }
+
+  int GraphicsEngine::GetTextureUploadCount() const
+  {
+    return _graphics_display.GetGpuDevice()->GetTextureUploadRing().GetStats().uploads;
+  }
+
+  int GraphicsEngine::GetTextureUploadBytes() const
+  {
+    return _graphics_display.GetGpuDevice()->GetTextureUploadRing().GetStats().uploaded_bytes;
+  }
+
+  int GraphicsEngine::GetIssuedBindingCount() const
+  {
+    return _graphics_display.GetGpuDevice()->GetRenderStates().GetBindingStats().issued;
+  }
+
+  int GraphicsEngine::GetSuppressedBindingCount() const
+  {
+    return _graphics_display.GetGpuDevice()->GetRenderStates().GetBindingStats().suppressed;
   }
 
   ObjectPtr< CachedResourceData > GraphicsEngine::CacheResource(ResourceData* Resource)
@@ -33,6 +33,7 @@
 #include "FontTexture.h"
 #include "RenderingPipe.h"
 #include "GLShader.h"
+#include "QuadBatcher.h"
 
 #if defined(NUX_OS_WINDOWS)
   #include "GraphicsDisplay.h"
@@ -554,6 +555,14 @@ namespace nux
     Rect GetClippingRegion() const;
     int GetNumberOfClippingRegions() const;
 
+    //! Get the clipping rectangle in the coordinates of the current model view matrix.
+    /*!
+        The rectangle is enlarged by a pixel on each side to account for fractional translations.
+        @param rect Receives the clipping rectangle.
+        @return False if the clipping rectangle stack is empty or if the model view matrix is not a translation.
+    */
+    bool GetModelViewClippingRegion(Rect& rect) const;
+
     void AddClipOffset(int x, int y);  //!< Deprecated. Use PushClipOffset.
     void PushClipOffset(int x, int y);
     void PopClipOffset();
@@ -628,6 +637,52 @@ namespace nux
     //Statistics
     void ResetStats();
 
+    //! Render the quads that have been batched by the QRP functions.
+    /*!
+        Call this before issuing OpenGL commands directly, in between calls to the QRP functions.
+        Nux flushes the batch itself when it changes render states, binds shader programs, changes the
+        frame buffer or swaps the buffers.
+    */
+    void FlushQuadBatch();
+
+    //! Enable or disable the batching of quads in the GLSL code path.
+    /*!
+        Batching is enabled by default. It can be turned off by setting the NUX_DISABLE_QUAD_BATCHING
+        environment variable.
+    */
+    void EnableQuadBatching(bool enable);
+    bool IsQuadBatchingEnabled() const;
+
+    //! Number of quads rendered through the batcher since the last call to ResetStats.
+    int GetBatchedQuadCount() const;
+    //! Number of draw calls issued by the batcher since the last call to ResetStats.
+    int GetQuadBatchDrawCallCount() const;
+
+    //! Number of texture updates done with IOpenGLSurface::LockRect since the last call to ResetStats.
+    int GetTextureUploadCount() const;
+    //! Number of bytes of these texture updates.
+    int GetTextureUploadBytes() const;
+
+    //! Number of binding calls that reached OpenGL since the last call to ResetStats.
+    /*!
+        The program, texture, buffer, vertex attribute array and scissor calls go through the render states,
+        which drop the ones that would not change the OpenGL state. See GpuRenderStates::SetBindingTracking.
+    */
+    int GetIssuedBindingCount() const;
+    //! Number of binding calls dropped since the last call to ResetStats.
+    int GetSuppressedBindingCount() const;
+
+    //! Compile the shader programs of the QRP functions before their first use.
+    /*!
+        Otherwise a program is compiled the first time a QRP function needs it, which shows as a hitch in that
+        frame. At most max_programs of the programs that are not compiled yet are compiled, so that the work
+        can be spread over several iterations of the main loop. The programs of the layer blend modes and of the
+        high quality Gaussian filters, which depend on a parameter, are still compiled on demand.
+        @param max_programs Maximum number of programs to compile, or -1 to compile them all.
+        @return The number of programs that are left to compile.
+    */
+    int WarmUpShaderPrograms(int max_programs = -1);
+
     /*!
         Cache a resource if it has previously been cached. If the resource does not contain valid data
         then the returned value is not valid. Check that the returned hardware resource is valid by calling ObjectPtr<CachedResourceData>.IsValid().
@@ -1116,6 +1171,9 @@ namespace nux
 
     FontRenderer* _font_renderer;
 
+    QuadBatcher* quad_batcher_;
+    bool quad_batching_enabled_;
+
     //Statistics
     mutable long m_quad_stats;
     mutable long m_quad_tex_stats;
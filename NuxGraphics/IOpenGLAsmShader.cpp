@@ -25,6 +25,7 @@
 #include "GpuDevice.h"
 #include "GLDeviceObjects.h"
 #include "IOpenGLAsmShader.h"
+#include "GraphicsEngine.h"
 #include "NuxCore/Logger.h"
 
 namespace nux
@@ -189,6 +190,9 @@ DECLARE_LOGGER(logger, "nux.graphics");
 
   void IOpenGLAsmShaderProgram::Begin(void)
   {
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGraphicsEngine())
+      GetGraphicsDisplay()->GetGraphicsEngine()->FlushQuadBatch();
+
 #ifndef NUX_OPENGLES_20
     CHECKGL(glEnable(GL_VERTEX_PROGRAM_ARB));
     CHECKGL(glBindProgramARB(GL_VERTEX_PROGRAM_ARB, m_AsmVertexProgram->GetOpenGLID()));
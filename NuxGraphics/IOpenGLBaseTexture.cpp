@@ -27,6 +27,8 @@
 #include "GLTextureStates.h"
 #include "IOpenGLBaseTexture.h"
 #include "IOpenGLSurface.h"
+#include "GraphicsDisplay.h"
+#include "GpuDevice.h"
 
 namespace nux
 {
@@ -90,24 +92,24 @@ namespace nux
   {
     if (_ResourceType == RTTEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_2D, _OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_2D, _OpenGLID);
     }
 #ifndef NUX_OPENGLES_20
     else if (_ResourceType == RTTEXTURERECTANGLE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID);
     }
     else if (_ResourceType == RTCUBETEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID);
     }
     else if (_ResourceType == RTVOLUMETEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_3D, _OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_3D, _OpenGLID);
     }
     else if (_ResourceType == RTANIMATEDTEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID);
     }
 #endif
     else
@@ -145,30 +147,32 @@ namespace nux
 
   int IOpenGLBaseTexture::BindTexture()
   {
+    GpuRenderStates& render_states = GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates();
+
     if (_OpenGLID == 0)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_2D, 0));
+      render_states.BindTexture(GL_TEXTURE_2D, 0);
     }
     else if (_ResourceType == RTTEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_2D, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_2D, _OpenGLID);
     }
 #ifndef NUX_OPENGLES_20
     else if (_ResourceType == RTTEXTURERECTANGLE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID);
     }
     else if (_ResourceType == RTCUBETEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID);
     }
     else if (_ResourceType == RTVOLUMETEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_3D, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_3D, _OpenGLID);
     }
     else if (_ResourceType == RTANIMATEDTEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID);
     }
 #endif
     else
@@ -183,12 +187,20 @@ namespace nux
 
   int IOpenGLBaseTexture::BindTextureToUnit(int TextureUnitIndex)
   {
-    CHECKGL(glActiveTextureARB(TextureUnitIndex));
-    CHECKGL(glBindTexture(GL_TEXTURE_2D, 0));
+    GpuRenderStates& render_states = GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates();
+
+    render_states.ActiveTexture(TextureUnitIndex);
+
+    // Only unbind the other targets: the binding of the texture target is then left alone when it doesn't change.
+    if (_ResourceType != RTTEXTURE)
+      render_states.BindTexture(GL_TEXTURE_2D, 0);
 #ifndef NUX_OPENGLES_20
-    CHECKGL(glBindTexture(GL_TEXTURE_3D, 0));
-    CHECKGL(glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
-    CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, 0));
+    if (_ResourceType != RTVOLUMETEXTURE)
+      render_states.BindTexture(GL_TEXTURE_3D, 0);
+    if (_ResourceType != RTCUBETEXTURE)
+      render_states.BindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    if ((_ResourceType != RTTEXTURERECTANGLE) && (_ResourceType != RTANIMATEDTEXTURE))
+      render_states.BindTexture(GL_TEXTURE_RECTANGLE_ARB, 0);
     CHECKGL(glDisable(GL_TEXTURE_2D));
     CHECKGL(glDisable(GL_TEXTURE_3D));
     CHECKGL(glDisable(GL_TEXTURE_RECTANGLE_ARB));
@@ -197,7 +209,7 @@ namespace nux
 
     if (_ResourceType == RTTEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_2D, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_2D, _OpenGLID);
 #ifndef NUX_OPENGLES_20
       CHECKGL(glEnable(GL_TEXTURE_2D));
 #endif
@@ -205,22 +217,22 @@ namespace nux
 #ifndef NUX_OPENGLES_20
     else if (_ResourceType == RTTEXTURERECTANGLE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID);
       CHECKGL(glEnable(GL_TEXTURE_RECTANGLE_ARB));
     }
     else if (_ResourceType == RTCUBETEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID);
       CHECKGL(glEnable(GL_TEXTURE_CUBE_MAP));
     }
     else if (_ResourceType == RTVOLUMETEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_3D, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_3D, _OpenGLID);
       CHECKGL(glEnable(GL_TEXTURE_3D));
     }
     else if (_ResourceType == RTANIMATEDTEXTURE)
     {
-      CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID));
+      render_states.BindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID);
       CHECKGL(glEnable(GL_TEXTURE_RECTANGLE_ARB));
     }
 #endif
@@ -267,7 +279,7 @@ namespace nux
   void IOpenGLBaseTexture::Save(const char* filename)
   {
     GLuint tex_id = GetOpenGLID();
-    glBindTexture(GL_TEXTURE_2D, tex_id);
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_2D, tex_id);
 
     int width, height;
 
@@ -21,6 +21,8 @@
 
 
 #include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "GpuDevice.h"
 #include "IOpenGLCubeTexture.h"
 
 namespace nux
@@ -35,7 +37,7 @@ namespace nux
     : IOpenGLBaseTexture(RTCUBETEXTURE, EdgeLength, EdgeLength, 1, Levels, PixelFormat)
   {
     CHECKGL(glGenTextures(1, &_OpenGLID));
-    CHECKGL(glBindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID);
 
     for (unsigned int face = CUBEMAP_FACE_POSITIVE_X; face < CUBEMAP_FACE_NEGATIVE_Z + 1; face++)
     {
@@ -52,7 +54,7 @@ namespace nux
       }
     }
 
-    CHECKGL(glBindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_CUBE_MAP, _OpenGLID);
     SetFiltering(GL_NEAREST, GL_NEAREST);
     SetWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
     SetRenderStates();
@@ -75,6 +77,8 @@ namespace nux
     }
 
     _SurfaceArray.clear();
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGpuDevice())
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().ForgetTexture(_OpenGLID);
     CHECKGL(glDeleteTextures(1, &_OpenGLID));
     _OpenGLID = 0;
     GRunTimeStats.UnRegister(this);
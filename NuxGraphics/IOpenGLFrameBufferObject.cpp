@@ -273,6 +273,9 @@ namespace nux
 
   int IOpenGLFrameBufferObject::Activate(bool WithClippingStack)
   {
+    if (GetGraphicsDisplay()->GetGraphicsEngine())
+      GetGraphicsDisplay()->GetGraphicsEngine()->FlushQuadBatch();
+
     GLuint NumBuffers = 0;
     _Fbo.Bind();
 
@@ -342,6 +345,9 @@ namespace nux
     GLenum binding = GL_DRAW_FRAMEBUFFER_EXT;
 #endif
 
+    if (GetGraphicsDisplay()->GetGraphicsEngine())
+      GetGraphicsDisplay()->GetGraphicsEngine()->FlushQuadBatch();
+
     CHECKGL(glBindFramebufferEXT( binding, 0 ));
 
 #ifndef NUX_OPENGLES_20
@@ -24,6 +24,10 @@
 #include "GpuDevice.h"
 #include "GLDeviceObjects.h"
 #include "IOpenGLGLSLShader.h"
+#include "GraphicsEngine.h"
+#include "ShaderProgramCache.h"
+
+#include <cstring>
 
 namespace nux
 {
@@ -33,6 +37,58 @@ namespace nux
   {
     GLuint last_loaded_shader = 0;
     bool enable_tracking = false;
+    bool enable_uniform_filtering = true;
+
+    void UseProgram(GLuint program)
+    {
+      GpuDevice* device = GetGraphicsDisplay() ? GetGraphicsDisplay()->GetGpuDevice() : NULL;
+
+      if (!device)
+      {
+        CHECKGL(glUseProgramObjectARB(program));
+        return;
+      }
+
+      // Without the tracking of the shaders, the program is always set.
+      if (!enable_tracking)
+        device->GetRenderStates().InvalidateBindings();
+
+      device->GetRenderStates().UseProgram(program);
+    }
+
+    // Location of a name handle that hasn't been resolved on a program yet.
+    const int UNRESOLVED_LOCATION = -2;
+
+    struct NameTable
+    {
+      NCriticalSection lock;
+      std::map<std::string, int> handles;
+      std::vector<std::string> names;
+    };
+
+    NameTable& GetNameTable()
+    {
+      static NameTable table;
+      return table;
+    }
+
+    std::string GetHandleName(int handle)
+    {
+      NameTable& table = GetNameTable();
+      NScopeLock scope(&table.lock);
+      return table.names[handle];
+    }
+
+    int ResolveHandle(std::vector<int>& locations, int handle)
+    {
+      if (handle < 0)
+        return -1;
+
+      if (handle >= (int) locations.size())
+        locations.resize(handle + 1, UNRESOLVED_LOCATION);
+
+      return locations[handle];
+    }
   }
   }
 
@@ -465,7 +521,7 @@ namespace nux
   {
     if (local::last_loaded_shader == _OpenGLID)
     {
-      CHECKGL(glUseProgramObjectARB(0));
+      local::UseProgram(0);
       local::last_loaded_shader = 0;
     }
       
@@ -589,6 +645,44 @@ namespace nux
 
   bool IOpenGLShaderProgram::Link()
   {
+    ResetLocationCache();
+
+    ShaderProgramCache* program_cache = NULL;
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGpuDevice())
+      program_cache = &GetGraphicsDisplay()->GetGpuDevice()->GetShaderProgramCache();
+
+    // The attribute locations bound by the caller are part of the binary. They are the same for a given set
+    // of sources, the sources are enough to identify the program.
+    std::string cache_key;
+    if (program_cache && program_cache->IsEnabled())
+    {
+      for (int i = 0; i < (int) ShaderObjectList.size(); i++)
+      {
+        cache_key += ShaderObjectList[i]->Type().name;
+        cache_key += '\n';
+        cache_key += ShaderObjectList[i]->_ShaderCode;
+        cache_key += '\n';
+      }
+
+      if (program_cache->Load(_OpenGLID, cache_key))
+      {
+        // Linked without compiling the shaders.
+        m_CompiledAndReady = true;
+
+        Begin();
+        CacheUniformLocations();
+        CheckUniformLocation();
+        CheckAttributeLocation();
+        End();
+
+        return m_CompiledAndReady;
+      }
+
+#ifndef NUX_OPENGLES_20
+      CHECKGL(glProgramParameteri(_OpenGLID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+#endif
+    }
+
     // Get the number of attached shaders.
     GLint NumAttachedShaders;
     CHECKGL(glGetProgramiv(_OpenGLID, GL_ATTACHED_SHADERS, &NumAttachedShaders));
@@ -680,7 +774,11 @@ namespace nux
 
     m_CompiledAndReady = true;
 
+    if (!cache_key.empty())
+      program_cache->Store(_OpenGLID, cache_key);
+
     Begin();
+    CacheUniformLocations();
     CheckUniformLocation();
     CheckAttributeLocation();
     End();
@@ -692,22 +790,23 @@ namespace nux
   {
     local::enable_tracking = enabled;
     local::last_loaded_shader = 0;
-    CHECKGL(glUseProgramObjectARB(0));
+    local::UseProgram(0);
   }
 
   void IOpenGLShaderProgram::Begin(void)
   {
-    if (local::last_loaded_shader == _OpenGLID && local::enable_tracking)
-      return;
-    
+    // The caller is about to set the uniforms and attributes of a program: pending quads must be rendered first.
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGraphicsEngine())
+      GetGraphicsDisplay()->GetGraphicsEngine()->FlushQuadBatch();
+
     local::last_loaded_shader = _OpenGLID;
-    CHECKGL(glUseProgramObjectARB(_OpenGLID));
+    local::UseProgram(_OpenGLID);
   }
 
   void IOpenGLShaderProgram::End(void)
   {
     if (!local::enable_tracking)
-      CHECKGL(glUseProgramObjectARB(0));
+      local::UseProgram(0);
   }
 
   void IOpenGLShaderProgram::CheckAttributeLocation()
@@ -830,365 +929,394 @@ namespace nux
     return -1;
   }
 
-  bool IOpenGLShaderProgram::SetUniform1f(char *varname, GLfloat v0)
+  int IOpenGLShaderProgram::GetAttributeLocation(int name_handle)
   {
-    GLint loc = GetUniformLocationARB(varname);
+    int location = local::ResolveHandle(attribute_handle_locations_, name_handle);
 
-    if (loc == -1) return false; // can't find variable
+    if (location == local::UNRESOLVED_LOCATION)
+    {
+      location = GetAttributeLocation(local::GetHandleName(name_handle).c_str());
 
-    glUniform1fARB(loc, v0);
+      if (m_CompiledAndReady)
+        attribute_handle_locations_[name_handle] = location;
+    }
 
-    return true;
+    return location;
   }
-  bool IOpenGLShaderProgram::SetUniform1f(GLint loc, GLfloat v0)
+
+  int IOpenGLShaderProgram::GetNameHandle(const char *name)
   {
-    if (loc == -1) return false; // can't find variable
+    local::NameTable& table = local::GetNameTable();
+    NScopeLock scope(&table.lock);
 
-    glUniform1fARB(loc, v0);
-    return true;
+    std::map<std::string, int>::iterator it = table.handles.find(name);
+    if (it != table.handles.end())
+      return it->second;
+
+    int handle = (int) table.names.size();
+    table.names.push_back(name);
+    table.handles[name] = handle;
+    return handle;
   }
 
+  void IOpenGLShaderProgram::SetUniformFiltering(bool enabled)
+  {
+    local::enable_uniform_filtering = enabled;
+  }
 
-  bool IOpenGLShaderProgram::SetUniform2f(char *varname, GLfloat v0, GLfloat v1)
+  void IOpenGLShaderProgram::ResetUniformValueCache()
   {
-    GLint loc = GetUniformLocationARB(varname);
+    uniform_values_.clear();
+  }
 
-    if (loc == -1) return false; // can't find variable
+  void IOpenGLShaderProgram::ResetLocationCache()
+  {
+    uniform_locations_.clear();
+    uniform_handle_locations_.clear();
+    attribute_handle_locations_.clear();
+    uniform_values_.clear();
+  }
 
-    glUniform2fARB(loc, v0, v1);
+  void IOpenGLShaderProgram::CacheUniformLocations()
+  {
+    GLint num_active_uniforms = 0;
+    CHECKGL(glGetProgramiv(_OpenGLID, GL_ACTIVE_UNIFORMS, &num_active_uniforms));
 
-    return true;
+    char active_uniform_name[256];
+    GLsizei length;
+    GLint size;
+    GLenum type;
+
+    for (int index = 0; index < num_active_uniforms; index++)
+    {
+      glGetActiveUniformARB(_OpenGLID, index, 256, &length, &size, &type, active_uniform_name);
+      CHECKGL_MSG(glGetActiveUniformARB);
+
+      int location = glGetUniformLocationARB(_OpenGLID, active_uniform_name);
+      CHECKGL_MSG(glGetUniformLocationARB);
+
+      std::string name(active_uniform_name, length);
+      uniform_locations_[name] = location;
+
+      // Arrays are reported as "name[0]": they can also be referred to as "name".
+      if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+        uniform_locations_[name.substr(0, name.size() - 3)] = location;
+    }
   }
-  bool IOpenGLShaderProgram::SetUniform2f(GLint loc, GLfloat v0, GLfloat v1)
+
+  bool IOpenGLShaderProgram::IsUniformValueUnchanged(GLint loc, GLenum type, GLboolean transpose, const void *data, size_t size)
   {
-    if (loc == -1) return false; // can't find variable
+    // Uniforms are set on the program in use. Only filter the values when this program is known to be the one.
+    if (!local::enable_uniform_filtering || !local::enable_tracking || local::last_loaded_shader != _OpenGLID)
+    {
+      uniform_values_.erase(loc);
+      return false;
+    }
 
-    glUniform2fARB(loc, v0, v1);
-    return true;
+    UniformValue& value = uniform_values_[loc];
+
+    if (value.type == type && value.transpose == transpose && !value.data.empty() &&
+        value.data.size() == size && std::memcmp(&value.data[0], data, size) == 0)
+    {
+      return true;
+    }
+
+    value.type = type;
+    value.transpose = transpose;
+    value.data.assign(static_cast<const unsigned char*>(data), static_cast<const unsigned char*>(data) + size);
+    return false;
   }
 
-  bool IOpenGLShaderProgram::SetUniform3f(char *varname, GLfloat v0, GLfloat v1, GLfloat v2)
+  bool IOpenGLShaderProgram::SetUniform1f(char *varname, GLfloat v0)
+  {
+    return SetUniform1f(GetUniformLocationARB(varname), v0);
+  }
+  bool IOpenGLShaderProgram::SetUniform1f(GLint loc, GLfloat v0)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
     if (loc == -1) return false; // can't find variable
 
-    glUniform3fARB(loc, v0, v1, v2);
+    GLfloat value[] = {v0};
+    if (IsUniformValueUnchanged(loc, GL_FLOAT, GL_FALSE, value, sizeof(value)))
+      return true;
 
+    CHECKGL(glUniform1fARB(loc, v0));
     return true;
   }
-  bool IOpenGLShaderProgram::SetUniform3f(GLint loc, GLfloat v0, GLfloat v1, GLfloat v2)
+
+  bool IOpenGLShaderProgram::SetUniform2f(char *varname, GLfloat v0, GLfloat v1)
+  {
+    return SetUniform2f(GetUniformLocationARB(varname), v0, v1);
+  }
+  bool IOpenGLShaderProgram::SetUniform2f(GLint loc, GLfloat v0, GLfloat v1)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform3fARB(loc, v0, v1, v2);
+    GLfloat value[] = {v0, v1};
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_VEC2, GL_FALSE, value, sizeof(value)))
+      return true;
 
+    CHECKGL(glUniform2fARB(loc, v0, v1));
     return true;
   }
 
-  bool IOpenGLShaderProgram::SetUniform4f(char *varname, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+  bool IOpenGLShaderProgram::SetUniform3f(char *varname, GLfloat v0, GLfloat v1, GLfloat v2)
+  {
+    return SetUniform3f(GetUniformLocationARB(varname), v0, v1, v2);
+  }
+  bool IOpenGLShaderProgram::SetUniform3f(GLint loc, GLfloat v0, GLfloat v1, GLfloat v2)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
     if (loc == -1) return false; // can't find variable
 
-    glUniform4fARB(loc, v0, v1, v2, v3);
+    GLfloat value[] = {v0, v1, v2};
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_VEC3, GL_FALSE, value, sizeof(value)))
+      return true;
 
+    CHECKGL(glUniform3fARB(loc, v0, v1, v2));
     return true;
   }
+
+  bool IOpenGLShaderProgram::SetUniform4f(char *varname, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+  {
+    return SetUniform4f(GetUniformLocationARB(varname), v0, v1, v2, v3);
+  }
   bool IOpenGLShaderProgram::SetUniform4f(GLint loc, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform4fARB(loc, v0, v1, v2, v3);
+    GLfloat value[] = {v0, v1, v2, v3};
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_VEC4, GL_FALSE, value, sizeof(value)))
+      return true;
 
+    CHECKGL(glUniform4fARB(loc, v0, v1, v2, v3));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform1i(char *varname, GLint v0)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform1iARB(loc, v0);
-
-    return true;
+    return SetUniform1i(GetUniformLocationARB(varname), v0);
   }
   bool IOpenGLShaderProgram::SetUniform1i(GLint loc, GLint v0)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform1iARB(loc, v0);
+    GLint value[] = {v0};
+    if (IsUniformValueUnchanged(loc, GL_INT, GL_FALSE, value, sizeof(value)))
+      return true;
 
+    CHECKGL(glUniform1iARB(loc, v0));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform2i(char *varname, GLint v0, GLint v1)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform2iARB(loc, v0, v1);
-
-
-    return true;
+    return SetUniform2i(GetUniformLocationARB(varname), v0, v1);
   }
   bool IOpenGLShaderProgram::SetUniform2i(GLint loc, GLint v0, GLint v1)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform2iARB(loc, v0, v1);
-
+    GLint value[] = {v0, v1};
+    if (IsUniformValueUnchanged(loc, GL_INT_VEC2, GL_FALSE, value, sizeof(value)))
+      return true;
 
+    CHECKGL(glUniform2iARB(loc, v0, v1));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform3i(char *varname, GLint v0, GLint v1, GLint v2)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform3iARB(loc, v0, v1, v2);
-
-    return true;
+    return SetUniform3i(GetUniformLocationARB(varname), v0, v1, v2);
   }
   bool IOpenGLShaderProgram::SetUniform3i(GLint loc, GLint v0, GLint v1, GLint v2)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform3iARB(loc, v0, v1, v2);
+    GLint value[] = {v0, v1, v2};
+    if (IsUniformValueUnchanged(loc, GL_INT_VEC3, GL_FALSE, value, sizeof(value)))
+      return true;
 
+    CHECKGL(glUniform3iARB(loc, v0, v1, v2));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform4i(char *varname, GLint v0, GLint v1, GLint v2, GLint v3)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform4iARB(loc, v0, v1, v2, v3);
-
-    return true;
+    return SetUniform4i(GetUniformLocationARB(varname), v0, v1, v2, v3);
   }
   bool IOpenGLShaderProgram::SetUniform4i(GLint loc, GLint v0, GLint v1, GLint v2, GLint v3)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform4iARB(loc, v0, v1, v2, v3);
+    GLint value[] = {v0, v1, v2, v3};
+    if (IsUniformValueUnchanged(loc, GL_INT_VEC4, GL_FALSE, value, sizeof(value)))
+      return true;
 
+    CHECKGL(glUniform4iARB(loc, v0, v1, v2, v3));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform1fv(char *varname, GLsizei count, GLfloat *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform1fvARB(loc, count, value);
-
-    return true;
+    return SetUniform1fv(GetUniformLocationARB(varname), count, value);
   }
   bool IOpenGLShaderProgram::SetUniform1fv(GLint loc, GLsizei count, GLfloat *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform1fvARB(loc, count, value);
+    if (IsUniformValueUnchanged(loc, GL_FLOAT, GL_FALSE, value, count * 1 * sizeof(GLfloat)))
+      return true;
 
+    CHECKGL(glUniform1fvARB(loc, count, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform2fv(char *varname, GLsizei count, GLfloat *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform2fvARB(loc, count, value);
-
-    return true;
+    return SetUniform2fv(GetUniformLocationARB(varname), count, value);
   }
   bool IOpenGLShaderProgram::SetUniform2fv(GLint loc, GLsizei count, GLfloat *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform2fvARB(loc, count, value);
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_VEC2, GL_FALSE, value, count * 2 * sizeof(GLfloat)))
+      return true;
 
+    CHECKGL(glUniform2fvARB(loc, count, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform3fv(char *varname, GLsizei count, GLfloat *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform3fvARB(loc, count, value);
-
-    return true;
+    return SetUniform3fv(GetUniformLocationARB(varname), count, value);
   }
   bool IOpenGLShaderProgram::SetUniform3fv(GLint loc, GLsizei count, GLfloat *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform3fvARB(loc, count, value);
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_VEC3, GL_FALSE, value, count * 3 * sizeof(GLfloat)))
+      return true;
 
+    CHECKGL(glUniform3fvARB(loc, count, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform4fv(char *varname, GLsizei count, GLfloat *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform4fvARB(loc, count, value);
-
-    return true;
+    return SetUniform4fv(GetUniformLocationARB(varname), count, value);
   }
   bool IOpenGLShaderProgram::SetUniform4fv(GLint loc, GLsizei count, GLfloat *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform4fvARB(loc, count, value);
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_VEC4, GL_FALSE, value, count * 4 * sizeof(GLfloat)))
+      return true;
 
+    CHECKGL(glUniform4fvARB(loc, count, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform1iv(char *varname, GLsizei count, GLint *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform1ivARB(loc, count, value);
-
-    return true;
+    return SetUniform1iv(GetUniformLocationARB(varname), count, value);
   }
   bool IOpenGLShaderProgram::SetUniform1iv(GLint loc, GLsizei count, GLint *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform1ivARB(loc, count, value);
+    if (IsUniformValueUnchanged(loc, GL_INT, GL_FALSE, value, count * 1 * sizeof(GLint)))
+      return true;
 
+    CHECKGL(glUniform1ivARB(loc, count, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform2iv(char *varname, GLsizei count, GLint *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform2ivARB(loc, count, value);
-
-    return true;
+    return SetUniform2iv(GetUniformLocationARB(varname), count, value);
   }
   bool IOpenGLShaderProgram::SetUniform2iv(GLint loc, GLsizei count, GLint *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform2ivARB(loc, count, value);
+    if (IsUniformValueUnchanged(loc, GL_INT_VEC2, GL_FALSE, value, count * 2 * sizeof(GLint)))
+      return true;
 
+    CHECKGL(glUniform2ivARB(loc, count, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform3iv(char *varname, GLsizei count, GLint *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform3ivARB(loc, count, value);
-
-    return true;
+    return SetUniform3iv(GetUniformLocationARB(varname), count, value);
   }
   bool IOpenGLShaderProgram::SetUniform3iv(GLint loc, GLsizei count, GLint *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform3ivARB(loc, count, value);
+    if (IsUniformValueUnchanged(loc, GL_INT_VEC3, GL_FALSE, value, count * 3 * sizeof(GLint)))
+      return true;
 
+    CHECKGL(glUniform3ivARB(loc, count, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniform4iv(char *varname, GLsizei count, GLint *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform4ivARB(loc, count, value);
-
-    return true;
+    return SetUniform4iv(GetUniformLocationARB(varname), count, value);
   }
   bool IOpenGLShaderProgram::SetUniform4iv(GLint loc, GLsizei count, GLint *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniform4ivARB(loc, count, value);
+    if (IsUniformValueUnchanged(loc, GL_INT_VEC4, GL_FALSE, value, count * 4 * sizeof(GLint)))
+      return true;
 
+    CHECKGL(glUniform4ivARB(loc, count, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniformMatrix2fv(char *varname, GLsizei count, GLboolean transpose, GLfloat *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniformMatrix2fvARB(loc, count, transpose, value);
-
-    return true;
+    return SetUniformLocMatrix2fv(GetUniformLocationARB(varname), count, transpose, value);
   }
   bool IOpenGLShaderProgram::SetUniformLocMatrix2fv(GLint loc, GLsizei count, GLboolean transpose, GLfloat *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniformMatrix2fvARB(loc, count, transpose, value);
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_MAT2, transpose, value, count * 2 * 2 * sizeof(GLfloat)))
+      return true;
 
+    CHECKGL(glUniformMatrix2fvARB(loc, count, transpose, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniformMatrix3fv(char *varname, GLsizei count, GLboolean transpose, GLfloat *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniformMatrix3fvARB(loc, count, transpose, value);
-
-    return true;
+    return SetUniformLocMatrix3fv(GetUniformLocationARB(varname), count, transpose, value);
   }
   bool IOpenGLShaderProgram::SetUniformLocMatrix3fv(GLint loc, GLsizei count, GLboolean transpose, GLfloat *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniformMatrix3fvARB(loc, count, transpose, value);
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_MAT3, transpose, value, count * 3 * 3 * sizeof(GLfloat)))
+      return true;
 
+    CHECKGL(glUniformMatrix3fvARB(loc, count, transpose, value));
     return true;
   }
 
   bool IOpenGLShaderProgram::SetUniformMatrix4fv(char *varname, GLsizei count, GLboolean transpose, GLfloat *value)
   {
-    GLint loc = GetUniformLocationARB(varname);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniformMatrix4fvARB(loc, count, transpose, value);
-
-    return true;
+    return SetUniformLocMatrix4fv(GetUniformLocationARB(varname), count, transpose, value);
   }
   bool IOpenGLShaderProgram::SetUniformLocMatrix4fv(GLint loc, GLsizei count, GLboolean transpose, GLfloat *value)
   {
     if (loc == -1) return false; // can't find variable
 
-    glUniformMatrix4fvARB(loc, count, transpose, value);
+    if (IsUniformValueUnchanged(loc, GL_FLOAT_MAT4, transpose, value, count * 4 * 4 * sizeof(GLfloat)))
+      return true;
 
+    CHECKGL(glUniformMatrix4fvARB(loc, count, transpose, value));
     return true;
   }
 
@@ -1225,12 +1353,35 @@ namespace nux
 
   int IOpenGLShaderProgram::GetUniformLocationARB(const GLcharARB *name)
   {
+    std::map<std::string, int>::const_iterator it = uniform_locations_.find(name);
+    if (it != uniform_locations_.end())
+      return it->second;
+
     GLint loc;
     loc = glGetUniformLocationARB(_OpenGLID, name);
     CHECKGL_MSG( glGetUniformLocationARB );
+
+    if (m_CompiledAndReady)
+      uniform_locations_[name] = loc;
+
     return loc;
   }
 
+  int IOpenGLShaderProgram::GetUniformLocation(int name_handle)
+  {
+    int location = local::ResolveHandle(uniform_handle_locations_, name_handle);
+
+    if (location == local::UNRESOLVED_LOCATION)
+    {
+      location = GetUniformLocationARB(local::GetHandleName(name_handle).c_str());
+
+      if (m_CompiledAndReady)
+        uniform_handle_locations_[name_handle] = location;
+    }
+
+    return location;
+  }
+
   void IOpenGLShaderProgram::GetActiveUniformARB(
     GLuint index,
     GLsizei maxLength,
@@ -1264,12 +1415,7 @@ namespace nux
 
   bool IOpenGLShaderProgram::SetSampler(char *name, int texture_unit)
   {
-    GLint loc = GetUniformLocationARB(name);
-
-    if (loc == -1) return false; // can't find variable
-
-    glUniform1iARB(loc, texture_unit);
-    return true;
+    return SetUniform1i(GetUniformLocationARB(name), texture_unit);
   }
 
 }
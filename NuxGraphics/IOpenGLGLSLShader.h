@@ -114,6 +114,27 @@ namespace nux
 
     static void SetShaderTracking(bool enabled);
 
+    //! Enable or disable the filtering of redundant uniform uploads.
+    /*!
+        When enabled (the default), the SetUniform* functions of a program skip the OpenGL call if the uniform
+        already holds the provided value. Code that sets the uniforms of a program with direct OpenGL calls must
+        call ResetUniformValueCache on that program afterwards.
+    */
+    static void SetUniformFiltering(bool enabled);
+
+    //! Forget the uniform values that have been uploaded through this program.
+    void ResetUniformValueCache();
+
+    //! Return a process wide handle for a uniform or attribute name.
+    /*!
+        Call sites that resolve the same names for every draw should get a handle once and use
+        GetUniformLocation(int) and GetAttributeLocation(int). After the first call on a given program, these
+        are a simple array lookup.
+        @param name Name of the uniform or attribute.
+        @return A handle that is valid for the lifetime of the process.
+    */
+    static int GetNameHandle(const char *name);
+
   public:
 
     bool SetUniform1f(char *varname, GLfloat v0);
@@ -167,7 +188,14 @@ namespace nux
 
     void GetUniformfv(char *name, GLfloat *values);
     void GetUniformiv(char *name, GLint *values);
+    //! Return the location of a uniform.
+    /*!
+        The locations of the active uniforms are cached when the program is linked. Names that are not in the
+        cache are resolved with OpenGL once and cached as well.
+    */
     int GetUniformLocationARB(const GLchar *name);
+    //! Return the location of a uniform from a handle returned by GetNameHandle.
+    int GetUniformLocation(int name_handle);
     void GetActiveUniformARB(GLuint index,
                               GLsizei maxLength,
                               GLsizei *length,
@@ -205,13 +233,36 @@ namespace nux
     void CheckAttributeLocation();
     void CheckUniformLocation();
     int GetAttributeLocation(const char *AttributeName);
+    //! Return the location of an attribute from a handle returned by GetNameHandle.
+    int GetAttributeLocation(int name_handle);
 
   private:
     IOpenGLShaderProgram(std::string ShaderProgramName = std::string("ShaderProgram"));
+
+    void CacheUniformLocations();
+    void ResetLocationCache();
+    //! Return true if the uniform at loc already holds the value. Otherwise remember the value and return false.
+    bool IsUniformValueUnchanged(GLint loc, GLenum type, GLboolean transpose, const void *data, size_t size);
+
+    struct UniformValue
+    {
+      UniformValue() : type(0), transpose(GL_FALSE) {}
+
+      GLenum type;
+      GLboolean transpose;
+      std::vector<unsigned char> data;
+    };
+
     ShaderAttributeDefinition m_ProgramAttributeDefinition[16/*NUM_VERTEX_SHADER_INPUT_ATTRIBUTE*/];
     std::vector<ObjectPtr<IOpenGLShader> > ShaderObjectList;
     bool m_CompiledAndReady;
     std::string _ShaderProgramName;
+
+    std::map<std::string, int> uniform_locations_;
+    std::vector<int> uniform_handle_locations_;
+    std::vector<int> attribute_handle_locations_;
+    std::map<GLint, UniformValue> uniform_values_;
+
     friend class GpuDevice;
   };
 
@@ -21,6 +21,7 @@
 
 
 #include "GpuDevice.h"
+#include "GraphicsDisplay.h"
 #include "GLDeviceObjects.h"
 #include "IOpenGLIndexBuffer.h"
 
@@ -39,14 +40,16 @@ namespace nux
     ,   _SizeToLock(0)
   {
     CHECKGL(glGenBuffersARB(1, &_OpenGLID));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, _OpenGLID);
     CHECKGL(glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, _Length, NULL, Usage));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     GRunTimeStats.Register(this);
   }
 
   IOpenGLIndexBuffer::~IOpenGLIndexBuffer()
   {
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGpuDevice())
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().ForgetBuffer(_OpenGLID);
     CHECKGL(glDeleteBuffersARB(1, &_OpenGLID));
     _OpenGLID = 0;
     GRunTimeStats.UnRegister(this);
@@ -77,7 +80,7 @@ namespace nux
     nuxAssert(_OffsetToLock == 0);
     nuxAssert(_SizeToLock == 0);
 
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, _OpenGLID);
     // Map the Entire buffer into system memory
 #ifndef NUX_OPENGLES_20
     _MemMap = (BYTE *) glMapBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, GL_WRITE_ONLY_ARB); // todo: use Format instead of GL_WRITE_ONLY_ARB
@@ -91,7 +94,7 @@ namespace nux
     _OffsetToLock   = OffsetToLock;
     _SizeToLock     = SizeToLock;
 
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     return OGL_OK;
   }
@@ -102,7 +105,7 @@ namespace nux
     nuxAssert(_SizeToLock != 0);
 
     // No need to bind
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, _OpenGLID);
 
 #ifndef NUX_OPENGLES_20
     CHECKGL(glUnmapBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB));
@@ -111,7 +114,7 @@ namespace nux
     delete [] _MemMap;
 #endif
 
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     _MemMap         = 0;
     _OffsetToLock   = 0;
@@ -136,7 +139,7 @@ namespace nux
 
   void IOpenGLIndexBuffer::BindIndexBuffer()
   {
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, _OpenGLID);
   }
 
   unsigned int IOpenGLIndexBuffer::GetSize()
@@ -21,6 +21,8 @@
 
 
 #include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "GpuDevice.h"
 #include "IOpenGLPixelBufferOject.h"
 
 namespace nux
@@ -37,14 +39,16 @@ namespace nux
     ,   _SizeToLock(0)
   {
     CHECKGL(glGenBuffersARB(1, &_OpenGLID));
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, _OpenGLID);
     CHECKGL(glBufferDataARB(GL_ARRAY_BUFFER_ARB, _Length, NULL, Usage));
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
     GRunTimeStats.Register(this);
   }
 
   IOpenGLPixelBufferObject::~IOpenGLPixelBufferObject()
   {
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGpuDevice())
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().ForgetBuffer(_OpenGLID);
     CHECKGL(glDeleteBuffersARB(1, &_OpenGLID));
     _OpenGLID = 0;
     GRunTimeStats.UnRegister(this);
@@ -21,6 +21,8 @@
 
 
 #include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "GpuDevice.h"
 #include "IOpenGLRectangleTexture.h"
 
 namespace nux
@@ -39,7 +41,7 @@ namespace nux
     if (Dummy == false)
     {
       CHECKGL(glGenTextures(1, &_OpenGLID));
-      CHECKGL(glBindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_RECTANGLE_ARB, _OpenGLID);
     }
 
     //_SurfaceArray.Empty(Levels);
@@ -68,6 +70,8 @@ namespace nux
     }
 
     _SurfaceArray.clear();
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGpuDevice())
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().ForgetTexture(_OpenGLID);
     CHECKGL(glDeleteTextures(1, &_OpenGLID));
     _OpenGLID = 0;
     GRunTimeStats.UnRegister(this);
@@ -25,6 +25,8 @@
 #include "GpuDevice.h"
 #include "GLDeviceObjects.h"
 #include "IOpenGLSurface.h"
+#include "GraphicsEngine.h"
+#include "TextureUploadRing.h"
 
 namespace nux
 {
@@ -45,6 +47,8 @@ namespace nux
     , _SSlice(Slice)
     , _BaseTexture(DeviceBaseTexture)
     , _AllocatedUnpackBuffer(0xFFFFFFFF)
+    , _UploadRingOffset(-1)
+    , _LockedDataSize(0)
   {
     // IOpenGLSurface surfaces are created inside a IOpenGLTexture2D, IOpenGLCubeTexture and IOpenGLVolumeTexture.
     // They reside within those classes. The reference counting starts once a call to GetSurfaceLevel,
@@ -144,7 +148,7 @@ namespace nux
     GLint unpack_alignment = GPixelFormats[_BaseTexture->_PixelFormat].RowMemoryAlignment;
     unsigned int halfUnpack = Log2(unpack_alignment);
 
-    CHECKGL(glBindTexture(_STextureTarget, _BaseTexture->_OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(_STextureTarget, _BaseTexture->_OpenGLID);
 
     unsigned int surface_size = 0;
     unsigned int BytePerPixel = 0;
@@ -238,29 +242,12 @@ namespace nux
     _Rect.bottom  = texheight;
     _Rect.right   = texwidth;
 
-
-    if (GetGraphicsDisplay()->GetGpuDevice()->UsePixelBufferObjects())
-    {
-      GetGraphicsDisplay()->GetGpuDevice()->AllocateUnpackPixelBufferIndex(&_AllocatedUnpackBuffer);
-    }
-
     if (pRect == 0)
     {
-      if (GetGraphicsDisplay()->GetGpuDevice()->UsePixelBufferObjects())
-      {
-        // Mapping the entire area of the surface
-        _LockedRect.pBits = GetGraphicsDisplay()->GetGpuDevice()->LockUnpackPixelBufferIndex(_AllocatedUnpackBuffer, surface_size);
-        pLockedRect->pBits = _LockedRect.pBits;
-        pLockedRect->Pitch = _LockedRect.Pitch;
-      }
-      else
-      {
-        //[DEBUGGING - NO PBO]
-        // Mapping the entire area of the surface
-        _LockedRect.pBits = new BYTE[surface_size];
-        pLockedRect->pBits = _LockedRect.pBits;
-        pLockedRect->Pitch = _LockedRect.Pitch;
-      }
+      // Mapping the entire area of the surface
+      _LockedRect.pBits = AllocateLockedData(surface_size);
+      pLockedRect->pBits = _LockedRect.pBits;
+      pLockedRect->Pitch = _LockedRect.Pitch;
     }
     else
     {
@@ -287,19 +274,9 @@ namespace nux
         return OGL_INVALID_LOCK;
       }
 
-      if (GetGraphicsDisplay()->GetGpuDevice()->UsePixelBufferObjects())
-      {
-        _LockedRect.pBits = GetGraphicsDisplay()->GetGpuDevice()->LockUnpackPixelBufferIndex(_AllocatedUnpackBuffer, RectSize);
-        pLockedRect->pBits = ((BYTE *) _LockedRect.pBits);
-        pLockedRect->Pitch = (((RectWidth * BytePerPixel + (unpack_alignment - 1)) >> (halfUnpack)) << (halfUnpack));
-      }
-      else
-      {
-        //[DEBUGGING - NO PBO]
-        _LockedRect.pBits = new BYTE[RectSize];
-        pLockedRect->pBits = ((BYTE *) _LockedRect.pBits);
-        pLockedRect->Pitch = (((RectWidth * BytePerPixel + (unpack_alignment - 1)) >> (halfUnpack)) << (halfUnpack));
-      }
+      _LockedRect.pBits = AllocateLockedData(RectSize);
+      pLockedRect->pBits = ((BYTE *) _LockedRect.pBits);
+      pLockedRect->Pitch = (((RectWidth * BytePerPixel + (unpack_alignment - 1)) >> (halfUnpack)) << (halfUnpack));
 
       _Rect.left  = pRect->left;
       _Rect.top   = pRect->top;
@@ -317,6 +294,17 @@ namespace nux
       return OGL_INVALID_UNLOCK;
     }
 
+    // Quads that use the previous content of the texture may still be waiting to be rendered.
+    if (GetGraphicsDisplay()->GetGraphicsEngine())
+      GetGraphicsDisplay()->GetGraphicsEngine()->FlushQuadBatch();
+
+    TextureUploadRing& upload_ring = GetGraphicsDisplay()->GetGpuDevice()->GetTextureUploadRing();
+    upload_ring.RecordUpload(_LockedDataSize);
+
+    // This leaves the ring bound as the unpack buffer.
+    if (_UploadRingOffset >= 0)
+      upload_ring.Unlock();
+
     CHECKGL(glPixelStorei(GL_UNPACK_ALIGNMENT, _BaseTexture->GetFormatRowMemoryAlignment()));
 
 #ifndef NUX_OPENGLES_20
@@ -328,10 +316,14 @@ namespace nux
       BYTE *DataPtr = 0;
       int w = _Rect.right - _Rect.left;
       int h = _Rect.bottom - _Rect.top;
-      CHECKGL(glBindTexture(_STextureTarget, _BaseTexture->_OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(_STextureTarget, _BaseTexture->_OpenGLID);
 
 #ifndef NUX_OPENGLES_20
-      if (GetGraphicsDisplay()->GetGpuDevice()->UsePixelBufferObjects())
+      if (_UploadRingOffset >= 0)
+      {
+        DataPtr = NUX_BUFFER_OFFSET(_UploadRingOffset);
+      }
+      else if (GetGraphicsDisplay()->GetGpuDevice()->UsePixelBufferObjects())
       {
         // Unmap the texture image buffer
         GetGraphicsDisplay()->GetGpuDevice()->BindUnpackPixelBufferIndex(_AllocatedUnpackBuffer);
@@ -486,7 +478,11 @@ namespace nux
     }
 
 #ifndef NUX_OPENGLES_20
-    if (GetGraphicsDisplay()->GetGpuDevice()->UsePixelBufferObjects())
+    if (_UploadRingOffset >= 0)
+    {
+      CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0));
+    }
+    else if (GetGraphicsDisplay()->GetGpuDevice()->UsePixelBufferObjects())
     {
       CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0));
       GetGraphicsDisplay()->GetGpuDevice()->FreeUnpackPixelBufferIndex(_AllocatedUnpackBuffer);
@@ -508,10 +504,34 @@ namespace nux
     _LockedRect.pBits = 0;
     _LockedRect.Pitch = 0;
     _CompressedDataSize = 0;
+    _UploadRingOffset = -1;
+    _LockedDataSize = 0;
 
     return OGL_OK;
   }
 
+  BYTE* IOpenGLSurface::AllocateLockedData(unsigned int size)
+  {
+    GpuDevice* gpu_device = GetGraphicsDisplay()->GetGpuDevice();
+    _LockedDataSize = size;
+
+    // Sub-allocate the data in the upload ring, it doesn't fit if the surface is too large.
+    void* data = gpu_device->GetTextureUploadRing().Lock(size, &_UploadRingOffset);
+    if (data)
+      return (BYTE*) data;
+
+    _UploadRingOffset = -1;
+
+    if (gpu_device->UsePixelBufferObjects())
+    {
+      gpu_device->AllocateUnpackPixelBufferIndex(&_AllocatedUnpackBuffer);
+      return (BYTE*) gpu_device->LockUnpackPixelBufferIndex(_AllocatedUnpackBuffer, size);
+    }
+
+    //[DEBUGGING - NO PBO]
+    return new BYTE[size];
+  }
+
   int IOpenGLSurface::InitializeLevel()
   {
     // Because we use SubImage when unlocking surfaces, we must first get some dummy data in the surface before we can make a lock.
@@ -626,6 +646,9 @@ namespace nux
 
   void IOpenGLSurface::CopyRenderTarget(int x, int y, int width, int height)
   {
+    if (GetGraphicsDisplay()->GetGraphicsEngine())
+      GetGraphicsDisplay()->GetGraphicsEngine()->FlushQuadBatch();
+
     CHECKGL(glPixelStorei(GL_UNPACK_ALIGNMENT, _BaseTexture->GetFormatRowMemoryAlignment()));
 
 #ifndef NUX_OPENGLES_20
@@ -634,7 +657,7 @@ namespace nux
     if (_STextureTarget == GL_TEXTURE_2D)
 #endif
     {
-      CHECKGL(glBindTexture(_STextureTarget, _BaseTexture->_OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(_STextureTarget, _BaseTexture->_OpenGLID);
 
 
 #ifndef NUX_OPENGLES_20
@@ -685,16 +708,39 @@ namespace nux
       return NULL;
     }
 
+    // We want RGBA data
+    int mip_level_size = GetWidth() * GetHeight() * 4;
+    unsigned char* img = new unsigned char[mip_level_size];
+
+    if (!ReadSurfaceData(img))
+    {
+      delete [] img;
+      return NULL;
+    }
+
+    width = GetWidth();
+    height = GetHeight(); 
+    stride = width * 4;
+
+    return img;
+  }
+
+  bool IOpenGLSurface::ReadSurfaceData(unsigned char* pixels)
+  {
+    if (_BaseTexture->_OpenGLID == 0)
+    {
+      return false;
+    }
+
+    if (GetGraphicsDisplay()->GetGraphicsEngine())
+      GetGraphicsDisplay()->GetGraphicsEngine()->FlushQuadBatch();
+
 #ifndef NUX_OPENGLES_20
-    CHECKGL(glBindTexture(_STextureTarget, _BaseTexture->_OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(_STextureTarget, _BaseTexture->_OpenGLID);
 
     // Despite a 1 byte pack alignment not being the most optimum, do it for simplicity.
     CHECKGL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
 
-    // We want RGBA data
-    int mip_level_size = GetWidth() * GetHeight() * 4;
-    unsigned char* img = new unsigned char[mip_level_size];
-
     // Internal OpenGL textures are in the RGBA format.
     // If the selected texture image does not contain four components, the following mappings are applied:
     // - Single-component textures are treated as RGBA buffers with red set to the single-component value, green set to 0, blue set to 0, and alpha set to 1.
@@ -714,16 +760,12 @@ namespace nux
     //   - blue set to component two
     //   - alpha set to 1.0
 
-    CHECKGL(glGetTexImage(_STextureTarget, _SMipLevel, GL_RGBA, GL_UNSIGNED_BYTE, img));
+    CHECKGL(glGetTexImage(_STextureTarget, _SMipLevel, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
 
-    width = GetWidth();
-    height = GetHeight(); 
-    stride = width * 4;
-
-    return img;
+    return true;
 #else
     //FIXME: need to render to framebuffer and use glReadPixels
-    return NULL;
+    return false;
 #endif
   }
 }
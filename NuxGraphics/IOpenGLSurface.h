@@ -58,6 +58,15 @@ namespace nux
     */
     unsigned char* GetSurfaceData(int &width, int &height, int &stride);
 
+    //! Read the mipmap data in RGBA, 8 bits per channel.
+    /*!
+        If a pixel pack buffer is bound, pixels is an offset in the buffer and the read is asynchronous.
+
+        @param pixels Receives the rows of the image, GetWidth() * 4 bytes each, without padding.
+        @return False if the surface can't be read.
+    */
+    bool ReadSurfaceData(unsigned char* pixels);
+
   private:
     virtual ~IOpenGLSurface();
 
@@ -114,6 +123,12 @@ namespace nux
     bool            _Initialized;
 
     int _AllocatedUnpackBuffer;
+    int _UploadRingOffset;  //!< Offset of the locked data in the texture upload ring, or -1.
+    int _LockedDataSize;
+
+    //! Allocate the data of LockRect, in the texture upload ring if it can hold it.
+    BYTE* AllocateLockedData(unsigned int size);
+
     friend class IOpenGLTexture2D;
     friend class IOpenGLRectangleTexture;
     friend class IOpenGLCubeTexture;
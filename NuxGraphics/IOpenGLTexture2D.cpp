@@ -21,6 +21,8 @@
 
 
 #include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "GpuDevice.h"
 #include "IOpenGLTexture2D.h"
 
 namespace nux
@@ -37,7 +39,7 @@ namespace nux
     if (external_id_ == false)
     {
       CHECKGL(glGenTextures(1, &_OpenGLID));
-      CHECKGL(glBindTexture(GL_TEXTURE_2D, _OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_2D, _OpenGLID);
     }
 
     //_SurfaceArray.Empty(Levels);
@@ -80,6 +82,8 @@ namespace nux
 
     if (external_id_ == false)
     {
+      if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGpuDevice())
+        GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().ForgetTexture(_OpenGLID);
       CHECKGL(glDeleteTextures(1, &_OpenGLID));
     }
     GRunTimeStats.UnRegister(this);
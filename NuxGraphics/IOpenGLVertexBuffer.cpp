@@ -21,6 +21,7 @@
 
 
 #include "GpuDevice.h"
+#include "GraphicsDisplay.h"
 #include "GLDeviceObjects.h"
 #include "IOpenGLVertexBuffer.h"
 
@@ -38,14 +39,16 @@ namespace nux
     ,   _SizeToLock(0)
   {
     CHECKGL(glGenBuffersARB(1, &_OpenGLID));
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, _OpenGLID);
     CHECKGL(glBufferDataARB(GL_ARRAY_BUFFER_ARB, _Length, NULL, Usage));
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
     GRunTimeStats.Register(this);
   }
 
   IOpenGLVertexBuffer::~IOpenGLVertexBuffer()
   {
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGpuDevice())
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().ForgetBuffer(_OpenGLID);
     CHECKGL(glDeleteBuffersARB(1, &_OpenGLID));
     _OpenGLID = 0;
     GRunTimeStats.UnRegister(this);
@@ -79,7 +82,7 @@ namespace nux
     nuxAssert(_OffsetToLock == 0);
     nuxAssert(_SizeToLock == 0);
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, _OpenGLID);
 #ifndef NUX_OPENGLES_20
     // Map the Entire buffer into system memory
     _MemMap = (BYTE *) glMapBufferARB(GL_ARRAY_BUFFER_ARB, GL_WRITE_ONLY_ARB);
@@ -93,14 +96,14 @@ namespace nux
     _OffsetToLock   = OffsetToLock;
     _SizeToLock     = SizeToLock;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
 
     return OGL_OK;
   }
 
   int IOpenGLVertexBuffer::Unlock()
   {
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, _OpenGLID);
 
 #ifndef NUX_OPENGLES_20
     CHECKGL(glUnmapBufferARB(GL_ARRAY_BUFFER_ARB));
@@ -108,7 +111,7 @@ namespace nux
     CHECKGL(glBufferSubData(GL_ARRAY_BUFFER_ARB, _OffsetToLock, _SizeToLock, _MemMap));
     delete [] _MemMap;
 #endif
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
 
     _MemMap         = 0;
     _OffsetToLock   = 0;
@@ -118,7 +121,7 @@ namespace nux
 
   void IOpenGLVertexBuffer::BindVertexBuffer()
   {
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, _OpenGLID);
   }
 
   unsigned int IOpenGLVertexBuffer::GetSize()
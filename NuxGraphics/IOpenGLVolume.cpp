@@ -68,7 +68,7 @@ namespace nux
     //GLint unpack_alignment = GPixelFormats[_VolumeTexture->_PixelFormat].RowMemoryAlignment;
 
 
-    CHECKGL(glBindTexture(_STextureTarget, _VolumeTexture->_OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(_STextureTarget, _VolumeTexture->_OpenGLID);
 
     unsigned int surface_size = 0;
 
@@ -275,7 +275,7 @@ namespace nux
     if (_STextureTarget == GL_TEXTURE_3D)
     {
       BYTE *DataPtr = 0;
-      CHECKGL(glBindTexture(_STextureTarget, _VolumeTexture->_OpenGLID));
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(_STextureTarget, _VolumeTexture->_OpenGLID);
 
       if (GetGraphicsDisplay()->GetGpuDevice()->UsePixelBufferObjects())
       {
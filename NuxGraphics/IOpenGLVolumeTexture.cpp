@@ -21,6 +21,8 @@
 
 
 #include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "GpuDevice.h"
 #include "IOpenGLVolumeTexture.h"
 
 namespace nux
@@ -38,7 +40,7 @@ namespace nux
   {
 #ifndef NUX_OPENGLES_20
     CHECKGL(glGenTextures(1, &_OpenGLID));
-    CHECKGL(glBindTexture(GL_TEXTURE_3D, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_3D, _OpenGLID);
 
     _VolumeSurfaceArray = new std::vector< ObjectPtr<IOpenGLSurface> >[_NumMipLevel];
 
@@ -61,7 +63,7 @@ namespace nux
       _VolumeArray.push_back(ObjectPtr<IOpenGLVolume> (volume));
     }
 
-    CHECKGL(glBindTexture(GL_TEXTURE_3D, _OpenGLID));
+    GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().BindTexture(GL_TEXTURE_3D, _OpenGLID);
     SetFiltering(GL_NEAREST, GL_NEAREST);
     SetWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
     SetRenderStates();
@@ -92,6 +94,8 @@ namespace nux
       _VolumeArray[mip] = ObjectPtr<IOpenGLVolume> (0);
     }
 
+    if (GetGraphicsDisplay() && GetGraphicsDisplay()->GetGpuDevice())
+      GetGraphicsDisplay()->GetGpuDevice()->GetRenderStates().ForgetTexture(_OpenGLID);
     CHECKGL(glDeleteTextures(1, &_OpenGLID));
     _OpenGLID = 0;
     GRunTimeStats.UnRegister(this);
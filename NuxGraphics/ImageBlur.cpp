@@ -0,0 +1,388 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#include "NuxCore/NuxCore.h"
+#include "ImageBlur.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  #define NUX_BLUR_X86
+  #include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define NUX_BLUR_NEON
+  #include <arm_neon.h>
+#endif
+
+namespace nux
+{
+  namespace
+  {
+    // Precision of the alpha parameter in fixed-point format 0.APREC.
+    const int APREC = 16;
+    // Precision of the filter state in fixed-point format 8.ZPREC. The state fits in 16 bits.
+    const int ZPREC = 7;
+
+    // Number of bytes of the rows that are filtered together by the horizontal pass.
+    const int TILE_BYTES = 64;
+
+    const int MIN_THREADED_PIXELS = 512 * 512;
+    const int MAX_THREADS = 4;
+
+    //! Filter one step of n independent bytes: z moves toward p by a fraction alpha of the distance.
+    typedef void (*StepFunction)(unsigned char* p, short* z, int n, int alpha);
+
+    inline void StepScalarRange(unsigned char* p, short* z, int begin, int n, int alpha)
+    {
+      for (int i = begin; i < n; ++i)
+      {
+        int zi = z[i];
+        zi += (alpha * ((p[i] << ZPREC) - zi)) >> APREC;
+        z[i] = zi;
+        p[i] = zi >> ZPREC;
+      }
+    }
+
+    void StepScalar(unsigned char* p, short* z, int n, int alpha)
+    {
+      StepScalarRange(p, z, 0, n, alpha);
+    }
+
+    // The SIMD steps compute (alpha * d) >> 16 with a signed 16 bits multiplication: alpha is stored as
+    // alpha - 65536 when it does not fit in a signed short, and d is added back to the high half of the product.
+
+#if defined(NUX_BLUR_X86)
+    __attribute__((target("sse2")))
+    inline __m128i UpdateSSE2(__m128i z, __m128i p, __m128i alpha, __m128i alpha_correction)
+    {
+      __m128i d = _mm_sub_epi16(_mm_slli_epi16(p, ZPREC), z);
+      __m128i t = _mm_add_epi16(_mm_mulhi_epi16(d, alpha), _mm_and_si128(d, alpha_correction));
+      return _mm_add_epi16(z, t);
+    }
+
+    __attribute__((target("sse2")))
+    void StepSSE2(unsigned char* p, short* z, int n, int alpha)
+    {
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i alpha_s = _mm_set1_epi16((short) alpha);
+      const __m128i alpha_correction = _mm_set1_epi16(alpha >= 32768 ? -1 : 0);
+
+      int i = 0;
+      for (; i + 16 <= n; i += 16)
+      {
+        __m128i px = _mm_loadu_si128((__m128i*) (p + i));
+        __m128i z0 = _mm_loadu_si128((__m128i*) (z + i));
+        __m128i z1 = _mm_loadu_si128((__m128i*) (z + i + 8));
+
+        z0 = UpdateSSE2(z0, _mm_unpacklo_epi8(px, zero), alpha_s, alpha_correction);
+        z1 = UpdateSSE2(z1, _mm_unpackhi_epi8(px, zero), alpha_s, alpha_correction);
+
+        _mm_storeu_si128((__m128i*) (z + i), z0);
+        _mm_storeu_si128((__m128i*) (z + i + 8), z1);
+        _mm_storeu_si128((__m128i*) (p + i), _mm_packus_epi16(_mm_srai_epi16(z0, ZPREC), _mm_srai_epi16(z1, ZPREC)));
+      }
+
+      StepScalarRange(p, z, i, n, alpha);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i UpdateAVX2(__m256i z, __m256i p, __m256i alpha, __m256i alpha_correction)
+    {
+      __m256i d = _mm256_sub_epi16(_mm256_slli_epi16(p, ZPREC), z);
+      __m256i t = _mm256_add_epi16(_mm256_mulhi_epi16(d, alpha), _mm256_and_si256(d, alpha_correction));
+      return _mm256_add_epi16(z, t);
+    }
+
+    __attribute__((target("avx2")))
+    void StepAVX2(unsigned char* p, short* z, int n, int alpha)
+    {
+      const __m256i alpha_s = _mm256_set1_epi16((short) alpha);
+      const __m256i alpha_correction = _mm256_set1_epi16(alpha >= 32768 ? -1 : 0);
+
+      int i = 0;
+      for (; i + 32 <= n; i += 32)
+      {
+        __m256i p0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*) (p + i)));
+        __m256i p1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*) (p + i + 16)));
+        __m256i z0 = _mm256_loadu_si256((__m256i*) (z + i));
+        __m256i z1 = _mm256_loadu_si256((__m256i*) (z + i + 16));
+
+        z0 = UpdateAVX2(z0, p0, alpha_s, alpha_correction);
+        z1 = UpdateAVX2(z1, p1, alpha_s, alpha_correction);
+
+        _mm256_storeu_si256((__m256i*) (z + i), z0);
+        _mm256_storeu_si256((__m256i*) (z + i + 16), z1);
+
+        // The pack works on each 128 bits lane: put the 64 bits blocks back in order.
+        __m256i packed = _mm256_packus_epi16(_mm256_srai_epi16(z0, ZPREC), _mm256_srai_epi16(z1, ZPREC));
+        _mm256_storeu_si256((__m256i*) (p + i), _mm256_permute4x64_epi64(packed, 0xD8));
+      }
+
+      StepScalarRange(p, z, i, n, alpha);
+    }
+#endif
+
+#if defined(NUX_BLUR_NEON)
+    inline int16x8_t UpdateNEON(int16x8_t z, int16x8_t p, int16x4_t alpha, int16x8_t alpha_correction)
+    {
+      int16x8_t d = vsubq_s16(vshlq_n_s16(p, ZPREC), z);
+      int16x8_t t = vcombine_s16(vshrn_n_s32(vmull_s16(vget_low_s16(d), alpha), 16),
+                                 vshrn_n_s32(vmull_s16(vget_high_s16(d), alpha), 16));
+      t = vaddq_s16(t, vandq_s16(d, alpha_correction));
+      return vaddq_s16(z, t);
+    }
+
+    void StepNEON(unsigned char* p, short* z, int n, int alpha)
+    {
+      const int16x4_t alpha_s = vdup_n_s16((short) alpha);
+      const int16x8_t alpha_correction = vdupq_n_s16(alpha >= 32768 ? -1 : 0);
+
+      int i = 0;
+      for (; i + 16 <= n; i += 16)
+      {
+        uint8x16_t px = vld1q_u8(p + i);
+        int16x8_t z0 = vld1q_s16(z + i);
+        int16x8_t z1 = vld1q_s16(z + i + 8);
+
+        z0 = UpdateNEON(z0, vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(px))), alpha_s, alpha_correction);
+        z1 = UpdateNEON(z1, vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(px))), alpha_s, alpha_correction);
+
+        vst1q_s16(z + i, z0);
+        vst1q_s16(z + i + 8, z1);
+        vst1q_u8(p + i, vcombine_u8(vqmovun_s16(vshrq_n_s16(z0, ZPREC)), vqmovun_s16(vshrq_n_s16(z1, ZPREC))));
+      }
+
+      StepScalarRange(p, z, i, n, alpha);
+    }
+#endif
+
+    StepFunction GetStepFunction(BlurImplementation implementation)
+    {
+      switch (implementation)
+      {
+#if defined(NUX_BLUR_X86)
+        case BLUR_SSE2:
+          return StepSSE2;
+        case BLUR_AVX2:
+          return StepAVX2;
+#endif
+#if defined(NUX_BLUR_NEON)
+        case BLUR_NEON:
+          return StepNEON;
+#endif
+        default:
+          return StepScalar;
+      }
+    }
+
+    //! Filter lines of n bytes in both directions. The lines are filtered one after the other.
+    /*!
+        The forward direction stops before the last line if filter_last_line is false.
+    */
+    void BlurLines(StepFunction step, unsigned char* base, int stride, int n, int lines, bool filter_last_line,
+                   short* z, int alpha)
+    {
+      for (int i = 0; i < n; ++i)
+        z[i] = base[i] << ZPREC;
+
+      int last_line = filter_last_line ? lines - 1 : lines - 2;
+
+      for (int line = 1; line <= last_line; ++line)
+        step(base + line * stride, z, n, alpha);
+
+      for (int line = lines - 2; line >= 0; --line)
+        step(base + line * stride, z, n, alpha);
+    }
+
+    template<int CHANNELS>
+    void TransposeRows(unsigned char* pixels, int width, int stride, int rows, unsigned char* tile, bool to_tile)
+    {
+      int n = rows * CHANNELS;
+
+      for (int r = 0; r < rows; ++r)
+      {
+        unsigned char* row = pixels + r * stride;
+        unsigned char* column = tile + r * CHANNELS;
+
+        for (int x = 0; x < width; ++x, row += CHANNELS, column += n)
+        {
+          if (to_tile)
+            std::memcpy(column, row, CHANNELS);
+          else
+            std::memcpy(row, column, CHANNELS);
+        }
+      }
+    }
+
+    void TransposeRows(int channels, unsigned char* pixels, int width, int stride, int rows, unsigned char* tile, bool to_tile)
+    {
+      switch (channels)
+      {
+        case 1:
+          TransposeRows<1>(pixels, width, stride, rows, tile, to_tile);
+          break;
+        case 2:
+          TransposeRows<2>(pixels, width, stride, rows, tile, to_tile);
+          break;
+        case 3:
+          TransposeRows<3>(pixels, width, stride, rows, tile, to_tile);
+          break;
+        default:
+          TransposeRows<4>(pixels, width, stride, rows, tile, to_tile);
+          break;
+      }
+    }
+
+    //! Horizontal pass over the rows [row_begin, row_end).
+    /*!
+        Groups of rows are transposed in a tile so the same byte of all the rows of the group is filtered in
+        a single step.
+    */
+    void BlurRows(StepFunction step, unsigned char* pixels, int width, int stride, int channels,
+                  int row_begin, int row_end, int alpha)
+    {
+      int tile_rows = TILE_BYTES / channels;
+      std::vector<unsigned char> tile(width * tile_rows * channels);
+      std::vector<short> z(tile_rows * channels);
+
+      for (int row = row_begin; row < row_end; row += tile_rows)
+      {
+        int rows = std::min(tile_rows, row_end - row);
+        int n = rows * channels;
+        unsigned char* first_row = pixels + row * stride;
+
+        TransposeRows(channels, first_row, width, stride, rows, &tile[0], true);
+        BlurLines(step, &tile[0], n, n, width, true, &z[0], alpha);
+        TransposeRows(channels, first_row, width, stride, rows, &tile[0], false);
+      }
+    }
+
+    //! Vertical pass over the bytes [byte_begin, byte_end) of the rows.
+    void BlurColumns(StepFunction step, unsigned char* pixels, int height, int stride,
+                     int byte_begin, int byte_end, int alpha)
+    {
+      std::vector<short> z(byte_end - byte_begin);
+      BlurLines(step, pixels + byte_begin, stride, byte_end - byte_begin, height, false, &z[0], alpha);
+    }
+
+    //! Run job(0) ... job(count - 1), the first one on the calling thread.
+    template<typename Job>
+    void RunJobs(int count, Job const& job)
+    {
+      std::vector<std::thread> threads;
+
+      for (int i = 1; i < count; ++i)
+        threads.push_back(std::thread(job, i));
+
+      job(0);
+
+      for (auto& thread : threads)
+        thread.join();
+    }
+  }
+
+  bool IsBlurImplementationSupported(BlurImplementation implementation)
+  {
+    switch (implementation)
+    {
+      case BLUR_AUTO:
+      case BLUR_SCALAR:
+        return true;
+#if defined(NUX_BLUR_X86)
+      case BLUR_SSE2:
+        return __builtin_cpu_supports("sse2");
+      case BLUR_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+#if defined(NUX_BLUR_NEON)
+      case BLUR_NEON:
+        return true;
+#endif
+      default:
+        return false;
+    }
+  }
+
+  BlurImplementation GetDefaultBlurImplementation()
+  {
+    static BlurImplementation implementation =
+      IsBlurImplementationSupported(BLUR_AVX2) ? BLUR_AVX2 :
+      IsBlurImplementationSupported(BLUR_SSE2) ? BLUR_SSE2 :
+      IsBlurImplementationSupported(BLUR_NEON) ? BLUR_NEON :
+      BLUR_SCALAR;
+
+    return implementation;
+  }
+
+  void ExpBlur(unsigned char* pixels, int width, int height, int stride, int channels, int radius,
+               BlurImplementation implementation, int max_threads)
+  {
+    if (radius < 1 || width <= 0 || height <= 0 || channels < 1 || channels > 4)
+      return;
+
+    if (implementation == BLUR_AUTO || !IsBlurImplementationSupported(implementation))
+      implementation = GetDefaultBlurImplementation();
+
+    StepFunction step = GetStepFunction(implementation);
+
+    // calculate the alpha such that 90% of
+    // the kernel is within the radius.
+    // (Kernel extends to infinity)
+    int alpha = (int) ((1 << APREC) * (1.0f - expf(-2.3f / (radius + 1.f))));
+
+    int threads = max_threads;
+    if (threads <= 0)
+    {
+      threads = 1;
+      if (width * height >= MIN_THREADED_PIXELS)
+        threads = std::min<int>(std::max<int>(std::thread::hardware_concurrency(), 1), MAX_THREADS);
+    }
+
+    int tile_rows = TILE_BYTES / channels;
+    threads = std::min(threads, (height + tile_rows - 1) / tile_rows);
+
+    // Split the rows in groups of tiles.
+    int rows_per_thread = ((height + threads - 1) / threads + tile_rows - 1) / tile_rows * tile_rows;
+    RunJobs(threads, [&] (int i)
+    {
+      int begin = std::min(height, i * rows_per_thread);
+      int end = std::min(height, begin + rows_per_thread);
+      BlurRows(step, pixels, width, stride, channels, begin, end, alpha);
+    });
+
+    // The columns are independent from each other.
+    int row_bytes = width * channels;
+    int bytes_per_thread = ((row_bytes + threads - 1) / threads + TILE_BYTES - 1) / TILE_BYTES * TILE_BYTES;
+    RunJobs(threads, [&] (int i)
+    {
+      int begin = std::min(row_bytes, i * bytes_per_thread);
+      int end = std::min(row_bytes, begin + bytes_per_thread);
+
+      if (begin < end)
+        BlurColumns(step, pixels, height, stride, begin, end, alpha);
+    });
+  }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#ifndef IMAGEBLUR_H
+#define IMAGEBLUR_H
+
+namespace nux
+{
+  //! Code path used to blur an image.
+  enum BlurImplementation
+  {
+    BLUR_AUTO,    //!< The fastest implementation supported by the processor.
+    BLUR_SCALAR,  //!< Portable C++.
+    BLUR_SSE2,
+    BLUR_AVX2,
+    BLUR_NEON,
+  };
+
+  //! Return true if the implementation can be used on this processor.
+  bool IsBlurImplementationSupported(BlurImplementation implementation);
+
+  //! Return the implementation used by BLUR_AUTO.
+  BlurImplementation GetDefaultBlurImplementation();
+
+  //! In-place blur with a two sided exponential impulse response.
+  /*!
+      The image is filtered in fixed point, one row at a time and then one column at a time. All the
+      implementations produce the same result.
+
+      @param pixels The first pixel of the image.
+      @param width Width of the image in pixels.
+      @param height Height of the image in pixels.
+      @param stride Number of bytes between two rows of the image.
+      @param channels Number of bytes per pixel. Each byte is filtered independently.
+      @param radius Approximate radius of the kernel. 90% of the kernel is within the radius.
+      @param implementation Code path to use. If it is not supported, BLUR_AUTO is used.
+      @param max_threads Maximum number of threads. If 0, large images are split between a few threads.
+  */
+  void ExpBlur(unsigned char* pixels, int width, int height, int stride, int channels, int radius,
+               BlurImplementation implementation = BLUR_AUTO, int max_threads = 0);
+}
+
+#endif // IMAGEBLUR_H
@@ -0,0 +1,941 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#include "NuxCore/NuxCore.h"
+#include "ImageKernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  #define NUX_PIXEL_KERNELS_X86
+  #include <immintrin.h>
+#endif
+
+namespace nux
+{
+  namespace
+  {
+    struct ByteChannelFormat
+    {
+      BitmapFormat format;
+      int bytes_per_pixel;
+      int offsets[4];  // Red, green, blue and alpha.
+    };
+
+    const ByteChannelFormat BYTE_CHANNEL_FORMATS[] =
+    {
+      { BITFMT_R8G8B8A8, 4, {  0,  1,  2,  3 } },
+      { BITFMT_B8G8R8A8, 4, {  2,  1,  0,  3 } },
+      { BITFMT_R8G8B8,   3, {  0,  1,  2, -1 } },
+      { BITFMT_A8,       1, { -1, -1, -1,  0 } },
+#ifndef NUX_OPENGLES_20
+      { BITFMT_A8R8G8B8, 4, {  1,  2,  3,  0 } },
+      { BITFMT_A8B8G8R8, 4, {  3,  2,  1,  0 } },
+      { BITFMT_B8G8R8,   3, {  2,  1,  0, -1 } },
+#endif
+    };
+
+    const ByteChannelFormat* FindByteChannelFormat(BitmapFormat format)
+    {
+      for (auto const& byte_format : BYTE_CHANNEL_FORMATS)
+      {
+        if (byte_format.format == format)
+          return &byte_format;
+      }
+
+      return nullptr;
+    }
+
+    //! Where the bytes of a converted pixel come from.
+    struct ByteMap
+    {
+      int src_bytes;
+      int dst_bytes;
+      int sources[4];               // Source byte of each destination byte, or -1.
+      unsigned char constants[4];   // Value of the destination bytes that have no source byte.
+    };
+
+    ByteMap GetByteMap(ByteChannelFormat const& src, ByteChannelFormat const& dst)
+    {
+      ByteMap map;
+      map.src_bytes = src.bytes_per_pixel;
+      map.dst_bytes = dst.bytes_per_pixel;
+
+      for (int k = 0; k < 4; ++k)
+      {
+        map.sources[k] = -1;
+        map.constants[k] = 0;
+      }
+
+      for (int channel = 0; channel < 4; ++channel)
+      {
+        int k = dst.offsets[channel];
+        if (k < 0)
+          continue;
+
+        map.sources[k] = src.offsets[channel];
+        map.constants[k] = (channel == 3) ? 255 : 0;
+      }
+
+      return map;
+    }
+
+    // All the row functions process the pixels [begin, width) of a row.
+
+    template<int BYTES>
+    inline void SumRowScalar(const unsigned char* row, int begin, int width, unsigned long long* sums)
+    {
+      for (int x = begin; x < width; ++x)
+      {
+        for (int k = 0; k < BYTES; ++k)
+          sums[k] += row[x * BYTES + k];
+      }
+    }
+
+    template<int BYTES>
+    inline void ReverseRowScalar(unsigned char* row, int begin, int width)
+    {
+      for (int x = begin; x < width - 1 - x; ++x)
+      {
+        unsigned char* left = row + x * BYTES;
+        unsigned char* right = row + (width - 1 - x) * BYTES;
+
+        for (int k = 0; k < BYTES; ++k)
+          std::swap(left[k], right[k]);
+      }
+    }
+
+    inline void ConvertRowScalar(const unsigned char* src, unsigned char* dst, int begin, int width, ByteMap const& map)
+    {
+      for (int x = begin; x < width; ++x)
+      {
+        const unsigned char* s = src + x * map.src_bytes;
+        unsigned char pixel[4];
+
+        // The pixel is read entirely before it is written, in case the conversion is in place.
+        for (int k = 0; k < map.dst_bytes; ++k)
+          pixel[k] = (map.sources[k] < 0) ? map.constants[k] : s[map.sources[k]];
+
+        std::memcpy(dst + x * map.dst_bytes, pixel, map.dst_bytes);
+      }
+    }
+
+    template<int ALPHA>
+    inline void PremultiplyRowScalar(const unsigned char* src, unsigned char* dst, int begin, int width)
+    {
+      for (int x = begin; x < width; ++x)
+      {
+        const unsigned char* s = src + x * 4;
+        unsigned char* d = dst + x * 4;
+        unsigned int a = s[ALPHA];
+
+        for (int k = 0; k < 4; ++k)
+          d[k] = (k == ALPHA) ? a : (s[k] * a) / 255;
+      }
+    }
+
+    template<int ALPHA>
+    inline void UnpremultiplyRowScalar(const unsigned char* src, unsigned char* dst, int begin, int width)
+    {
+      for (int x = begin; x < width; ++x)
+      {
+        const unsigned char* s = src + x * 4;
+        unsigned char* d = dst + x * 4;
+        unsigned int a = s[ALPHA];
+
+        for (int k = 0; k < 4; ++k)
+        {
+          if (k == ALPHA)
+            d[k] = a;
+          else if (a == 0)
+            d[k] = 0;
+          else
+            d[k] = std::min<unsigned int>(255, (s[k] * 255 + a / 2) / a);
+        }
+      }
+    }
+
+    typedef void (*SumFunction)(const unsigned char* row, int width, unsigned long long* sums);
+    typedef void (*ReverseFunction)(unsigned char* row, int width);
+    typedef void (*ConvertFunction)(const unsigned char* src, unsigned char* dst, int width, ByteMap const& map);
+    typedef void (*AlphaFunction)(const unsigned char* src, unsigned char* dst, int width);
+
+    template<int BYTES>
+    void SumScalar(const unsigned char* row, int width, unsigned long long* sums)
+    {
+      SumRowScalar<BYTES>(row, 0, width, sums);
+    }
+
+    template<int BYTES>
+    void ReverseScalar(unsigned char* row, int width)
+    {
+      ReverseRowScalar<BYTES>(row, 0, width);
+    }
+
+    void ConvertScalar(const unsigned char* src, unsigned char* dst, int width, ByteMap const& map)
+    {
+      ConvertRowScalar(src, dst, 0, width, map);
+    }
+
+    template<int ALPHA>
+    void PremultiplyScalar(const unsigned char* src, unsigned char* dst, int width)
+    {
+      PremultiplyRowScalar<ALPHA>(src, dst, 0, width);
+    }
+
+    template<int ALPHA>
+    void UnpremultiplyScalar(const unsigned char* src, unsigned char* dst, int width)
+    {
+      UnpremultiplyRowScalar<ALPHA>(src, dst, 0, width);
+    }
+
+#if defined(NUX_PIXEL_KERNELS_X86)
+    // The bytes of a vector that belong to the k-th byte of the pixels, when the vector is the r-th one of a
+    // group of BYTES vectors. A group always starts with the first byte of a pixel.
+    template<int BYTES, int SIZE>
+    void GetByteMasks(unsigned char masks[BYTES][4][SIZE])
+    {
+      for (int r = 0; r < BYTES; ++r)
+      {
+        for (int k = 0; k < 4; ++k)
+        {
+          for (int i = 0; i < SIZE; ++i)
+            masks[r][k][i] = ((r * SIZE + i) % BYTES == k) ? 0xFF : 0;
+        }
+      }
+    }
+
+    //! The conversion of the 4 bytes of a pixel, as groups of bytes shifted by the same amount.
+    struct LaneMap
+    {
+      int count;
+      int right_shifts[4];
+      int left_shifts[4];
+      unsigned int masks[4];
+      unsigned int constant;
+    };
+
+    LaneMap GetLaneMap(ByteMap const& map)
+    {
+      LaneMap lanes;
+      lanes.count = 0;
+      lanes.constant = 0;
+
+      for (int k = 0; k < map.dst_bytes; ++k)
+      {
+        if (map.sources[k] < 0)
+        {
+          lanes.constant |= (unsigned int) map.constants[k] << (8 * k);
+          continue;
+        }
+
+        int shift = 8 * (k - map.sources[k]);
+        int right = std::max(0, -shift);
+        int left = std::max(0, shift);
+
+        int group = 0;
+        while (group < lanes.count && (lanes.right_shifts[group] != right || lanes.left_shifts[group] != left))
+          ++group;
+
+        if (group == lanes.count)
+        {
+          lanes.right_shifts[group] = right;
+          lanes.left_shifts[group] = left;
+          lanes.masks[group] = 0;
+          ++lanes.count;
+        }
+
+        lanes.masks[group] |= 0xFFu << (8 * k);
+      }
+
+      return lanes;
+    }
+
+    template<int BYTES>
+    __attribute__((target("sse2")))
+    void SumSSE2(const unsigned char* row, int width, unsigned long long* sums)
+    {
+      unsigned char mask_bytes[BYTES][4][16];
+      GetByteMasks<BYTES, 16>(mask_bytes);
+
+      __m128i masks[BYTES][BYTES];
+      __m128i acc[BYTES];
+      for (int k = 0; k < BYTES; ++k)
+      {
+        acc[k] = _mm_setzero_si128();
+        for (int r = 0; r < BYTES; ++r)
+          masks[r][k] = _mm_loadu_si128((const __m128i*) mask_bytes[r][k]);
+      }
+
+      // Each group of 16 pixels is BYTES vectors. The sums of absolute differences add the bytes in 64 bits.
+      const __m128i zero = _mm_setzero_si128();
+      int x = 0;
+      for (; x + 16 <= width; x += 16)
+      {
+        for (int r = 0; r < BYTES; ++r)
+        {
+          __m128i v = _mm_loadu_si128((const __m128i*) (row + x * BYTES + r * 16));
+          for (int k = 0; k < BYTES; ++k)
+            acc[k] = _mm_add_epi64(acc[k], _mm_sad_epu8(_mm_and_si128(v, masks[r][k]), zero));
+        }
+      }
+
+      for (int k = 0; k < BYTES; ++k)
+      {
+        unsigned long long halves[2];
+        _mm_storeu_si128((__m128i*) halves, acc[k]);
+        sums[k] += halves[0] + halves[1];
+      }
+
+      SumRowScalar<BYTES>(row, x, width, sums);
+    }
+
+    template<int BYTES>
+    __attribute__((target("avx2")))
+    void SumAVX2(const unsigned char* row, int width, unsigned long long* sums)
+    {
+      unsigned char mask_bytes[BYTES][4][32];
+      GetByteMasks<BYTES, 32>(mask_bytes);
+
+      __m256i masks[BYTES][BYTES];
+      __m256i acc[BYTES];
+      for (int k = 0; k < BYTES; ++k)
+      {
+        acc[k] = _mm256_setzero_si256();
+        for (int r = 0; r < BYTES; ++r)
+          masks[r][k] = _mm256_loadu_si256((const __m256i*) mask_bytes[r][k]);
+      }
+
+      const __m256i zero = _mm256_setzero_si256();
+      int x = 0;
+      for (; x + 32 <= width; x += 32)
+      {
+        for (int r = 0; r < BYTES; ++r)
+        {
+          __m256i v = _mm256_loadu_si256((const __m256i*) (row + x * BYTES + r * 32));
+          for (int k = 0; k < BYTES; ++k)
+            acc[k] = _mm256_add_epi64(acc[k], _mm256_sad_epu8(_mm256_and_si256(v, masks[r][k]), zero));
+        }
+      }
+
+      for (int k = 0; k < BYTES; ++k)
+      {
+        unsigned long long quarters[4];
+        _mm256_storeu_si256((__m256i*) quarters, acc[k]);
+        sums[k] += quarters[0] + quarters[1] + quarters[2] + quarters[3];
+      }
+
+      SumRowScalar<BYTES>(row, x, width, sums);
+    }
+
+    template<int BYTES>
+    __attribute__((target("sse2")))
+    inline __m128i ReverseSSE2(__m128i v)
+    {
+      if (BYTES == 4)
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+
+      v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+      v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+      v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+
+      if (BYTES == 1)
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+      return v;
+    }
+
+    template<int BYTES>
+    __attribute__((target("sse2")))
+    void ReverseSSE2(unsigned char* row, int width)
+    {
+      // Swap the vectors at both ends of the row, then the pixels left in the middle.
+      const int n = 16 / BYTES;
+      int x = 0;
+      for (; 2 * (x + n) <= width; x += n)
+      {
+        unsigned char* left = row + x * BYTES;
+        unsigned char* right = row + (width - x - n) * BYTES;
+
+        __m128i l = _mm_loadu_si128((const __m128i*) left);
+        __m128i r = _mm_loadu_si128((const __m128i*) right);
+        _mm_storeu_si128((__m128i*) left, ReverseSSE2<BYTES>(r));
+        _mm_storeu_si128((__m128i*) right, ReverseSSE2<BYTES>(l));
+      }
+
+      ReverseRowScalar<BYTES>(row, x, width);
+    }
+
+    template<int BYTES>
+    __attribute__((target("avx2")))
+    inline __m256i ReverseAVX2(__m256i v)
+    {
+      if (BYTES == 4)
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+
+      const __m256i reverse_lanes = (BYTES == 1) ?
+        _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                         15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0) :
+        _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                         14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+
+      return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, reverse_lanes), _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    template<int BYTES>
+    __attribute__((target("avx2")))
+    void ReverseAVX2(unsigned char* row, int width)
+    {
+      const int n = 32 / BYTES;
+      int x = 0;
+      for (; 2 * (x + n) <= width; x += n)
+      {
+        unsigned char* left = row + x * BYTES;
+        unsigned char* right = row + (width - x - n) * BYTES;
+
+        __m256i l = _mm256_loadu_si256((const __m256i*) left);
+        __m256i r = _mm256_loadu_si256((const __m256i*) right);
+        _mm256_storeu_si256((__m256i*) left, ReverseAVX2<BYTES>(r));
+        _mm256_storeu_si256((__m256i*) right, ReverseAVX2<BYTES>(l));
+      }
+
+      ReverseRowScalar<BYTES>(row, x, width);
+    }
+
+    __attribute__((target("sse2")))
+    inline __m128i MapLanesSSE2(__m128i v, LaneMap const& lanes)
+    {
+      __m128i result = _mm_set1_epi32(lanes.constant);
+
+      for (int group = 0; group < lanes.count; ++group)
+      {
+        __m128i shifted = _mm_srl_epi32(v, _mm_cvtsi32_si128(lanes.right_shifts[group]));
+        shifted = _mm_sll_epi32(shifted, _mm_cvtsi32_si128(lanes.left_shifts[group]));
+        result = _mm_or_si128(result, _mm_and_si128(shifted, _mm_set1_epi32(lanes.masks[group])));
+      }
+
+      return result;
+    }
+
+    __attribute__((target("sse2")))
+    void ConvertSSE2(const unsigned char* src, unsigned char* dst, int width, ByteMap const& map)
+    {
+      LaneMap lanes = GetLaneMap(map);
+      const __m128i low_bytes = _mm_set1_epi32(0x00FFFFFF);
+
+      // 4 pixels at a time, one in each 32 bits lane. The loads of 3 bytes pixels read 4 bytes past the pixels,
+      // so the last pixels are left to the scalar loop.
+      int x = 0;
+      for (; x + 8 <= width; x += 4)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + x * map.src_bytes));
+
+        if (map.src_bytes == 3)
+        {
+          __m128i v01 = _mm_unpacklo_epi32(v, _mm_srli_si128(v, 3));
+          __m128i v23 = _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9));
+          v = _mm_unpacklo_epi64(v01, v23);
+        }
+
+        v = MapLanesSSE2(v, lanes);
+
+        if (map.dst_bytes == 4)
+        {
+          _mm_storeu_si128((__m128i*) (dst + x * 4), v);
+        }
+        else
+        {
+          // Pack the 4 lanes of 3 bytes. The store must not write past the pixels, the next ones may not be
+          // read yet if the conversion is in place.
+          v = _mm_and_si128(v, low_bytes);
+          __m128i packed = _mm_or_si128(_mm_and_si128(v, _mm_setr_epi32(-1, 0, 0, 0)),
+                                        _mm_srli_si128(_mm_and_si128(v, _mm_setr_epi32(0, -1, 0, 0)), 1));
+          packed = _mm_or_si128(packed, _mm_srli_si128(_mm_and_si128(v, _mm_setr_epi32(0, 0, -1, 0)), 2));
+          packed = _mm_or_si128(packed, _mm_srli_si128(_mm_and_si128(v, _mm_setr_epi32(0, 0, 0, -1)), 3));
+
+          int last = _mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+          _mm_storel_epi64((__m128i*) (dst + x * 3), packed);
+          std::memcpy(dst + x * 3 + 8, &last, 4);
+        }
+      }
+
+      ConvertRowScalar(src, dst, x, width, map);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i MapLanesAVX2(__m256i v, LaneMap const& lanes)
+    {
+      __m256i result = _mm256_set1_epi32(lanes.constant);
+
+      for (int group = 0; group < lanes.count; ++group)
+      {
+        __m256i shifted = _mm256_srl_epi32(v, _mm_cvtsi32_si128(lanes.right_shifts[group]));
+        shifted = _mm256_sll_epi32(shifted, _mm_cvtsi32_si128(lanes.left_shifts[group]));
+        result = _mm256_or_si256(result, _mm256_and_si256(shifted, _mm256_set1_epi32(lanes.masks[group])));
+      }
+
+      return result;
+    }
+
+    __attribute__((target("avx2")))
+    void ConvertAVX2(const unsigned char* src, unsigned char* dst, int width, ByteMap const& map)
+    {
+      LaneMap lanes = GetLaneMap(map);
+      const __m256i expand = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                              0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+      const __m256i compact = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                               0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+      // 8 pixels at a time, 4 in each 128 bits lane.
+      int x = 0;
+      for (; x + 12 <= width; x += 8)
+      {
+        __m256i v;
+        if (map.src_bytes == 4)
+        {
+          v = _mm256_loadu_si256((const __m256i*) (src + x * 4));
+        }
+        else
+        {
+          __m128i low = _mm_loadu_si128((const __m128i*) (src + x * 3));
+          __m128i high = _mm_loadu_si128((const __m128i*) (src + x * 3 + 12));
+          v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), expand);
+        }
+
+        v = MapLanesAVX2(v, lanes);
+
+        if (map.dst_bytes == 4)
+        {
+          _mm256_storeu_si256((__m256i*) (dst + x * 4), v);
+        }
+        else
+        {
+          v = _mm256_shuffle_epi8(v, compact);
+          __m128i low = _mm256_castsi256_si128(v);
+          __m128i high = _mm256_extracti128_si256(v, 1);
+
+          int low_last = _mm_cvtsi128_si32(_mm_srli_si128(low, 8));
+          int high_last = _mm_cvtsi128_si32(_mm_srli_si128(high, 8));
+          _mm_storel_epi64((__m128i*) (dst + x * 3), low);
+          std::memcpy(dst + x * 3 + 8, &low_last, 4);
+          _mm_storel_epi64((__m128i*) (dst + x * 3 + 12), high);
+          std::memcpy(dst + x * 3 + 20, &high_last, 4);
+        }
+      }
+
+      ConvertRowScalar(src, dst, x, width, map);
+    }
+
+    // c * a / 255 is computed as ((c * a) * 0x8081) >> 23, which is exact for all the products of two bytes.
+
+    template<int ALPHA>
+    __attribute__((target("sse2")))
+    inline __m128i PremultiplyHalfSSE2(__m128i v)
+    {
+      const __m128i alpha_mask = _mm_slli_epi64(_mm_set1_epi64x(0xFFFF), 16 * ALPHA);
+
+      __m128i a = _mm_shufflelo_epi16(v, _MM_SHUFFLE(ALPHA, ALPHA, ALPHA, ALPHA));
+      a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(ALPHA, ALPHA, ALPHA, ALPHA));
+
+      __m128i product = _mm_mullo_epi16(v, a);
+      __m128i result = _mm_srli_epi16(_mm_mulhi_epu16(product, _mm_set1_epi16((short) 0x8081)), 7);
+      return _mm_or_si128(_mm_andnot_si128(alpha_mask, result), _mm_and_si128(alpha_mask, v));
+    }
+
+    template<int ALPHA>
+    __attribute__((target("sse2")))
+    void PremultiplySSE2(const unsigned char* src, unsigned char* dst, int width)
+    {
+      const __m128i zero = _mm_setzero_si128();
+
+      int x = 0;
+      for (; x + 4 <= width; x += 4)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + x * 4));
+        __m128i low = PremultiplyHalfSSE2<ALPHA>(_mm_unpacklo_epi8(v, zero));
+        __m128i high = PremultiplyHalfSSE2<ALPHA>(_mm_unpackhi_epi8(v, zero));
+        _mm_storeu_si128((__m128i*) (dst + x * 4), _mm_packus_epi16(low, high));
+      }
+
+      PremultiplyRowScalar<ALPHA>(src, dst, x, width);
+    }
+
+    template<int ALPHA>
+    __attribute__((target("avx2")))
+    inline __m256i PremultiplyHalfAVX2(__m256i v)
+    {
+      const __m256i alpha_mask = _mm256_slli_epi64(_mm256_set1_epi64x(0xFFFF), 16 * ALPHA);
+
+      __m256i a = _mm256_shufflelo_epi16(v, _MM_SHUFFLE(ALPHA, ALPHA, ALPHA, ALPHA));
+      a = _mm256_shufflehi_epi16(a, _MM_SHUFFLE(ALPHA, ALPHA, ALPHA, ALPHA));
+
+      __m256i product = _mm256_mullo_epi16(v, a);
+      __m256i result = _mm256_srli_epi16(_mm256_mulhi_epu16(product, _mm256_set1_epi16((short) 0x8081)), 7);
+      return _mm256_or_si256(_mm256_andnot_si256(alpha_mask, result), _mm256_and_si256(alpha_mask, v));
+    }
+
+    template<int ALPHA>
+    __attribute__((target("avx2")))
+    void PremultiplyAVX2(const unsigned char* src, unsigned char* dst, int width)
+    {
+      const __m256i zero = _mm256_setzero_si256();
+
+      // The unpacks and the pack work on each 128 bits lane, the pixels stay in order.
+      int x = 0;
+      for (; x + 8 <= width; x += 8)
+      {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + x * 4));
+        __m256i low = PremultiplyHalfAVX2<ALPHA>(_mm256_unpacklo_epi8(v, zero));
+        __m256i high = PremultiplyHalfAVX2<ALPHA>(_mm256_unpackhi_epi8(v, zero));
+        _mm256_storeu_si256((__m256i*) (dst + x * 4), _mm256_packus_epi16(low, high));
+      }
+
+      PremultiplyRowScalar<ALPHA>(src, dst, x, width);
+    }
+
+    // The divisions are done in single precision and truncated: the quotients that are not clamped are small
+    // enough for the rounding of the division to never reach the next integer.
+
+    template<int ALPHA>
+    __attribute__((target("sse2")))
+    inline __m128i UnpremultiplyPixelSSE2(__m128i p)
+    {
+      const __m128i alpha_mask = _mm_slli_si128(_mm_cvtsi32_si128(-1), 4 * ALPHA);
+
+      __m128i a = _mm_shuffle_epi32(p, _MM_SHUFFLE(ALPHA, ALPHA, ALPHA, ALPHA));
+      __m128i n = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(p, 8), p), _mm_srli_epi32(a, 1));
+      __m128i q = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(n), _mm_cvtepi32_ps(a)));
+
+      q = _mm_andnot_si128(_mm_cmpeq_epi32(a, _mm_setzero_si128()), q);
+      return _mm_or_si128(_mm_andnot_si128(alpha_mask, q), _mm_and_si128(alpha_mask, p));
+    }
+
+    template<int ALPHA>
+    __attribute__((target("sse2")))
+    void UnpremultiplySSE2(const unsigned char* src, unsigned char* dst, int width)
+    {
+      const __m128i zero = _mm_setzero_si128();
+
+      int x = 0;
+      for (; x + 4 <= width; x += 4)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + x * 4));
+        __m128i low = _mm_unpacklo_epi8(v, zero);
+        __m128i high = _mm_unpackhi_epi8(v, zero);
+
+        __m128i p0 = UnpremultiplyPixelSSE2<ALPHA>(_mm_unpacklo_epi16(low, zero));
+        __m128i p1 = UnpremultiplyPixelSSE2<ALPHA>(_mm_unpackhi_epi16(low, zero));
+        __m128i p2 = UnpremultiplyPixelSSE2<ALPHA>(_mm_unpacklo_epi16(high, zero));
+        __m128i p3 = UnpremultiplyPixelSSE2<ALPHA>(_mm_unpackhi_epi16(high, zero));
+
+        // The saturating packs clamp the quotients to 255.
+        _mm_storeu_si128((__m128i*) (dst + x * 4), _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+      }
+
+      UnpremultiplyRowScalar<ALPHA>(src, dst, x, width);
+    }
+
+    template<int ALPHA>
+    __attribute__((target("avx2")))
+    inline __m256i UnpremultiplyPixelsAVX2(__m256i p)
+    {
+      const __m256i alpha_mask = _mm256_slli_si256(_mm256_setr_epi32(-1, 0, 0, 0, -1, 0, 0, 0), 4 * ALPHA);
+
+      __m256i a = _mm256_shuffle_epi32(p, _MM_SHUFFLE(ALPHA, ALPHA, ALPHA, ALPHA));
+      __m256i n = _mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(p, 8), p), _mm256_srli_epi32(a, 1));
+      __m256i q = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(n), _mm256_cvtepi32_ps(a)));
+
+      q = _mm256_andnot_si256(_mm256_cmpeq_epi32(a, _mm256_setzero_si256()), q);
+      return _mm256_or_si256(_mm256_andnot_si256(alpha_mask, q), _mm256_and_si256(alpha_mask, p));
+    }
+
+    template<int ALPHA>
+    __attribute__((target("avx2")))
+    void UnpremultiplyAVX2(const unsigned char* src, unsigned char* dst, int width)
+    {
+      const __m256i zero = _mm256_setzero_si256();
+
+      int x = 0;
+      for (; x + 8 <= width; x += 8)
+      {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + x * 4));
+        __m256i low = _mm256_unpacklo_epi8(v, zero);
+        __m256i high = _mm256_unpackhi_epi8(v, zero);
+
+        __m256i p0 = UnpremultiplyPixelsAVX2<ALPHA>(_mm256_unpacklo_epi16(low, zero));
+        __m256i p1 = UnpremultiplyPixelsAVX2<ALPHA>(_mm256_unpackhi_epi16(low, zero));
+        __m256i p2 = UnpremultiplyPixelsAVX2<ALPHA>(_mm256_unpacklo_epi16(high, zero));
+        __m256i p3 = UnpremultiplyPixelsAVX2<ALPHA>(_mm256_unpackhi_epi16(high, zero));
+
+        __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(p0, p1), _mm256_packs_epi32(p2, p3));
+        _mm256_storeu_si256((__m256i*) (dst + x * 4), packed);
+      }
+
+      UnpremultiplyRowScalar<ALPHA>(src, dst, x, width);
+    }
+#endif
+
+    PixelKernelImplementation GetImplementation(PixelKernelImplementation implementation)
+    {
+      if (implementation == PIXEL_KERNELS_AUTO || !IsPixelKernelImplementationSupported(implementation))
+        return GetDefaultPixelKernelImplementation();
+
+      return implementation;
+    }
+
+    template<int BYTES>
+    SumFunction GetSumFunction(PixelKernelImplementation implementation)
+    {
+      switch (implementation)
+      {
+#if defined(NUX_PIXEL_KERNELS_X86)
+        case PIXEL_KERNELS_SSE2:
+          return SumSSE2<BYTES>;
+        case PIXEL_KERNELS_AVX2:
+          return SumAVX2<BYTES>;
+#endif
+        default:
+          return SumScalar<BYTES>;
+      }
+    }
+
+    template<int BYTES>
+    ReverseFunction GetReverseFunction(PixelKernelImplementation implementation)
+    {
+      switch (implementation)
+      {
+#if defined(NUX_PIXEL_KERNELS_X86)
+        case PIXEL_KERNELS_SSE2:
+          return ReverseSSE2<BYTES>;
+        case PIXEL_KERNELS_AVX2:
+          return ReverseAVX2<BYTES>;
+#endif
+        default:
+          return ReverseScalar<BYTES>;
+      }
+    }
+
+    ConvertFunction GetConvertFunction(PixelKernelImplementation implementation)
+    {
+      switch (implementation)
+      {
+#if defined(NUX_PIXEL_KERNELS_X86)
+        case PIXEL_KERNELS_SSE2:
+          return ConvertSSE2;
+        case PIXEL_KERNELS_AVX2:
+          return ConvertAVX2;
+#endif
+        default:
+          return ConvertScalar;
+      }
+    }
+
+    template<int ALPHA>
+    AlphaFunction GetAlphaFunction(PixelKernelImplementation implementation, bool premultiply)
+    {
+      switch (implementation)
+      {
+#if defined(NUX_PIXEL_KERNELS_X86)
+        case PIXEL_KERNELS_SSE2:
+          return premultiply ? PremultiplySSE2<ALPHA> : UnpremultiplySSE2<ALPHA>;
+        case PIXEL_KERNELS_AVX2:
+          return premultiply ? PremultiplyAVX2<ALPHA> : UnpremultiplyAVX2<ALPHA>;
+#endif
+        default:
+          return premultiply ? PremultiplyScalar<ALPHA> : UnpremultiplyScalar<ALPHA>;
+      }
+    }
+
+    bool ApplyAlpha(const unsigned char* src, int src_stride, unsigned char* dst, int dst_stride,
+                    int width, int height, BitmapFormat format, PixelKernelImplementation implementation,
+                    bool premultiply)
+    {
+      const ByteChannelFormat* byte_format = FindByteChannelFormat(format);
+      if (!byte_format || byte_format->bytes_per_pixel != 4)
+        return false;
+
+      implementation = GetImplementation(implementation);
+      AlphaFunction function = (byte_format->offsets[3] == 0) ?
+        GetAlphaFunction<0>(implementation, premultiply) :
+        GetAlphaFunction<3>(implementation, premultiply);
+
+      for (int y = 0; y < height; ++y)
+        function(src + y * src_stride, dst + y * dst_stride, width);
+
+      return true;
+    }
+  }
+
+  bool IsPixelKernelImplementationSupported(PixelKernelImplementation implementation)
+  {
+    switch (implementation)
+    {
+      case PIXEL_KERNELS_AUTO:
+      case PIXEL_KERNELS_SCALAR:
+        return true;
+#if defined(NUX_PIXEL_KERNELS_X86)
+      case PIXEL_KERNELS_SSE2:
+        return __builtin_cpu_supports("sse2");
+      case PIXEL_KERNELS_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+      default:
+        return false;
+    }
+  }
+
+  PixelKernelImplementation GetDefaultPixelKernelImplementation()
+  {
+    static PixelKernelImplementation implementation =
+      IsPixelKernelImplementationSupported(PIXEL_KERNELS_AVX2) ? PIXEL_KERNELS_AVX2 :
+      IsPixelKernelImplementationSupported(PIXEL_KERNELS_SSE2) ? PIXEL_KERNELS_SSE2 :
+      PIXEL_KERNELS_SCALAR;
+
+    return implementation;
+  }
+
+  bool IsByteChannelFormat(BitmapFormat format, int offsets[4])
+  {
+    const ByteChannelFormat* byte_format = FindByteChannelFormat(format);
+    if (!byte_format)
+      return false;
+
+    if (offsets)
+      std::copy(byte_format->offsets, byte_format->offsets + 4, offsets);
+
+    return true;
+  }
+
+  void SumPixelBytes(const unsigned char* pixels, int width, int height, int stride, int bytes_per_pixel,
+                     unsigned long long sums[4], PixelKernelImplementation implementation)
+  {
+    std::fill(sums, sums + 4, 0);
+
+    if (width <= 0 || height <= 0 || bytes_per_pixel < 1 || bytes_per_pixel > 4)
+      return;
+
+    implementation = GetImplementation(implementation);
+
+    SumFunction function;
+    switch (bytes_per_pixel)
+    {
+      case 1:
+        function = GetSumFunction<1>(implementation);
+        break;
+      case 2:
+        function = GetSumFunction<2>(implementation);
+        break;
+      case 3:
+        function = GetSumFunction<3>(implementation);
+        break;
+      default:
+        function = GetSumFunction<4>(implementation);
+        break;
+    }
+
+    for (int y = 0; y < height; ++y)
+      function(pixels + y * stride, width, sums);
+  }
+
+  void ReversePixelRows(unsigned char* pixels, int width, int height, int stride, int bytes_per_pixel,
+                        PixelKernelImplementation implementation)
+  {
+    if (width <= 1 || height <= 0 || bytes_per_pixel < 1 || bytes_per_pixel > 4)
+      return;
+
+    implementation = GetImplementation(implementation);
+
+    // There is no vector shuffle of 3 bytes pixels in SSE2, they are swapped with portable C++.
+    ReverseFunction function;
+    switch (bytes_per_pixel)
+    {
+      case 1:
+        function = GetReverseFunction<1>(implementation);
+        break;
+      case 2:
+        function = GetReverseFunction<2>(implementation);
+        break;
+      case 3:
+        function = ReverseScalar<3>;
+        break;
+      default:
+        function = GetReverseFunction<4>(implementation);
+        break;
+    }
+
+    for (int y = 0; y < height; ++y)
+      function(pixels + y * stride, width);
+  }
+
+  bool ConvertPixels(const unsigned char* src, int src_stride, BitmapFormat src_format,
+                     unsigned char* dst, int dst_stride, BitmapFormat dst_format, int width, int height,
+                     PixelKernelImplementation implementation)
+  {
+    const ByteChannelFormat* src_byte_format = FindByteChannelFormat(src_format);
+    const ByteChannelFormat* dst_byte_format = FindByteChannelFormat(dst_format);
+
+    if (!src_byte_format || !dst_byte_format)
+      return false;
+
+    if (width <= 0 || height <= 0)
+      return true;
+
+    if (src_format == dst_format)
+    {
+      for (int y = 0; y < height; ++y)
+      {
+        if (src + y * src_stride != dst + y * dst_stride)
+          std::memmove(dst + y * dst_stride, src + y * src_stride, width * src_byte_format->bytes_per_pixel);
+      }
+
+      return true;
+    }
+
+    ByteMap map = GetByteMap(*src_byte_format, *dst_byte_format);
+
+    ConvertFunction function = ConvertScalar;
+    if (map.src_bytes >= 3 && map.dst_bytes >= 3)
+      function = GetConvertFunction(GetImplementation(implementation));
+
+    for (int y = 0; y < height; ++y)
+      function(src + y * src_stride, dst + y * dst_stride, width, map);
+
+    return true;
+  }
+
+  void SwizzleRedBlue(const unsigned char* src, int src_stride, unsigned char* dst, int dst_stride,
+                      int width, int height, PixelKernelImplementation implementation)
+  {
+    ConvertPixels(src, src_stride, BITFMT_R8G8B8A8, dst, dst_stride, BITFMT_B8G8R8A8, width, height, implementation);
+  }
+
+  bool PremultiplyAlpha(const unsigned char* src, int src_stride, unsigned char* dst, int dst_stride,
+                        int width, int height, BitmapFormat format, PixelKernelImplementation implementation)
+  {
+    return ApplyAlpha(src, src_stride, dst, dst_stride, width, height, format, implementation, true);
+  }
+
+  bool UnpremultiplyAlpha(const unsigned char* src, int src_stride, unsigned char* dst, int dst_stride,
+                          int width, int height, BitmapFormat format, PixelKernelImplementation implementation)
+  {
+    return ApplyAlpha(src, src_stride, dst, dst_stride, width, height, format, implementation, false);
+  }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#ifndef IMAGEKERNELS_H
+#define IMAGEKERNELS_H
+
+#include "BitmapFormats.h"
+
+namespace nux
+{
+  //! Code path used by the pixel kernels.
+  enum PixelKernelImplementation
+  {
+    PIXEL_KERNELS_AUTO,    //!< The fastest implementation supported by the processor.
+    PIXEL_KERNELS_SCALAR,  //!< Portable C++.
+    PIXEL_KERNELS_SSE2,
+    PIXEL_KERNELS_AVX2,
+  };
+
+  //! Return true if the implementation can be used on this processor.
+  bool IsPixelKernelImplementationSupported(PixelKernelImplementation implementation);
+
+  //! Return the implementation used by PIXEL_KERNELS_AUTO.
+  PixelKernelImplementation GetDefaultPixelKernelImplementation();
+
+  //! Return true if the pixels of the format are made of one byte per channel.
+  /*!
+      These are the formats the pixel kernels work on: BITFMT_R8G8B8A8, BITFMT_B8G8R8A8, BITFMT_A8R8G8B8,
+      BITFMT_A8B8G8R8, BITFMT_R8G8B8, BITFMT_B8G8R8 and BITFMT_A8. The name of the format is the order of the
+      channels in memory.
+
+      @param format Format of the pixels.
+      @param offsets If not null, receives the offset in the pixel of the red, green, blue and alpha channels,
+          or -1 for a channel that is not in the format.
+  */
+  bool IsByteChannelFormat(BitmapFormat format, int offsets[4] = 0);
+
+  //! Sum each byte of the pixels of an image.
+  /*!
+      All the implementations produce the same result.
+
+      @param pixels The first pixel of the image.
+      @param width Width of the image in pixels.
+      @param height Height of the image in pixels.
+      @param stride Number of bytes between two rows of the image.
+      @param bytes_per_pixel Number of bytes per pixel, from 1 to 4.
+      @param sums Receives the sum of the first, second, third and fourth byte of the pixels. The sums of the
+          bytes that are not in the pixels are 0.
+      @param implementation Code path to use. If it is not supported, PIXEL_KERNELS_AUTO is used.
+  */
+  void SumPixelBytes(const unsigned char* pixels, int width, int height, int stride, int bytes_per_pixel,
+                     unsigned long long sums[4], PixelKernelImplementation implementation = PIXEL_KERNELS_AUTO);
+
+  //! In-place reversal of the order of the pixels of each row of an image.
+  /*!
+      @param pixels The first pixel of the image.
+      @param width Width of the image in pixels.
+      @param height Height of the image in pixels.
+      @param stride Number of bytes between two rows of the image.
+      @param bytes_per_pixel Number of bytes per pixel, from 1 to 4.
+      @param implementation Code path to use. If it is not supported, PIXEL_KERNELS_AUTO is used.
+  */
+  void ReversePixelRows(unsigned char* pixels, int width, int height, int stride, int bytes_per_pixel,
+                        PixelKernelImplementation implementation = PIXEL_KERNELS_AUTO);
+
+  //! Convert pixels from one byte channel format to another.
+  /*!
+      The channels that are not in the source format are 0, except for the alpha channel that is 255. The
+      conversion of an image to the same format copies the rows. The source and destination images can be the
+      same if the formats have the same number of bytes per pixel. The conversions between 3 and 4 bytes per
+      pixel are vectorized; the conversions from or to BITFMT_A8 are done with portable C++.
+
+      @param src The first pixel of the source image.
+      @param src_stride Number of bytes between two rows of the source image.
+      @param src_format Format of the source image.
+      @param dst The first pixel of the destination image.
+      @param dst_stride Number of bytes between two rows of the destination image.
+      @param dst_format Format of the destination image.
+      @param width Width of the images in pixels.
+      @param height Height of the images in pixels.
+      @param implementation Code path to use. If it is not supported, PIXEL_KERNELS_AUTO is used.
+      @return False if one of the formats is not a byte channel format.
+  */
+  bool ConvertPixels(const unsigned char* src, int src_stride, BitmapFormat src_format,
+                     unsigned char* dst, int dst_stride, BitmapFormat dst_format, int width, int height,
+                     PixelKernelImplementation implementation = PIXEL_KERNELS_AUTO);
+
+  //! Swap the red and blue channels of 4 bytes pixels: RGBA to BGRA and back.
+  /*!
+      Same as ConvertPixels from BITFMT_R8G8B8A8 to BITFMT_B8G8R8A8.
+  */
+  void SwizzleRedBlue(const unsigned char* src, int src_stride, unsigned char* dst, int dst_stride,
+                      int width, int height, PixelKernelImplementation implementation = PIXEL_KERNELS_AUTO);
+
+  //! Multiply the color channels of 4 bytes pixels by their alpha.
+  /*!
+      Each color channel c becomes c * alpha / 255, rounded down. The source and destination images can be the
+      same.
+
+      @param format Format of the images. One of the byte channel formats with 4 bytes per pixel.
+      @return False if the format is not supported.
+  */
+  bool PremultiplyAlpha(const unsigned char* src, int src_stride, unsigned char* dst, int dst_stride,
+                        int width, int height, BitmapFormat format,
+                        PixelKernelImplementation implementation = PIXEL_KERNELS_AUTO);
+
+  //! Divide the color channels of 4 bytes pixels by their alpha.
+  /*!
+      Each color channel c becomes (c * 255 + alpha / 2) / alpha, rounded down and clamped to 255. The color
+      channels of the pixels with a zero alpha become 0. The source and destination images can be the same.
+
+      @param format Format of the images. One of the byte channel formats with 4 bytes per pixel.
+      @return False if the format is not supported.
+  */
+  bool UnpremultiplyAlpha(const unsigned char* src, int src_stride, unsigned char* dst, int dst_stride,
+                          int width, int height, BitmapFormat format,
+                          PixelKernelImplementation implementation = PIXEL_KERNELS_AUTO);
+}
+
+#endif // IMAGEKERNELS_H
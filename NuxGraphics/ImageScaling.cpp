@@ -0,0 +1,711 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#include "NuxCore/NuxCore.h"
+#include "ImageScaling.h"
+#include "ImageSurface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  #define NUX_SCALING_X86
+  #include <immintrin.h>
+#endif
+
+namespace nux
+{
+  namespace
+  {
+    const int MIN_THREADED_PIXELS = 512 * 512;
+    const int MAX_THREADS = 4;
+
+    const float INV_255 = 1.0f / 255.0f;
+    const double LANCZOS_LOBES = 3.0;
+
+    //! Weights of the source pixels that make each destination pixel, along one axis.
+    /*!
+        Every destination pixel has the same number of taps, the source pixels [first, first + taps). The taps
+        outside of the filter have a zero weight.
+    */
+    struct Contributions
+    {
+      int taps;
+      std::vector<int> first;
+      std::vector<float> weights;
+    };
+
+    double Sinc(double x)
+    {
+      if (x == 0.0)
+        return 1.0;
+
+      x *= M_PI;
+      return sin(x) / x;
+    }
+
+    double LanczosWeight(double x)
+    {
+      if (x <= -LANCZOS_LOBES || x >= LANCZOS_LOBES)
+        return 0.0;
+
+      return Sinc(x) * Sinc(x / LANCZOS_LOBES);
+    }
+
+    Contributions ComputeContributions(int src_size, int dst_size, ImageFilter filter)
+    {
+      // When the image is reduced, the filter covers all the source pixels of a destination pixel.
+      double scale = double(src_size) / dst_size;
+      double support = std::max(scale, 1.0);
+      double radius = ((filter == IMAGE_FILTER_BOX) ? 0.5 : LANCZOS_LOBES) * support;
+
+      Contributions contributions;
+      contributions.taps = std::min(src_size, int(ceil(2.0 * radius)) + 1);
+      contributions.first.resize(dst_size);
+      contributions.weights.resize(dst_size * contributions.taps);
+
+      int taps = contributions.taps;
+      std::vector<double> weights(taps);
+
+      for (int i = 0; i < dst_size; ++i)
+      {
+        double center = (i + 0.5) * scale;
+
+        // The taps are moved back at the end of the source, the extra ones get a zero weight.
+        int first = std::min(std::max(0, int(floor(center - radius))), src_size - taps);
+        double sum = 0.0;
+
+        for (int t = 0; t < taps; ++t)
+        {
+          double j = first + t;
+          if (filter == IMAGE_FILTER_BOX)
+            weights[t] = std::max(0.0, std::min(j + 1.0, center + radius) - std::max(j, center - radius));
+          else
+            weights[t] = LanczosWeight((j + 0.5 - center) / support);
+
+          sum += weights[t];
+        }
+
+        if (sum == 0.0)
+        {
+          std::fill(weights.begin(), weights.end(), 0.0);
+          weights[std::min(int(center) - first, taps - 1)] = 1.0;
+          sum = 1.0;
+        }
+
+        contributions.first[i] = first;
+        for (int t = 0; t < taps; ++t)
+          contributions.weights[i * taps + t] = weights[t] / sum;
+      }
+
+      return contributions;
+    }
+
+    //! Convert a row of pixels to floats, with the color channels multiplied by the alpha channel.
+    typedef void (*LoadFunction)(const unsigned char* src, int width, int bytes_per_pixel, int alpha, float* row);
+
+    //! Filter a row of floats horizontally.
+    typedef void (*RowFunction)(const float* row, Contributions const& columns, int dst_width, int bytes_per_pixel,
+                                float* out);
+
+    //! Weighted sum of rows of n floats, the rows are row_stride floats apart.
+    typedef void (*ColumnFunction)(const float* rows, int row_stride, const float* weights, int taps, int n,
+                                   float* sums);
+
+    void LoadRowScalar(const unsigned char* src, int width, int bytes_per_pixel, int alpha, float* row)
+    {
+      int n = width * bytes_per_pixel;
+
+      if (alpha < 0)
+      {
+        for (int i = 0; i < n; ++i)
+          row[i] = src[i];
+
+        return;
+      }
+
+      for (int i = 0; i < n; i += bytes_per_pixel)
+      {
+        float a = src[i + alpha];
+        float factor = a * INV_255;
+
+        for (int k = 0; k < bytes_per_pixel; ++k)
+          row[i + k] = (k == alpha) ? a : src[i + k] * factor;
+      }
+    }
+
+    template<int BYTES>
+    void FilterRowScalar(const float* row, Contributions const& columns, int dst_width, float* out)
+    {
+      for (int x = 0; x < dst_width; ++x)
+      {
+        const float* weights = &columns.weights[x * columns.taps];
+        const float* pixel = row + columns.first[x] * BYTES;
+
+        float sums[BYTES];
+        for (int k = 0; k < BYTES; ++k)
+          sums[k] = 0.0f;
+
+        for (int t = 0; t < columns.taps; ++t)
+        {
+          for (int k = 0; k < BYTES; ++k)
+            sums[k] += weights[t] * pixel[t * BYTES + k];
+        }
+
+        for (int k = 0; k < BYTES; ++k)
+          out[x * BYTES + k] = sums[k];
+      }
+    }
+
+    void FilterRowScalar(const float* row, Contributions const& columns, int dst_width, int bytes_per_pixel,
+                         float* out)
+    {
+      switch (bytes_per_pixel)
+      {
+        case 1:
+          FilterRowScalar<1>(row, columns, dst_width, out);
+          break;
+        case 2:
+          FilterRowScalar<2>(row, columns, dst_width, out);
+          break;
+        case 3:
+          FilterRowScalar<3>(row, columns, dst_width, out);
+          break;
+        default:
+          FilterRowScalar<4>(row, columns, dst_width, out);
+          break;
+      }
+    }
+
+    inline void FilterColumnsScalarRange(const float* rows, int row_stride, const float* weights, int taps,
+                                         int begin, int n, float* sums)
+    {
+      for (int i = begin; i < n; ++i)
+        sums[i] = 0.0f;
+
+      for (int t = 0; t < taps; ++t)
+      {
+        const float* row = rows + t * row_stride;
+        for (int i = begin; i < n; ++i)
+          sums[i] += weights[t] * row[i];
+      }
+    }
+
+    void FilterColumnsScalar(const float* rows, int row_stride, const float* weights, int taps, int n,
+                             float* sums)
+    {
+      FilterColumnsScalarRange(rows, row_stride, weights, taps, 0, n, sums);
+    }
+
+#if defined(NUX_SCALING_X86)
+    // The vector functions do the same operations as the scalar ones, in the same order: the results are equal.
+
+    template<int ALPHA>
+    __attribute__((target("sse2")))
+    inline __m128 PremultiplyPixelSSE2(__m128i pixel)
+    {
+      const __m128 alpha_lane = _mm_castsi128_ps(ALPHA == 0 ? _mm_setr_epi32(-1, 0, 0, 0) : _mm_setr_epi32(0, 0, 0, -1));
+
+      __m128 p = _mm_cvtepi32_ps(pixel);
+      __m128 factor = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(ALPHA, ALPHA, ALPHA, ALPHA)), _mm_set1_ps(INV_255));
+      factor = _mm_or_ps(_mm_and_ps(alpha_lane, _mm_set1_ps(1.0f)), _mm_andnot_ps(alpha_lane, factor));
+
+      return _mm_mul_ps(p, factor);
+    }
+
+    template<int ALPHA>
+    __attribute__((target("sse2")))
+    void LoadRowSSE2(const unsigned char* src, int width, float* row)
+    {
+      const __m128i zero = _mm_setzero_si128();
+      int x = 0;
+
+      for (; x + 4 <= width; x += 4)
+      {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+        __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        __m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+        _mm_storeu_ps(row + x * 4, PremultiplyPixelSSE2<ALPHA>(_mm_unpacklo_epi16(low, zero)));
+        _mm_storeu_ps(row + x * 4 + 4, PremultiplyPixelSSE2<ALPHA>(_mm_unpackhi_epi16(low, zero)));
+        _mm_storeu_ps(row + x * 4 + 8, PremultiplyPixelSSE2<ALPHA>(_mm_unpacklo_epi16(high, zero)));
+        _mm_storeu_ps(row + x * 4 + 12, PremultiplyPixelSSE2<ALPHA>(_mm_unpackhi_epi16(high, zero)));
+      }
+
+      for (; x < width; ++x)
+      {
+        int value;
+        memcpy(&value, src + x * 4, 4);
+        __m128i pixel = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero);
+        _mm_storeu_ps(row + x * 4, PremultiplyPixelSSE2<ALPHA>(pixel));
+      }
+    }
+
+    void LoadRowSSE2(const unsigned char* src, int width, int bytes_per_pixel, int alpha, float* row)
+    {
+      if (bytes_per_pixel == 4 && alpha == 0)
+        LoadRowSSE2<0>(src, width, row);
+      else if (bytes_per_pixel == 4 && alpha == 3)
+        LoadRowSSE2<3>(src, width, row);
+      else
+        LoadRowScalar(src, width, bytes_per_pixel, alpha, row);
+    }
+
+    __attribute__((target("sse2")))
+    void FilterRowSSE2(const float* row, Contributions const& columns, int dst_width, int bytes_per_pixel,
+                       float* out)
+    {
+      if (bytes_per_pixel != 4)
+      {
+        FilterRowScalar(row, columns, dst_width, bytes_per_pixel, out);
+        return;
+      }
+
+      int taps = columns.taps;
+      int x = 0;
+
+      // One pixel per vector, four destination pixels at a time to hide the latency of the additions.
+      for (; x + 4 <= dst_width; x += 4)
+      {
+        const float* weights = &columns.weights[x * taps];
+        const float* p0 = row + columns.first[x] * 4;
+        const float* p1 = row + columns.first[x + 1] * 4;
+        const float* p2 = row + columns.first[x + 2] * 4;
+        const float* p3 = row + columns.first[x + 3] * 4;
+
+        __m128 s0 = _mm_setzero_ps();
+        __m128 s1 = _mm_setzero_ps();
+        __m128 s2 = _mm_setzero_ps();
+        __m128 s3 = _mm_setzero_ps();
+
+        for (int t = 0; t < taps; ++t)
+        {
+          s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(p0 + t * 4)));
+          s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_set1_ps(weights[taps + t]), _mm_loadu_ps(p1 + t * 4)));
+          s2 = _mm_add_ps(s2, _mm_mul_ps(_mm_set1_ps(weights[2 * taps + t]), _mm_loadu_ps(p2 + t * 4)));
+          s3 = _mm_add_ps(s3, _mm_mul_ps(_mm_set1_ps(weights[3 * taps + t]), _mm_loadu_ps(p3 + t * 4)));
+        }
+
+        _mm_storeu_ps(out + x * 4, s0);
+        _mm_storeu_ps(out + x * 4 + 4, s1);
+        _mm_storeu_ps(out + x * 4 + 8, s2);
+        _mm_storeu_ps(out + x * 4 + 12, s3);
+      }
+
+      for (; x < dst_width; ++x)
+      {
+        const float* weights = &columns.weights[x * taps];
+        const float* pixel = row + columns.first[x] * 4;
+
+        __m128 sum = _mm_setzero_ps();
+        for (int t = 0; t < taps; ++t)
+          sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(pixel + t * 4)));
+
+        _mm_storeu_ps(out + x * 4, sum);
+      }
+    }
+
+    template<int ALPHA>
+    __attribute__((target("avx2")))
+    inline __m256 PremultiplyPixelsAVX2(__m256i pixels)
+    {
+      // The alpha lane of each pixel is multiplied by 1, like in PremultiplyPixelSSE2.
+      const int alpha_lanes = (ALPHA == 0) ? 0x11 : 0x88;
+
+      __m256 p = _mm256_cvtepi32_ps(pixels);
+      __m256 factor = _mm256_mul_ps(_mm256_permute_ps(p, _MM_SHUFFLE(ALPHA, ALPHA, ALPHA, ALPHA)), _mm256_set1_ps(INV_255));
+      factor = _mm256_blend_ps(factor, _mm256_set1_ps(1.0f), alpha_lanes);
+
+      return _mm256_mul_ps(p, factor);
+    }
+
+    template<int ALPHA>
+    __attribute__((target("avx2")))
+    void LoadRowAVX2(const unsigned char* src, int width, float* row)
+    {
+      int x = 0;
+
+      // Two pixels per vector.
+      for (; x + 8 <= width; x += 8)
+      {
+        for (int i = 0; i < 8; i += 2)
+        {
+          __m256i pixels = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (x + i) * 4)));
+          _mm256_storeu_ps(row + (x + i) * 4, PremultiplyPixelsAVX2<ALPHA>(pixels));
+        }
+      }
+
+      for (; x < width; ++x)
+      {
+        int value;
+        memcpy(&value, src + x * 4, 4);
+        _mm_storeu_ps(row + x * 4, PremultiplyPixelSSE2<ALPHA>(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(value))));
+      }
+    }
+
+    void LoadRowAVX2(const unsigned char* src, int width, int bytes_per_pixel, int alpha, float* row)
+    {
+      if (bytes_per_pixel == 4 && alpha == 0)
+        LoadRowAVX2<0>(src, width, row);
+      else if (bytes_per_pixel == 4 && alpha == 3)
+        LoadRowAVX2<3>(src, width, row);
+      else
+        LoadRowScalar(src, width, bytes_per_pixel, alpha, row);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256 LoadPixelPairAVX2(const float* low, const float* high)
+    {
+      return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256 SetWeightPairAVX2(float low, float high)
+    {
+      return _mm256_setr_ps(low, low, low, low, high, high, high, high);
+    }
+
+    __attribute__((target("avx2")))
+    void FilterRowAVX2(const float* row, Contributions const& columns, int dst_width, int bytes_per_pixel,
+                       float* out)
+    {
+      if (bytes_per_pixel != 4)
+      {
+        FilterRowScalar(row, columns, dst_width, bytes_per_pixel, out);
+        return;
+      }
+
+      int taps = columns.taps;
+      int x = 0;
+
+      // Two destination pixels per vector, four at a time to hide the latency of the additions.
+      for (; x + 4 <= dst_width; x += 4)
+      {
+        const float* weights = &columns.weights[x * taps];
+        const float* p0 = row + columns.first[x] * 4;
+        const float* p1 = row + columns.first[x + 1] * 4;
+        const float* p2 = row + columns.first[x + 2] * 4;
+        const float* p3 = row + columns.first[x + 3] * 4;
+
+        __m256 s01 = _mm256_setzero_ps();
+        __m256 s23 = _mm256_setzero_ps();
+
+        for (int t = 0; t < taps; ++t)
+        {
+          s01 = _mm256_add_ps(s01, _mm256_mul_ps(SetWeightPairAVX2(weights[t], weights[taps + t]),
+                                                 LoadPixelPairAVX2(p0 + t * 4, p1 + t * 4)));
+          s23 = _mm256_add_ps(s23, _mm256_mul_ps(SetWeightPairAVX2(weights[2 * taps + t], weights[3 * taps + t]),
+                                                 LoadPixelPairAVX2(p2 + t * 4, p3 + t * 4)));
+        }
+
+        _mm256_storeu_ps(out + x * 4, s01);
+        _mm256_storeu_ps(out + x * 4 + 8, s23);
+      }
+
+      for (; x < dst_width; ++x)
+      {
+        const float* weights = &columns.weights[x * taps];
+        const float* pixel = row + columns.first[x] * 4;
+
+        __m128 sum = _mm_setzero_ps();
+        for (int t = 0; t < taps; ++t)
+          sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(pixel + t * 4)));
+
+        _mm_storeu_ps(out + x * 4, sum);
+      }
+    }
+
+    __attribute__((target("sse2")))
+    void FilterColumnsSSE2(const float* rows, int row_stride, const float* weights, int taps, int n,
+                           float* sums)
+    {
+      int i = 0;
+
+      // Four independent sums hide the latency of the additions.
+      for (; i + 16 <= n; i += 16)
+      {
+        __m128 s0 = _mm_setzero_ps();
+        __m128 s1 = _mm_setzero_ps();
+        __m128 s2 = _mm_setzero_ps();
+        __m128 s3 = _mm_setzero_ps();
+
+        for (int t = 0; t < taps; ++t)
+        {
+          const float* row = rows + t * row_stride + i;
+          __m128 w = _mm_set1_ps(weights[t]);
+          s0 = _mm_add_ps(s0, _mm_mul_ps(w, _mm_loadu_ps(row)));
+          s1 = _mm_add_ps(s1, _mm_mul_ps(w, _mm_loadu_ps(row + 4)));
+          s2 = _mm_add_ps(s2, _mm_mul_ps(w, _mm_loadu_ps(row + 8)));
+          s3 = _mm_add_ps(s3, _mm_mul_ps(w, _mm_loadu_ps(row + 12)));
+        }
+
+        _mm_storeu_ps(sums + i, s0);
+        _mm_storeu_ps(sums + i + 4, s1);
+        _mm_storeu_ps(sums + i + 8, s2);
+        _mm_storeu_ps(sums + i + 12, s3);
+      }
+
+      for (; i + 4 <= n; i += 4)
+      {
+        __m128 s = _mm_setzero_ps();
+        for (int t = 0; t < taps; ++t)
+          s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(rows + t * row_stride + i)));
+
+        _mm_storeu_ps(sums + i, s);
+      }
+
+      FilterColumnsScalarRange(rows, row_stride, weights, taps, i, n, sums);
+    }
+
+    __attribute__((target("avx2")))
+    void FilterColumnsAVX2(const float* rows, int row_stride, const float* weights, int taps, int n,
+                           float* sums)
+    {
+      int i = 0;
+
+      for (; i + 32 <= n; i += 32)
+      {
+        __m256 s0 = _mm256_setzero_ps();
+        __m256 s1 = _mm256_setzero_ps();
+        __m256 s2 = _mm256_setzero_ps();
+        __m256 s3 = _mm256_setzero_ps();
+
+        for (int t = 0; t < taps; ++t)
+        {
+          const float* row = rows + t * row_stride + i;
+          __m256 w = _mm256_set1_ps(weights[t]);
+          s0 = _mm256_add_ps(s0, _mm256_mul_ps(w, _mm256_loadu_ps(row)));
+          s1 = _mm256_add_ps(s1, _mm256_mul_ps(w, _mm256_loadu_ps(row + 8)));
+          s2 = _mm256_add_ps(s2, _mm256_mul_ps(w, _mm256_loadu_ps(row + 16)));
+          s3 = _mm256_add_ps(s3, _mm256_mul_ps(w, _mm256_loadu_ps(row + 24)));
+        }
+
+        _mm256_storeu_ps(sums + i, s0);
+        _mm256_storeu_ps(sums + i + 8, s1);
+        _mm256_storeu_ps(sums + i + 16, s2);
+        _mm256_storeu_ps(sums + i + 24, s3);
+      }
+
+      for (; i + 8 <= n; i += 8)
+      {
+        __m256 s = _mm256_setzero_ps();
+        for (int t = 0; t < taps; ++t)
+          s = _mm256_add_ps(s, _mm256_mul_ps(_mm256_set1_ps(weights[t]), _mm256_loadu_ps(rows + t * row_stride + i)));
+
+        _mm256_storeu_ps(sums + i, s);
+      }
+
+      FilterColumnsScalarRange(rows, row_stride, weights, taps, i, n, sums);
+    }
+#endif
+
+    inline unsigned char ToByte(float value)
+    {
+      if (value <= 0.0f)
+        return 0;
+      if (value >= 255.0f)
+        return 255;
+
+      return static_cast<unsigned char>(value + 0.5f);
+    }
+
+    //! Convert a row of floats back to pixels, dividing the color channels by the alpha channel.
+    void StoreRow(const float* row, int width, int bytes_per_pixel, int alpha, unsigned char* dst)
+    {
+      int n = width * bytes_per_pixel;
+
+      if (alpha < 0)
+      {
+        for (int i = 0; i < n; ++i)
+          dst[i] = ToByte(row[i]);
+
+        return;
+      }
+
+      for (int i = 0; i < n; i += bytes_per_pixel)
+      {
+        float a = row[i + alpha];
+        float factor = (a > 0.0f) ? 255.0f / a : 0.0f;
+
+        for (int k = 0; k < bytes_per_pixel; ++k)
+          dst[i + k] = ToByte((k == alpha) ? a : row[i + k] * factor);
+      }
+    }
+
+    //! Run job(0) ... job(count - 1), the first one on the calling thread.
+    template<typename Job>
+    void RunJobs(int count, Job const& job)
+    {
+      std::vector<std::thread> threads;
+
+      for (int i = 1; i < count; ++i)
+        threads.push_back(std::thread(job, i));
+
+      job(0);
+
+      for (auto& thread : threads)
+        thread.join();
+    }
+  }
+
+  bool ScalePixels(const unsigned char* src, int src_stride, int src_width, int src_height,
+                   unsigned char* dst, int dst_stride, int dst_width, int dst_height,
+                   BitmapFormat format, ImageFilter filter, PixelKernelImplementation implementation,
+                   int max_threads)
+  {
+    int offsets[4];
+    if (!IsByteChannelFormat(format, offsets))
+      return false;
+
+    if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0)
+      return true;
+
+    if (implementation == PIXEL_KERNELS_AUTO || !IsPixelKernelImplementationSupported(implementation))
+      implementation = GetDefaultPixelKernelImplementation();
+
+    LoadFunction load = LoadRowScalar;
+    RowFunction filter_row = FilterRowScalar;
+    ColumnFunction filter_columns = FilterColumnsScalar;
+
+#if defined(NUX_SCALING_X86)
+    if (implementation == PIXEL_KERNELS_SSE2 || implementation == PIXEL_KERNELS_AVX2)
+    {
+      load = LoadRowSSE2;
+      filter_row = FilterRowSSE2;
+      filter_columns = FilterColumnsSSE2;
+    }
+
+    if (implementation == PIXEL_KERNELS_AVX2)
+    {
+      load = LoadRowAVX2;
+      filter_row = FilterRowAVX2;
+      filter_columns = FilterColumnsAVX2;
+    }
+#endif
+
+    int bytes_per_pixel = *std::max_element(offsets, offsets + 4) + 1;
+    int alpha = (bytes_per_pixel > 1) ? offsets[3] : -1;
+
+    Contributions columns = ComputeContributions(src_width, dst_width, filter);
+    Contributions rows = ComputeContributions(src_height, dst_height, filter);
+
+    int threads = max_threads;
+    if (threads <= 0)
+    {
+      threads = 1;
+      if (src_width * src_height >= MIN_THREADED_PIXELS)
+        threads = std::min<int>(std::max<int>(std::thread::hardware_concurrency(), 1), MAX_THREADS);
+    }
+
+    // The rows are reduced first, the columns are filtered in the narrower image.
+    int row_floats = dst_width * bytes_per_pixel;
+    std::vector<float> filtered(src_height * row_floats);
+
+    int rows_per_thread = (src_height + threads - 1) / threads;
+    RunJobs(threads, [&] (int i)
+    {
+      int begin = std::min(src_height, i * rows_per_thread);
+      int end = std::min(src_height, begin + rows_per_thread);
+
+      std::vector<float> row(src_width * bytes_per_pixel);
+      for (int y = begin; y < end; ++y)
+      {
+        load(src + y * src_stride, src_width, bytes_per_pixel, alpha, &row[0]);
+        filter_row(&row[0], columns, dst_width, bytes_per_pixel, &filtered[y * row_floats]);
+      }
+    });
+
+    rows_per_thread = (dst_height + threads - 1) / threads;
+    RunJobs(threads, [&] (int i)
+    {
+      int begin = std::min(dst_height, i * rows_per_thread);
+      int end = std::min(dst_height, begin + rows_per_thread);
+
+      std::vector<float> sums(row_floats);
+      for (int y = begin; y < end; ++y)
+      {
+        filter_columns(&filtered[rows.first[y] * row_floats], row_floats, &rows.weights[y * rows.taps], rows.taps,
+                       row_floats, &sums[0]);
+        StoreRow(&sums[0], dst_width, bytes_per_pixel, alpha, dst + y * dst_stride);
+      }
+    });
+
+    return true;
+  }
+
+  ImageSurface ScaleImageSurface(ImageSurface const& surface, int width, int height, ImageFilter filter)
+  {
+    if (!IsByteChannelFormat(surface.GetFormat()) || width <= 0 || height <= 0)
+      return ImageSurface();
+
+    ImageSurface scaled(surface.GetFormat(), width, height);
+    ScalePixels(surface.GetPtrRawData(), surface.GetPitch(), surface.GetWidth(), surface.GetHeight(),
+                scaled.GetPtrRawData(), scaled.GetPitch(), width, height, surface.GetFormat(), filter);
+
+    return scaled;
+  }
+
+  bool GenerateMipmaps(NTextureData& texture, ImageFilter filter)
+  {
+    if (!IsByteChannelFormat(texture.GetFormat()))
+      return false;
+
+    for (int level = 1; level < texture.GetNumMipmap(); ++level)
+    {
+      ImageSurface const& src = texture.GetSurface(level - 1);
+      ImageSurface& dst = texture.GetSurface(level);
+
+      ScalePixels(src.GetPtrRawData(), src.GetPitch(), src.GetWidth(), src.GetHeight(),
+                  dst.GetPtrRawData(), dst.GetPitch(), dst.GetWidth(), dst.GetHeight(), texture.GetFormat(), filter);
+    }
+
+    return true;
+  }
+
+  bool FitTextureData(NTextureData& texture, int max_width, int max_height, ImageFilter filter)
+  {
+    int width = texture.GetWidth();
+    int height = texture.GetHeight();
+
+    if (width <= max_width && height <= max_height)
+      return false;
+
+    if (max_width <= 0 || max_height <= 0 || !IsByteChannelFormat(texture.GetFormat()))
+      return false;
+
+    double scale = std::min(double(max_width) / width, double(max_height) / height);
+    int fit_width = std::max(1, int(width * scale + 0.5));
+    int fit_height = std::max(1, int(height * scale + 0.5));
+
+    NTextureData fit(texture.GetFormat(), fit_width, fit_height, texture.GetNumMipmap());
+    ImageSurface const& src = texture.GetSurface(0);
+    ImageSurface& dst = fit.GetSurface(0);
+
+    ScalePixels(src.GetPtrRawData(), src.GetPitch(), width, height,
+                dst.GetPtrRawData(), dst.GetPitch(), fit_width, fit_height, texture.GetFormat(), filter);
+    GenerateMipmaps(fit);
+
+    texture = std::move(fit);
+    return true;
+  }
+}
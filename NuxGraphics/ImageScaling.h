@@ -0,0 +1,94 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#ifndef IMAGESCALING_H
+#define IMAGESCALING_H
+
+#include "ImageKernels.h"
+
+namespace nux
+{
+  class ImageSurface;
+  class NTextureData;
+
+  //! Filter used to resample an image.
+  enum ImageFilter
+  {
+    IMAGE_FILTER_BOX,      //!< Average of the covered source pixels. Fast, used for the mipmaps.
+    IMAGE_FILTER_LANCZOS,  //!< Lanczos with 3 lobes. Sharper, used for the large reductions.
+  };
+
+  //! Resample an image to another size.
+  /*!
+      The image is filtered one row at a time and then one column at a time, in floating point. When the
+      image is reduced, the filter is stretched over the source pixels covered by a destination pixel. The
+      color channels are weighted by the alpha channel, so that the color of the transparent pixels does not
+      bleed. All the implementations produce the same result.
+
+      @param src The first pixel of the source image.
+      @param src_stride Number of bytes between two rows of the source image.
+      @param src_width Width of the source image in pixels.
+      @param src_height Height of the source image in pixels.
+      @param dst The first pixel of the destination image. It must not overlap the source image.
+      @param dst_stride Number of bytes between two rows of the destination image.
+      @param dst_width Width of the destination image in pixels.
+      @param dst_height Height of the destination image in pixels.
+      @param format Format of both images. One of the byte channel formats (see IsByteChannelFormat).
+      @param filter Resampling filter.
+      @param implementation Code path to use. If it is not supported, PIXEL_KERNELS_AUTO is used.
+      @param max_threads Maximum number of threads. If 0, large images are split between a few threads.
+      @return False if the format is not supported.
+  */
+  bool ScalePixels(const unsigned char* src, int src_stride, int src_width, int src_height,
+                   unsigned char* dst, int dst_stride, int dst_width, int dst_height,
+                   BitmapFormat format, ImageFilter filter = IMAGE_FILTER_LANCZOS,
+                   PixelKernelImplementation implementation = PIXEL_KERNELS_AUTO, int max_threads = 0);
+
+  //! Return a copy of the surface resampled to another size.
+  /*!
+      @return The resampled surface, or a null surface if the format is not supported.
+  */
+  ImageSurface ScaleImageSurface(ImageSurface const& surface, int width, int height,
+                                 ImageFilter filter = IMAGE_FILTER_LANCZOS);
+
+  //! Fill the mipmaps of a texture, each one from the previous level.
+  /*!
+      The levels are the ones reserved by NTextureData::Allocate.
+
+      @return False if the format is not supported.
+  */
+  bool GenerateMipmaps(NTextureData& texture, ImageFilter filter = IMAGE_FILTER_BOX);
+
+  //! Reduce a texture so that it fits in a size, keeping its aspect ratio.
+  /*!
+      A texture that already fits is not changed. The texture keeps its number of mipmaps, as far as the
+      new size allows; they are generated again.
+
+      @param texture The texture to reduce.
+      @param max_width Maximum width of the texture.
+      @param max_height Maximum height of the texture.
+      @param filter Filter used to reduce the first level.
+      @return True if the texture was reduced.
+  */
+  bool FitTextureData(NTextureData& texture, int max_width, int max_height,
+                      ImageFilter filter = IMAGE_FILTER_LANCZOS);
+}
+
+#endif // IMAGESCALING_H
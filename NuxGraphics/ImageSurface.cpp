@@ -26,6 +26,7 @@
 
 #include "BitmapFormats.h"
 #include "GdkGraphics.h"
+#include "ImageKernels.h"
 
 #if defined(NUX_OS_WINDOWS)
   #include "GdiImageLoader.h"
@@ -529,28 +530,25 @@ DECLARE_LOGGER(logger, "nux.image");
     if ((format_ == BITFMT_DXT1) || (format_ == BITFMT_DXT2)  || (format_ == BITFMT_DXT3)  || (format_ == BITFMT_DXT4) || (format_ == BITFMT_DXT5))
       return;
 
-    int i, j, k;
-
     if (RawData_.empty())
       return;
 
     if (width_ == 0 || height_ == 0)
       return;
 
-    std::vector<unsigned char> flip_data(m_Pitch*height_);
-
-    for (j = 0; j < height_; j++)
+    if (bpe_ <= 4)
     {
-      for (i = 0; i < width_; i++)
-      {
-        for (k = 0; k < bpe_; k++)
-        {
-          flip_data[ (j*m_Pitch) + i *bpe_ + k] = RawData_[ (j*m_Pitch) + (width_-i-1) * bpe_ + k];
-        }
-      }
+      ReversePixelRows(RawData_.data(), width_, height_, m_Pitch, bpe_);
+      return;
     }
 
-    RawData_.swap(flip_data);
+    for (int j = 0; j < height_; j++)
+    {
+      unsigned char* row = RawData_.data() + j * m_Pitch;
+
+      for (int i = 0; i < width_ - 1 - i; i++)
+        std::swap_ranges(row + i * bpe_, row + (i + 1) * bpe_, row + (width_ - 1 - i) * bpe_);
+    }
   }
 
   void ImageSurface::FlipVertical()
@@ -567,20 +565,12 @@ DECLARE_LOGGER(logger, "nux.image");
     }
     else
     {
-      std::vector<unsigned char> flip_data(m_Pitch*height_);
-
-      for (int j = 0; j < height_; j++)
+      // Swap the rows in place.
+      for (int j = 0; j < height_ / 2; j++)
       {
-        for (int i = 0; i < width_; i++)
-        {
-          for (int k = 0; k < bpe_; k++)
-          {
-            flip_data[ (j*m_Pitch) + i *bpe_ + k] = RawData_[ (height_-j-1) *m_Pitch + i * bpe_ + k];
-          }
-        }
+        unsigned char* row = RawData_.data() + j * m_Pitch;
+        std::swap_ranges(row, row + m_Pitch, RawData_.data() + (height_ - 1 - j) * m_Pitch);
       }
-
-      RawData_.swap(flip_data);
     }
 
   }
@@ -825,29 +815,26 @@ DECLARE_LOGGER(logger, "nux.image");
 
   Color ImageSurface::AverageColor()
   {
-    if (width_ == 0 || height_ == 0)
+    int offsets[4];
+
+    if (width_ == 0 || height_ == 0 || !IsByteChannelFormat(format_, offsets))
       return Color(0.f, 0.f, 0.f, 0.f);
 
-    float r, g, b, a;
-    r = g = b = a = 0;
+    unsigned long long sums[4];
+    SumPixelBytes(RawData_.data(), width_, height_, m_Pitch, bpe_, sums);
 
-    if (bpe_ == 8)
+    double scale = 1.0 / (255.0 * width_ * height_);
+    float channels[4];
+
+    for (int c = 0; c < 4; c++)
     {
-      for (int j = 0; j < height_; j++)
-      {
-        for (int i = 0; i < width_; i++)
-        {
-          unsigned int v = Read(i, j);
-          r += (v & 0x000000FF);
-          g += (v & 0x0000FF00) >> 1;
-          b += (v & 0x00FF0000) >> 2;
-          a += (v & 0xFF000000) >> 3;
-        }
-      }
+      if (offsets[c] < 0)
+        channels[c] = (c == 3) ? 1.0f : 0.0f;
+      else
+        channels[c] = sums[offsets[c]] * scale;
     }
 
-    unsigned int num_pixels = width_ * height_;
-    return Color(r / num_pixels, g / num_pixels, b / num_pixels, a / num_pixels);
+    return Color(channels[0], channels[1], channels[2], channels[3]);
   }
 
 
@@ -911,8 +898,8 @@ DECLARE_LOGGER(logger, "nux.image");
 
     for (int i = 0; i < m_NumMipmap; ++i)
     {
-      int w = width >> i;
-      int h = height >> i;
+      int w = ImageSurface::GetLevelDim(format, width, i);
+      int h = ImageSurface::GetLevelDim(format, height, i);
       m_MipSurfaceArray[i] = ImageSurface(format, w, h);
       m_TotalMemorySize += m_MipSurfaceArray[i].GetSize();
     }
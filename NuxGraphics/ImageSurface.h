@@ -143,8 +143,10 @@ namespace nux
     // Image Processing
     //! Compute the average color of the image surface.
     /*!
-        Sum up all the image elements and divide by the number of elements.
-        @return The average color of the image.
+        Sum up all the image elements and divide by the number of elements. Only the formats with one byte per
+        channel are supported (see IsByteChannelFormat); a missing color channel is 0 and a missing alpha channel
+        is 1.
+        @return The average color of the image, or transparent black if the format is not supported.
     */
     Color AverageColor();
 
@@ -1,156 +1,583 @@
 
+
 #include "GLResource.h"
 #include "MeshFileLoader-OBJ.h"
 #include "MeshData.h"
-#include "NuxCore/Math/Vector3.h"
-#include "NuxCore/Math/Vector2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace nux
 {
-#define TOKEN_VERTEX_POS "v"
-#define TOKEN_VERTEX_NOR "vn"
-#define TOKEN_VERTEX_TEX "vt"
-#define TOKEN_FACE "f"
-
-  struct ObjMeshVertex
+  /**
+   * Lines beginning with:
+   * '#'  are comments can be ignored
+   * 'v'  are vertices positions(3 floats that can be positive or negative)
+   * 'vt' are vertices texcoords(2 floats that can be positive or negative)
+   * 'vn' are vertices normals   (3 floats that can be positive or negative)
+   * 'f'  are faces, 3 or more vertices separated by <space>. A vertex is a position index, optionally followed by
+   *      a texcoord index and a normal index, separated by '/'. The other lines are ignored.
+   *
+   * The file is parsed in place in two passes over chunks of lines: the first pass counts the elements of each
+   * chunk, the second one parses each chunk into its own slice of the arrays.
+   */
+  namespace
   {
-    nux::Vector3 pos;
-    nux::Vector2 texcoord;
-    nux::Vector3 normal;
-  };
+    const size_t MIN_THREADED_BYTES = 1 << 20;
+    const int MAX_THREADS = 4;
 
-  /* This is a triangle, that we can render */
-  struct ObjMeshFace
-  {
-    ObjMeshVertex vertices[3];
-  };
+    // Number of floats of a vertex: position (4), normal (3) and texcoord (2).
+    const int VERTEX_FLOATS = 9;
 
-  /* This contains a list of triangles */
-  struct ObjMesh
-  {
-    std::vector<ObjMeshFace> faces;
-  };
+    const double POWERS_OF_10[] =
+    {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
 
-  /* Internal structure */
-  struct _ObjMeshFaceIndex
-  {
-    int pos_index[3];
-    int tex_index[3];
-    int nor_index[3];
-  };
+    //! Indices of the position, texcoord and normal of a vertex, -1 if there is none.
+    struct ObjVertexIndex
+    {
+      int pos;
+      int tex;
+      int nor;
+    };
 
-  MeshData* LoadMeshFile_OBJ(const char* filename)
-  {
-    std::vector<nux::Vector4>           positions;
-    std::vector<nux::Vector2>           texcoords;
-    std::vector<nux::Vector3>           normals;
-    std::vector<_ObjMeshFaceIndex>  faces;
-    /**
-     * Load file, parse it
-     * Lines beginning with:
-     * '#'  are comments can be ignored
-     * 'v'  are vertices positions(3 floats that can be positive or negative)
-     * 'vt' are vertices texcoords(2 floats that can be positive or negative)
-     * 'vn' are vertices normals   (3 floats that can be positive or negative)
-     * 'f'  are faces, 3 values that contain 3 values which are separated by / and <space>
-     */
+    //! Elements in a chunk of the file, or before it.
+    struct ObjCounts
+    {
+      ObjCounts()
+        : positions(0)
+        , texcoords(0)
+        , normals(0)
+        , triangles(0)
+      {}
+
+      size_t positions;
+      size_t texcoords;
+      size_t normals;
+      size_t triangles;
+    };
 
-    std::ifstream filestream;
-    filestream.open(filename);
+    //! Everything parsed from the file. The faces are split in triangles.
+    struct ObjArrays
+    {
+      std::vector<float> positions;           // 3 floats per position.
+      std::vector<float> texcoords;           // 2 floats per texcoord.
+      std::vector<float> normals;             // 3 floats per normal.
+      std::vector<ObjVertexIndex> corners;    // 3 vertices per triangle.
+    };
+
+    inline bool IsSpace(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\r';
+    }
 
-    std::string line_stream;    // No longer depending on char arrays thanks to: Dale Weiler
+    inline bool IsDigit(char c)
+    {
+      return c >= '0' && c <= '9';
+    }
 
-    while (std::getline(filestream, line_stream))
+    inline const char* SkipSpaces(const char* p, const char* end)
     {
-      std::stringstream str_stream(line_stream);
-      std::string type_str;
-      str_stream >> type_str;
+      while (p < end && IsSpace(*p))
+        ++p;
+      return p;
+    }
 
-      if (type_str == TOKEN_VERTEX_POS)
+    inline const char* SkipToken(const char* p, const char* end)
+    {
+      while (p < end && !IsSpace(*p) && *p != '\n')
+        ++p;
+      return p;
+    }
+
+    inline const char* NextLine(const char* p, const char* end)
+    {
+      const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+      return newline ? newline + 1 : end;
+    }
+
+    //! Parse a decimal number and move p past it. Returns 0 if there is no number at p.
+    /*!
+        The first 19 significant digits are scaled by an exact power of 10, which is correctly rounded for the
+        numbers found in mesh files.
+    */
+    float ParseFloat(const char*& p, const char* end)
+    {
+      bool negative = false;
+      if (p < end && (*p == '-' || *p == '+'))
       {
-        nux::Vector4 pos;
-        str_stream >> pos.x >> pos.y >> pos.z;
-        pos.w = 1.0f;
-        positions.push_back(pos);
+        negative = (*p == '-');
+        ++p;
       }
-      else if (type_str == TOKEN_VERTEX_TEX)
+
+      unsigned long long mantissa = 0;
+      int digits = 0;
+      int exponent = 0;
+      bool found = false;
+
+      for (; p < end && IsDigit(*p); ++p)
       {
-        nux::Vector2 tex;
-        str_stream >> tex.x >> tex.y;
-        texcoords.push_back(tex);
+        found = true;
+        if (digits < 19)
+        {
+          mantissa = mantissa * 10 + (*p - '0');
+          digits += (mantissa != 0);
+        }
+        else
+        {
+          ++exponent;
+        }
       }
-      else if (type_str == TOKEN_VERTEX_NOR)
+
+      if (p < end && *p == '.')
       {
-        nux::Vector3 nor;
-        str_stream >> nor.x >> nor.y >> nor.z;
-        normals.push_back(nor);
+        for (++p; p < end && IsDigit(*p); ++p)
+        {
+          found = true;
+          if (digits < 19)
+          {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += (mantissa != 0);
+            --exponent;
+          }
+        }
       }
-      else if (type_str == TOKEN_FACE)
+
+      if (!found)
+      {
+        p = SkipToken(p, end);
+        return 0.0f;
+      }
+
+      if (p + 1 < end && (*p == 'e' || *p == 'E'))
       {
-        _ObjMeshFaceIndex face_index;
-        char interupt;
-        for (int i = 0; i < 3; ++i)
+        const char* q = p + 1;
+        bool negative_exponent = false;
+        if (*q == '-' || *q == '+')
         {
-          str_stream >> face_index.pos_index[i] >> interupt
-                       >> face_index.tex_index[i]  >> interupt
-                       >> face_index.nor_index[i];
+          negative_exponent = (*q == '-');
+          ++q;
+        }
+
+        if (q < end && IsDigit(*q))
+        {
+          int value = 0;
+          for (; q < end && IsDigit(*q); ++q)
+          {
+            if (value < 10000)
+              value = value * 10 + (*q - '0');
+          }
+
+          exponent += negative_exponent ? -value : value;
+          p = q;
         }
-        faces.push_back(face_index);
       }
+
+      double value = double(mantissa);
+      if (exponent < 0 && exponent >= -22)
+        value /= POWERS_OF_10[-exponent];
+      else if (exponent > 0 && exponent <= 22)
+        value *= POWERS_OF_10[exponent];
+      else if (exponent != 0)
+        value *= pow(10.0, exponent);
+
+      return float(negative ? -value : value);
     }
-    // Explicit closing of the file
-    filestream.close();
 
-    nux::MeshData* md = new nux::MeshData;
-    md->Allocate(faces.size(), nux::NUX_MESH_TRIANGLE, 3*faces.size(), 16 + 12 + 8);
+    //! Parse an index of a face vertex. Returns 0, an invalid index, if there is no number at p.
+    inline int ParseIndex(const char*& p, const char* end)
+    {
+      bool negative = false;
+      if (p < end && *p == '-')
+      {
+        negative = true;
+        ++p;
+      }
 
-    //md->_mesh_primitive_type = nux::NuxMeshPrimitiveType::NUX_MESH_TRIANGLE;
+      int value = 0;
+      for (; p < end && IsDigit(*p); ++p)
+        value = value * 10 + (*p - '0');
 
-    size_t i = 0;
+      return negative ? -value : value;
+    }
 
-    float* vertex_buffer = (float*)md->_vertex_data;
-//     for (i = 0; i < positions.size(); i++)
-//     {
-//       vertex_buffer[9*i + 0] = positions[i].x;
-//       vertex_buffer[9*i + 1] = positions[i].y;
-//       vertex_buffer[9*i + 2] = positions[i].z;
-//       vertex_buffer[9*i + 3] = positions[i].w;
-// 
-//       vertex_buffer[9*i + 4] = normals[i].x;
-//       vertex_buffer[9*i + 5] = normals[i].y;
-//       vertex_buffer[9*i + 6] = normals[i].z;
-// 
-//       vertex_buffer[9*i + 7] = texcoords[i].x;
-//       vertex_buffer[9*i + 8] = texcoords[i].y;
-//     }
+    //! Convert an index of the file, 1 based or relative to the end, to a 0 based index.
+    inline int ResolveIndex(int index, size_t count)
+    {
+      if (index > 0 && size_t(index) <= count)
+        return index - 1;
+
+      if (index < 0 && size_t(-index) <= count)
+        return int(count) + index;
 
-    int* index_buffer = (int*)md->_index_data;
-    for (i = 0; i < faces.size(); i++)
+      return -1;
+    }
+
+    //! Return the type of the element on a line: 'v', 't' (texcoord), 'n' (normal), 'f' or 0 for the others.
+    inline char GetLineType(const char*& p, const char* end)
     {
-      index_buffer[3*i + 0] = 3*i + 0;  //faces[i].pos_index[0]-1;
-      index_buffer[3*i + 1] = 3*i + 1;  //faces[i].pos_index[1]-1;
-      index_buffer[3*i + 2] = 3*i + 2;  //faces[i].pos_index[2]-1;
+      p = SkipSpaces(p, end);
+      if (end - p < 2)
+        return 0;
+
+      if (p[0] == 'f' && IsSpace(p[1]))
+      {
+        p += 2;
+        return 'f';
+      }
+
+      if (p[0] != 'v')
+        return 0;
+
+      if (IsSpace(p[1]))
+      {
+        p += 2;
+        return 'v';
+      }
 
-      for (int j = 0; j < 3; j++)
+      if ((p[1] == 't' || p[1] == 'n') && end - p > 2 && IsSpace(p[2]))
       {
-        int vi    = faces[i].pos_index[j]-1;
-        int ni    = faces[i].nor_index[j]-1;
-        int ti    = faces[i].tex_index[j]-1;
+        p += 3;
+        return p[-2];
+      }
+
+      return 0;
+    }
 
-        vertex_buffer[27*i + 9*j + 0] = positions[vi].x;
-        vertex_buffer[27*i + 9*j + 1] = positions[vi].y;
-        vertex_buffer[27*i + 9*j + 2] = positions[vi].z;
-        vertex_buffer[27*i + 9*j + 3] = positions[vi].w;
+    //! Number of vertices of the face on the line that starts at p, up to the end of the line or a comment.
+    inline int CountFaceVertices(const char* p, const char* end)
+    {
+      int count = 0;
+      for (p = SkipSpaces(p, end); p < end && *p != '\n' && *p != '#'; p = SkipSpaces(p, end))
+      {
+        ++count;
+        p = SkipToken(p, end);
+      }
 
-        vertex_buffer[27*i + 9*j + 4] = normals[ni].x;
-        vertex_buffer[27*i + 9*j + 5] = normals[ni].y;
-        vertex_buffer[27*i + 9*j + 6] = normals[ni].z;
+      return count;
+    }
 
-        vertex_buffer[27*i + 9*j + 7] = texcoords[ti].x;
-        vertex_buffer[27*i + 9*j + 8] = texcoords[ti].y;
+    ObjCounts CountChunk(const char* p, const char* end)
+    {
+      ObjCounts counts;
+
+      for (; p < end; p = NextLine(p, end))
+      {
+        switch (GetLineType(p, end))
+        {
+          case 'v':
+            ++counts.positions;
+            break;
+          case 't':
+            ++counts.texcoords;
+            break;
+          case 'n':
+            ++counts.normals;
+            break;
+          case 'f':
+          {
+            int vertices = CountFaceVertices(p, end);
+            if (vertices >= 3)
+              counts.triangles += vertices - 2;
+            break;
+          }
+          default:
+            break;
+        }
       }
+
+      return counts;
     }
 
+    //! Parse a chunk into the arrays, from the elements counted before the chunk.
+    void ParseChunk(const char* p, const char* end, ObjCounts counts, ObjArrays& arrays)
+    {
+      std::vector<ObjVertexIndex> face;
+
+      for (; p < end; p = NextLine(p, end))
+      {
+        switch (GetLineType(p, end))
+        {
+          case 'v':
+          {
+            float* position = &arrays.positions[3 * counts.positions++];
+            for (int i = 0; i < 3; ++i)
+            {
+              p = SkipSpaces(p, end);
+              position[i] = ParseFloat(p, end);
+            }
+            break;
+          }
+          case 't':
+          {
+            float* texcoord = &arrays.texcoords[2 * counts.texcoords++];
+            for (int i = 0; i < 2; ++i)
+            {
+              p = SkipSpaces(p, end);
+              texcoord[i] = ParseFloat(p, end);
+            }
+            break;
+          }
+          case 'n':
+          {
+            float* normal = &arrays.normals[3 * counts.normals++];
+            for (int i = 0; i < 3; ++i)
+            {
+              p = SkipSpaces(p, end);
+              normal[i] = ParseFloat(p, end);
+            }
+            break;
+          }
+          case 'f':
+          {
+            // Same tokens as CountFaceVertices.
+            face.clear();
+            for (p = SkipSpaces(p, end); p < end && *p != '\n' && *p != '#'; p = SkipSpaces(p, end))
+            {
+              ObjVertexIndex vertex;
+              vertex.pos = ResolveIndex(ParseIndex(p, end), counts.positions);
+              vertex.tex = -1;
+              vertex.nor = -1;
+
+              if (p < end && *p == '/')
+              {
+                ++p;
+                vertex.tex = ResolveIndex(ParseIndex(p, end), counts.texcoords);
+
+                if (p < end && *p == '/')
+                {
+                  ++p;
+                  vertex.nor = ResolveIndex(ParseIndex(p, end), counts.normals);
+                }
+              }
+
+              face.push_back(vertex);
+              p = SkipToken(p, end);
+            }
+
+            // Triangle fan.
+            for (size_t i = 2; i < face.size(); ++i)
+            {
+              ObjVertexIndex* triangle = &arrays.corners[3 * counts.triangles++];
+              triangle[0] = face[0];
+              triangle[1] = face[i - 1];
+              triangle[2] = face[i];
+            }
+            break;
+          }
+          default:
+            break;
+        }
+      }
+    }
+
+    //! Run job(0) ... job(count - 1), the first one on the calling thread.
+    template<typename Job>
+    void RunJobs(int count, Job const& job)
+    {
+      std::vector<std::thread> threads;
+
+      for (int i = 1; i < count; ++i)
+        threads.push_back(std::thread(job, i));
+
+      job(0);
+
+      for (auto& thread : threads)
+        thread.join();
+    }
+
+    inline size_t HashVertex(ObjVertexIndex const& vertex)
+    {
+      size_t hash = size_t(vertex.pos) * 0x9E3779B1u;
+      hash ^= size_t(vertex.tex) * 0x85EBCA77u + (hash >> 15);
+      hash ^= size_t(vertex.nor) * 0xC2B2AE3Du + (hash >> 13);
+      return hash ^ (hash >> 16);
+    }
+
+    inline bool operator == (ObjVertexIndex const& a, ObjVertexIndex const& b)
+    {
+      return a.pos == b.pos && a.tex == b.tex && a.nor == b.nor;
+    }
+
+    //! Give each distinct vertex of the triangles an index.
+    /*!
+        @param corners The vertices of the triangles.
+        @param expected Expected number of distinct vertices, to size the hash table.
+        @param indices Receives the index of the vertex of each corner.
+        @return The distinct vertices, in the order of their first use.
+    */
+    std::vector<ObjVertexIndex> MergeVertices(std::vector<ObjVertexIndex> const& corners, size_t expected,
+                                              std::vector<int>& indices)
+    {
+      std::vector<ObjVertexIndex> vertices;
+      vertices.reserve(expected);
+
+      // Open addressing, the table is kept at most half full.
+      size_t capacity = 16;
+      while (capacity < 2 * expected)
+        capacity *= 2;
+
+      std::vector<int> table(capacity, -1);
+      size_t mask = capacity - 1;
+
+      indices.resize(corners.size());
+      for (size_t i = 0; i < corners.size(); ++i)
+      {
+        size_t slot = HashVertex(corners[i]) & mask;
+        while (table[slot] != -1 && !(vertices[table[slot]] == corners[i]))
+          slot = (slot + 1) & mask;
+
+        int index = table[slot];
+        if (index == -1)
+        {
+          index = vertices.size();
+          table[slot] = index;
+          vertices.push_back(corners[i]);
+
+          if (2 * vertices.size() > capacity)
+          {
+            capacity *= 2;
+            mask = capacity - 1;
+            table.assign(capacity, -1);
+
+            for (size_t v = 0; v < vertices.size(); ++v)
+            {
+              size_t free_slot = HashVertex(vertices[v]) & mask;
+              while (table[free_slot] != -1)
+                free_slot = (free_slot + 1) & mask;
+              table[free_slot] = v;
+            }
+          }
+        }
+
+        indices[i] = index;
+      }
+
+      return vertices;
+    }
+
+    MeshData* ParseMesh(const char* text, size_t length, int max_threads)
+    {
+      int chunks = max_threads;
+      if (chunks <= 0)
+      {
+        chunks = 1;
+        if (length >= MIN_THREADED_BYTES)
+          chunks = std::min<int>(std::max<int>(std::thread::hardware_concurrency(), 1), MAX_THREADS);
+      }
+
+      // Split the text at the ends of the lines.
+      std::vector<const char*> bounds(chunks + 1, text + length);
+      bounds[0] = text;
+      for (int i = 1; i < chunks; ++i)
+        bounds[i] = std::max(bounds[i - 1], NextLine(text + length * i / chunks, text + length));
+
+      std::vector<ObjCounts> counts(chunks + 1);
+      RunJobs(chunks, [&] (int i)
+      {
+        counts[i + 1] = CountChunk(bounds[i], bounds[i + 1]);
+      });
+
+      // Elements before each chunk.
+      for (int i = 1; i <= chunks; ++i)
+      {
+        counts[i].positions += counts[i - 1].positions;
+        counts[i].texcoords += counts[i - 1].texcoords;
+        counts[i].normals += counts[i - 1].normals;
+        counts[i].triangles += counts[i - 1].triangles;
+      }
+
+      ObjCounts const& total = counts[chunks];
+      if (total.triangles == 0)
+        return NULL;
+
+      ObjArrays arrays;
+      arrays.positions.resize(3 * total.positions);
+      arrays.texcoords.resize(2 * total.texcoords);
+      arrays.normals.resize(3 * total.normals);
+      arrays.corners.resize(3 * total.triangles);
+
+      RunJobs(chunks, [&] (int i)
+      {
+        ParseChunk(bounds[i], bounds[i + 1], counts[i], arrays);
+      });
+
+      std::vector<int> indices;
+      // Usually, each position is used with a single texcoord and normal.
+      size_t expected = std::max(total.positions, std::max(total.texcoords, total.normals));
+      std::vector<ObjVertexIndex> vertices = MergeVertices(arrays.corners, expected, indices);
+
+      MeshData* md = new MeshData;
+      if (!md->Allocate(total.triangles, NUX_MESH_TRIANGLE, vertices.size(), VERTEX_FLOATS * sizeof(float)))
+      {
+        delete md;
+        return NULL;
+      }
+
+      memcpy(md->_index_data, &indices[0], indices.size() * sizeof(int));
+
+      float* vertex_buffer = reinterpret_cast<float*>(md->_vertex_data);
+      for (size_t i = 0; i < vertices.size(); ++i)
+      {
+        ObjVertexIndex const& vertex = vertices[i];
+        float* v = vertex_buffer + VERTEX_FLOATS * i;
+
+        std::fill(v, v + VERTEX_FLOATS, 0.0f);
+        v[3] = 1.0f;
+
+        if (vertex.pos >= 0)
+          std::copy_n(&arrays.positions[3 * vertex.pos], 3, v);
+
+        if (vertex.nor >= 0)
+          std::copy_n(&arrays.normals[3 * vertex.nor], 3, v + 4);
+
+        if (vertex.tex >= 0)
+          std::copy_n(&arrays.texcoords[2 * vertex.tex], 2, v + 7);
+      }
+
+      return md;
+    }
+  }
+
+  MeshData* LoadMeshFile_OBJ(const char* filename, int max_threads)
+  {
+    NUX_RETURN_VALUE_IF_NULL(filename, NULL);
+
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+      return NULL;
+
+    MeshData* md = NULL;
+    struct stat info;
+
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+      void* text = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (text != MAP_FAILED)
+      {
+        madvise(text, info.st_size, MADV_SEQUENTIAL);
+        md = ParseMesh(static_cast<const char*>(text), info.st_size, max_threads);
+        munmap(text, info.st_size);
+      }
+    }
+
+    close(fd);
     return md;
   }
+
+  MeshData* ParseMeshData_OBJ(const char* text, size_t length, int max_threads)
+  {
+    NUX_RETURN_VALUE_IF_NULL(text, NULL);
+    return ParseMesh(text, length, max_threads);
+  }
 }
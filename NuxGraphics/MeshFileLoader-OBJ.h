@@ -1,11 +1,27 @@
 #ifndef MESHFILELOADER_H
 #define MESHFILELOADER_H
 
+#include <cstddef>
+
 namespace nux
 {
   class MeshData;
 
-  MeshData* LoadMeshFile_OBJ(const char* filename);
+  //! Load a Wavefront OBJ file.
+  /*!
+      The file is mapped in memory and parsed in place. The faces are split in triangles and the vertices that
+      share the same position, texcoord and normal are merged. A vertex is 9 floats: position (x, y, z, 1),
+      normal and texcoord; the missing attributes are 0. MeshData::_num_element is the number of merged vertices,
+      not 3 times the number of triangles.
+
+      @param filename Path of the file.
+      @param max_threads Maximum number of threads. If 0, large files are split between a few threads.
+      @return The mesh, or NULL if the file cannot be read or has no face. Destroy it with delete.
+  */
+  MeshData* LoadMeshFile_OBJ(const char* filename, int max_threads = 0);
+
+  //! Same as LoadMeshFile_OBJ, with the content of a file.
+  MeshData* ParseMeshData_OBJ(const char* text, size_t length, int max_threads = 0);
 
 }
 
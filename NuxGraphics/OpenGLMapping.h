@@ -65,6 +65,7 @@
 #define glDeleteBuffersARB glDeleteBuffers
 #define glBindBufferARB glBindBuffer
 #define glBufferDataARB glBufferData
+#define glBufferSubDataARB glBufferSubData
 #define glMapBufferARB glMapBufferOES
 #define glUnmapBufferARB glUnmapBufferOES
 
@@ -0,0 +1,316 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#include "NuxCore/NuxCore.h"
+#include "GLResource.h"
+#include "GpuDevice.h"
+#include "GLDeviceObjects.h"
+#include "GraphicsEngine.h"
+#include "QuadBatcher.h"
+
+#include <cstring>
+
+namespace nux
+{
+namespace
+{
+  // The indices are 16 bits: 4 vertices per quad gives at most 16384 quads per draw call.
+  // Stay well below that so the streamed vertex buffer remains reasonably sized.
+  const int MAX_QUADS_PER_BATCH = 4096;
+
+  struct NameHandles
+  {
+    NameHandles()
+      : vertex(IOpenGLShaderProgram::GetNameHandle("AVertex"))
+      , tex_coord0(IOpenGLShaderProgram::GetNameHandle("MyTextureCoord0"))
+      , tex_coord1(IOpenGLShaderProgram::GetNameHandle("MyTextureCoord1"))
+      , vertex_color(IOpenGLShaderProgram::GetNameHandle("VertexColor"))
+      , view_projection_matrix(IOpenGLShaderProgram::GetNameHandle("ViewProjectionMatrix"))
+      , color0(IOpenGLShaderProgram::GetNameHandle("color0"))
+      , color1(IOpenGLShaderProgram::GetNameHandle("color1"))
+    {
+      texture_object[0] = IOpenGLShaderProgram::GetNameHandle("TextureObject0");
+      texture_object[1] = IOpenGLShaderProgram::GetNameHandle("TextureObject1");
+    }
+
+    int vertex;
+    int tex_coord0;
+    int tex_coord1;
+    int vertex_color;
+    int view_projection_matrix;
+    int color0;
+    int color1;
+    int texture_object[2];
+  };
+
+  NameHandles const& GetNameHandles()
+  {
+    static NameHandles handles;
+    return handles;
+  }
+}
+
+  QuadBatcher::State::State()
+    : layout(LAYOUT_TEXCOORD_COLOR)
+  {
+    for (int i = 0; i < 2; ++i)
+    {
+      uwrap[i] = TEXWRAP_UNKNOWN;
+      vwrap[i] = TEXWRAP_UNKNOWN;
+      min_filter[i] = TEXFILTER_UNKNOWN;
+      mag_filter[i] = TEXFILTER_UNKNOWN;
+    }
+  }
+
+  void QuadBatcher::State::SetTexture(int index, ObjectPtr<IOpenGLBaseTexture> const& tex, TexCoordXForm const& texxform)
+  {
+    texture[index] = tex;
+    uwrap[index] = texxform.uwrap;
+    vwrap[index] = texxform.vwrap;
+    min_filter[index] = texxform.min_filter;
+    mag_filter[index] = texxform.mag_filter;
+  }
+
+  bool QuadBatcher::State::operator == (State const& other) const
+  {
+    if (program.GetPointer() != other.program.GetPointer() || layout != other.layout)
+      return false;
+
+    for (int i = 0; i < 2; ++i)
+    {
+      if (texture[i].GetPointer() != other.texture[i].GetPointer() ||
+          uwrap[i] != other.uwrap[i] ||
+          vwrap[i] != other.vwrap[i] ||
+          min_filter[i] != other.min_filter[i] ||
+          mag_filter[i] != other.mag_filter[i])
+      {
+        return false;
+      }
+
+      if (layout == LAYOUT_TEXCOORD_TEXCOORD && color[i] != other.color[i])
+        return false;
+    }
+
+    return std::memcmp(mvp_matrix.m, other.mvp_matrix.m, sizeof(mvp_matrix.m)) == 0;
+  }
+
+  bool QuadBatcher::State::operator != (State const& other) const
+  {
+    return !(*this == other);
+  }
+
+  QuadBatcher::QuadBatcher(GraphicsEngine& graphics_engine)
+    : graphics_engine_(graphics_engine)
+    , num_quads_(0)
+    , index_buffer_quads_(0)
+    , stats_quads_(0)
+    , stats_draw_calls_(0)
+  {
+    vertices_.resize(MAX_QUADS_PER_BATCH * QUAD_FLOAT_COUNT);
+  }
+
+  QuadBatcher::~QuadBatcher()
+  {
+  }
+
+  void QuadBatcher::SetState(State const& state)
+  {
+    if (num_quads_ && state_ != state)
+      Flush();
+
+    if (num_quads_ == 0)
+      state_ = state;
+  }
+
+  float* QuadBatcher::AddQuad()
+  {
+    if (num_quads_ == MAX_QUADS_PER_BATCH)
+    {
+      State state = state_;
+      Flush();
+      state_ = state;
+    }
+
+    return &vertices_[QUAD_FLOAT_COUNT * num_quads_++];
+  }
+
+  bool QuadBatcher::IsEmpty() const
+  {
+    return num_quads_ == 0;
+  }
+
+  void QuadBatcher::Discard()
+  {
+    num_quads_ = 0;
+    state_ = State();
+  }
+
+  void QuadBatcher::ReserveIndexBuffer(int num_quads)
+  {
+    if (index_buffer_.IsValid() && index_buffer_quads_ >= num_quads)
+      return;
+
+    // The index buffer never changes: grow it to the maximum batch size at once.
+    index_buffer_quads_ = MAX_QUADS_PER_BATCH;
+    index_buffer_ = GetGraphicsDisplay()->GetGpuDevice()->CreateIndexBuffer(
+      index_buffer_quads_ * 6 * sizeof(unsigned short), VBO_USAGE_STATIC, INDEX_FORMAT_USHORT);
+
+    std::vector<unsigned short> indices(index_buffer_quads_ * 6);
+    for (int i = 0; i < index_buffer_quads_; ++i)
+    {
+      unsigned short v = i * 4;
+      indices[6 * i + 0] = v;
+      indices[6 * i + 1] = v + 1;
+      indices[6 * i + 2] = v + 2;
+      indices[6 * i + 3] = v;
+      indices[6 * i + 4] = v + 2;
+      indices[6 * i + 5] = v + 3;
+    }
+
+    graphics_engine_.GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, index_buffer_->GetOpenGLID());
+    CHECKGL(glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, indices.size() * sizeof(unsigned short), &indices[0], VBO_USAGE_STATIC));
+    graphics_engine_.GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+  }
+
+  void QuadBatcher::Flush()
+  {
+    if (num_quads_ == 0)
+      return;
+
+    // Take the batch out before touching any OpenGL state. Binding the shader program and
+    // changing render states below would otherwise call back into this function.
+    int num_quads = num_quads_;
+    State state = state_;
+    num_quads_ = 0;
+    state_ = State();
+
+    unsigned int size = num_quads * QUAD_FLOAT_COUNT * sizeof(float);
+
+    if (!vertex_buffer_.IsValid())
+    {
+      vertex_buffer_ = GetGraphicsDisplay()->GetGpuDevice()->CreateVertexBuffer(
+        MAX_QUADS_PER_BATCH * QUAD_FLOAT_COUNT * sizeof(float), VBO_USAGE_STREAM);
+    }
+    ReserveIndexBuffer(num_quads);
+
+    graphics_engine_.GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, vertex_buffer_->GetOpenGLID());
+    // Orphan the storage so the driver doesn't have to wait for the previous batch to be consumed.
+    CHECKGL(glBufferDataARB(GL_ARRAY_BUFFER_ARB, vertex_buffer_->GetSize(), NULL, VBO_USAGE_STREAM));
+    CHECKGL(glBufferSubDataARB(GL_ARRAY_BUFFER_ARB, 0, size, &vertices_[0]));
+    graphics_engine_.GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, index_buffer_->GetOpenGLID());
+
+    ObjectPtr<IOpenGLShaderProgram> ShaderProg = state.program;
+    ShaderProg->Begin();
+
+    NameHandles const& names = GetNameHandles();
+    int VertexLocation = ShaderProg->GetAttributeLocation(names.vertex);
+    int TextureCoord0Location = ShaderProg->GetAttributeLocation(names.tex_coord0);
+    int Attribute2Location = -1;
+
+    if (state.layout == LAYOUT_TEXCOORD_COLOR)
+      Attribute2Location = ShaderProg->GetAttributeLocation(names.vertex_color);
+    else
+      Attribute2Location = ShaderProg->GetAttributeLocation(names.tex_coord1);
+
+    for (int i = 0; i < 2; ++i)
+    {
+      if (!state.texture[i].IsValid())
+        continue;
+
+      // Another texture quad may have changed the sampler states of the texture since the quads of
+      // this batch were added. Apply the ones they were computed with before the texture is bound.
+      state.texture[i]->SetWrap(TexWrapGLMapping(state.uwrap[i]), TexWrapGLMapping(state.vwrap[i]), GL_CLAMP);
+      state.texture[i]->SetFiltering(TexFilterGLMapping(state.min_filter[i]), TexFilterGLMapping(state.mag_filter[i]));
+
+      int TextureObjectLocation = ShaderProg->GetUniformLocation(names.texture_object[i]);
+      graphics_engine_.SetTexture(GL_TEXTURE0 + i, state.texture[i]);
+      if (TextureObjectLocation != -1)
+        ShaderProg->SetUniform1i(TextureObjectLocation, i);
+    }
+
+    if (state.layout == LAYOUT_TEXCOORD_TEXCOORD)
+    {
+      int TextureCoef0Location = ShaderProg->GetUniformLocation(names.color0);
+      int TextureCoef1Location = ShaderProg->GetUniformLocation(names.color1);
+      Color const& color0 = state.color[0];
+      Color const& color1 = state.color[1];
+
+      if (TextureCoef0Location != -1)
+        ShaderProg->SetUniform4f(TextureCoef0Location, color0.red, color0.green, color0.blue, color0.alpha);
+      if (TextureCoef1Location != -1)
+        ShaderProg->SetUniform4f(TextureCoef1Location, color1.red, color1.green, color1.blue, color1.alpha);
+    }
+
+    int VPMatrixLocation = ShaderProg->GetUniformLocation(names.view_projection_matrix);
+    ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (state.mvp_matrix.m));
+
+    int stride = VERTEX_FLOAT_COUNT * sizeof(float);
+
+    graphics_engine_.GetRenderStates().EnableVertexAttribArray(VertexLocation);
+    CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, stride, NUX_BUFFER_OFFSET(0)));
+
+    if (TextureCoord0Location != -1)
+    {
+      graphics_engine_.GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
+      CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, stride, NUX_BUFFER_OFFSET(4 * sizeof(float))));
+    }
+
+    if (Attribute2Location != -1)
+    {
+      graphics_engine_.GetRenderStates().EnableVertexAttribArray(Attribute2Location);
+      CHECKGL(glVertexAttribPointerARB((GLuint) Attribute2Location, 4, GL_FLOAT, GL_FALSE, stride, NUX_BUFFER_OFFSET(8 * sizeof(float))));
+    }
+
+    CHECKGL(glDrawElements(GL_TRIANGLES, num_quads * 6, GL_UNSIGNED_SHORT, NUX_BUFFER_OFFSET(0)));
+
+    graphics_engine_.GetRenderStates().DisableVertexAttribArray(VertexLocation);
+
+    if (TextureCoord0Location != -1)
+      graphics_engine_.GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
+
+    if (Attribute2Location != -1)
+      graphics_engine_.GetRenderStates().DisableVertexAttribArray(Attribute2Location);
+
+    // The non batched QRP functions source their vertices from client memory.
+    graphics_engine_.GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    graphics_engine_.GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+
+    ShaderProg->End();
+
+    stats_quads_ += num_quads;
+    stats_draw_calls_++;
+  }
+
+  int QuadBatcher::GetQuadCount() const
+  {
+    return stats_quads_;
+  }
+
+  int QuadBatcher::GetDrawCallCount() const
+  {
+    return stats_draw_calls_;
+  }
+
+  void QuadBatcher::ResetStats()
+  {
+    stats_quads_ = 0;
+    stats_draw_calls_ = 0;
+  }
+}
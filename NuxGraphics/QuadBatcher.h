@@ -0,0 +1,136 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#ifndef QUADBATCHER_H
+#define QUADBATCHER_H
+
+#include <vector>
+
+#include "NuxCore/Math/Matrix4.h"
+#include "NuxCore/Color.h"
+#include "RenderingPipe.h"
+
+namespace nux
+{
+  class GraphicsEngine;
+  class IOpenGLBaseTexture;
+  class IOpenGLShaderProgram;
+  class IOpenGLVertexBuffer;
+  class IOpenGLIndexBuffer;
+
+  //! Accumulates screen aligned quads that are rendered with the same states.
+  /*!
+      The QRP_GLSL_* functions that only differ from one call to the next by their vertex data push their
+      quads into the batcher instead of issuing a draw call each. Consecutive quads sharing the same shader
+      program, textures, sampler states, uniforms and model view projection matrix are streamed into a single
+      vertex buffer and rendered with one indexed draw call.
+
+      The batch is flushed when a quad with different states is added, when a render state is about to change,
+      when any shader program is bound, when the frame buffer changes and when the frame ends. Code that issues
+      raw OpenGL commands in between calls to the QRP functions must call GraphicsEngine::FlushQuadBatch first.
+  */
+  class QuadBatcher
+  {
+  public:
+    //! Number of floats per vertex: position, texture coordinate 0 and a color or texture coordinate 1.
+    static const int VERTEX_FLOAT_COUNT = 12;
+    //! Number of floats per quad.
+    static const int QUAD_FLOAT_COUNT = 4 * VERTEX_FLOAT_COUNT;
+
+    //! Meaning of the third attribute of a vertex.
+    enum VertexLayout
+    {
+      LAYOUT_TEXCOORD_COLOR,    //!< AVertex, MyTextureCoord0, VertexColor.
+      LAYOUT_TEXCOORD_TEXCOORD, //!< AVertex, MyTextureCoord0, MyTextureCoord1. The colors are uniforms.
+    };
+
+    //! The states shared by all the quads of a batch.
+    class State
+    {
+    public:
+      State();
+
+      void SetTexture(int index, ObjectPtr<IOpenGLBaseTexture> const& texture, TexCoordXForm const& texxform);
+      bool operator == (State const& other) const;
+      bool operator != (State const& other) const;
+
+      ObjectPtr<IOpenGLShaderProgram> program;
+      VertexLayout layout;
+      ObjectPtr<IOpenGLBaseTexture> texture[2];
+      //! Sampler states of the textures. They are applied to the texture objects when the batch is rendered.
+      TexWrap uwrap[2];
+      TexWrap vwrap[2];
+      TexFilter min_filter[2];
+      TexFilter mag_filter[2];
+      //! Uniform colors, used with LAYOUT_TEXCOORD_TEXCOORD only.
+      Color color[2];
+      Matrix4 mvp_matrix;
+    };
+
+    QuadBatcher(GraphicsEngine& graphics_engine);
+    ~QuadBatcher();
+
+    //! Make the batch use the provided states.
+    /*!
+        If the pending quads were added with different states they are rendered first.
+        The sampler states must be the ones returned by QRP_Compute_Texture_Coord.
+    */
+    void SetState(State const& state);
+
+    //! Reserve a quad in the current batch.
+    /*!
+        @return A pointer to the QUAD_FLOAT_COUNT floats that describe the four vertices of the quad, in
+        the same order as the GL_TRIANGLE_FAN used by the non batched QRP functions.
+    */
+    float* AddQuad();
+
+    //! Render the pending quads.
+    void Flush();
+
+    //! Release the pending quads and their references to the textures, without rendering them.
+    void Discard();
+
+    bool IsEmpty() const;
+
+    int GetQuadCount() const;
+    int GetDrawCallCount() const;
+    void ResetStats();
+
+  private:
+    QuadBatcher(QuadBatcher const&);
+    QuadBatcher& operator = (QuadBatcher const&);
+
+    void ReserveIndexBuffer(int num_quads);
+
+    GraphicsEngine& graphics_engine_;
+    State state_;
+    std::vector<float> vertices_;
+    int num_quads_;
+
+    ObjectPtr<IOpenGLVertexBuffer> vertex_buffer_;
+    ObjectPtr<IOpenGLIndexBuffer> index_buffer_;
+    int index_buffer_quads_;
+
+    int stats_quads_;
+    int stats_draw_calls_;
+  };
+}
+
+#endif // QUADBATCHER_H
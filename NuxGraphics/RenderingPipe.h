@@ -139,6 +139,11 @@ namespace nux
   */
   void QRP_Compute_Texture_Coord(int quad_width, int quad_height, ObjectPtr<IOpenGLBaseTexture> tex, TexCoordXForm &texxform);
 
+  //! Return the OpenGL wrap mode that corresponds to a TexWrap.
+  GLenum TexWrapGLMapping(TexWrap tex_wrap_mode);
+  //! Return the OpenGL filtering mode that corresponds to a TexFilter.
+  GLenum TexFilterGLMapping(TexFilter tex_filter_mode);
+
 }
 
 #endif // RENDERINGPIPE_H
@@ -573,8 +573,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, c3.red, c3.green, c3.blue, c3.alpha,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_AsmColor;
 
@@ -591,21 +591,21 @@ namespace nux
     int VertexLocation          = VTXATTRIB_POSITION;
     int VertexColorLocation     = VTXATTRIB_COLOR;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     shader_program->End();
   }
@@ -625,8 +625,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform.u1, texxform.v0, 0, 1.0f, color.red, color.green, color.blue, color.alpha,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_AsmTextureModColor;
     if (device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -649,30 +649,30 @@ namespace nux
     int TextureCoord0Location   = VTXATTRIB_TEXCOORD0;
     int VertexColorLocation     = VTXATTRIB_COLOR;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     shader_program->End();
   }
@@ -694,8 +694,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform.u1, texxform.v0, 0, 1.0f, color.red, color.green, color.blue, color.alpha,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_AsmColorModTexMaskAlpha;
     if (device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -718,30 +718,30 @@ namespace nux
     int TextureCoord0Location   = VTXATTRIB_TEXCOORD0;
     int VertexColorLocation     = VTXATTRIB_COLOR;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     shader_program->End();
   }
@@ -765,8 +765,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform0.u1, texxform0.v0, 0.0f, 1.0f, texxform1.u1, texxform1.v0, 0.0f, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_Asm2TextureAdd;
     if (device_texture0->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -792,30 +792,30 @@ namespace nux
     CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 0, color0.red, color0.green, color0.blue, color0.alpha ));
     CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 1, color1.red, color1.green, color1.blue, color1.alpha ));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (TextureCoord1Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
 
     shader_program->End();
   }
@@ -840,8 +840,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform0.u1, texxform0.v0, 0.0f, 1.0f, texxform1.u1, texxform1.v0, 0.0f, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_ASM2TextureDepRead;
     if (src_device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -867,30 +867,30 @@ namespace nux
     CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 0, c0.red, c0.green, c0.blue, c0.alpha ));
     CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 1, c1.red, c1.green, c1.blue, c1.alpha ));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (TextureCoord1Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
 
     shader_program->End();
   }
@@ -914,8 +914,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform0.u1, texxform0.v0, 0.0f, 1.0f, texxform1.u1, texxform1.v0, 0.0f, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_Asm2TextureMod;
     if (device_texture0->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -941,30 +941,30 @@ namespace nux
     CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 0, color0.red, color0.green, color0.blue, color0.alpha ));
     CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 1, color1.red, color1.green, color1.blue, color1.alpha ));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (TextureCoord1Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
 
     shader_program->End();
   }
@@ -992,8 +992,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform0.u1, texxform0.v0, 0, 1.0f, texxform1.u1, texxform1.v0, 0, 1.0f, texxform2.u1, texxform2.v0, 0, 1.0f, texxform3.u1, texxform3.v0, 0, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_Asm4TextureAdd;
     if (device_texture0->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -1025,48 +1025,48 @@ namespace nux
     CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 2, color2.red, color2.green, color2.blue, color2.alpha ));
     CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 3, color3.red, color3.green, color3.blue, color3.alpha ));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer + 4));
     }
 
     if (TextureCoord1Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer + 8));
     }
 
     if (TextureCoord2Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord2Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord2Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord2Location, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer + 12));
     }
 
     if (TextureCoord3Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord3Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord3Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord3Location, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer + 16));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
 
     if (TextureCoord2Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord2Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord2Location);
 
     if (TextureCoord3Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord3Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord3Location);
 
     shader_program->End();
   }
@@ -1094,8 +1094,8 @@ namespace nux
       static_cast<float>(x2), static_cast<float>(y2), 0.0f, 1.0f, c2.red, c2.green, c2.blue, c2.alpha,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> ShaderProg = m_AsmColor;
 
@@ -1111,16 +1111,16 @@ namespace nux
     int VertexLocation          = VTXATTRIB_POSITION;
     int VertexColorLocation     = VTXATTRIB_COLOR;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
 
     CHECKGL(glDrawArrays(GL_TRIANGLES, 0, 3));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
-    CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
+    GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
     ShaderProg->End();
 
     m_triangle_stats++;
@@ -1149,8 +1149,8 @@ namespace nux
     ObjectPtr<IOpenGLAsmShaderProgram> ShaderProg = m_AsmColor;
 
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     CHECKGL(glMatrixMode(GL_MODELVIEW));
@@ -1163,21 +1163,21 @@ namespace nux
     int VertexLocation          = VTXATTRIB_POSITION;
     int VertexColorLocation     = VTXATTRIB_COLOR;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_LINES, 0, 2));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();
 
@@ -1204,8 +1204,8 @@ namespace nux
 
     ObjectPtr<IOpenGLAsmShaderProgram> ShaderProg = m_AsmColor;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     CHECKGL(glMatrixMode(GL_MODELVIEW));
@@ -1218,21 +1218,21 @@ namespace nux
     int VertexLocation          = VTXATTRIB_POSITION;
     int VertexColorLocation     = VTXATTRIB_COLOR;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_LINE_STRIP, 0, 5));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();
 
@@ -1290,8 +1290,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform.u1, texxform.v0, 0, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = _asm_tex_component_exponentiation_prog;
     if (device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -1316,21 +1316,21 @@ namespace nux
     int VertexLocation          = VTXATTRIB_POSITION;
     int TextureCoord0Location   = VTXATTRIB_TEXCOORD0;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     shader_program->End();
   }
@@ -1382,8 +1382,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform.u1, texxform.v0, 0, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = _asm_tex_alpha_replicate_prog;
     if (device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -1407,21 +1407,21 @@ namespace nux
     int VertexLocation          = VTXATTRIB_POSITION;
     int TextureCoord0Location   = VTXATTRIB_TEXCOORD0;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     shader_program->End();
   }
@@ -1505,8 +1505,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform.u1, texxform.v0, 0, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = _asm_tex_color_matrix_filter_prog;
     if (device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -1535,21 +1535,21 @@ namespace nux
     int VertexLocation          = VTXATTRIB_POSITION;
     int TextureCoord0Location   = VTXATTRIB_TEXCOORD0;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     shader_program->End();
   }
@@ -1684,8 +1684,8 @@ namespace nux
       texxform.u1 + 3.0f * delta, texxform.v0, 0, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = _asm_tex_separable_gauss_filter_prog;
     if (device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -1725,18 +1725,18 @@ namespace nux
     int TextureCoord5Location   = VTXATTRIB_TEXCOORD5;
     int TextureCoord6Location   = VTXATTRIB_TEXCOORD6;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 128, VtxBuffer));
 
     //if(TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord2Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord3Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord4Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord5Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord6Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord2Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord3Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord4Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord5Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord6Location);
 
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 128, VtxBuffer + 4));
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 128, VtxBuffer + 8));
@@ -1749,22 +1749,22 @@ namespace nux
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
     if (TextureCoord2Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord2Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord2Location);
     if (TextureCoord3Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord3Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord3Location);
     if (TextureCoord4Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord4Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord4Location);
     if (TextureCoord5Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord5Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord5Location);
     if (TextureCoord6Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord6Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord6Location);
 
     shader_program->End();
   }
@@ -1815,8 +1815,8 @@ namespace nux
       texxform.u1, texxform.v0 + 3.0f * delta, 0, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = _asm_tex_separable_gauss_filter_prog;
     if (device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -1856,18 +1856,18 @@ namespace nux
     int TextureCoord5Location   = VTXATTRIB_TEXCOORD5;
     int TextureCoord6Location   = VTXATTRIB_TEXCOORD6;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 128, VtxBuffer));
 
     //if(TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord2Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord3Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord4Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord5Location));
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord6Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord2Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord3Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord4Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord5Location);
+      GetRenderStates().EnableVertexAttribArray(TextureCoord6Location);
 
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 128, VtxBuffer + 4));
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 128, VtxBuffer + 8));
@@ -1880,22 +1880,22 @@ namespace nux
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
     if (TextureCoord2Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord2Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord2Location);
     if (TextureCoord3Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord3Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord3Location);
     if (TextureCoord4Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord4Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord4Location);
     if (TextureCoord5Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord5Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord5Location);
     if (TextureCoord6Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord6Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord6Location);
 
     shader_program->End();
   }
@@ -2342,8 +2342,8 @@ namespace nux
     float tex_width = device_texture->GetWidth();
     float tex_height = device_texture->GetHeight();
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     bool rectangle_texture = false;
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_AsmPixelate;
@@ -2378,30 +2378,30 @@ namespace nux
       CHECKGL(glProgramLocalParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 1, 1.0f/pixel_size, 1.0f/pixel_size, 1.0f, 1.0f));
     }
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     shader_program->End();
   }
@@ -2566,8 +2566,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform.u1, texxform.v0, 0, 1.0f, color.red, color.green, color.blue, color.alpha,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ObjectPtr<IOpenGLAsmShaderProgram> shader_program = m_AsmTexturePremultiplyModColor;
     if (device_texture->Type().IsDerivedFromType(IOpenGLRectangleTexture::StaticObjectType))
@@ -2590,30 +2590,30 @@ namespace nux
     int TextureCoord0Location   = VTXATTRIB_TEXCOORD0;
     int VertexColorLocation     = VTXATTRIB_COLOR;
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     shader_program->End();
   }
@@ -31,6 +31,56 @@
 
 namespace nux
 {
+  int GraphicsEngine::WarmUpShaderPrograms(int max_programs)
+  {
+    if (!UsingGLSLCodePath())
+      return 0;
+
+    struct WarmUpProgram
+    {
+      ObjectPtr<IOpenGLShaderProgram> GraphicsEngine::*program;
+      void (GraphicsEngine::*init)();
+    };
+
+    // In the order of their likely use.
+    static const WarmUpProgram programs[] =
+    {
+      {&GraphicsEngine::m_SlColor, &GraphicsEngine::InitSlColorShader},
+      {&GraphicsEngine::m_SlTextureModColor, &GraphicsEngine::InitSlTextureShader},
+      {&GraphicsEngine::m_SlColorModTexMaskAlpha, &GraphicsEngine::InitSlColorModTexMaskAlpha},
+      {&GraphicsEngine::m_SlTexturePremultiplyModColor, &GraphicsEngine::InitSlTexturePremultiplyShader},
+      {&GraphicsEngine::m_Sl2TextureAdd, &GraphicsEngine::InitSl2TextureAdd},
+      {&GraphicsEngine::m_Sl2TextureMod, &GraphicsEngine::InitSl2TextureMod},
+      {&GraphicsEngine::m_Sl2TextureDepRead, &GraphicsEngine::InitSl2TextureDepRead},
+      {&GraphicsEngine::m_Sl4TextureAdd, &GraphicsEngine::InitSl4TextureAdd},
+      {&GraphicsEngine::_horizontal_gauss_filter_prog, &GraphicsEngine::InitSLHorizontalGaussFilter},
+      {&GraphicsEngine::_vertical_gauss_filter_prog, &GraphicsEngine::InitSLVerticalGaussFilter},
+      {&GraphicsEngine::_component_exponentiation_prog, &GraphicsEngine::InitSLPower},
+      {&GraphicsEngine::_alpha_replicate_prog, &GraphicsEngine::InitSLAlphaReplicate},
+      {&GraphicsEngine::_color_matrix_filter_prog, &GraphicsEngine::InitSLColorMatrixFilter},
+      {&GraphicsEngine::desaturation_prog_, &GraphicsEngine::InitSLDesaturation},
+      {&GraphicsEngine::m_SLPixelate, &GraphicsEngine::InitSlPixelateShader},
+    };
+
+    int left = 0;
+    for (auto const& warm_up : programs)
+    {
+      if ((this->*warm_up.program).IsValid())
+        continue;
+
+      if (max_programs != 0)
+      {
+        (this->*warm_up.init)();
+        --max_programs;
+        continue;
+      }
+
+      ++left;
+    }
+
+    return left;
+  }
+
   void GraphicsEngine::InitSlColorShader()
   {
     ObjectPtr<IOpenGLVertexShader> VS = _graphics_display.m_DeviceFactory->CreateVertexShader();
@@ -819,8 +869,26 @@ namespace nux
 
     ObjectPtr<IOpenGLShaderProgram> ShaderProg = m_SlColor;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    if (quad_batching_enabled_)
+    {
+      QuadBatcher::State state;
+      state.program = ShaderProg;
+      state.mvp_matrix = GetOpenGLModelViewProjectionMatrix();
+      quad_batcher_->SetState(state);
+
+      float* quad = quad_batcher_->AddQuad();
+      for (int i = 0; i < 4; ++i)
+      {
+        float* vertex = quad + i * QuadBatcher::VERTEX_FLOAT_COUNT;
+        Memcpy(vertex, VtxBuffer + 8 * i, 4 * sizeof(float));
+        vertex[4] = vertex[5] = vertex[6] = vertex[7] = 0.0f;
+        Memcpy(vertex + 8, VtxBuffer + 8 * i + 4, 4 * sizeof(float));
+      }
+      return;
+    }
+
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int VertexLocation = ShaderProg->GetAttributeLocation("AVertex");
@@ -830,21 +898,21 @@ namespace nux
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();
   }
@@ -878,8 +946,19 @@ namespace nux
 //         ShaderProg = m_TexturedRectProg;
 //     }
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    if (quad_batching_enabled_ && ShaderProg.IsValid())
+    {
+      QuadBatcher::State state;
+      state.program = ShaderProg;
+      state.SetTexture(0, DeviceTexture, texxform0);
+      state.mvp_matrix = GetOpenGLModelViewProjectionMatrix();
+      quad_batcher_->SetState(state);
+      Memcpy(quad_batcher_->AddQuad(), VtxBuffer, sizeof(VtxBuffer));
+      return;
+    }
+
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -888,36 +967,36 @@ namespace nux
     int VertexColorLocation = ShaderProg->GetAttributeLocation("VertexColor");
 
     SetTexture(GL_TEXTURE0, DeviceTexture);
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();
   }
@@ -953,8 +1032,19 @@ namespace nux
       ShaderProg = m_SlColorModTexRectMaskAlpha;
     }
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    if (quad_batching_enabled_ && ShaderProg.IsValid())
+    {
+      QuadBatcher::State state;
+      state.program = ShaderProg;
+      state.SetTexture(0, DeviceTexture, texxform);
+      state.mvp_matrix = GetOpenGLModelViewProjectionMatrix();
+      quad_batcher_->SetState(state);
+      Memcpy(quad_batcher_->AddQuad(), VtxBuffer, sizeof(VtxBuffer));
+      return;
+    }
+
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -966,7 +1056,7 @@ namespace nux
 
     if (TextureObjectLocation != -1)
     {
-      CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+      ShaderProg->SetUniform1i(TextureObjectLocation, 0);
     }
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
@@ -975,35 +1065,35 @@ namespace nux
 
     if (VertexLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
     }
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArray(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointer((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
     if (VertexLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
     }
 
     ShaderProg->End();
@@ -1032,8 +1122,23 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform0.u1, texxform0.v0, 0.0f, 1.0f, texxform1.u1, texxform1.v0, 0.0f, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    if (quad_batching_enabled_)
+    {
+      QuadBatcher::State state;
+      state.program = ShaderProg;
+      state.layout = QuadBatcher::LAYOUT_TEXCOORD_TEXCOORD;
+      state.SetTexture(0, DeviceTexture0, texxform0);
+      state.SetTexture(1, DeviceTexture1, texxform1);
+      state.color[0] = color0;
+      state.color[1] = color1;
+      state.mvp_matrix = GetOpenGLModelViewProjectionMatrix();
+      quad_batcher_->SetState(state);
+      Memcpy(quad_batcher_->AddQuad(), VtxBuffer, sizeof(VtxBuffer));
+      return;
+    }
+
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation0 = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1049,40 +1154,40 @@ namespace nux
     SetTexture(GL_TEXTURE0, DeviceTexture0);
     SetTexture(GL_TEXTURE1, DeviceTexture1);
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation0, 0));
-    CHECKGL(glUniform1iARB(TextureObjectLocation1, 1));
+    ShaderProg->SetUniform1i(TextureObjectLocation0, 0);
+    ShaderProg->SetUniform1i(TextureObjectLocation1, 1);
 
-    CHECKGL(glUniform4fARB(TextureCoef0Location, color0.red, color0.green, color0.blue, color0.alpha ));
-    CHECKGL(glUniform4fARB(TextureCoef1Location, color1.red, color1.green, color1.blue, color1.alpha ));
+    ShaderProg->SetUniform4f(TextureCoef0Location, color0.red, color0.green, color0.blue, color0.alpha);
+    ShaderProg->SetUniform4f(TextureCoef1Location, color1.red, color1.green, color1.blue, color1.alpha);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (TextureCoord1Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
 
     ShaderProg->End();
   }
@@ -1109,8 +1214,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform0.u1, texxform0.v0, 0.0f, 1.0f, texxform1.u1, texxform1.v0, 0.0f, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation0 = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1126,40 +1231,40 @@ namespace nux
     SetTexture(GL_TEXTURE0, distorsion_texture);
     SetTexture(GL_TEXTURE1, src_device_texture);
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation0, 0));
-    CHECKGL(glUniform1iARB(TextureObjectLocation1, 1));
+    ShaderProg->SetUniform1i(TextureObjectLocation0, 0);
+    ShaderProg->SetUniform1i(TextureObjectLocation1, 1);
 
-    CHECKGL(glUniform4fARB(TextureCoef0Location, c0.red, c0.green, c0.blue, c0.alpha ));
-    CHECKGL(glUniform4fARB(TextureCoef1Location, c1.red, c1.green, c1.blue, c1.alpha ));
+    ShaderProg->SetUniform4f(TextureCoef0Location, c0.red, c0.green, c0.blue, c0.alpha);
+    ShaderProg->SetUniform4f(TextureCoef1Location, c1.red, c1.green, c1.blue, c1.alpha);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (TextureCoord1Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
 
     ShaderProg->End();
   }
@@ -1188,8 +1293,23 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform0.u1, texxform0.v0, 0.0f, 1.0f, texxform1.u1, texxform1.v0, 0.0f, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    if (quad_batching_enabled_)
+    {
+      QuadBatcher::State state;
+      state.program = ShaderProg;
+      state.layout = QuadBatcher::LAYOUT_TEXCOORD_TEXCOORD;
+      state.SetTexture(0, DeviceTexture0, texxform0);
+      state.SetTexture(1, DeviceTexture1, texxform1);
+      state.color[0] = color0;
+      state.color[1] = color1;
+      state.mvp_matrix = GetOpenGLModelViewProjectionMatrix();
+      quad_batcher_->SetState(state);
+      Memcpy(quad_batcher_->AddQuad(), VtxBuffer, sizeof(VtxBuffer));
+      return;
+    }
+
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation0 = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1205,40 +1325,40 @@ namespace nux
     SetTexture(GL_TEXTURE0, DeviceTexture0);
     SetTexture(GL_TEXTURE1, DeviceTexture1);
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation0, 0));
-    CHECKGL(glUniform1iARB(TextureObjectLocation1, 1));
+    ShaderProg->SetUniform1i(TextureObjectLocation0, 0);
+    ShaderProg->SetUniform1i(TextureObjectLocation1, 1);
 
-    CHECKGL(glUniform4fARB(TextureCoef0Location, color0.red, color0.green, color0.blue, color0.alpha ));
-    CHECKGL(glUniform4fARB(TextureCoef1Location, color1.red, color1.green, color1.blue, color1.alpha ));
+    ShaderProg->SetUniform4f(TextureCoef0Location, color0.red, color0.green, color0.blue, color0.alpha);
+    ShaderProg->SetUniform4f(TextureCoef1Location, color1.red, color1.green, color1.blue, color1.alpha);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (TextureCoord1Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
 
     ShaderProg->End();
   }
@@ -1269,8 +1389,8 @@ namespace nux
       fx + width,  fy,          0.0f, 1.0f, texxform0.u1, texxform0.v0, 0, 1.0f, texxform1.u1, texxform1.v0, 0, 1.0f, texxform2.u1, texxform2.v0, 0, 1.0f, texxform3.u1, texxform3.v0, 0, 1.0f,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation0 = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1293,62 +1413,62 @@ namespace nux
     SetTexture(GL_TEXTURE2, DeviceTexture2);
     SetTexture(GL_TEXTURE3, DeviceTexture3);
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation0, 0));
-    CHECKGL(glUniform1iARB(TextureObjectLocation1, 1));
-    CHECKGL(glUniform1iARB(TextureObjectLocation2, 2));
-    CHECKGL(glUniform1iARB(TextureObjectLocation3, 3));
+    ShaderProg->SetUniform1i(TextureObjectLocation0, 0);
+    ShaderProg->SetUniform1i(TextureObjectLocation1, 1);
+    ShaderProg->SetUniform1i(TextureObjectLocation2, 2);
+    ShaderProg->SetUniform1i(TextureObjectLocation3, 3);
 
-    CHECKGL(glUniform4fARB(TextureCoef0Location, color0.red, color0.green, color0.blue, color0.alpha ));
-    CHECKGL(glUniform4fARB(TextureCoef1Location, color1.red, color1.green, color1.blue, color1.alpha ));
-    CHECKGL(glUniform4fARB(TextureCoef2Location, color2.red, color2.green, color2.blue, color2.alpha ));
-    CHECKGL(glUniform4fARB(TextureCoef3Location, color3.red, color3.green, color3.blue, color3.alpha ));
+    ShaderProg->SetUniform4f(TextureCoef0Location, color0.red, color0.green, color0.blue, color0.alpha);
+    ShaderProg->SetUniform4f(TextureCoef1Location, color1.red, color1.green, color1.blue, color1.alpha);
+    ShaderProg->SetUniform4f(TextureCoef2Location, color2.red, color2.green, color2.blue, color2.alpha);
+    ShaderProg->SetUniform4f(TextureCoef3Location, color3.red, color3.green, color3.blue, color3.alpha);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer + 4));
     }
 
     if (TextureCoord1Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord1Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord1Location, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer + 8));
     }
 
     if (TextureCoord2Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord2Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord2Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord2Location, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer + 12));
     }
 
     if (TextureCoord3Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord3Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord3Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord3Location, 4, GL_FLOAT, GL_FALSE, 80, VtxBuffer + 16));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (TextureCoord1Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord1Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord1Location);
 
     if (TextureCoord2Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord2Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord2Location);
 
     if (TextureCoord3Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord3Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord3Location);
 
     ShaderProg->End();
   }
@@ -1376,8 +1496,8 @@ namespace nux
       static_cast<float>(x2), static_cast<float>(y2), 0.0f, 1.0f, c2.red, c2.green, c2.blue, c2.alpha,
     };
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     m_SlColor->Begin();
 
@@ -1388,16 +1508,16 @@ namespace nux
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     m_SlColor->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
 
     CHECKGL(glDrawArrays(GL_TRIANGLES, 0, 3));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
-    CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
+    GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
     m_SlColor->End();
 
     m_triangle_stats++;
@@ -1427,8 +1547,8 @@ namespace nux
     ObjectPtr<IOpenGLShaderProgram> ShaderProg = m_SlColor;
 
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1437,36 +1557,36 @@ namespace nux
     int VertexColorLocation = ShaderProg->GetAttributeLocation("VertexColor");
 
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_LINES, 0, 2));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();
 
@@ -1495,8 +1615,8 @@ namespace nux
     ObjectPtr<IOpenGLShaderProgram> ShaderProg = m_SlColor;
 
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1505,36 +1625,36 @@ namespace nux
     int VertexColorLocation = ShaderProg->GetAttributeLocation("VertexColor");
 
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_LINE_STRIP, 0, 5));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();
 
@@ -1566,8 +1686,8 @@ namespace nux
 
     ShaderProg = _component_exponentiation_prog;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation   = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1579,31 +1699,31 @@ namespace nux
 
     SetTexture(GL_TEXTURE0, device_texture);
     
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
-    CHECKGL(glUniform4fARB(ExponentLocation, exponent.x, exponent.y, exponent.z, exponent.w ));
+    ShaderProg->SetUniform4f(ExponentLocation, exponent.x, exponent.y, exponent.z, exponent.w);
 
-    CHECKGL(glUniform4fARB(Color0Location, c0.red, c0.green, c0.blue, c0.alpha));
+    ShaderProg->SetUniform4f(Color0Location, c0.red, c0.green, c0.blue, c0.alpha);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix =  GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     ShaderProg->End();
   }
@@ -1633,8 +1753,8 @@ namespace nux
 
     ShaderProg = _alpha_replicate_prog;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1645,29 +1765,29 @@ namespace nux
 
     SetTexture(GL_TEXTURE0, device_texture);
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
-    CHECKGL(glUniform4fARB(Color0Location, c0.red, c0.green, c0.blue, c0.alpha));
+    ShaderProg->SetUniform4f(Color0Location, c0.red, c0.green, c0.blue, c0.alpha);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     ShaderProg->End();
   }
@@ -1760,8 +1880,8 @@ namespace nux
 
     ShaderProg = _horizontal_gauss_filter_prog;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
     ShaderProg->Begin();
 
@@ -1772,37 +1892,37 @@ namespace nux
     int TextureCoord0Location = ShaderProg->GetAttributeLocation("MyTextureCoord0");
 
     SetTexture(GL_TEXTURE0, device_texture);
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
     sigma = Clamp <float> (sigma, 0.1f, 9.0f);
     // Set the Gaussian weights
     {
       float *W;
       GaussianWeights(&W, sigma, 7);
-      CHECKGL(glUniform1fv(WeightsLocation, 7, W));
+      ShaderProg->SetUniform1fv(WeightsLocation, 7, W);
       delete[] W;
     }
 
-    CHECKGL(glUniform2fARB(TextureSizeLocation, width, height));
+    ShaderProg->SetUniform2f(TextureSizeLocation, width, height);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     ShaderProg->End();
   }
@@ -1894,8 +2014,8 @@ namespace nux
 
     ShaderProg = _vertical_gauss_filter_prog;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1907,38 +2027,38 @@ namespace nux
 
     SetTexture(GL_TEXTURE0, device_texture);
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     sigma = Clamp <float> (sigma, 0.1f, 9.0f);
     // Set the Gaussian weights
     {
       float *W;
       GaussianWeights(&W, sigma, 7);
-      CHECKGL(glUniform1fv(WeightsLocation, 7, W));
+      ShaderProg->SetUniform1fv(WeightsLocation, 7, W);
       delete[] W;
     }
 
-    CHECKGL(glUniform2fARB(TextureSizeLocation, width, height));
+    ShaderProg->SetUniform2f(TextureSizeLocation, width, height);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     ShaderProg->End();
   }
@@ -1972,8 +2092,8 @@ namespace nux
 
     ShaderProg = _horizontal_hq_gauss_filter_prog[k-1];
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -1983,38 +2103,38 @@ namespace nux
     int TextureCoord0Location = ShaderProg->GetAttributeLocation("MyTextureCoord0");
 
     SetTexture(GL_TEXTURE0, device_texture);
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     sigma = Clamp <float> (sigma, 0.1f, NUX_MAX_GAUSSIAN_SIGMA);
     // Set the Gaussian weights
     {
       float *W;
       GaussianWeights(&W, sigma, 6*k+1);
-      CHECKGL(glUniform1fv(WeightsLocation, 6*k+1, W));
+      ShaderProg->SetUniform1fv(WeightsLocation, 6*k+1, W);
       delete[] W;
     }
 
-    CHECKGL(glUniform2fARB(TextureSizeLocation, width, height));
+    ShaderProg->SetUniform2f(TextureSizeLocation, width, height);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     ShaderProg->End();
   }
@@ -2048,8 +2168,8 @@ namespace nux
 
     ShaderProg = _vertical_hq_gauss_filter_prog[k-1];
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -2061,38 +2181,38 @@ namespace nux
 
     SetTexture(GL_TEXTURE0, device_texture);
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     sigma = Clamp <float> (sigma, 0.1f, NUX_MAX_GAUSSIAN_SIGMA);
     // Set the Gaussian weights
     {
       float *W;
       GaussianWeights(&W, sigma, 6*k+1);
-      CHECKGL(glUniform1fv(WeightsLocation, 6*k+1, W));
+      ShaderProg->SetUniform1fv(WeightsLocation, 6*k+1, W);
       delete[] W;
     }
 
-    CHECKGL(glUniform2fARB(TextureSizeLocation, width, height));
+    ShaderProg->SetUniform2f(TextureSizeLocation, width, height);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     ShaderProg->End();
   }
@@ -2129,8 +2249,8 @@ namespace nux
 
     shader_prog = _horizontal_ls_gauss_filter_prog[num_samples-1];
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     shader_prog->Begin();
 
     int tex_object_location = shader_prog->GetUniformLocationARB("tex_object");
@@ -2139,7 +2259,7 @@ namespace nux
     int tex_coord_location  = shader_prog->GetAttributeLocation("tex_coord");
 
     SetTexture(GL_TEXTURE0, device_texture);
-    CHECKGL(glUniform1iARB(tex_object_location, 0));
+    shader_prog->SetUniform1i(tex_object_location, 0);
 
     std::vector<float> taps;
     for (int i = 0; i < num_samples; ++i)
@@ -2147,27 +2267,27 @@ namespace nux
       taps.push_back(offsets[i] /= width);
       taps.push_back(weights[i]);
     }
-    CHECKGL(glUniform2fv(taps_location, taps.size(), &taps[0]));
+    shader_prog->SetUniform2fv(taps_location, taps.size() / 2, &taps[0]);
 
     int     VPMatrixLocation = shader_prog->GetUniformLocationARB("view_projection_matrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     shader_prog->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(vertex_location));
+    GetRenderStates().EnableVertexAttribArray(vertex_location);
     CHECKGL(glVertexAttribPointerARB((GLuint) vertex_location, 4, GL_FLOAT, GL_FALSE, 32, vtx_buffer));
 
     if (tex_coord_location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(tex_coord_location));
+      GetRenderStates().EnableVertexAttribArray(tex_coord_location);
       CHECKGL(glVertexAttribPointerARB((GLuint) tex_coord_location, 4, GL_FLOAT, GL_FALSE, 32, vtx_buffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(vertex_location));
+    GetRenderStates().DisableVertexAttribArray(vertex_location);
 
     if (tex_coord_location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(tex_coord_location));
+      GetRenderStates().DisableVertexAttribArray(tex_coord_location);
 
     shader_prog->End();
   }
@@ -2204,8 +2324,8 @@ namespace nux
 
     shader_prog = _vertical_ls_gauss_filter_prog[num_samples-1];
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     shader_prog->Begin();
 
     int tex_object_location     = shader_prog->GetUniformLocationARB("tex_object");
@@ -2215,7 +2335,7 @@ namespace nux
 
     SetTexture(GL_TEXTURE0, device_texture);
 
-    CHECKGL(glUniform1iARB(tex_object_location, 0));
+    shader_prog->SetUniform1i(tex_object_location, 0);
 
     std::vector<float> taps;
     for (int i = 0; i < num_samples; ++i)
@@ -2223,27 +2343,27 @@ namespace nux
       taps.push_back(offsets[i] /= height);
       taps.push_back(weights[i]);
     }
-    CHECKGL(glUniform2fv(taps_location, taps.size(), &taps[0]));
+    shader_prog->SetUniform2fv(taps_location, taps.size() / 2, &taps[0]);
 
     int     VPMatrixLocation = shader_prog->GetUniformLocationARB("view_projection_matrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     shader_prog->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(vertex_location));
+    GetRenderStates().EnableVertexAttribArray(vertex_location);
     CHECKGL(glVertexAttribPointerARB((GLuint) vertex_location, 4, GL_FLOAT, GL_FALSE, 32, vtx_buffer));
 
     if (tex_coord_location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(tex_coord_location));
+      GetRenderStates().EnableVertexAttribArray(tex_coord_location);
       CHECKGL(glVertexAttribPointerARB((GLuint) tex_coord_location, 4, GL_FLOAT, GL_FALSE, 32, vtx_buffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(vertex_location));
+    GetRenderStates().DisableVertexAttribArray(vertex_location);
 
     if (tex_coord_location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(tex_coord_location));
+      GetRenderStates().DisableVertexAttribArray(tex_coord_location);
 
     shader_prog->End();
   }
@@ -2276,8 +2396,8 @@ namespace nux
 
     ShaderProg = _color_matrix_filter_prog;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -2292,39 +2412,39 @@ namespace nux
 
     SetTexture(GL_TEXTURE0, device_texture);
 
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
-    CHECKGL(glUniform4fARB(Color0Location, c0.red, c0.green, c0.blue, c0.alpha));
+    ShaderProg->SetUniform4f(Color0Location, c0.red, c0.green, c0.blue, c0.alpha);
 
     float v[5];
     v[0] = color_matrix.m[0][0]; v[1] = color_matrix.m[0][1]; v[2] = color_matrix.m[0][2]; v[3] = color_matrix.m[0][3]; v[4] = offset.x;
-    CHECKGL(glUniform1fvARB(MatrixRow0Location, 5, v));
+    ShaderProg->SetUniform1fv(MatrixRow0Location, 5, v);
     v[0] = color_matrix.m[1][0]; v[1] = color_matrix.m[1][1]; v[2] = color_matrix.m[1][2]; v[3] = color_matrix.m[1][3]; v[4] = offset.y;
-    CHECKGL(glUniform1fvARB(MatrixRow1Location, 5, v));
+    ShaderProg->SetUniform1fv(MatrixRow1Location, 5, v);
     v[0] = color_matrix.m[2][0]; v[1] = color_matrix.m[2][1]; v[2] = color_matrix.m[2][2]; v[3] = color_matrix.m[2][3]; v[4] = offset.z;
-    CHECKGL(glUniform1fvARB(MatrixRow2Location, 5, v));
+    ShaderProg->SetUniform1fv(MatrixRow2Location, 5, v);
     v[0] = color_matrix.m[3][0]; v[1] = color_matrix.m[3][1]; v[2] = color_matrix.m[3][2]; v[3] = color_matrix.m[3][3]; v[4] = offset.w;
-    CHECKGL(glUniform1fvARB(MatrixRow3Location, 5, v));
+    ShaderProg->SetUniform1fv(MatrixRow3Location, 5, v);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 32, VtxBuffer + 4));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     ShaderProg->End();
   }
@@ -3045,8 +3165,8 @@ namespace nux
     ObjectPtr<IOpenGLShaderProgram> ShaderProg;
     ShaderProg = m_SLPixelate;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -3057,7 +3177,7 @@ namespace nux
     int VertexColorLocation = ShaderProg->GetAttributeLocation("VertexColor");
 
     SetTexture(GL_TEXTURE0, DeviceTexture);
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
@@ -3066,30 +3186,30 @@ namespace nux
     ShaderProg->SetUniform4f((GLint) PixelSizeLocation, (float)pixel_size / (float)tex_width, (float)pixel_size / (float)tex_height, 1.0f, 1.0f);
     ShaderProg->SetUniform4f((GLint) PixelSizeInvLocation, (float)tex_width / (float)pixel_size, (float)tex_height / (float)pixel_size, 1.0f, 1.0f);
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();
   }
@@ -3259,8 +3379,8 @@ namespace nux
 
     ObjectPtr<IOpenGLShaderProgram> ShaderProg = m_SlTexturePremultiplyModColor;
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -3269,36 +3389,36 @@ namespace nux
     int VertexColorLocation = ShaderProg->GetAttributeLocation("i_vertex_color");
 
     SetTexture(GL_TEXTURE0, DeviceTexture);
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();
   }
@@ -3374,8 +3494,8 @@ namespace nux
       ShaderProg = desaturation_prog_;
     }
 
-    CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     ShaderProg->Begin();
 
     int TextureObjectLocation = ShaderProg->GetUniformLocationARB("TextureObject0");
@@ -3386,41 +3506,41 @@ namespace nux
     int VertexColorLocation = ShaderProg->GetAttributeLocation("VertexColor");
 
     SetTexture(GL_TEXTURE0, DeviceTexture);
-    CHECKGL(glUniform1iARB(TextureObjectLocation, 0));
+    ShaderProg->SetUniform1i(TextureObjectLocation, 0);
 
     float luma[3] = {color::LumaRed, color::LumaGreen, color::LumaBlue};
-    CHECKGL(glUniform3fv(luma_location, 3, luma));
+    ShaderProg->SetUniform3fv(luma_location, 1, luma);
 
-    CHECKGL(glUniform1f(desat_factor_location, desaturation_factor));
+    ShaderProg->SetUniform1f(desat_factor_location, desaturation_factor);
 
     int     VPMatrixLocation = ShaderProg->GetUniformLocationARB("ViewProjectionMatrix");
     Matrix4 MVPMatrix = GetOpenGLModelViewProjectionMatrix();
     ShaderProg->SetUniformLocMatrix4fv((GLint) VPMatrixLocation, 1, false, (GLfloat *) & (MVPMatrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().EnableVertexAttribArray(VertexLocation);
     CHECKGL(glVertexAttribPointerARB((GLuint) VertexLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer));
 
     if (TextureCoord0Location != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().EnableVertexAttribArray(TextureCoord0Location);
       CHECKGL(glVertexAttribPointerARB((GLuint) TextureCoord0Location, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 4));
     }
 
     if (VertexColorLocation != -1)
     {
-      CHECKGL(glEnableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().EnableVertexAttribArray(VertexColorLocation);
       CHECKGL(glVertexAttribPointerARB((GLuint) VertexColorLocation, 4, GL_FLOAT, GL_FALSE, 48, VtxBuffer + 8));
     }
 
     CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-    CHECKGL(glDisableVertexAttribArrayARB(VertexLocation));
+    GetRenderStates().DisableVertexAttribArray(VertexLocation);
 
     if (TextureCoord0Location != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(TextureCoord0Location));
+      GetRenderStates().DisableVertexAttribArray(TextureCoord0Location);
 
     if (VertexColorLocation != -1)
-      CHECKGL(glDisableVertexAttribArrayARB(VertexColorLocation));
+      GetRenderStates().DisableVertexAttribArray(VertexColorLocation);
 
     ShaderProg->End();    
   }
@@ -196,8 +196,8 @@ void GraphicsEngine::QRP_GLSL_ColorLayerOverTexture(int x, int y, int width, int
     fx + width,  fy,          0.0f, 1.0f, bkg_texxform.u1, bkg_texxform.v0, 0, 0,
   };
 
-  CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-  CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+  GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+  GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
   ShaderProg->Begin();
 
   int in_vertex_loc         = ShaderProg->GetAttributeLocation("in_vertex");
@@ -207,14 +207,14 @@ void GraphicsEngine::QRP_GLSL_ColorLayerOverTexture(int x, int y, int width, int
   int frg_color_loc         = ShaderProg->GetUniformLocationARB("frg_color");
 
   SetTexture(GL_TEXTURE0, bkg_device_texture);
-  CHECKGL(glUniform1iARB(bkg_texture_loc, 0));
+  ShaderProg->SetUniform1i(bkg_texture_loc, 0);
   if (bkg_color_loc != -1)
   {
-    CHECKGL(glUniform4fARB(bkg_color_loc, bkg_color.red, bkg_color.green, bkg_color.blue, bkg_color.alpha));
+    ShaderProg->SetUniform4f(bkg_color_loc, bkg_color.red, bkg_color.green, bkg_color.blue, bkg_color.alpha);
   }
   if (frg_color_loc != -1)
   {
-    CHECKGL(glUniform4fARB(frg_color_loc, frg_color.red, frg_color.green, frg_color.blue, frg_color.alpha));
+    ShaderProg->SetUniform4f(frg_color_loc, frg_color.red, frg_color.green, frg_color.blue, frg_color.alpha);
   }
 
   int view_projection_matrix_loc = ShaderProg->GetUniformLocationARB("view_projection_matrix");
@@ -223,23 +223,23 @@ void GraphicsEngine::QRP_GLSL_ColorLayerOverTexture(int x, int y, int width, int
 
   if (in_vertex_loc != -1)
   {
-    CHECKGL(glEnableVertexAttribArrayARB(in_vertex_loc));
+    GetRenderStates().EnableVertexAttribArray(in_vertex_loc);
     CHECKGL(glVertexAttribPointerARB((GLuint) in_vertex_loc, 4, GL_FLOAT, GL_FALSE, 32, vtx_buffer));
   }
 
   if (in_bkg_tex_coord_loc != -1)
   {
-    CHECKGL(glEnableVertexAttribArrayARB(in_bkg_tex_coord_loc));
+    GetRenderStates().EnableVertexAttribArray(in_bkg_tex_coord_loc);
     CHECKGL(glVertexAttribPointerARB((GLuint) in_bkg_tex_coord_loc, 4, GL_FLOAT, GL_FALSE, 32, vtx_buffer + 4));
   }
 
   CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
   if (in_vertex_loc != -1)
-    CHECKGL(glDisableVertexAttribArrayARB(in_vertex_loc));
+    GetRenderStates().DisableVertexAttribArray(in_vertex_loc);
 
   if (in_bkg_tex_coord_loc != -1)
-    CHECKGL(glDisableVertexAttribArrayARB(in_bkg_tex_coord_loc));
+    GetRenderStates().DisableVertexAttribArray(in_bkg_tex_coord_loc);
 
   ShaderProg->End();;
 }
@@ -327,8 +327,8 @@ void GraphicsEngine::QRP_GLSL_TextureLayerOverColor(int x, int y, int width, int
     fx + width,  fy,          0.0f, 1.0f, frg_texxform.u1, frg_texxform.v0, 0, 0,
   };
 
-  CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-  CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+  GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+  GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
   ShaderProg->Begin();
 
   int frg_texture_loc       = ShaderProg->GetUniformLocationARB("frg_texture");
@@ -339,7 +339,7 @@ void GraphicsEngine::QRP_GLSL_TextureLayerOverColor(int x, int y, int width, int
   
 
   SetTexture(GL_TEXTURE0, frg_device_texture);
-  CHECKGL(glUniform1iARB(frg_texture_loc, 0));
+  ShaderProg->SetUniform1i(frg_texture_loc, 0);
 
   int view_projection_matrix_loc = ShaderProg->GetUniformLocationARB("view_projection_matrix");
   Matrix4 mvp_matrix = GetOpenGLModelViewProjectionMatrix();
@@ -347,32 +347,32 @@ void GraphicsEngine::QRP_GLSL_TextureLayerOverColor(int x, int y, int width, int
 
   if (in_vertex_loc != -1)
   {
-    CHECKGL(glEnableVertexAttribArrayARB(in_vertex_loc));
+    GetRenderStates().EnableVertexAttribArray(in_vertex_loc);
     CHECKGL(glVertexAttribPointerARB((GLuint) in_vertex_loc, 4, GL_FLOAT, GL_FALSE, 32, vtx_buffer));
   }
 
   if (in_frg_tex_coord_loc != -1)
   {
-    CHECKGL(glEnableVertexAttribArrayARB(in_frg_tex_coord_loc));
+    GetRenderStates().EnableVertexAttribArray(in_frg_tex_coord_loc);
     CHECKGL(glVertexAttribPointerARB((GLuint) in_frg_tex_coord_loc, 4, GL_FLOAT, GL_FALSE, 32, vtx_buffer + 4));
   }
 
   if (frg_color_loc != -1)
   {
-    CHECKGL(glUniform4fARB(frg_color_loc, frg_color.red, frg_color.green, frg_color.blue, frg_color.alpha));
+    ShaderProg->SetUniform4f(frg_color_loc, frg_color.red, frg_color.green, frg_color.blue, frg_color.alpha);
   } 
   if (bkg_color_loc != -1)
   {
-    CHECKGL(glUniform4fARB(bkg_color_loc, bkg_color.red, bkg_color.green, bkg_color.blue, bkg_color.alpha));
+    ShaderProg->SetUniform4f(bkg_color_loc, bkg_color.red, bkg_color.green, bkg_color.blue, bkg_color.alpha);
   }
 
   CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
   if (in_vertex_loc != -1)
-    CHECKGL(glDisableVertexAttribArrayARB(in_vertex_loc));
+    GetRenderStates().DisableVertexAttribArray(in_vertex_loc);
 
   if (in_frg_tex_coord_loc != -1)
-    CHECKGL(glDisableVertexAttribArrayARB(in_frg_tex_coord_loc));
+    GetRenderStates().DisableVertexAttribArray(in_frg_tex_coord_loc);
 
   ShaderProg->End();
 }
@@ -448,8 +448,8 @@ void GraphicsEngine::QRP_GLSL_ColorLayerOverColor(int x, int y, int width, int h
     fx + width,  fy,          0.0f, 1.0f,
   };
 
-  CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-  CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+  GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+  GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
   shader_prog->Begin();
 
   int in_vertex_loc = shader_prog->GetAttributeLocation("in_vertex");
@@ -457,10 +457,10 @@ void GraphicsEngine::QRP_GLSL_ColorLayerOverColor(int x, int y, int width, int h
   int frg_color_loc = shader_prog->GetUniformLocationARB("frg_color");
 
   if (bkg_color_loc != -1)
-    CHECKGL(glUniform4fARB(bkg_color_loc, bkg_color.red, bkg_color.green, bkg_color.blue, bkg_color.alpha));
+    shader_prog->SetUniform4f(bkg_color_loc, bkg_color.red, bkg_color.green, bkg_color.blue, bkg_color.alpha);
 
   if (frg_color_loc != -1)
-    CHECKGL(glUniform4fARB(frg_color_loc, frg_color.red, frg_color.green, frg_color.blue, frg_color.alpha));
+    shader_prog->SetUniform4f(frg_color_loc, frg_color.red, frg_color.green, frg_color.blue, frg_color.alpha);
 
   int view_projection_matrix_loc = shader_prog->GetUniformLocationARB("view_projection_matrix");
   Matrix4 mvp_matrix = GetOpenGLModelViewProjectionMatrix();
@@ -468,14 +468,14 @@ void GraphicsEngine::QRP_GLSL_ColorLayerOverColor(int x, int y, int width, int h
 
   if (in_vertex_loc != -1)
   {
-    CHECKGL(glEnableVertexAttribArrayARB(in_vertex_loc));
+    GetRenderStates().EnableVertexAttribArray(in_vertex_loc);
     CHECKGL(glVertexAttribPointerARB((GLuint)in_vertex_loc, 4, GL_FLOAT, GL_FALSE, 16, vtx_buffer));
   }
 
   CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
   if (in_vertex_loc != -1)
-    CHECKGL(glDisableVertexAttribArrayARB(in_vertex_loc));
+    GetRenderStates().DisableVertexAttribArray(in_vertex_loc);
 
   shader_prog->End();
 }
@@ -567,8 +567,8 @@ void GraphicsEngine::QRP_GLSL_TextureLayerOverTexture(int x, int y, int width, i
     fx + width,  fy,          0.0f, 1.0f, bkg_texxform.u1, bkg_texxform.v0, 0.0f, 1.0f, frg_texxform.u1, frg_texxform.v0, 0.0f, 1.0f,
   };
 
-  CHECKGL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
-  CHECKGL(glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+  GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+  GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
   ShaderProg->Begin();
 
   int bkg_texture_loc = ShaderProg->GetUniformLocationARB("bkg_texture");
@@ -584,40 +584,40 @@ void GraphicsEngine::QRP_GLSL_TextureLayerOverTexture(int x, int y, int width, i
   SetTexture(GL_TEXTURE0, bkg_device_texture);
   SetTexture(GL_TEXTURE1, frg_device_texture);
 
-  CHECKGL(glUniform1iARB(bkg_texture_loc, 0));
-  CHECKGL(glUniform1iARB(frg_texture_loc, 1));
+  ShaderProg->SetUniform1i(bkg_texture_loc, 0);
+  ShaderProg->SetUniform1i(frg_texture_loc, 1);
 
-  CHECKGL(glUniform4fARB(TextureCoef0Location, bkg_color.red, bkg_color.green, bkg_color.blue, bkg_color.alpha ));
-  CHECKGL(glUniform4fARB(TextureCoef1Location, frg_color.red, frg_color.green, frg_color.blue, frg_color.alpha ));
+  ShaderProg->SetUniform4f(TextureCoef0Location, bkg_color.red, bkg_color.green, bkg_color.blue, bkg_color.alpha);
+  ShaderProg->SetUniform4f(TextureCoef1Location, frg_color.red, frg_color.green, frg_color.blue, frg_color.alpha);
 
   int     view_projection_matrix_loc = ShaderProg->GetUniformLocationARB("view_projection_matrix");
   Matrix4 mvp_matrix = GetOpenGLModelViewProjectionMatrix();
   ShaderProg->SetUniformLocMatrix4fv((GLint) view_projection_matrix_loc, 1, false, (GLfloat*) & (mvp_matrix.m));
 
-  CHECKGL(glEnableVertexAttribArrayARB(in_vertex_loc));
+  GetRenderStates().EnableVertexAttribArray(in_vertex_loc);
   CHECKGL(glVertexAttribPointerARB((GLuint) in_vertex_loc, 4, GL_FLOAT, GL_FALSE, 48, vtx_buffer));
 
   if (in_bkg_tex_coord_loc != -1)
   {
-    CHECKGL(glEnableVertexAttribArrayARB(in_bkg_tex_coord_loc));
+    GetRenderStates().EnableVertexAttribArray(in_bkg_tex_coord_loc);
     CHECKGL(glVertexAttribPointerARB((GLuint) in_bkg_tex_coord_loc, 4, GL_FLOAT, GL_FALSE, 48, vtx_buffer + 4));
   }
 
   if (in_frg_tex_coord_loc != -1)
   {
-    CHECKGL(glEnableVertexAttribArrayARB(in_frg_tex_coord_loc));
+    GetRenderStates().EnableVertexAttribArray(in_frg_tex_coord_loc);
     CHECKGL(glVertexAttribPointerARB((GLuint) in_frg_tex_coord_loc, 4, GL_FLOAT, GL_FALSE, 48, vtx_buffer + 8));
   }
 
   CHECKGL(glDrawArrays(GL_TRIANGLE_FAN, 0, 4));
 
-  CHECKGL(glDisableVertexAttribArrayARB(in_vertex_loc));
+  GetRenderStates().DisableVertexAttribArray(in_vertex_loc);
 
   if (in_bkg_tex_coord_loc != -1)
-    CHECKGL(glDisableVertexAttribArrayARB(in_bkg_tex_coord_loc));
+    GetRenderStates().DisableVertexAttribArray(in_bkg_tex_coord_loc);
 
   if (in_frg_tex_coord_loc != -1)
-    CHECKGL(glDisableVertexAttribArrayARB(in_frg_tex_coord_loc));
+    GetRenderStates().DisableVertexAttribArray(in_frg_tex_coord_loc);
 
   ShaderProg->End();
 }
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include "NuxCore/NuxCore.h"
+#include "GLResource.h"
+#include "GpuDevice.h"
+#include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "ShaderProgramCache.h"
+
+#include <cstring>
+#include <glib.h>
+
+namespace nux
+{
+  namespace
+  {
+    const char FILE_MAGIC[8] = {'N', 'U', 'X', 'S', 'H', 'B', 'I', 'N'};
+
+    struct FileHeader
+    {
+      char magic[8];
+      unsigned int key_size;
+      unsigned int binary_format;
+      unsigned int binary_size;
+    };
+
+    // 64 bits FNV-1a.
+    unsigned long long HashString(std::string const& str)
+    {
+      unsigned long long hash = 14695981039346656037ULL;
+      for (std::string::const_iterator it = str.begin(); it != str.end(); ++it)
+      {
+        hash ^= static_cast<unsigned char>(*it);
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    std::string GetGLString(GLenum name)
+    {
+      const char* str = reinterpret_cast<const char*>(glGetString(name));
+      return str ? str : "";
+    }
+  }
+
+  ShaderProgramCache::Stats::Stats()
+    : hits(0)
+    , misses(0)
+    , rejects(0)
+    , stores(0)
+  {
+  }
+
+  ShaderProgramCache::ShaderProgramCache(GpuInfo const& gpu_info)
+    : supported_(false)
+    , enabled_(true)
+  {
+#ifndef NUX_OPENGLES_20
+    if (gpu_info.Support_ARB_Get_Program_Binary())
+    {
+      GLint num_formats = 0;
+      CHECKGL(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats));
+      supported_ = num_formats > 0;
+    }
+#else
+    (void) gpu_info;
+#endif
+
+    driver_ = GetGLString(GL_VENDOR) + "\n" + GetGLString(GL_RENDERER) + "\n" + GetGLString(GL_VERSION) + "\n";
+
+    const char* directory = g_getenv("NUX_SHADER_CACHE_DIR");
+    if (directory)
+    {
+      directory_ = directory;
+    }
+    else
+    {
+      char* default_directory = g_build_filename(g_get_user_cache_dir(), "nux", "shaders", NULL);
+      directory_ = default_directory;
+      g_free(default_directory);
+    }
+
+    if (g_getenv("NUX_DISABLE_SHADER_CACHE"))
+      enabled_ = false;
+  }
+
+  void ShaderProgramCache::SetEnabled(bool enabled)
+  {
+    enabled_ = enabled;
+  }
+
+  bool ShaderProgramCache::IsEnabled() const
+  {
+    return enabled_ && supported_;
+  }
+
+  void ShaderProgramCache::SetDirectory(std::string const& directory)
+  {
+    directory_ = directory;
+  }
+
+  std::string const& ShaderProgramCache::GetDirectory() const
+  {
+    return directory_;
+  }
+
+  ShaderProgramCache::Stats const& ShaderProgramCache::GetStats() const
+  {
+    return stats_;
+  }
+
+  std::string ShaderProgramCache::GetFileName(std::string const& key) const
+  {
+    // Different drivers don't share the files, the cache of a system with two GPUs is not overwritten.
+    char name[32];
+    g_snprintf(name, sizeof(name), "%016llx.bin", HashString(driver_ + key));
+
+    char* file_name = g_build_filename(directory_.c_str(), name, NULL);
+    std::string result(file_name);
+    g_free(file_name);
+    return result;
+  }
+
+  bool ShaderProgramCache::Load(unsigned int program, std::string const& key)
+  {
+    if (!IsEnabled())
+      return false;
+
+    gchar* contents = NULL;
+    gsize length = 0;
+
+    if (!g_file_get_contents(GetFileName(key).c_str(), &contents, &length, NULL))
+    {
+      ++stats_.misses;
+      return false;
+    }
+
+    std::string full_key = driver_ + key;
+    bool linked = false;
+    FileHeader header;
+
+    if (length >= sizeof(header))
+    {
+      memcpy(&header, contents, sizeof(header));
+
+      if (memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 &&
+          header.key_size == full_key.size() &&
+          length == sizeof(header) + header.key_size + header.binary_size &&
+          full_key.compare(0, full_key.size(), contents + sizeof(header), header.key_size) == 0)
+      {
+#ifndef NUX_OPENGLES_20
+        CHECKGL(glProgramBinary(program, header.binary_format, contents + sizeof(header) + header.key_size, header.binary_size));
+
+        GLint status = GL_FALSE;
+        CHECKGL(glGetProgramiv(program, GL_LINK_STATUS, &status));
+        linked = (status == GL_TRUE);
+#endif
+      }
+    }
+
+    g_free(contents);
+
+    if (linked)
+      ++stats_.hits;
+    else
+      ++stats_.rejects;
+
+    return linked;
+  }
+
+  void ShaderProgramCache::Store(unsigned int program, std::string const& key)
+  {
+    if (!IsEnabled())
+      return;
+
+#ifndef NUX_OPENGLES_20
+    GLint binary_size = 0;
+    CHECKGL(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size));
+    if (binary_size <= 0)
+      return;
+
+    std::string full_key = driver_ + key;
+    std::vector<char> contents(sizeof(FileHeader) + full_key.size() + binary_size);
+
+    FileHeader header;
+    memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.key_size = full_key.size();
+    header.binary_size = binary_size;
+
+    GLenum binary_format = 0;
+    GLsizei length = 0;
+    CHECKGL(glGetProgramBinary(program, binary_size, &length, &binary_format, &contents[sizeof(header) + full_key.size()]));
+    if (length != binary_size)
+      return;
+
+    header.binary_format = binary_format;
+    memcpy(&contents[0], &header, sizeof(header));
+    memcpy(&contents[sizeof(header)], full_key.data(), full_key.size());
+
+    // The file is replaced atomically, concurrent processes never read a partial binary.
+    if (g_mkdir_with_parents(directory_.c_str(), 0700) != 0 ||
+        !g_file_set_contents(GetFileName(key).c_str(), &contents[0], contents.size(), NULL))
+    {
+      nuxDebugMsg("[ShaderProgramCache::Store] Failed to write a shader binary in %s.", directory_.c_str());
+      return;
+    }
+
+    ++stats_.stores;
+#endif
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#ifndef SHADERPROGRAMCACHE_H
+#define SHADERPROGRAMCACHE_H
+
+#include <string>
+
+namespace nux
+{
+  class GpuInfo;
+
+  //! Stores the binaries of the linked shader programs on disk (GL_ARB_get_program_binary).
+  /*!
+      IOpenGLShaderProgram::Link looks for a binary of the program before it compiles the shaders. The binaries
+      are keyed by the sources of the shaders and by the driver: its vendor, renderer and version strings. A
+      binary that does not match the key, or that the driver refuses, is discarded and the program is compiled
+      from its sources, then stored again.
+
+      The binaries are stored in $XDG_CACHE_HOME/nux/shaders, or in the directory set by the
+      NUX_SHADER_CACHE_DIR environment variable. The cache can be turned off by setting the
+      NUX_DISABLE_SHADER_CACHE environment variable.
+  */
+  class ShaderProgramCache
+  {
+  public:
+    struct Stats
+    {
+      Stats();
+
+      int hits;     //!< Programs loaded from a binary.
+      int misses;   //!< Programs without a binary.
+      int rejects;  //!< Binaries that did not match their key or that the driver refused.
+      int stores;   //!< Binaries written.
+    };
+
+    ShaderProgramCache(GpuInfo const& gpu_info);
+
+    void SetEnabled(bool enabled);
+    //! Return true if the cache is enabled and supported by the driver.
+    bool IsEnabled() const;
+
+    void SetDirectory(std::string const& directory);
+    std::string const& GetDirectory() const;
+
+    //! Load the binary of a program.
+    /*!
+        @param program The OpenGL program object.
+        @param key The sources of the shaders of the program.
+        @return True if the program is linked from the binary.
+    */
+    bool Load(unsigned int program, std::string const& key);
+
+    //! Store the binary of a linked program.
+    /*!
+        The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+    */
+    void Store(unsigned int program, std::string const& key);
+
+    Stats const& GetStats() const;
+
+  private:
+    ShaderProgramCache(ShaderProgramCache const&);
+    ShaderProgramCache& operator = (ShaderProgramCache const&);
+
+    std::string GetFileName(std::string const& key) const;
+
+    bool supported_;
+    bool enabled_;
+    std::string directory_;
+    std::string driver_;
+    Stats stats_;
+  };
+}
+
+#endif // SHADERPROGRAMCACHE_H
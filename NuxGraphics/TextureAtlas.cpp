@@ -0,0 +1,451 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#include "NuxCore/NuxCore.h"
+#include "GLResource.h"
+#include "GpuDevice.h"
+#include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "RenderingPipe.h"
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <cstring>
+
+namespace nux
+{
+  AtlasAllocator::AtlasAllocator(int width, int height)
+    : width_(width)
+    , height_(height)
+    , shelves_height_(0)
+    , used_area_(0)
+    , allocations_(0)
+  {
+  }
+
+  bool AtlasAllocator::Allocate(int width, int height, Geometry& rect)
+  {
+    if (width <= 0 || height <= 0 || width > width_ || height > height_)
+      return false;
+
+    Shelf* best_shelf = NULL;
+    size_t best_span = 0;
+
+    for (auto& shelf : shelves_)
+    {
+      if (shelf.height < height || (best_shelf && shelf.height >= best_shelf->height))
+        continue;
+
+      for (size_t i = 0; i < shelf.free_spans.size(); ++i)
+      {
+        if (shelf.free_spans[i].width >= width)
+        {
+          best_shelf = &shelf;
+          best_span = i;
+          break;
+        }
+      }
+    }
+
+    // Open a new shelf if the best one wastes too much height.
+    if ((!best_shelf || best_shelf->height > 2 * height) && shelves_height_ + height <= height_)
+    {
+      Shelf shelf;
+      shelf.y = shelves_height_;
+      shelf.height = height;
+      shelf.allocations = 0;
+      Span span = {0, width_};
+      shelf.free_spans.push_back(span);
+
+      shelves_.push_back(shelf);
+      shelves_height_ += height;
+
+      best_shelf = &shelves_.back();
+      best_span = 0;
+    }
+
+    if (!best_shelf)
+      return false;
+
+    Span& span = best_shelf->free_spans[best_span];
+    rect = Geometry(span.x, best_shelf->y, width, height);
+
+    span.x += width;
+    span.width -= width;
+
+    if (span.width == 0)
+      best_shelf->free_spans.erase(best_shelf->free_spans.begin() + best_span);
+
+    ++best_shelf->allocations;
+    ++allocations_;
+    used_area_ += width * height;
+
+    return true;
+  }
+
+  void AtlasAllocator::Free(Geometry const& rect)
+  {
+    auto shelf = std::find_if(shelves_.begin(), shelves_.end(), [&rect] (Shelf const& s) { return s.y == rect.y; });
+
+    nuxAssert(shelf != shelves_.end());
+    if (shelf == shelves_.end())
+      return;
+
+    std::vector<Span>& spans = shelf->free_spans;
+    auto next = std::find_if(spans.begin(), spans.end(), [&rect] (Span const& s) { return s.x > rect.x; });
+
+    Span span = {rect.x, rect.width};
+    auto it = spans.insert(next, span);
+
+    // Merge with the following span.
+    if ((it + 1) != spans.end() && it->x + it->width == (it + 1)->x)
+    {
+      it->width += (it + 1)->width;
+      spans.erase(it + 1);
+    }
+
+    // Merge with the previous span.
+    if (it != spans.begin() && (it - 1)->x + (it - 1)->width == it->x)
+    {
+      (it - 1)->width += it->width;
+      spans.erase(it);
+    }
+
+    --shelf->allocations;
+    --allocations_;
+    used_area_ -= rect.width * rect.height;
+
+    // Close the empty shelves at the bottom so their height can be reused by taller rectangles.
+    while (!shelves_.empty() && shelves_.back().allocations == 0)
+    {
+      shelves_height_ -= shelves_.back().height;
+      shelves_.pop_back();
+    }
+  }
+
+  void AtlasAllocator::Clear()
+  {
+    shelves_.clear();
+    shelves_height_ = 0;
+    used_area_ = 0;
+    allocations_ = 0;
+  }
+
+  int AtlasAllocator::GetWidth() const
+  {
+    return width_;
+  }
+
+  int AtlasAllocator::GetHeight() const
+  {
+    return height_;
+  }
+
+  int AtlasAllocator::GetUsedArea() const
+  {
+    return used_area_;
+  }
+
+  int AtlasAllocator::GetAllocationCount() const
+  {
+    return allocations_;
+  }
+
+  const TextureAtlas::Handle TextureAtlas::INVALID_HANDLE;
+  const int TextureAtlas::REGION_PADDING;
+
+  TextureAtlas::Stats::Stats()
+    : pages(0)
+    , regions(0)
+    , used_area(0)
+    , page_area(0)
+    , evictions(0)
+    , defragmentations(0)
+  {
+  }
+
+  float TextureAtlas::Stats::GetOccupancy() const
+  {
+    return page_area ? float(used_area) / float(page_area) : 0.0f;
+  }
+
+  TextureAtlas::Page::Page(int size)
+    : allocator(size, size)
+  {
+  }
+
+  TextureAtlas::TextureAtlas(int page_size, BitmapFormat format, int max_pages)
+    : page_size_(page_size)
+    , format_(format)
+    , max_pages_(max_pages)
+    , bytes_per_pixel_(GPixelFormats[format].BlockBytes)
+    , next_handle_(0)
+    , use_clock_(0)
+    , evictions_(0)
+    , defragmentations_(0)
+  {
+    nuxAssertMsg(GPixelFormats[format].BlockSizeX == 1, "[TextureAtlas::TextureAtlas] Compressed formats are not supported.");
+  }
+
+  TextureAtlas::~TextureAtlas()
+  {
+  }
+
+  int TextureAtlas::GetMaxRegionSize() const
+  {
+    // Larger textures would leave too little room to the others.
+    return page_size_ / 4;
+  }
+
+  TextureAtlas::Handle TextureAtlas::Add(int width, int height, const unsigned char* data, int pitch, bool evictable)
+  {
+    if (width <= 0 || height <= 0 || width > GetMaxRegionSize() || height > GetMaxRegionSize() || !data)
+      return INVALID_HANDLE;
+
+    Region region;
+    region.page = -1;
+    region.width = width;
+    region.height = height;
+    region.evictable = evictable;
+    region.last_use = ++use_clock_;
+
+    int row_size = width * bytes_per_pixel_;
+    region.pixels.resize(row_size * height);
+
+    for (int y = 0; y < height; ++y)
+      std::memcpy(&region.pixels[y * row_size], data + y * pitch, row_size);
+
+    if (!Place(region))
+      return INVALID_HANDLE;
+
+    Upload(region);
+
+    Handle handle = next_handle_++;
+    regions_[handle] = std::move(region);
+    return handle;
+  }
+
+  void TextureAtlas::Remove(Handle handle)
+  {
+    auto it = regions_.find(handle);
+
+    if (it == regions_.end())
+      return;
+
+    pages_[it->second.page].allocator.Free(it->second.rect);
+    regions_.erase(it);
+  }
+
+  bool TextureAtlas::Contains(Handle handle) const
+  {
+    return regions_.find(handle) != regions_.end();
+  }
+
+  ObjectPtr<IOpenGLTexture2D> TextureAtlas::GetTexture(Handle handle) const
+  {
+    auto it = regions_.find(handle);
+
+    if (it == regions_.end())
+      return ObjectPtr<IOpenGLTexture2D>();
+
+    return pages_[it->second.page].texture;
+  }
+
+  Geometry TextureAtlas::GetRect(Handle handle) const
+  {
+    auto it = regions_.find(handle);
+
+    if (it == regions_.end())
+      return Geometry(0, 0, 0, 0);
+
+    Region const& region = it->second;
+    return Geometry(region.rect.x + REGION_PADDING, region.rect.y + REGION_PADDING, region.width, region.height);
+  }
+
+  void TextureAtlas::SetTexCoords(Handle handle, TexCoordXForm& texxform) const
+  {
+    Geometry rect = GetRect(handle);
+
+    texxform.SetTexCoordType(TexCoordXForm::NORMALIZED_COORD);
+    texxform.u0 = float(rect.x) / page_size_;
+    texxform.v0 = float(rect.y) / page_size_;
+    texxform.u1 = float(rect.x + rect.width) / page_size_;
+    texxform.v1 = float(rect.y + rect.height) / page_size_;
+  }
+
+  void TextureAtlas::Touch(Handle handle)
+  {
+    auto it = regions_.find(handle);
+
+    if (it != regions_.end())
+      it->second.last_use = ++use_clock_;
+  }
+
+  bool TextureAtlas::PlaceInPages(Region& region)
+  {
+    int width = region.width + 2 * REGION_PADDING;
+    int height = region.height + 2 * REGION_PADDING;
+
+    for (size_t i = 0; i < pages_.size(); ++i)
+    {
+      if (pages_[i].allocator.Allocate(width, height, region.rect))
+      {
+        region.page = i;
+        return true;
+      }
+    }
+
+    if ((int) pages_.size() >= max_pages_)
+      return false;
+
+    Page page(page_size_);
+    page.texture = GetGraphicsDisplay()->GetGpuDevice()->CreateTexture(page_size_, page_size_, 1, format_, NUX_TRACKER_LOCATION);
+
+    if (!page.texture.IsValid() || !page.allocator.Allocate(width, height, region.rect))
+      return false;
+
+    pages_.push_back(page);
+    region.page = pages_.size() - 1;
+    return true;
+  }
+
+  bool TextureAtlas::Place(Region& region)
+  {
+    while (!PlaceInPages(region))
+    {
+      if (!EvictLeastRecentlyUsed())
+        return false;
+    }
+
+    return true;
+  }
+
+  bool TextureAtlas::EvictLeastRecentlyUsed()
+  {
+    auto victim = regions_.end();
+
+    for (auto it = regions_.begin(); it != regions_.end(); ++it)
+    {
+      if (it->second.evictable && (victim == regions_.end() || it->second.last_use < victim->second.last_use))
+        victim = it;
+    }
+
+    if (victim == regions_.end())
+      return false;
+
+    Handle handle = victim->first;
+    Remove(handle);
+    ++evictions_;
+    region_evicted.emit(handle);
+
+    return true;
+  }
+
+  void TextureAtlas::Upload(Region const& region)
+  {
+    ObjectPtr<IOpenGLTexture2D> const& texture = pages_[region.page].texture;
+
+    SURFACE_RECT rect;
+    rect.left = region.rect.x;
+    rect.top = region.rect.y;
+    rect.right = region.rect.x + region.rect.width;
+    rect.bottom = region.rect.y + region.rect.height;
+
+    SURFACE_LOCKED_RECT lock_rect;
+    if (texture->LockRect(0, &lock_rect, &rect) != OGL_OK)
+      return;
+
+    // The padding is cleared, the pixels are copied inside it.
+    unsigned char* dest = static_cast<unsigned char*>(lock_rect.pBits);
+    int row_size = region.width * bytes_per_pixel_;
+
+    for (int y = 0; y < region.rect.height; ++y)
+    {
+      unsigned char* dest_row = dest + y * lock_rect.Pitch;
+      std::memset(dest_row, 0, region.rect.width * bytes_per_pixel_);
+
+      if (y >= REGION_PADDING && y < REGION_PADDING + region.height)
+      {
+        std::memcpy(dest_row + REGION_PADDING * bytes_per_pixel_,
+                    &region.pixels[(y - REGION_PADDING) * row_size],
+                    row_size);
+      }
+    }
+
+    texture->UnlockRect(0);
+  }
+
+  void TextureAtlas::Defragment()
+  {
+    // Place the tallest regions first so the shelves are filled with regions of similar heights.
+    std::vector<std::pair<Handle, Region*> > regions;
+    for (auto& entry : regions_)
+      regions.push_back(std::make_pair(entry.first, &entry.second));
+
+    std::stable_sort(regions.begin(), regions.end(),
+                     [] (std::pair<Handle, Region*> const& a, std::pair<Handle, Region*> const& b)
+                     { return a.second->height > b.second->height; });
+
+    for (auto& page : pages_)
+      page.allocator.Clear();
+
+    std::vector<Handle> lost_regions;
+    size_t used_pages = 0;
+
+    for (auto const& entry : regions)
+    {
+      Region& region = *entry.second;
+
+      if (!PlaceInPages(region))
+      {
+        lost_regions.push_back(entry.first);
+        continue;
+      }
+
+      used_pages = std::max(used_pages, size_t(region.page + 1));
+      Upload(region);
+    }
+
+    pages_.resize(used_pages, Page(page_size_));
+    ++defragmentations_;
+
+    // Only happens if a page could not be created again.
+    for (auto handle : lost_regions)
+    {
+      regions_.erase(handle);
+      ++evictions_;
+      region_evicted.emit(handle);
+    }
+  }
+
+  TextureAtlas::Stats TextureAtlas::GetStats() const
+  {
+    Stats stats;
+    stats.pages = pages_.size();
+    stats.regions = regions_.size();
+    stats.page_area = stats.pages * page_size_ * page_size_;
+    stats.evictions = evictions_;
+    stats.defragmentations = defragmentations_;
+
+    for (auto const& region : regions_)
+      stats.used_area += region.second.width * region.second.height;
+
+    return stats;
+  }
+}
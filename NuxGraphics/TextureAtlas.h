@@ -0,0 +1,223 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <map>
+#include <vector>
+
+#include "NuxCore/Rect.h"
+#include "BitmapFormats.h"
+
+namespace nux
+{
+  class IOpenGLTexture2D;
+  class TexCoordXForm;
+
+  //! Packs rectangles into a fixed size area.
+  /*!
+      The area is divided in horizontal shelves. A rectangle goes in the shelf that wastes the least height and
+      that has a free span wide enough for it. A new shelf is opened at the bottom of the used area when no
+      existing shelf fits. Freed rectangles give their span back to the shelf, and empty shelves at the bottom
+      of the area are closed.
+  */
+  class AtlasAllocator
+  {
+  public:
+    AtlasAllocator(int width, int height);
+
+    //! Reserve a rectangle.
+    /*!
+        @param width Width of the rectangle.
+        @param height Height of the rectangle.
+        @param rect Receives the position and size of the rectangle.
+        @return True if the rectangle was reserved.
+    */
+    bool Allocate(int width, int height, Geometry& rect);
+
+    //! Release a rectangle returned by Allocate.
+    void Free(Geometry const& rect);
+
+    //! Release all the rectangles.
+    void Clear();
+
+    int GetWidth() const;
+    int GetHeight() const;
+
+    //! Sum of the areas of the reserved rectangles.
+    int GetUsedArea() const;
+
+    //! Number of reserved rectangles.
+    int GetAllocationCount() const;
+
+  private:
+    struct Span
+    {
+      int x;
+      int width;
+    };
+
+    struct Shelf
+    {
+      int y;
+      int height;
+      int allocations;
+      std::vector<Span> free_spans; //!< Sorted by x.
+    };
+
+    int width_;
+    int height_;
+    int shelves_height_; //!< Height of the area covered by the shelves.
+    int used_area_;
+    int allocations_;
+    std::vector<Shelf> shelves_; //!< Sorted by y.
+  };
+
+  //! Groups small textures in a few large textures.
+  /*!
+      Each texture added to the atlas is copied in a region of one of the pages of the atlas. Quads that use
+      regions of the same page can be rendered without changing the texture binding, which lets the quad
+      batcher of the GraphicsEngine merge them.
+
+      The pixels of each region are also kept in system memory. When the atlas is full, the least recently used
+      evictable regions are removed to make room for a new one. Defragment repacks the regions of all the pages
+      and releases the pages that are no longer needed.
+
+      The pages are created with the GpuDevice of the thread that creates the atlas. The atlas must be used from
+      that thread only.
+  */
+  class TextureAtlas
+  {
+  public:
+    typedef int Handle;
+
+    static const Handle INVALID_HANDLE = -1;
+    //! Empty pixels kept around each region so texture filtering does not sample its neighbors.
+    static const int REGION_PADDING = 1;
+
+    struct Stats
+    {
+      Stats();
+
+      //! Fraction of the area of the pages used by the regions.
+      float GetOccupancy() const;
+
+      int pages;
+      int regions;
+      int used_area;
+      int page_area;
+      int evictions;
+      int defragmentations;
+    };
+
+    /*!
+        @param page_size Width and height of the pages.
+        @param format Pixel format of the pages and of the textures added to the atlas.
+        @param max_pages Maximum number of pages.
+    */
+    TextureAtlas(int page_size = 1024, BitmapFormat format = BITFMT_R8G8B8A8, int max_pages = 4);
+    ~TextureAtlas();
+
+    //! Copy a texture in the atlas.
+    /*!
+        @param width Width of the texture. It must not be larger than GetMaxRegionSize.
+        @param height Height of the texture. It must not be larger than GetMaxRegionSize.
+        @param data Pixels of the texture, in the format of the atlas.
+        @param pitch Number of bytes between two rows of pixels in data.
+        @param evictable If true, the region may be removed when the atlas is full.
+        @return The handle of the region, or INVALID_HANDLE if it does not fit in the atlas.
+    */
+    Handle Add(int width, int height, const unsigned char* data, int pitch, bool evictable = false);
+
+    //! Remove a region from the atlas.
+    void Remove(Handle handle);
+
+    //! Return true if the region is in the atlas. Evicted regions are not.
+    bool Contains(Handle handle) const;
+
+    //! Return the texture of the page that holds a region.
+    ObjectPtr<IOpenGLTexture2D> GetTexture(Handle handle) const;
+
+    //! Return the position and size of a region in its page.
+    Geometry GetRect(Handle handle) const;
+
+    //! Set texxform so a quad samples a region only.
+    void SetTexCoords(Handle handle, TexCoordXForm& texxform) const;
+
+    //! Mark a region as used. The least recently used evictable regions are evicted first.
+    void Touch(Handle handle);
+
+    //! Repack all the regions and release the pages that are no longer needed.
+    /*!
+        The regions may move to a different page. Call GetTexture and GetRect again after this call.
+    */
+    void Defragment();
+
+    int GetMaxRegionSize() const;
+    Stats GetStats() const;
+
+    //! Emitted when a region is removed to make room for another one.
+    sigc::signal<void, Handle> region_evicted;
+
+  private:
+    TextureAtlas(TextureAtlas const&);
+    TextureAtlas& operator = (TextureAtlas const&);
+
+    struct Page
+    {
+      Page(int size);
+
+      ObjectPtr<IOpenGLTexture2D> texture;
+      AtlasAllocator allocator;
+    };
+
+    struct Region
+    {
+      int page;
+      Geometry rect;  //!< Allocated rectangle, including the padding.
+      int width;
+      int height;
+      bool evictable;
+      unsigned int last_use;
+      std::vector<unsigned char> pixels;
+    };
+
+    bool Place(Region& region);
+    bool PlaceInPages(Region& region);
+    bool EvictLeastRecentlyUsed();
+    void Upload(Region const& region);
+
+    int page_size_;
+    BitmapFormat format_;
+    int max_pages_;
+    int bytes_per_pixel_;
+
+    std::vector<Page> pages_;
+    std::map<Handle, Region> regions_;
+    Handle next_handle_;
+    unsigned int use_clock_;
+
+    int evictions_;
+    int defragmentations_;
+  };
+}
+
+#endif // TEXTUREATLAS_H
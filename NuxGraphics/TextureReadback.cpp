@@ -0,0 +1,255 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#include "NuxCore/NuxCore.h"
+#include "GLResource.h"
+#include "GpuDevice.h"
+#include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "TextureReadback.h"
+
+namespace nux
+{
+  namespace
+  {
+    void DeleteFence(void* fence)
+    {
+#ifndef NUX_OPENGLES_20
+      if (fence)
+        CHECKGL(glDeleteSync(static_cast<GLsync>(fence)));
+#endif
+    }
+  }
+
+  TextureReadback::Stats::Stats()
+    : reads(0)
+    , completed_reads(0)
+    , waits(0)
+    , buffers(0)
+  {
+  }
+
+  TextureReadback::TextureReadback(int max_buffers)
+    : max_buffers_(std::max(1, max_buffers))
+    , use_pixel_buffers_(false)
+    , use_fences_(false)
+  {
+#ifndef NUX_OPENGLES_20
+    GpuInfo const& gpu_info = GetGraphicsDisplay()->GetGpuDevice()->GetGpuInfo();
+    use_pixel_buffers_ = gpu_info.Support_ARB_Pixel_Buffer_Object();
+    use_fences_ = use_pixel_buffers_ && gpu_info.Support_ARB_Sync();
+#endif
+  }
+
+  TextureReadback::~TextureReadback()
+  {
+    // The callbacks of the pending reads are not called.
+    for (auto const& read : pending_reads_)
+      DeleteFence(read.fence);
+  }
+
+  bool TextureReadback::Read(ObjectPtr<IOpenGLBaseTexture> const& texture, int level, Callback const& callback)
+  {
+    if (texture.IsNull() || level < 0 || level >= texture->GetNumMipLevel())
+      return false;
+
+    ObjectPtr<IOpenGLSurface> surface = texture->GetSurfaceLevel(level);
+    if (surface.IsNull())
+      return false;
+
+    PendingRead read;
+    read.callback = callback;
+    read.width = surface->GetWidth();
+    read.height = surface->GetHeight();
+    read.buffer = -1;
+    read.fence = NULL;
+    read.poll_count = 0;
+    unsigned int size = read.width * read.height * 4;
+
+    // Make room by completing the oldest reads. The buffers of the reads whose callback is running can't be
+    // reused, a read issued by a callback may have to be synchronous.
+    while (use_pixel_buffers_ && GetBusyBufferCount() >= max_buffers_ && !pending_reads_.empty())
+    {
+      PendingRead oldest = std::move(pending_reads_.front());
+      pending_reads_.pop_front();
+      IsComplete(oldest, true);
+      Complete(oldest);
+    }
+
+    if (use_pixel_buffers_ && GetBusyBufferCount() < max_buffers_)
+    {
+#ifndef NUX_OPENGLES_20
+      read.buffer = AcquireBuffer(size);
+      buffers_[read.buffer]->BindPackPixelBufferObject();
+      bool success = surface->ReadSurfaceData(NULL);
+      CHECKGL(glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0));
+
+      if (!success)
+      {
+        busy_buffers_[read.buffer] = false;
+        return false;
+      }
+
+      if (use_fences_)
+        read.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+    }
+    else
+    {
+      read.pixels.resize(size);
+      if (size == 0 || !surface->ReadSurfaceData(&read.pixels[0]))
+        return false;
+    }
+
+    ++stats_.reads;
+    pending_reads_.push_back(std::move(read));
+    return true;
+  }
+
+  void TextureReadback::Poll(bool wait)
+  {
+    for (auto& read : pending_reads_)
+      ++read.poll_count;
+
+    // The callbacks may issue new reads, they are completed by the next call.
+    size_t count = pending_reads_.size();
+    for (size_t i = 0; i < count && IsComplete(pending_reads_.front(), wait); ++i)
+    {
+      PendingRead read = std::move(pending_reads_.front());
+      pending_reads_.pop_front();
+      Complete(read);
+    }
+  }
+
+  int TextureReadback::GetPendingReadCount() const
+  {
+    return pending_reads_.size();
+  }
+
+  TextureReadback::Stats const& TextureReadback::GetStats() const
+  {
+    return stats_;
+  }
+
+  int TextureReadback::GetBusyBufferCount() const
+  {
+    return std::count(busy_buffers_.begin(), busy_buffers_.end(), true);
+  }
+
+  bool TextureReadback::IsComplete(PendingRead& read, bool wait)
+  {
+    if (read.buffer < 0)
+      return true;
+
+#ifndef NUX_OPENGLES_20
+    if (read.fence)
+    {
+      GLsync fence = static_cast<GLsync>(read.fence);
+      GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+      if (result == GL_TIMEOUT_EXPIRED)
+      {
+        if (!wait)
+          return false;
+
+        ++stats_.waits;
+        const GLuint64 one_second = 1000000000;
+        while (result == GL_TIMEOUT_EXPIRED)
+          result = glClientWaitSync(fence, 0, one_second);
+      }
+
+      // If the wait failed, mapping the buffer waits for the copy.
+      return true;
+    }
+#endif
+
+    // Without fences, give the GPU a frame to do the copy.
+    if (read.poll_count >= 2)
+      return true;
+
+    if (wait)
+      ++stats_.waits;
+
+    return wait;
+  }
+
+  void TextureReadback::Complete(PendingRead& read)
+  {
+    ++stats_.completed_reads;
+
+    if (read.buffer < 0)
+    {
+      read.callback(&read.pixels[0], read.width, read.height, read.width * 4);
+      return;
+    }
+
+    DeleteFence(read.fence);
+    read.fence = NULL;
+
+    ObjectPtr<IOpenGLPixelBufferObject> buffer = buffers_[read.buffer];
+    void* pixels = NULL;
+    buffer->Lock(0, read.width * read.height * 4, &pixels);
+
+    // The buffer stays busy during the callback so that the reads it issues do not reuse it.
+    read.callback(static_cast<unsigned char const*>(pixels), read.width, read.height, read.width * 4);
+
+    buffer->Unlock();
+    busy_buffers_[read.buffer] = false;
+  }
+
+  int TextureReadback::AcquireBuffer(unsigned int size)
+  {
+    int index = -1;
+
+    for (int i = 0; i < static_cast<int>(buffers_.size()); ++i)
+    {
+      if (busy_buffers_[i])
+        continue;
+
+      if (buffers_[i]->GetSize() >= size)
+      {
+        index = i;
+        break;
+      }
+
+      if (index < 0)
+        index = i;
+    }
+
+#ifndef NUX_OPENGLES_20
+    if (index < 0 || buffers_[index]->GetSize() < size)
+    {
+      // Add a buffer while there are less than max_buffers_, then grow the free ones.
+      if (static_cast<int>(buffers_.size()) < max_buffers_)
+      {
+        index = buffers_.size();
+        buffers_.push_back(ObjectPtr<IOpenGLPixelBufferObject>());
+        busy_buffers_.push_back(false);
+      }
+
+      buffers_[index] = GetGraphicsDisplay()->GetGpuDevice()->CreatePixelBufferObject(size, VBO_USAGE_STREAM_READ);
+      ++stats_.buffers;
+    }
+#endif
+
+    busy_buffers_[index] = true;
+    return index;
+  }
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+
+#ifndef TEXTUREREADBACK_H
+#define TEXTUREREADBACK_H
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace nux
+{
+  class IOpenGLBaseTexture;
+  class IOpenGLPixelBufferObject;
+
+  //! Reads textures back to system memory without stalling the rendering.
+  /*!
+      Read copies a mip level of a texture into a pixel pack buffer and returns immediately. The GPU does the
+      copy after the rendering commands that were issued before it. Poll hands the pixels of the reads the GPU
+      has completed to their callbacks, in the order of the reads. Call it once per frame.
+
+      The completion of the reads is tracked with fence sync objects (GL_ARB_sync). Without them, a read
+      completes at the second call to Poll after it is issued. Without pixel buffer objects, the texture is
+      read synchronously and the callback is still called by Poll.
+
+      The pixel buffers are reused from one read to the next. At most max_buffers reads are pending: beyond
+      that, Read waits for the oldest one to complete. The readback must be used from the thread of the
+      GpuDevice.
+  */
+  class TextureReadback
+  {
+  public:
+    //! Receives the pixels of a read.
+    /*!
+        The pixels are in RGBA, 8 bits per channel, and are only valid during the call. They are NULL if the
+        pixel buffer could not be mapped.
+    */
+    typedef std::function<void(unsigned char const* pixels, int width, int height, int stride)> Callback;
+
+    struct Stats
+    {
+      Stats();
+
+      int reads;            //!< Reads issued.
+      int completed_reads;  //!< Reads handed to their callback.
+      int waits;            //!< Reads completed by waiting for the GPU, because Poll was asked to or no buffer was free.
+      int buffers;          //!< Pixel buffers allocated.
+    };
+
+    TextureReadback(int max_buffers = 3);
+    ~TextureReadback();
+
+    //! Start reading a mip level of a texture.
+    /*!
+        @return False if the texture can't be read back. The callback is not called then.
+    */
+    bool Read(ObjectPtr<IOpenGLBaseTexture> const& texture, int level, Callback const& callback);
+
+    //! Call the callbacks of the completed reads.
+    /*!
+        @param wait If true, wait for all the pending reads to complete.
+    */
+    void Poll(bool wait = false);
+
+    //! Return the number of reads whose callback has not been called yet.
+    int GetPendingReadCount() const;
+
+    Stats const& GetStats() const;
+
+  private:
+    TextureReadback(TextureReadback const&);
+    TextureReadback& operator = (TextureReadback const&);
+
+    struct PendingRead
+    {
+      Callback callback;
+      int width;
+      int height;
+      int buffer;       //!< Index in buffers_, or -1 if the pixels are in system memory.
+      void* fence;      //!< GLsync of the copy.
+      int poll_count;   //!< Number of calls to Poll since the read was issued.
+      std::vector<unsigned char> pixels;
+    };
+
+    bool IsComplete(PendingRead& read, bool wait);
+    void Complete(PendingRead& read);
+    int AcquireBuffer(unsigned int size);
+    int GetBusyBufferCount() const;
+
+    int max_buffers_;
+    bool use_pixel_buffers_;
+    bool use_fences_;
+    std::vector<ObjectPtr<IOpenGLPixelBufferObject> > buffers_;
+    std::vector<bool> busy_buffers_;
+    std::deque<PendingRead> pending_reads_;
+    Stats stats_;
+  };
+}
+
+#endif // TEXTUREREADBACK_H
@@ -0,0 +1,291 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include "NuxCore/NuxCore.h"
+#include "GLResource.h"
+#include "GpuDevice.h"
+#include "GLDeviceObjects.h"
+#include "GraphicsDisplay.h"
+#include "TextureUploadRing.h"
+
+namespace nux
+{
+  namespace
+  {
+    // Offsets are aligned for the widest pixel formats and the copies of the driver.
+    const int UPLOAD_ALIGNMENT = 64;
+
+    void DeleteFence(void* fence)
+    {
+#ifndef NUX_OPENGLES_20
+      if (fence)
+        CHECKGL(glDeleteSync(static_cast<GLsync>(fence)));
+#endif
+    }
+  }
+
+  TextureUploadRing::Stats::Stats()
+    : uploads(0)
+    , uploaded_bytes(0)
+    , ring_uploads(0)
+    , waits(0)
+    , orphans(0)
+  {
+  }
+
+  TextureUploadRing::TextureUploadRing(GpuInfo const& gpu_info, int size)
+    : size_(0)
+    , segment_size_(0)
+    , supported_(false)
+    , enabled_(true)
+    , use_fences_(false)
+    , use_persistent_mapping_(false)
+    , buffer_(0)
+    , persistent_data_(NULL)
+    , head_(0)
+    , segment_(0)
+    , locked_(false)
+    , fences_(SEGMENT_COUNT, static_cast<void*>(NULL))
+  {
+    // Make the segments a multiple of the alignment.
+    segment_size_ = std::max(UPLOAD_ALIGNMENT, size / SEGMENT_COUNT / UPLOAD_ALIGNMENT * UPLOAD_ALIGNMENT);
+    size_ = segment_size_ * SEGMENT_COUNT;
+
+#ifndef NUX_OPENGLES_20
+    supported_ = gpu_info.Support_ARB_Pixel_Buffer_Object() && gpu_info.Support_ARB_Map_Buffer_Range();
+    use_fences_ = gpu_info.Support_ARB_Sync();
+    use_persistent_mapping_ = use_fences_ && gpu_info.Support_ARB_Buffer_Storage();
+#else
+    (void) gpu_info;
+#endif
+  }
+
+  TextureUploadRing::~TextureUploadRing()
+  {
+    DestroyBuffer();
+  }
+
+  void TextureUploadRing::SetEnabled(bool enabled)
+  {
+    nuxAssert(!locked_);
+    if (!locked_)
+      enabled_ = enabled;
+  }
+
+  bool TextureUploadRing::IsEnabled() const
+  {
+    return enabled_ && supported_;
+  }
+
+  bool TextureUploadRing::IsLocked() const
+  {
+    return locked_;
+  }
+
+  void* TextureUploadRing::Lock(int size, int* offset)
+  {
+    if (!IsEnabled() || locked_ || size <= 0 || size > segment_size_)
+      return NULL;
+
+    if (buffer_ == 0 && !CreateBuffer())
+    {
+      // Don't try again.
+      supported_ = false;
+      return NULL;
+    }
+
+    // An allocation does not straddle two segments, so that the fence of a segment is always inserted after
+    // the updates that read it.
+    int start = (head_ + UPLOAD_ALIGNMENT - 1) / UPLOAD_ALIGNMENT * UPLOAD_ALIGNMENT;
+    if (start + size > (segment_ + 1) * segment_size_)
+    {
+      int next_segment = (segment_ + 1) % SEGMENT_COUNT;
+      EnterSegment(next_segment);
+      start = next_segment * segment_size_;
+    }
+
+    void* data = NULL;
+
+#ifndef NUX_OPENGLES_20
+    if (use_persistent_mapping_)
+    {
+      data = persistent_data_ + start;
+    }
+    else
+    {
+      // The range is not read by the GPU: it was orphaned or its fence has been waited for.
+      CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, buffer_));
+      data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER_ARB, start, size,
+                              GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+      CHECKGL_MSG(glMapBufferRange);
+      CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0));
+    }
+#endif
+
+    if (data == NULL)
+      return NULL;
+
+    head_ = start + size;
+    locked_ = true;
+    *offset = start;
+    ++stats_.ring_uploads;
+    return data;
+  }
+
+  void TextureUploadRing::Unlock()
+  {
+    nuxAssert(locked_);
+    if (!locked_)
+      return;
+
+    locked_ = false;
+
+#ifndef NUX_OPENGLES_20
+    CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, buffer_));
+
+    // The persistent mapping is coherent, the writes are visible to the GPU without a flush.
+    if (!use_persistent_mapping_)
+      CHECKGL(glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB));
+#endif
+  }
+
+  void TextureUploadRing::RecordUpload(int size)
+  {
+    ++stats_.uploads;
+    stats_.uploaded_bytes += size;
+  }
+
+  void TextureUploadRing::ResetStats()
+  {
+    stats_ = Stats();
+  }
+
+  TextureUploadRing::Stats const& TextureUploadRing::GetStats() const
+  {
+    return stats_;
+  }
+
+  bool TextureUploadRing::CreateBuffer()
+  {
+#ifndef NUX_OPENGLES_20
+    CHECKGL(glGenBuffersARB(1, &buffer_));
+    CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, buffer_));
+
+#ifdef GL_ARB_buffer_storage
+    if (use_persistent_mapping_)
+    {
+      GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+      CHECKGL(glBufferStorage(GL_PIXEL_UNPACK_BUFFER_ARB, size_, NULL, flags));
+      persistent_data_ = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER_ARB, 0, size_, flags));
+      CHECKGL_MSG(glMapBufferRange);
+
+      // Fall back to mapping each update.
+      if (persistent_data_ == NULL)
+      {
+        use_persistent_mapping_ = false;
+        CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0));
+        CHECKGL(glDeleteBuffersARB(1, &buffer_));
+        CHECKGL(glGenBuffersARB(1, &buffer_));
+        CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, buffer_));
+      }
+    }
+#endif
+
+    if (!use_persistent_mapping_)
+      CHECKGL(glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, size_, NULL, GL_STREAM_DRAW_ARB));
+
+    CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0));
+    head_ = 0;
+    segment_ = 0;
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void TextureUploadRing::DestroyBuffer()
+  {
+    for (auto& fence : fences_)
+    {
+      DeleteFence(fence);
+      fence = NULL;
+    }
+
+#ifndef NUX_OPENGLES_20
+    if (buffer_ == 0)
+      return;
+
+    if (persistent_data_ || locked_)
+    {
+      CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, buffer_));
+      CHECKGL(glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB));
+      CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0));
+    }
+
+    CHECKGL(glDeleteBuffersARB(1, &buffer_));
+#endif
+
+    buffer_ = 0;
+    persistent_data_ = NULL;
+    locked_ = false;
+  }
+
+  void TextureUploadRing::EnterSegment(int segment)
+  {
+#ifndef NUX_OPENGLES_20
+    if (!use_fences_)
+    {
+      // Let the driver give us new storage when the allocations wrap around.
+      if (segment == 0)
+      {
+        CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, buffer_));
+        CHECKGL(glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, size_, NULL, GL_STREAM_DRAW_ARB));
+        CHECKGL(glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0));
+        ++stats_.orphans;
+      }
+
+      segment_ = segment;
+      return;
+    }
+
+    // Every update that read the segment we leave has been issued.
+    DeleteFence(fences_[segment_]);
+    fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    if (fences_[segment])
+    {
+      GLsync fence = static_cast<GLsync>(fences_[segment]);
+      GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+      if (result == GL_TIMEOUT_EXPIRED)
+      {
+        ++stats_.waits;
+        const GLuint64 one_second = 1000000000;
+        while (result == GL_TIMEOUT_EXPIRED)
+          result = glClientWaitSync(fence, 0, one_second);
+      }
+
+      DeleteFence(fences_[segment]);
+      fences_[segment] = NULL;
+    }
+#endif
+
+    segment_ = segment;
+  }
+}
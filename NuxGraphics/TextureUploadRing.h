@@ -0,0 +1,117 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#ifndef TEXTUREUPLOADRING_H
+#define TEXTUREUPLOADRING_H
+
+#include <vector>
+
+namespace nux
+{
+  class GpuInfo;
+
+  //! Streams the texture updates of IOpenGLSurface::LockRect through one large pixel unpack buffer.
+  /*!
+      Lock sub-allocates the data of an update in the buffer, one after the other, so that the many small
+      updates of a frame (text, canvas, animated textures) need neither a heap allocation nor a buffer of their
+      own. The texture is then updated from the buffer, and the GPU copies the data asynchronously.
+
+      The buffer is split in SEGMENT_COUNT segments. When the allocations leave a segment, a fence (GL_ARB_sync)
+      is inserted after the updates that read it. The fence is waited for before the segment is written again,
+      one lap of the ring later. With GL_ARB_buffer_storage the buffer is mapped once and stays mapped, otherwise
+      each update maps its range without synchronization (GL_ARB_map_buffer_range). Without fences, the buffer
+      is orphaned each time the allocations wrap around.
+
+      A single update can be locked at a time. Lock returns NULL when the ring can't be used, and the caller
+      falls back to a buffer of its own.
+  */
+  class TextureUploadRing
+  {
+  public:
+    struct Stats
+    {
+      Stats();
+
+      int uploads;          //!< Texture updates, through the ring or not.
+      int uploaded_bytes;   //!< Bytes of the texture updates.
+      int ring_uploads;     //!< Texture updates whose data went through the ring.
+      int waits;            //!< Times a segment was still being read by the GPU.
+      int orphans;          //!< Times the buffer was orphaned.
+    };
+
+    static const int DEFAULT_SIZE = 4 * 1024 * 1024;
+    static const int SEGMENT_COUNT = 4;
+
+    TextureUploadRing(GpuInfo const& gpu_info, int size = DEFAULT_SIZE);
+    ~TextureUploadRing();
+
+    //! Enable or disable the ring. It can't be disabled while an update is locked.
+    void SetEnabled(bool enabled);
+    //! Return true if the ring is enabled and supported by the system.
+    bool IsEnabled() const;
+
+    //! Allocate the data of a texture update.
+    /*!
+        @param size The size of the data, at most the size of a segment.
+        @param offset Receives the offset of the data in the buffer.
+        @return A pointer where to write the data, or NULL if the ring can't hold it.
+    */
+    void* Lock(int size, int* offset);
+
+    //! End the update locked by Lock.
+    /*!
+        The buffer is left bound to GL_PIXEL_UNPACK_BUFFER. Update the texture from the offset returned by Lock,
+        then unbind it.
+    */
+    void Unlock();
+
+    bool IsLocked() const;
+
+    //! Count a texture update in the statistics.
+    void RecordUpload(int size);
+
+    void ResetStats();
+    Stats const& GetStats() const;
+
+  private:
+    TextureUploadRing(TextureUploadRing const&);
+    TextureUploadRing& operator = (TextureUploadRing const&);
+
+    bool CreateBuffer();
+    void DestroyBuffer();
+    void EnterSegment(int segment);
+
+    int size_;
+    int segment_size_;
+    bool supported_;
+    bool enabled_;
+    bool use_fences_;
+    bool use_persistent_mapping_;
+
+    unsigned int buffer_;
+    unsigned char* persistent_data_;  //!< Mapping of the whole buffer, with persistent mapping.
+    int head_;                        //!< Offset of the end of the last allocation.
+    int segment_;                     //!< Segment of the last allocation.
+    bool locked_;
+    std::vector<void*> fences_;       //!< GLsync of the updates that read each segment.
+    Stats stats_;
+  };
+}
+
+#endif // TEXTUREUPLOADRING_H
@@ -315,8 +315,8 @@ void Tile::Draw(nux::GraphicsEngine &graphics_engine, bool force_draw)
       w,    0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0, 0, color.red, color.green, color.blue, color.alpha,
     };
 
-    CHECKGL(glBindBufferARB (GL_ARRAY_BUFFER_ARB, 0));
-    CHECKGL(glBindBufferARB (GL_ELEMENT_ARRAY_BUFFER_ARB, 0));
+    graphics_engine.GetRenderStates().BindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    graphics_engine.GetRenderStates().BindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
     shader_prog_->Begin();
 
     int texture_unit0_location          = shader_prog_->GetUniformLocationARB("texture_unit0");
@@ -327,37 +327,37 @@ void Tile::Draw(nux::GraphicsEngine &graphics_engine, bool force_draw)
     if (texture_unit0_location != -1)
     {
       graphics_engine.SetTexture(GL_TEXTURE0, 0);
-      CHECKGL(glUniform1iARB(texture_unit0_location, 0));
+      shader_prog_->SetUniform1i(texture_unit0_location, 0);
     }
 
     int mvp_matrix_location = shader_prog_->GetUniformLocationARB ("mvp_matrix");
     nux::Matrix4 mvp_matrix      = graphics_engine.GetOpenGLModelViewProjectionMatrix();
     shader_prog_->SetUniformLocMatrix4fv((GLint) mvp_matrix_location, 1, false, (GLfloat *) &(mvp_matrix.m));
 
-    CHECKGL(glEnableVertexAttribArrayARB(vertex_attrib_location));
+    graphics_engine.GetRenderStates().EnableVertexAttribArray(vertex_attrib_location);
     CHECKGL(glVertexAttribPointerARB ( (GLuint) vertex_attrib_location, 4, GL_FLOAT, GL_FALSE, 48, vertex_buffer));
 
     if (texture_coord_attrib_location != -1)
     {
-      CHECKGL ( glEnableVertexAttribArrayARB (texture_coord_attrib_location) );
+      graphics_engine.GetRenderStates().EnableVertexAttribArray(texture_coord_attrib_location);
       CHECKGL ( glVertexAttribPointerARB ( (GLuint) texture_coord_attrib_location, 4, GL_FLOAT, GL_FALSE, 48, vertex_buffer + 4) );
     }
 
     if (color_attrib_location != -1)
     {
-      CHECKGL ( glEnableVertexAttribArrayARB (color_attrib_location) );
+      graphics_engine.GetRenderStates().EnableVertexAttribArray(color_attrib_location);
       CHECKGL ( glVertexAttribPointerARB ( (GLuint) color_attrib_location, 4, GL_FLOAT, GL_FALSE, 48, vertex_buffer + 8) );
     }
 
     CHECKGL ( glDrawArrays (GL_TRIANGLE_FAN, 0, 4) );
 
-    CHECKGL ( glDisableVertexAttribArrayARB (vertex_attrib_location) );
+    graphics_engine.GetRenderStates().DisableVertexAttribArray(vertex_attrib_location);
 
     if (texture_coord_attrib_location != -1)
-      CHECKGL ( glDisableVertexAttribArrayARB (texture_coord_attrib_location) );
+      graphics_engine.GetRenderStates().DisableVertexAttribArray(texture_coord_attrib_location);
 
     if (color_attrib_location != -1)
-      CHECKGL ( glDisableVertexAttribArrayARB (color_attrib_location) );
+      graphics_engine.GetRenderStates().DisableVertexAttribArray(color_attrib_location);
 
     shader_prog_->End();
   }
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glib.h>
+
+#include "NuxCore/NuxCore.h"
+#include "NuxCore/AsyncFileWriter.h"
+
+// Reports the throughput of AsyncFileWriter and the 99th percentile of the time spent in Write() when
+// 1, 4 and 16 threads write log lines while the main thread runs the main loop.
+
+namespace
+{
+  const int NUM_LINES = 400000;
+  const std::size_t LINE_SIZE = 128;
+
+  typedef std::chrono::steady_clock Clock;
+
+  bool writer_closed;
+
+  void OnWriterClosed()
+  {
+    writer_closed = true;
+  }
+
+  void WriteLines(nux::AsyncFileWriter& writer, int count, std::vector<double>& latencies,
+                  std::atomic<int>& finished)
+  {
+    std::string line(LINE_SIZE - 1, 'x');
+    line += '\n';
+    latencies.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+      auto start = Clock::now();
+      writer.Write(line);
+      std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+      latencies.push_back(elapsed.count());
+    }
+
+    ++finished;
+  }
+
+  void Benchmark(std::string const& filename, int num_threads)
+  {
+    std::remove(filename.c_str());
+
+    nux::AsyncFileWriter writer(filename);
+    writer_closed = false;
+    writer.closed.connect(sigc::ptr_fun(OnWriterClosed));
+
+    std::vector<std::vector<double>> latencies(num_threads);
+    std::vector<std::thread> threads;
+    std::atomic<int> finished(0);
+    auto start = Clock::now();
+
+    for (int i = 0; i < num_threads; ++i)
+      threads.push_back(std::thread(WriteLines, std::ref(writer), NUM_LINES / num_threads,
+                                    std::ref(latencies[i]), std::ref(finished)));
+
+    while (finished != num_threads)
+      g_main_context_iteration(NULL, FALSE);
+
+    for (auto& thread : threads)
+      thread.join();
+
+    writer.Close();
+    while (!writer_closed)
+      g_main_context_iteration(NULL, TRUE);
+
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::vector<double> all_latencies;
+    for (auto const& thread_latencies : latencies)
+      all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+    std::sort(all_latencies.begin(), all_latencies.end());
+
+    double megabytes = double(NUM_LINES / num_threads * num_threads) * LINE_SIZE / (1024 * 1024);
+    printf("%2d threads: %7.1f MB/s, p99 Write() %6.2f us, %zu bytes dropped\n", num_threads,
+           megabytes / elapsed.count(), all_latencies[all_latencies.size() * 99 / 100],
+           writer.GetDroppedBytes());
+  }
+}
+
+int main()
+{
+  nux::NuxCoreInitialize(0);
+
+  std::string filename = std::string(g_get_tmp_dir()) + "/nux-benchmark-async-file-writer.log";
+  const int thread_counts[] = { 1, 4, 16 };
+
+  for (int num_threads : thread_counts)
+    Benchmark(filename, num_threads);
+
+  std::remove(filename.c_str());
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "NuxGraphics/ImageBlur.h"
+
+// Reports the time it takes to blur ARGB surfaces of a few sizes with the scalar implementation, with the
+// fastest implementation supported by the processor, and with the fastest implementation on several threads.
+
+namespace
+{
+  const int RADIUS = 10;
+
+  double TimeBlur(int size, nux::BlurImplementation implementation, int max_threads)
+  {
+    std::vector<unsigned char> pixels(size * size * 4);
+    for (size_t i = 0; i < pixels.size(); ++i)
+      pixels[i] = (i * 7919) % 256;
+
+    int iterations = std::max(1, (64 * 1024 * 1024) / (size * size * 4));
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+      nux::ExpBlur(&pixels[0], size, size, size * 4, 4, RADIUS, implementation, max_threads);
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+  }
+
+  const char* GetName(nux::BlurImplementation implementation)
+  {
+    switch (implementation)
+    {
+      case nux::BLUR_SSE2:
+        return "SSE2";
+      case nux::BLUR_AVX2:
+        return "AVX2";
+      case nux::BLUR_NEON:
+        return "NEON";
+      default:
+        return "scalar";
+    }
+  }
+}
+
+int main()
+{
+  nux::BlurImplementation simd = nux::GetDefaultBlurImplementation();
+  const int sizes[] = {256, 1024, 2048};
+
+  printf("Exponential blur of ARGB surfaces, radius %d, time per blur:\n", RADIUS);
+  printf("%8s %12s %12s %12s\n", "size", "scalar", GetName(simd), "threaded");
+
+  for (int size : sizes)
+  {
+    double scalar = TimeBlur(size, nux::BLUR_SCALAR, 1);
+    double vectorized = TimeBlur(size, simd, 1);
+    double threaded = TimeBlur(size, simd, 0);
+
+    printf("%8d %9.2f ms %9.2f ms %9.2f ms\n", size, scalar, vectorized, threaded);
+  }
+
+  return 0;
+}
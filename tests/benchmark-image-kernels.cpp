@@ -0,0 +1,150 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "NuxCore/NuxCore.h"
+#include "NuxGraphics/ImageKernels.h"
+
+// Reports the time each pixel kernel takes on images of a few sizes, with the scalar implementation and with
+// each vector implementation supported by the processor. Launcher icons are about 128 pixels wide.
+
+namespace
+{
+  enum Kernel
+  {
+    KERNEL_SUM,
+    KERNEL_REVERSE,
+    KERNEL_SWIZZLE,
+    KERNEL_EXPAND,
+    KERNEL_PREMULTIPLY,
+    KERNEL_UNPREMULTIPLY,
+    KERNEL_COUNT,
+  };
+
+  const char* GetKernelName(Kernel kernel)
+  {
+    switch (kernel)
+    {
+      case KERNEL_SUM:
+        return "average color";
+      case KERNEL_REVERSE:
+        return "horizontal flip";
+      case KERNEL_SWIZZLE:
+        return "RGBA to BGRA";
+      case KERNEL_EXPAND:
+        return "RGB to RGBA";
+      case KERNEL_PREMULTIPLY:
+        return "premultiply";
+      default:
+        return "unpremultiply";
+    }
+  }
+
+  const char* GetName(nux::PixelKernelImplementation implementation)
+  {
+    switch (implementation)
+    {
+      case nux::PIXEL_KERNELS_SSE2:
+        return "SSE2";
+      case nux::PIXEL_KERNELS_AVX2:
+        return "AVX2";
+      default:
+        return "scalar";
+    }
+  }
+
+  double TimeKernel(Kernel kernel, int size, nux::PixelKernelImplementation implementation)
+  {
+    int stride = size * 4;
+    std::vector<unsigned char> src(stride * size);
+    std::vector<unsigned char> dst(stride * size);
+    for (size_t i = 0; i < src.size(); ++i)
+      src[i] = (i * 7919) % 256;
+
+    int iterations = std::max(1, (256 * 1024 * 1024) / (size * size * 4));
+    unsigned long long sums[4];
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+      switch (kernel)
+      {
+        case KERNEL_SUM:
+          nux::SumPixelBytes(&src[0], size, size, stride, 4, sums, implementation);
+          break;
+        case KERNEL_REVERSE:
+          nux::ReversePixelRows(&src[0], size, size, stride, 4, implementation);
+          break;
+        case KERNEL_SWIZZLE:
+          nux::SwizzleRedBlue(&src[0], stride, &dst[0], stride, size, size, implementation);
+          break;
+        case KERNEL_EXPAND:
+          nux::ConvertPixels(&src[0], size * 3, nux::BITFMT_R8G8B8, &dst[0], stride, nux::BITFMT_R8G8B8A8,
+                             size, size, implementation);
+          break;
+        case KERNEL_PREMULTIPLY:
+          nux::PremultiplyAlpha(&src[0], stride, &dst[0], stride, size, size, nux::BITFMT_R8G8B8A8, implementation);
+          break;
+        default:
+          nux::UnpremultiplyAlpha(&src[0], stride, &dst[0], stride, size, size, nux::BITFMT_R8G8B8A8, implementation);
+          break;
+      }
+    }
+
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+  }
+}
+
+int main()
+{
+  std::vector<nux::PixelKernelImplementation> implementations;
+  for (auto implementation : {nux::PIXEL_KERNELS_SCALAR, nux::PIXEL_KERNELS_SSE2, nux::PIXEL_KERNELS_AVX2})
+  {
+    if (nux::IsPixelKernelImplementationSupported(implementation))
+      implementations.push_back(implementation);
+  }
+
+  const int sizes[] = {128, 1024};
+
+  for (int size : sizes)
+  {
+    printf("Pixel kernels on %dx%d images, time per image:\n", size, size);
+    printf("%16s", "kernel");
+    for (auto implementation : implementations)
+      printf(" %12s", GetName(implementation));
+    printf("\n");
+
+    for (int kernel = 0; kernel < KERNEL_COUNT; ++kernel)
+    {
+      printf("%16s", GetKernelName(Kernel(kernel)));
+      for (auto implementation : implementations)
+        printf(" %9.1f us", TimeKernel(Kernel(kernel), size, implementation));
+      printf("\n");
+    }
+
+    printf("\n");
+  }
+
+  return 0;
+}
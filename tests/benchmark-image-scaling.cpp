@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "NuxCore/NuxCore.h"
+#include "NuxGraphics/ImageScaling.h"
+
+// Reports the time to reduce 256 pixels icons to the 32 pixels they are drawn at, with each filter and with
+// the scalar implementation and each vector implementation supported by the processor. A large image shows the
+// gain of the threads.
+
+namespace
+{
+  const char* GetName(nux::PixelKernelImplementation implementation)
+  {
+    switch (implementation)
+    {
+      case nux::PIXEL_KERNELS_SSE2:
+        return "SSE2";
+      case nux::PIXEL_KERNELS_AVX2:
+        return "AVX2";
+      default:
+        return "scalar";
+    }
+  }
+
+  const char* GetName(nux::ImageFilter filter)
+  {
+    return (filter == nux::IMAGE_FILTER_BOX) ? "box" : "lanczos";
+  }
+
+  double TimeScale(int size, int scaled_size, nux::ImageFilter filter,
+                   nux::PixelKernelImplementation implementation, int max_threads)
+  {
+    std::vector<unsigned char> src(size * size * 4);
+    std::vector<unsigned char> dst(scaled_size * scaled_size * 4);
+    for (size_t i = 0; i < src.size(); ++i)
+      src[i] = (i * 7919) % 256;
+
+    int iterations = std::max(1, (64 * 1024 * 1024) / (size * size * 4));
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+      nux::ScalePixels(&src[0], size * 4, size, size, &dst[0], scaled_size * 4, scaled_size, scaled_size,
+                       nux::BITFMT_R8G8B8A8, filter, implementation, max_threads);
+    }
+
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+  }
+}
+
+int main()
+{
+  std::vector<nux::PixelKernelImplementation> implementations;
+  for (auto implementation : {nux::PIXEL_KERNELS_SCALAR, nux::PIXEL_KERNELS_SSE2, nux::PIXEL_KERNELS_AVX2})
+  {
+    if (nux::IsPixelKernelImplementationSupported(implementation))
+      implementations.push_back(implementation);
+  }
+
+  const int sizes[][2] = {{256, 32}, {256, 64}, {2048, 256}};
+
+  for (auto const& size : sizes)
+  {
+    printf("Reduction of a %dx%d image to %dx%d, time per image:\n", size[0], size[0], size[1], size[1]);
+    printf("%10s", "filter");
+    for (auto implementation : implementations)
+      printf(" %12s", GetName(implementation));
+    printf(" %12s\n", "threads");
+
+    for (auto filter : {nux::IMAGE_FILTER_BOX, nux::IMAGE_FILTER_LANCZOS})
+    {
+      printf("%10s", GetName(filter));
+      for (auto implementation : implementations)
+        printf(" %9.1f us", TimeScale(size[0], size[1], filter, implementation, 1));
+      printf(" %9.1f us\n", TimeScale(size[0], size[1], filter, nux::PIXEL_KERNELS_AUTO, 0));
+    }
+
+    printf("\n");
+  }
+
+  return 0;
+}
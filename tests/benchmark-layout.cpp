@@ -0,0 +1,91 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "Nux/Nux.h"
+#include "Nux/VLayout.h"
+#include "Nux/ProgramFramework/TestView.h"
+
+// Lays out a VLayout with a large number of children and reports the time it takes to compute the layout again
+// after the size of a single child has changed, with and without reusing the cached sizes of the other children.
+
+namespace
+{
+  const int NUM_CHILDREN = 10000;
+  const int NUM_ITERATIONS = 100;
+
+  double Relayout(nux::WindowThread* wnd_thread, nux::VLayout* layout, std::vector<nux::View*> const& views, bool invalidate_all)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < NUM_ITERATIONS; ++i)
+    {
+      nux::View* view = views[(i * 7919) % views.size()];
+      view->SetMinMaxSize(100, (i % 2) ? 20 : 10);
+
+      if (invalidate_all)
+      {
+        for (auto v : views)
+          v->InvalidateContentSize();
+      }
+
+      wnd_thread->ComputeElementLayout(layout);
+    }
+
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / NUM_ITERATIONS;
+  }
+}
+
+int main()
+{
+  nux::NuxInitialize(0);
+  std::unique_ptr<nux::WindowThread> wnd_thread(nux::CreateNuxWindow("Layout Benchmark", 300, 200, nux::WINDOWSTYLE_NORMAL,
+                                                                     NULL, false, NULL, NULL));
+
+  nux::VLayout* layout = new nux::VLayout(NUX_TRACKER_LOCATION);
+  layout->SetContentDistribution(nux::MAJOR_POSITION_START);
+  std::vector<nux::View*> views;
+
+  for (int i = 0; i < NUM_CHILDREN; ++i)
+  {
+    nux::View* view = new nux::TestView(NUX_TRACKER_LOCATION);
+    view->SetMinMaxSize(100, 10);
+    layout->AddView(view, 0);
+    views.push_back(view);
+  }
+
+  layout->SetGeometry(0, 0, 300, NUM_CHILDREN * 20);
+  wnd_thread->ComputeElementLayout(layout);
+
+  double full = Relayout(wnd_thread.get(), layout, views, true);
+  double cached = Relayout(wnd_thread.get(), layout, views, false);
+
+  printf("VLayout with %d children, relayout after a single child resize:\n", NUM_CHILDREN);
+  printf("  all children computed: %10.1f us\n", full);
+  printf("  cached children:       %10.1f us\n", cached);
+
+  layout->UnReference();
+
+  return 0;
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "NuxCore/NuxCore.h"
+#include "NuxCore/Math/Vector4.h"
+#include "NuxCore/Math/Matrix4.h"
+
+// Reports the time of the Matrix4 products and inverse with the vector implementations, and with the generic
+// template code they replace for floats.
+
+namespace
+{
+  //! The generic Matrix4x4<T>::operator * (const Matrix4x4<T>&).
+  nux::Matrix4 GenericMultiply(nux::Matrix4 const& a, nux::Matrix4 const& b)
+  {
+    nux::Matrix4 o;
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        o.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] + a.m[i][3] * b.m[3][j];
+
+    return o;
+  }
+
+  //! The generic Matrix4x4<T>::operator * (const Vector4&).
+  nux::Vector4 GenericTransform(nux::Matrix4 const& a, nux::Vector4 const& v)
+  {
+    return nux::Vector4(v.x * a.m[0][0] + v.y * a.m[0][1] + v.z * a.m[0][2] + v.w * a.m[0][3],
+                        v.x * a.m[1][0] + v.y * a.m[1][1] + v.z * a.m[1][2] + v.w * a.m[1][3],
+                        v.x * a.m[2][0] + v.y * a.m[2][1] + v.z * a.m[2][2] + v.w * a.m[2][3],
+                        v.x * a.m[3][0] + v.y * a.m[3][1] + v.z * a.m[3][2] + v.w * a.m[3][3]);
+  }
+
+  //! The generic Matrix4x4<T>::Inverse: the adjugate divided by the determinant.
+  nux::Matrix4 GenericInverse(nux::Matrix4 const& a)
+  {
+    const float m00 = a.m[0][0], m01 = a.m[0][1], m02 = a.m[0][2], m03 = a.m[0][3];
+    const float m10 = a.m[1][0], m11 = a.m[1][1], m12 = a.m[1][2], m13 = a.m[1][3];
+    const float m20 = a.m[2][0], m21 = a.m[2][1], m22 = a.m[2][2], m23 = a.m[2][3];
+    const float m30 = a.m[3][0], m31 = a.m[3][1], m32 = a.m[3][2], m33 = a.m[3][3];
+
+    float det = a.Determinant();
+    if (det == 0)
+      return a;
+
+    nux::Matrix4 t;
+    t.m[0][0] = m12 * m23 * m31 - m13 * m22 * m31 + m13 * m21 * m32 - m11 * m23 * m32 - m12 * m21 * m33 + m11 * m22 * m33;
+    t.m[0][1] = m03 * m22 * m31 - m02 * m23 * m31 - m03 * m21 * m32 + m01 * m23 * m32 + m02 * m21 * m33 - m01 * m22 * m33;
+    t.m[0][2] = m02 * m13 * m31 - m03 * m12 * m31 + m03 * m11 * m32 - m01 * m13 * m32 - m02 * m11 * m33 + m01 * m12 * m33;
+    t.m[0][3] = m03 * m12 * m21 - m02 * m13 * m21 - m03 * m11 * m22 + m01 * m13 * m22 + m02 * m11 * m23 - m01 * m12 * m23;
+    t.m[1][0] = m13 * m22 * m30 - m12 * m23 * m30 - m13 * m20 * m32 + m10 * m23 * m32 + m12 * m20 * m33 - m10 * m22 * m33;
+    t.m[1][1] = m02 * m23 * m30 - m03 * m22 * m30 + m03 * m20 * m32 - m00 * m23 * m32 - m02 * m20 * m33 + m00 * m22 * m33;
+    t.m[1][2] = m03 * m12 * m30 - m02 * m13 * m30 - m03 * m10 * m32 + m00 * m13 * m32 + m02 * m10 * m33 - m00 * m12 * m33;
+    t.m[1][3] = m02 * m13 * m20 - m03 * m12 * m20 + m03 * m10 * m22 - m00 * m13 * m22 - m02 * m10 * m23 + m00 * m12 * m23;
+    t.m[2][0] = m11 * m23 * m30 - m13 * m21 * m30 + m13 * m20 * m31 - m10 * m23 * m31 - m11 * m20 * m33 + m10 * m21 * m33;
+    t.m[2][1] = m03 * m21 * m30 - m01 * m23 * m30 - m03 * m20 * m31 + m00 * m23 * m31 + m01 * m20 * m33 - m00 * m21 * m33;
+    t.m[2][2] = m01 * m13 * m30 - m03 * m11 * m30 + m03 * m10 * m31 - m00 * m13 * m31 - m01 * m10 * m33 + m00 * m11 * m33;
+    t.m[2][3] = m03 * m11 * m20 - m01 * m13 * m20 - m03 * m10 * m21 + m00 * m13 * m21 + m01 * m10 * m23 - m00 * m11 * m23;
+    t.m[3][0] = m12 * m21 * m30 - m11 * m22 * m30 - m12 * m20 * m31 + m10 * m22 * m31 + m11 * m20 * m32 - m10 * m21 * m32;
+    t.m[3][1] = m01 * m22 * m30 - m02 * m21 * m30 + m02 * m20 * m31 - m00 * m22 * m31 - m01 * m20 * m32 + m00 * m21 * m32;
+    t.m[3][2] = m02 * m11 * m30 - m01 * m12 * m30 - m02 * m10 * m31 + m00 * m12 * m31 + m01 * m10 * m32 - m00 * m11 * m32;
+    t.m[3][3] = m01 * m12 * m20 - m02 * m11 * m20 + m02 * m10 * m21 - m00 * m12 * m21 - m01 * m10 * m22 + m00 * m11 * m22;
+
+    return (1.0f / det) * t;
+  }
+
+  const int ITERATIONS = 10000000;
+  const int COUNT = 256;
+
+  template <typename F>
+  double TimeNanoseconds(F const& function)
+  {
+    int iterations = ITERATIONS / COUNT;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      function();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (iterations * COUNT);
+  }
+
+  void Report(const char* name, double generic, double vector)
+  {
+    printf("%20s %9.2f ns %9.2f ns %9.1fx\n", name, generic, vector, generic / vector);
+  }
+}
+
+int main()
+{
+  // Rotations keep the results bounded when they are multiplied again and again.
+  const nux::Matrix4 rotation = nux::Matrix4::ROTATEZ(0.01f) * nux::Matrix4::ROTATEX(0.02f);
+
+  std::vector<nux::Matrix4> matrices(COUNT);
+  std::vector<nux::Vector4> vectors(COUNT);
+  for (int i = 0; i < COUNT; ++i)
+  {
+    matrices[i] = nux::Matrix4::TRANSLATE(i, 2 * i, 1) * nux::Matrix4::ROTATEY(i * 0.1f) * nux::Matrix4::SCALE(2, 3, 4);
+    vectors[i] = nux::Vector4(i, i + 1, i + 2, 1);
+  }
+
+  std::vector<nux::Matrix4> generic_matrices(matrices), vector_matrices(matrices);
+  std::vector<nux::Vector4> generic_vectors(vectors), vector_vectors(vectors);
+  float sink = 0;
+
+  printf("%20s %12s %12s %10s\n", "operation", "generic", "vector", "speedup");
+
+  Report("matrix * matrix",
+         TimeNanoseconds([&] {
+           for (auto& matrix : generic_matrices)
+             matrix = GenericMultiply(matrix, rotation);
+         }),
+         TimeNanoseconds([&] {
+           for (auto& matrix : vector_matrices)
+             matrix = matrix * rotation;
+         }));
+
+  Report("matrix * vector",
+         TimeNanoseconds([&] {
+           for (int i = 0; i < COUNT; ++i)
+             generic_vectors[i] = GenericTransform(matrices[i], generic_vectors[i]);
+         }),
+         TimeNanoseconds([&] {
+           for (int i = 0; i < COUNT; ++i)
+             vector_vectors[i] = matrices[i] * vector_vectors[i];
+         }));
+
+  Report("transform points",
+         TimeNanoseconds([&] {
+           for (auto& vector : generic_vectors)
+             vector = GenericTransform(rotation, vector);
+         }),
+         TimeNanoseconds([&] {
+           rotation.TransformPoints(&vector_vectors[0], &vector_vectors[0], COUNT);
+         }));
+
+  // Each matrix is inverted an even number of times.
+  generic_matrices = vector_matrices = matrices;
+  Report("inverse",
+         TimeNanoseconds([&] {
+           for (auto& matrix : generic_matrices)
+             matrix = GenericInverse(matrix);
+         }),
+         TimeNanoseconds([&] {
+           for (auto& matrix : vector_matrices)
+             matrix.Inverse();
+         }));
+
+  for (int i = 0; i < COUNT; ++i)
+    sink += generic_matrices[i].m[0][0] + vector_matrices[i].m[0][0] + generic_vectors[i].x + vector_vectors[i].x;
+
+  // Keeps the results alive.
+  return sink == 12345.0f;
+}
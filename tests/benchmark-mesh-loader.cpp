@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "NuxGraphics/MeshData.h"
+#include "NuxGraphics/MeshFileLoader-OBJ.h"
+
+// Reports the time to load synthetic OBJ files of growing sizes with the memory mapped loader, on one thread and
+// on a few threads, and with the line by line loader it replaced.
+
+namespace
+{
+  //! The loader before the memory mapped one: a std::stringstream per line, the vertices are not shared.
+  nux::MeshData* LoadLineByLine(const char* filename)
+  {
+    struct FaceIndex
+    {
+      int pos_index[3];
+      int tex_index[3];
+      int nor_index[3];
+    };
+
+    std::vector<float> positions, texcoords, normals;
+    std::vector<FaceIndex> faces;
+
+    std::ifstream filestream(filename);
+    std::string line;
+
+    while (std::getline(filestream, line))
+    {
+      std::stringstream str_stream(line);
+      std::string type;
+      str_stream >> type;
+
+      float x, y, z;
+      if (type == "v")
+      {
+        str_stream >> x >> y >> z;
+        positions.insert(positions.end(), {x, y, z, 1.0f});
+      }
+      else if (type == "vt")
+      {
+        str_stream >> x >> y;
+        texcoords.insert(texcoords.end(), {x, y});
+      }
+      else if (type == "vn")
+      {
+        str_stream >> x >> y >> z;
+        normals.insert(normals.end(), {x, y, z});
+      }
+      else if (type == "f")
+      {
+        FaceIndex face;
+        char interupt;
+        for (int i = 0; i < 3; ++i)
+          str_stream >> face.pos_index[i] >> interupt >> face.tex_index[i] >> interupt >> face.nor_index[i];
+        faces.push_back(face);
+      }
+    }
+
+    nux::MeshData* md = new nux::MeshData;
+    md->Allocate(faces.size(), nux::NUX_MESH_TRIANGLE, 3 * faces.size(), 16 + 12 + 8);
+
+    float* vertex_buffer = (float*) md->_vertex_data;
+    int* index_buffer = (int*) md->_index_data;
+    for (size_t i = 0; i < faces.size(); ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        float* v = vertex_buffer + 27 * i + 9 * j;
+        int vi = faces[i].pos_index[j] - 1, ni = faces[i].nor_index[j] - 1, ti = faces[i].tex_index[j] - 1;
+
+        index_buffer[3 * i + j] = 3 * i + j;
+        std::copy_n(&positions[4 * vi], 4, v);
+        std::copy_n(&normals[3 * ni], 3, v + 4);
+        std::copy_n(&texcoords[2 * ti], 2, v + 7);
+      }
+    }
+
+    return md;
+  }
+
+  //! Write a grid of size x size quads split in triangles, with a texcoord and a normal per position.
+  void WriteGrid(const char* filename, int size)
+  {
+    FILE* file = fopen(filename, "w");
+
+    for (int y = 0; y <= size; ++y)
+    {
+      for (int x = 0; x <= size; ++x)
+      {
+        fprintf(file, "v %f %f %f\nvt %f %f\nvn %f %f %f\n", x * 0.01f, y * 0.01f, ((x * 31 + y * 17) % 101) * 1e-3f,
+                float(x) / size, float(y) / size, 0.0f, 0.0f, 1.0f);
+      }
+    }
+
+    for (int y = 0; y < size; ++y)
+    {
+      for (int x = 0; x < size; ++x)
+      {
+        int a = y * (size + 1) + x + 1;
+        int b = a + 1, c = a + size + 2, d = a + size + 1;
+        fprintf(file, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, c, c, c);
+        fprintf(file, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, c, c, c, d, d, d);
+      }
+    }
+
+    fclose(file);
+  }
+
+  template<typename Load>
+  double TimeLoad(Load const& load)
+  {
+    auto start = std::chrono::steady_clock::now();
+    delete load();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+}
+
+int main()
+{
+  char filename[] = "/tmp/benchmark-mesh-loader-XXXXXX";
+  int fd = mkstemp(filename);
+  if (fd == -1)
+    return 1;
+  close(fd);
+
+  const int sizes[] = {100, 316, 708};
+
+  printf("%10s %14s %14s %14s %14s\n", "faces", "line by line", "mapped", "mapped, 4 thr", "speedup");
+  for (int size : sizes)
+  {
+    WriteGrid(filename, size);
+
+    // Warm up the page cache.
+    delete nux::LoadMeshFile_OBJ(filename);
+
+    double line_by_line = TimeLoad([&] { return LoadLineByLine(filename); });
+    double mapped = TimeLoad([&] { return nux::LoadMeshFile_OBJ(filename, 1); });
+    double threaded = TimeLoad([&] { return nux::LoadMeshFile_OBJ(filename, 4); });
+
+    printf("%10d %11.1f ms %11.1f ms %11.1f ms %13.1fx\n", 2 * size * size, line_by_line, mapped, threaded,
+           line_by_line / std::min(mapped, threaded));
+  }
+
+  unlink(filename);
+  return 0;
+}
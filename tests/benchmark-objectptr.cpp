@@ -0,0 +1,120 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "NuxCore/NuxCore.h"
+#include "NuxCore/Object.h"
+#include "NuxCore/ObjectPtr.h"
+
+// Reports the cost of creating and destroying Nux objects, and the throughput of copying and destroying
+// ObjectPtr and ObjectWeakPtr, on one thread and on several threads working on their own objects.
+
+namespace
+{
+  const int NUM_OBJECTS = 100000;
+  const int NUM_COPIES = 10000000;
+  const int NUM_THREADS = 4;
+
+  typedef std::chrono::steady_clock Clock;
+
+  double NanosecondsSince(Clock::time_point start, int count)
+  {
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / count;
+  }
+
+  double CreateAndDestroyObjects()
+  {
+    std::vector<nux::Object*> objects(NUM_OBJECTS);
+    auto start = Clock::now();
+
+    for (auto& object : objects)
+      object = new nux::Object();
+
+    for (auto object : objects)
+      object->UnReference();
+
+    return NanosecondsSince(start, NUM_OBJECTS);
+  }
+
+  void CopyObjectPtr(nux::ObjectPtr<nux::Object> const& ptr, int count)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      nux::ObjectPtr<nux::Object> copy(ptr);
+    }
+  }
+
+  void CopyObjectWeakPtr(nux::ObjectWeakPtr<nux::Object> const& ptr, int count)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      nux::ObjectWeakPtr<nux::Object> copy(ptr);
+    }
+  }
+
+  double CopyObjectPtrs(int num_threads)
+  {
+    std::vector<nux::ObjectPtr<nux::Object>> ptrs;
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < num_threads; ++i)
+      ptrs.push_back(nux::ObjectPtr<nux::Object>(new nux::Object()));
+
+    for (auto& ptr : ptrs)
+      ptr->UnReference();
+
+    auto start = Clock::now();
+
+    for (auto const& ptr : ptrs)
+      threads.push_back(std::thread(CopyObjectPtr, std::cref(ptr), NUM_COPIES / num_threads));
+
+    for (auto& thread : threads)
+      thread.join();
+
+    return NanosecondsSince(start, NUM_COPIES);
+  }
+
+  double CopyObjectWeakPtrs()
+  {
+    nux::ObjectPtr<nux::Object> ptr(new nux::Object());
+    ptr->UnReference();
+    nux::ObjectWeakPtr<nux::Object> weak_ptr(ptr);
+
+    auto start = Clock::now();
+    CopyObjectWeakPtr(weak_ptr, NUM_COPIES);
+    return NanosecondsSince(start, NUM_COPIES);
+  }
+}
+
+int main()
+{
+  nux::NuxCoreInitialize(0);
+
+  printf("Object creation and destruction: %.1f ns per object\n", CreateAndDestroyObjects());
+  printf("ObjectPtr copy and destruction, 1 thread: %.1f ns per copy\n", CopyObjectPtrs(1));
+  printf("ObjectPtr copy and destruction, %d threads: %.1f ns per copy\n", NUM_THREADS, CopyObjectPtrs(NUM_THREADS));
+  printf("ObjectWeakPtr copy and destruction: %.1f ns per copy\n", CopyObjectWeakPtrs());
+
+  return 0;
+}
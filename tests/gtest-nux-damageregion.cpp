@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "Nux/Nux.h"
+#include "Nux/DamageRegion.h"
+
+using namespace nux;
+
+namespace {
+
+TEST(TestDamageRegion, TestEmptyRegion)
+{
+  DamageRegion region;
+
+  EXPECT_TRUE(region.IsEmpty());
+  EXPECT_EQ(0, region.GetArea());
+  EXPECT_EQ(Geometry(0, 0, 0, 0), region.GetBounds());
+
+  region.Add(Geometry(10, 10, 0, 20));
+  region.Add(Geometry(10, 10, 20, -1));
+  EXPECT_TRUE(region.IsEmpty());
+}
+
+TEST(TestDamageRegion, TestDisjointRectsAreKept)
+{
+  DamageRegion region;
+
+  region.Add(Geometry(0, 0, 10, 10));
+  region.Add(Geometry(100, 100, 10, 10));
+
+  ASSERT_EQ(2, (int) region.GetRects().size());
+  EXPECT_EQ(200, region.GetArea());
+  EXPECT_EQ(Geometry(0, 0, 110, 110), region.GetBounds());
+}
+
+TEST(TestDamageRegion, TestContainedRectIsMerged)
+{
+  DamageRegion region;
+
+  region.Add(Geometry(0, 0, 100, 100));
+  region.Add(Geometry(10, 10, 2, 16));
+
+  ASSERT_EQ(1, (int) region.GetRects().size());
+  EXPECT_EQ(Geometry(0, 0, 100, 100), region.GetRects()[0]);
+}
+
+TEST(TestDamageRegion, TestAdjacentRectsAreMerged)
+{
+  DamageRegion region;
+
+  region.Add(Geometry(0, 0, 10, 10));
+  region.Add(Geometry(10, 0, 10, 10));
+
+  ASSERT_EQ(1, (int) region.GetRects().size());
+  EXPECT_EQ(Geometry(0, 0, 20, 10), region.GetRects()[0]);
+}
+
+TEST(TestDamageRegion, TestMergeCascades)
+{
+  DamageRegion region;
+
+  region.Add(Geometry(0, 0, 10, 10));
+  region.Add(Geometry(20, 0, 10, 10));
+  ASSERT_EQ(2, (int) region.GetRects().size());
+
+  // Fills the gap between the two rectangles.
+  region.Add(Geometry(10, 0, 10, 10));
+  ASSERT_EQ(1, (int) region.GetRects().size());
+  EXPECT_EQ(Geometry(0, 0, 30, 10), region.GetRects()[0]);
+}
+
+TEST(TestDamageRegion, TestNumberOfRectsIsBounded)
+{
+  DamageRegion region;
+
+  for (int i = 0; i < 10 * DamageRegion::MAX_RECTS; ++i)
+    region.Add(Geometry(i * 20, (i % 3) * 20, 2, 2));
+
+  EXPECT_LE((int) region.GetRects().size(), DamageRegion::MAX_RECTS);
+
+  for (int i = 0; i < 10 * DamageRegion::MAX_RECTS; ++i)
+    EXPECT_TRUE(region.IsIntersecting(Geometry(i * 20, (i % 3) * 20, 2, 2)));
+}
+
+TEST(TestDamageRegion, TestIsIntersecting)
+{
+  DamageRegion region;
+  region.Add(Geometry(10, 10, 10, 10));
+
+  EXPECT_TRUE(region.IsIntersecting(Geometry(15, 15, 10, 10)));
+  EXPECT_FALSE(region.IsIntersecting(Geometry(20, 10, 10, 10)));
+  EXPECT_FALSE(region.IsIntersecting(Geometry(0, 0, 5, 5)));
+}
+
+TEST(TestDamageRegion, TestClip)
+{
+  DamageRegion region;
+  region.Add(Geometry(-10, -10, 20, 20));
+  region.Add(Geometry(200, 200, 10, 10));
+
+  region.Clip(Geometry(0, 0, 100, 100));
+
+  ASSERT_EQ(1, (int) region.GetRects().size());
+  EXPECT_EQ(Geometry(0, 0, 10, 10), region.GetRects()[0]);
+}
+
+TEST(TestDamageRegion, TestAddRegion)
+{
+  DamageRegion region;
+  DamageRegion other;
+
+  region.Add(Geometry(0, 0, 10, 10));
+  other.Add(Geometry(50, 50, 10, 10));
+  other.Add(Geometry(5, 5, 2, 2));
+
+  region.Add(other);
+  EXPECT_EQ(2, (int) region.GetRects().size());
+  EXPECT_EQ(200, region.GetArea());
+
+  region.Clear();
+  EXPECT_TRUE(region.IsEmpty());
+}
+
+}
@@ -0,0 +1,195 @@
+#include <gmock/gmock.h>
+#include <glib.h>
+
+#include "Nux/Nux.h"
+#include "Nux/HLayout.h"
+#include "Nux/ImageLoader.h"
+#include "Nux/TextureArea.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+const std::string IMAGE = TESTDIR "/../data/UITextures/AddButton.png";
+const std::string OTHER_IMAGE = TESTDIR "/../data/UITextures/CancelButton.png";
+
+class TestImageLoader : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("nux::TestImageLoader", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+    completed = 0;
+  }
+
+  ImageLoader& GetImageLoader()
+  {
+    return wnd_thread->GetImageLoader();
+  }
+
+  ImageLoader::Callback Store(ObjectPtr<BaseTexture>& texture)
+  {
+    return [this, &texture] (ObjectPtr<BaseTexture> const& loaded) { texture = loaded; ++completed; };
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+  int completed;
+};
+
+TEST_F(TestImageLoader, TestLoad)
+{
+  ObjectPtr<BaseTexture> texture;
+  ImageLoader::Handle handle = GetImageLoader().Load(IMAGE, Store(texture));
+
+  EXPECT_NE(0u, handle);
+  EXPECT_TRUE(GetImageLoader().IsPending(handle));
+  EXPECT_EQ(0, completed);
+
+  GetImageLoader().Finish();
+
+  EXPECT_EQ(1, completed);
+  EXPECT_FALSE(GetImageLoader().IsPending(handle));
+  ASSERT_TRUE(texture.IsValid());
+  EXPECT_EQ(20, texture->GetWidth());
+  EXPECT_EQ(20, texture->GetHeight());
+}
+
+TEST_F(TestImageLoader, TestSamePathSharesTheTexture)
+{
+  ObjectPtr<BaseTexture> first, second, other;
+  GetImageLoader().Load(IMAGE, Store(first));
+  GetImageLoader().Load(IMAGE, Store(second));
+  GetImageLoader().Load(OTHER_IMAGE, Store(other));
+  EXPECT_EQ(3, GetImageLoader().GetPendingCount());
+
+  GetImageLoader().Finish();
+
+  EXPECT_EQ(3, completed);
+  ASSERT_TRUE(first.IsValid());
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, other);
+}
+
+TEST_F(TestImageLoader, TestMaxSize)
+{
+  ObjectPtr<BaseTexture> reduced, full;
+  GetImageLoader().Load(IMAGE, Store(reduced), 10);
+  GetImageLoader().Load(IMAGE, Store(full));
+
+  GetImageLoader().Finish();
+
+  EXPECT_EQ(2, completed);
+  ASSERT_TRUE(reduced.IsValid());
+  EXPECT_EQ(10, reduced->GetWidth());
+  EXPECT_EQ(10, reduced->GetHeight());
+  ASSERT_TRUE(full.IsValid());
+  EXPECT_EQ(20, full->GetWidth());
+}
+
+TEST_F(TestImageLoader, TestCancel)
+{
+  ObjectPtr<BaseTexture> cancelled, kept;
+  ImageLoader::Handle handle = GetImageLoader().Load(IMAGE, Store(cancelled));
+  GetImageLoader().Load(IMAGE, Store(kept));
+
+  GetImageLoader().Cancel(handle);
+  EXPECT_FALSE(GetImageLoader().IsPending(handle));
+  EXPECT_EQ(1, GetImageLoader().GetPendingCount());
+
+  GetImageLoader().Finish();
+
+  EXPECT_EQ(1, completed);
+  EXPECT_FALSE(cancelled.IsValid());
+  EXPECT_TRUE(kept.IsValid());
+}
+
+TEST_F(TestImageLoader, TestCancelEveryRequest)
+{
+  ObjectPtr<BaseTexture> texture;
+  GetImageLoader().Cancel(GetImageLoader().Load(IMAGE, Store(texture)));
+  GetImageLoader().Finish();
+
+  EXPECT_EQ(0, completed);
+  EXPECT_EQ(0, GetImageLoader().GetPendingCount());
+}
+
+TEST_F(TestImageLoader, TestInvalidFile)
+{
+  ObjectPtr<BaseTexture> texture;
+  GetImageLoader().Load(TESTDIR "/no-such-image.png", Store(texture));
+  GetImageLoader().Finish();
+
+  EXPECT_EQ(1, completed);
+  EXPECT_FALSE(texture.IsValid());
+}
+
+TEST_F(TestImageLoader, TestCallbackCanLoadAgain)
+{
+  ObjectPtr<BaseTexture> texture;
+  GetImageLoader().Load(IMAGE, [this, &texture] (ObjectPtr<BaseTexture> const&)
+  {
+    ++completed;
+    GetImageLoader().Load(IMAGE, Store(texture));
+  });
+
+  // The first Finish may or may not upload the second request, depending on the workers.
+  GetImageLoader().Finish();
+  GetImageLoader().Finish();
+  EXPECT_EQ(2, completed);
+  EXPECT_EQ(0, GetImageLoader().GetPendingCount());
+  EXPECT_TRUE(texture.IsValid());
+}
+
+TEST_F(TestImageLoader, TestPlaceholder)
+{
+  ObjectPtr<BaseTexture> placeholder = GetImageLoader().GetPlaceholderTexture();
+
+  ASSERT_TRUE(placeholder.IsValid());
+  EXPECT_EQ(1, placeholder->GetWidth());
+  EXPECT_EQ(1, placeholder->GetHeight());
+  EXPECT_EQ(placeholder, GetImageLoader().GetPlaceholderTexture());
+}
+
+TEST_F(TestImageLoader, TestUploadBudget)
+{
+  EXPECT_EQ(ImageLoader::DEFAULT_UPLOAD_BUDGET, GetImageLoader().GetUploadBudget());
+
+  GetImageLoader().SetUploadBudget(-1);
+  EXPECT_EQ(0, GetImageLoader().GetUploadBudget());
+}
+
+TEST_F(TestImageLoader, TestTextureAreaAsync)
+{
+  ObjectPtr<TextureArea> area(new TextureArea());
+  area->LoadImageFileAsync(IMAGE);
+  EXPECT_EQ(1, GetImageLoader().GetPendingCount());
+
+  area->SetColor(color::Red);
+  EXPECT_EQ(0, GetImageLoader().GetPendingCount());
+
+  area->LoadImageFileAsync(IMAGE);
+  GetImageLoader().Finish();
+  EXPECT_EQ(0, GetImageLoader().GetPendingCount());
+
+  std::unique_ptr<AbstractPaintLayer> layer(area->GetPaintLayer());
+  EXPECT_EQ(20, static_cast<TextureLayer*>(layer.get())->GetDeviceTexture()->GetWidth());
+}
+
+TEST_F(TestImageLoader, TestDestroyWindowThreadWithPendingLoad)
+{
+  HLayout* layout = new HLayout();
+  TextureArea* area = new TextureArea();
+  layout->AddView(area);
+  wnd_thread->SetLayout(layout);
+
+  area->LoadImageFileAsync(IMAGE);
+  EXPECT_EQ(1, GetImageLoader().GetPendingCount());
+
+  // The area cancels its load while the window thread destroys its layout.
+  wnd_thread.reset();
+}
+
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <gmock/gmock.h>
+#include "Nux/Nux.h"
+#include "Nux/VLayout.h"
+#include "Nux/ProgramFramework/TestView.h"
+
+
+using namespace testing;
+
+namespace {
+
+struct CountingView : nux::TestView
+{
+  CountingView()
+    : compute_count(0)
+  {
+    SetMinMaxSize(100, 20);
+  }
+
+  long ComputeContentSize()
+  {
+    ++compute_count;
+    return nux::TestView::ComputeContentSize();
+  }
+
+  int compute_count;
+};
+
+struct TestLayoutContentSizeCache : public testing::Test
+{
+  void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("Layout Test", 300, 200, nux::WINDOWSTYLE_NORMAL,
+                                          NULL, false, NULL, NULL));
+
+    layout = new nux::VLayout(NUX_TRACKER_LOCATION);
+    layout->SetContentDistribution(nux::MAJOR_POSITION_START);
+
+    for (int i = 0; i < 3; ++i)
+    {
+      views[i] = new CountingView();
+      layout->AddView(views[i], 0);
+    }
+
+    layout->SetGeometry(0, 0, 300, 200);
+    Relayout();
+  }
+
+  void TearDown()
+  {
+    layout->UnReference();
+  }
+
+  void Relayout()
+  {
+    wnd_thread->ComputeElementLayout(layout);
+  }
+
+  void ResetCounts()
+  {
+    for (int i = 0; i < 3; ++i)
+      views[i]->compute_count = 0;
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+  nux::VLayout* layout;
+  CountingView* views[3];
+};
+
+TEST_F(TestLayoutContentSizeCache, TestUnchangedChildrenAreNotComputed)
+{
+  ResetCounts();
+  Relayout();
+
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(0, views[i]->compute_count);
+
+  EXPECT_EQ(20, views[1]->GetBaseHeight());
+}
+
+TEST_F(TestLayoutContentSizeCache, TestResizedChildIsComputed)
+{
+  ResetCounts();
+  views[1]->SetMinMaxSize(100, 40);
+  Relayout();
+
+  EXPECT_EQ(0, views[0]->compute_count);
+  EXPECT_LT(0, views[1]->compute_count);
+  EXPECT_EQ(40, views[1]->GetBaseHeight());
+  EXPECT_EQ(views[1]->GetBaseY() + 40, views[2]->GetBaseY());
+}
+
+TEST_F(TestLayoutContentSizeCache, TestInvalidatedChildIsComputed)
+{
+  ResetCounts();
+  views[2]->InvalidateContentSize();
+  Relayout();
+
+  EXPECT_EQ(0, views[0]->compute_count);
+  EXPECT_EQ(0, views[1]->compute_count);
+  EXPECT_LT(0, views[2]->compute_count);
+}
+
+TEST_F(TestLayoutContentSizeCache, TestQueuedChildIsComputed)
+{
+  ResetCounts();
+  wnd_thread->QueueObjectLayout(views[0]);
+  Relayout();
+
+  EXPECT_LT(0, views[0]->compute_count);
+  EXPECT_EQ(0, views[1]->compute_count);
+}
+
+TEST_F(TestLayoutContentSizeCache, TestShownChildIsComputed)
+{
+  views[1]->SetVisible(false);
+  Relayout();
+  ResetCounts();
+
+  views[1]->SetVisible(true);
+  Relayout();
+
+  EXPECT_LT(0, views[1]->compute_count);
+  EXPECT_EQ(views[1]->GetBaseY() + 20, views[2]->GetBaseY());
+}
+
+struct DrawCountingView : nux::TestView
+{
+  DrawCountingView()
+    : draw_count(0)
+  {
+    SetMinMaxSize(100, 20);
+  }
+
+  void Draw(nux::GraphicsEngine& /* graphics_engine */, bool /* force_draw */)
+  {
+    ++draw_count;
+  }
+
+  int draw_count;
+};
+
+struct TestLayoutCulling : public testing::Test
+{
+  static const int NUM_VIEWS = 100;
+
+  void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("Layout Test", 300, 200, nux::WINDOWSTYLE_NORMAL,
+                                          NULL, false, NULL, NULL));
+
+    // The layout is ten times taller than the window.
+    layout = new nux::VLayout(NUX_TRACKER_LOCATION);
+    layout->SetContentDistribution(nux::MAJOR_POSITION_START);
+
+    for (int i = 0; i < NUM_VIEWS; ++i)
+    {
+      views[i] = new DrawCountingView();
+      layout->AddView(views[i], 0);
+    }
+
+    layout->SetGeometry(0, 0, 300, 2000);
+    wnd_thread->ComputeElementLayout(layout);
+  }
+
+  void TearDown()
+  {
+    layout->UnReference();
+  }
+
+  void Draw()
+  {
+    for (int i = 0; i < NUM_VIEWS; ++i)
+      views[i]->draw_count = 0;
+
+    nux::Layout::ResetDrawStatistics();
+    layout->ProcessDraw(wnd_thread->GetGraphicsEngine(), true);
+  }
+
+  void ExpectDrawn(int first, int last)
+  {
+    for (int i = 0; i < NUM_VIEWS; ++i)
+      EXPECT_EQ((i >= first && i <= last) ? 1 : 0, views[i]->draw_count) << "view " << i;
+
+    nux::Layout::DrawStatistics const& statistics = nux::Layout::GetDrawStatistics();
+    EXPECT_EQ(unsigned(last - first + 1), statistics.drawn_children);
+    EXPECT_EQ(unsigned(NUM_VIEWS - (last - first + 1)), statistics.culled_children);
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+  nux::VLayout* layout;
+  DrawCountingView* views[NUM_VIEWS];
+};
+
+TEST_F(TestLayoutCulling, TestChildrenOutsideOfTheWindowAreCulled)
+{
+  Draw();
+  // The culling is conservative, the view touching the bottom of the window is drawn.
+  ExpectDrawn(0, 10);
+}
+
+TEST_F(TestLayoutCulling, TestTranslatedLayout)
+{
+  layout->Set2DTranslation(0, -1000, 0);
+  Draw();
+  ExpectDrawn(49, 60);
+}
+
+TEST_F(TestLayoutCulling, TestDrawIndex)
+{
+  layout->SetDrawIndexEnabled(true);
+  Draw();
+  ExpectDrawn(0, 10);
+
+  layout->Set2DTranslation(0, -1000, 0);
+  Draw();
+  ExpectDrawn(49, 60);
+
+  // The index follows the changes of the children.
+  views[55]->SetVisible(false);
+  views[56]->SetMinMaxSize(100, 1000);
+  wnd_thread->ComputeElementLayout(layout);
+  Draw();
+  EXPECT_EQ(0, views[55]->draw_count);
+  EXPECT_EQ(1, views[56]->draw_count);
+  EXPECT_EQ(0, views[57]->draw_count);
+  EXPECT_EQ(1, views[54]->draw_count);
+}
+
+TEST_F(TestLayoutCulling, TestHiddenChildrenAreCountedTheSameWithTheDrawIndex)
+{
+  views[5]->SetVisible(false);
+  views[50]->SetVisible(false);
+
+  for (bool enabled : {false, true})
+  {
+    layout->SetDrawIndexEnabled(enabled);
+    Draw();
+
+    // The hidden view outside of the window is culled, the one inside is neither drawn nor culled.
+    nux::Layout::DrawStatistics const& statistics = nux::Layout::GetDrawStatistics();
+    EXPECT_EQ(10u, statistics.drawn_children) << "draw index " << enabled;
+    EXPECT_EQ(unsigned(NUM_VIEWS - 11), statistics.culled_children) << "draw index " << enabled;
+  }
+}
+
+TEST_F(TestLayoutCulling, TestHitTestIndex)
+{
+  nux::Geometry geo = views[3]->GetAbsoluteGeometry();
+  nux::Point center(geo.x + geo.width / 2, geo.y + geo.height / 2);
+
+  layout->SetHitTestIndexEnabled(true);
+  EXPECT_EQ(views[3], layout->FindAreaUnderMouse(center, nux::NUX_MOUSE_MOVE));
+
+  views[3]->SetVisible(false);
+  EXPECT_EQ(nullptr, layout->FindAreaUnderMouse(center, nux::NUX_MOUSE_MOVE));
+  views[3]->SetVisible(true);
+
+  // The index finds the same areas as walking the children, also after they move.
+  for (int translation : {0, -1000})
+  {
+    layout->Set2DTranslation(0, translation, 0);
+
+    for (int y = -5; y < 2005; y += 7)
+    {
+      for (int x = 0; x < 300; x += 25)
+      {
+        nux::Point position(x, y + translation);
+
+        nux::Area* expected = nullptr;
+        for (int i = 0; i < NUM_VIEWS && !expected && layout->GetAbsoluteGeometry().IsInside(position); ++i)
+          expected = views[i]->FindAreaUnderMouse(position, nux::NUX_MOUSE_MOVE);
+
+        ASSERT_EQ(expected, layout->FindAreaUnderMouse(position, nux::NUX_MOUSE_MOVE)) << x << ", " << y;
+      }
+    }
+
+    views[56]->SetMinMaxSize(100, 60);
+    wnd_thread->ComputeElementLayout(layout);
+  }
+}
+
+}
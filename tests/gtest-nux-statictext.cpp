@@ -8,6 +8,7 @@
 
 #include "Nux/Nux.h"
 #include "Nux/StaticText.h"
+#include "Nux/TextRenderingCache.h"
 
 
 using namespace testing;
@@ -49,4 +50,44 @@ TEST(TestStaticText, TestCreate)
   delete wnd_thread;
 }
 
+TEST(TestStaticText, TestIdenticalTextsShareTexture)
+{
+  nux::NuxInitialize(0);
+  nux::WindowThread *wnd_thread = nux::CreateNuxWindow("Nux Window", 300, 200,
+    nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL);
+
+  nux::TextRenderingCache& cache = nux::TextRenderingCache::Instance();
+
+  nux::StaticText *statictext1 = new nux::StaticText("Shared label");
+  nux::StaticText *statictext2 = new nux::StaticText("Shared label");
+  statictext2->SetTextColor(nux::color::Red);
+
+  int rasterizations = cache.GetRasterizationCount();
+  nux::ObjectPtr<nux::IOpenGLBaseTexture> texture1 = statictext1->GetTextAlphaTexture();
+  nux::ObjectPtr<nux::IOpenGLBaseTexture> texture2 = statictext2->GetTextAlphaTexture();
+
+  ASSERT_TRUE(texture1.IsValid());
+  EXPECT_EQ(texture1, texture2);
+  EXPECT_EQ(rasterizations + 1, cache.GetRasterizationCount());
+
+  // A color change does not rasterize the text again.
+  statictext1->SetTextColor(nux::color::Blue);
+  EXPECT_EQ(texture1, statictext1->GetTextAlphaTexture());
+  EXPECT_EQ(rasterizations + 1, cache.GetRasterizationCount());
+
+  statictext2->SetText("Other label");
+  EXPECT_NE(texture1, statictext2->GetTextAlphaTexture());
+  EXPECT_EQ(rasterizations + 2, cache.GetRasterizationCount());
+
+  // GetTextTexture keeps returning an RGBA texture.
+  nux::ObjectPtr<nux::IOpenGLBaseTexture> rgba_texture = statictext1->GetTextTexture();
+  ASSERT_TRUE(rgba_texture.IsValid());
+  EXPECT_NE(texture1, rgba_texture);
+  EXPECT_NE(nux::BITFMT_A8, rgba_texture->GetPixelFormat());
+
+  statictext1->UnReference();
+  statictext2->UnReference();
+  delete wnd_thread;
+}
+
 }
@@ -0,0 +1,121 @@
+#include <gmock/gmock.h>
+#include <glib.h>
+
+#include "Nux/Nux.h"
+#include "Nux/TimerProc.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+class TestTimerHandler : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("nux::TestTimerHandler", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+    ticks = 0;
+    expirations = 0;
+    timeout.tick.connect([this] (void*) { ++ticks; });
+    timeout.expired.connect([this] (void*) { ++expirations; });
+  }
+
+  TimerHandler& GetTimerHandler()
+  {
+    return wnd_thread->GetTimerHandler();
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+  TimeOutSignal timeout;
+  int ticks;
+  int expirations;
+};
+
+TEST_F(TestTimerHandler, TestOneShotTimer)
+{
+  TimerHandle handle = GetTimerHandler().AddOneShotTimer(0, &timeout, NULL);
+  EXPECT_TRUE(GetTimerHandler().FindTimerHandle(handle));
+
+  GetTimerHandler().ExecTimerHandler(0);
+
+  EXPECT_EQ(1, ticks);
+  EXPECT_EQ(1, expirations);
+  EXPECT_FALSE(GetTimerHandler().FindTimerHandle(handle));
+
+  GetTimerHandler().ExecTimerHandler(0);
+  EXPECT_EQ(1, ticks);
+}
+
+TEST_F(TestTimerHandler, TestRemovedTimerDoesNotTick)
+{
+  TimerHandle handle = GetTimerHandler().AddOneShotTimer(0, &timeout, NULL);
+  TimerHandle other = handle;
+
+  EXPECT_TRUE(GetTimerHandler().RemoveTimerHandler(handle));
+  EXPECT_FALSE(handle.Activated());
+  EXPECT_FALSE(GetTimerHandler().FindTimerHandle(other));
+  EXPECT_FALSE(GetTimerHandler().RemoveTimerHandler(other));
+
+  GetTimerHandler().ExecTimerHandler(0);
+  EXPECT_EQ(0, ticks);
+}
+
+TEST_F(TestTimerHandler, TestIterativeTimer)
+{
+  TimerHandle handle = GetTimerHandler().AddIterativeTimer(0, 3, &timeout, NULL);
+
+  // Each dispatch runs every timer once, even the ones that are due again right away.
+  for (int i = 0; i < 5; ++i)
+    GetTimerHandler().ExecTimerHandler(0);
+
+  EXPECT_EQ(3, ticks);
+  EXPECT_EQ(1, expirations);
+  EXPECT_EQ(3, handle.GetProgressIterationCount());
+}
+
+TEST_F(TestTimerHandler, TestDelayUntilEarliestTimer)
+{
+  TimerHandle late = GetTimerHandler().AddOneShotTimer(10000, &timeout, NULL);
+  TimerHandle early = GetTimerHandler().AddOneShotTimer(500, &timeout, NULL);
+
+  EXPECT_LE(GetTimerHandler().DelayUntilNextTimerExpires(), 500);
+  EXPECT_GT(GetTimerHandler().DelayUntilNextTimerExpires(), 400);
+
+  GetTimerHandler().RemoveTimerHandler(early);
+  EXPECT_GT(GetTimerHandler().DelayUntilNextTimerExpires(), 9000);
+
+  // Timers that are not due are not dispatched.
+  GetTimerHandler().ExecTimerHandler(0);
+  EXPECT_EQ(0, ticks);
+  EXPECT_TRUE(GetTimerHandler().FindTimerHandle(late));
+}
+
+TEST_F(TestTimerHandler, TestSlackDelaysWakeUp)
+{
+  GetTimerHandler().SetTimerSlack(1000);
+  EXPECT_EQ(1000u, GetTimerHandler().GetTimerSlack());
+
+  GetTimerHandler().AddOneShotTimer(500, &timeout, NULL);
+  EXPECT_GT(GetTimerHandler().DelayUntilNextTimerExpires(), 1400);
+}
+
+TEST_F(TestTimerHandler, TestPauseAndResume)
+{
+  TimerHandle handle = GetTimerHandler().AddDurationTimer(0, 1000, &timeout, NULL);
+
+  EXPECT_TRUE(GetTimerHandler().PauseTimer(handle));
+  EXPECT_FALSE(GetTimerHandler().PauseTimer(handle));
+  EXPECT_TRUE(GetTimerHandler().FindTimerHandle(handle));
+
+  GetTimerHandler().ExecTimerHandler(0);
+  EXPECT_EQ(0, ticks);
+
+  EXPECT_TRUE(GetTimerHandler().ResumeTimer(handle));
+  GetTimerHandler().ExecTimerHandler(0);
+  EXPECT_EQ(1, ticks);
+}
+
+}
@@ -777,3 +777,123 @@ TEST_F(EmbeddedContextMultiWindow, MoveToPresentationListAfterFrameEndedIfCaught
 
 
 }
+
+namespace nux
+{
+class TestWindowThreadLayoutQueue : public testing::Test
+{
+public:
+  class CountingLayout : public HLayout
+  {
+  public:
+    CountingLayout()
+      : compute_content_size_calls(0)
+    {}
+
+    long ComputeContentSize()
+    {
+      ++compute_content_size_calls;
+      return HLayout::ComputeContentSize();
+    }
+
+    int compute_content_size_calls;
+  };
+
+  void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("WindowThread Layout Queue Test", 300, 200, nux::WINDOWSTYLE_NORMAL,
+                                          NULL, false, NULL, NULL));
+  }
+
+  void ComputeQueuedLayout()
+  {
+    wnd_thread->ComputeQueuedLayout();
+  }
+
+  // Flush the areas queued while building the hierarchy.
+  void ResetLayoutQueue(std::vector<CountingLayout*> const& layouts)
+  {
+    wnd_thread->ComputeQueuedLayout();
+
+    for (auto layout : layouts)
+      layout->compute_content_size_calls = 0;
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+};
+
+TEST_F(TestWindowThreadLayoutQueue, TestAreaIsQueuedOnce)
+{
+  ObjectPtr<CountingLayout> layout(new CountingLayout());
+
+  EXPECT_TRUE(wnd_thread->QueueObjectLayout(layout.GetPointer()));
+  EXPECT_TRUE(wnd_thread->QueueObjectLayout(layout.GetPointer()));
+  ComputeQueuedLayout();
+
+  EXPECT_EQ(1, layout->compute_content_size_calls);
+}
+
+TEST_F(TestWindowThreadLayoutQueue, TestRemoveFromQueue)
+{
+  ObjectPtr<CountingLayout> layout(new CountingLayout());
+
+  wnd_thread->QueueObjectLayout(layout.GetPointer());
+  EXPECT_TRUE(wnd_thread->RemoveObjectFromLayoutQueue(layout.GetPointer()));
+  EXPECT_FALSE(wnd_thread->RemoveObjectFromLayoutQueue(layout.GetPointer()));
+  ComputeQueuedLayout();
+
+  EXPECT_EQ(0, layout->compute_content_size_calls);
+}
+
+TEST_F(TestWindowThreadLayoutQueue, TestDestroyedAreaIsSkipped)
+{
+  ObjectPtr<CountingLayout> layout(new CountingLayout());
+  CountingLayout* destroyed_layout = new CountingLayout();
+
+  wnd_thread->QueueObjectLayout(destroyed_layout);
+  wnd_thread->QueueObjectLayout(layout.GetPointer());
+  destroyed_layout->UnReference();
+  ComputeQueuedLayout();
+
+  EXPECT_EQ(1, layout->compute_content_size_calls);
+}
+
+TEST_F(TestWindowThreadLayoutQueue, TestDescendantOfQueuedAncestorIsCollapsed)
+{
+  ObjectPtr<CountingLayout> parent(new CountingLayout());
+  CountingLayout* child = new CountingLayout();
+  CountingLayout* grand_child = new CountingLayout();
+  parent->AddLayout(child);
+  child->AddLayout(grand_child);
+  ResetLayoutQueue({parent.GetPointer(), child, grand_child});
+
+  // Queued bottom-up, processed top-down: the parent computes the size of its whole subtree.
+  wnd_thread->QueueObjectLayout(grand_child);
+  wnd_thread->QueueObjectLayout(child);
+  wnd_thread->QueueObjectLayout(parent.GetPointer());
+  ComputeQueuedLayout();
+
+  EXPECT_EQ(1, parent->compute_content_size_calls);
+  EXPECT_EQ(1, child->compute_content_size_calls);
+  EXPECT_EQ(1, grand_child->compute_content_size_calls);
+}
+
+TEST_F(TestWindowThreadLayoutQueue, TestSiblingsAreComputed)
+{
+  ObjectPtr<CountingLayout> parent(new CountingLayout());
+  CountingLayout* child1 = new CountingLayout();
+  CountingLayout* child2 = new CountingLayout();
+  parent->AddLayout(child1);
+  parent->AddLayout(child2);
+  ResetLayoutQueue({parent.GetPointer(), child1, child2});
+
+  wnd_thread->QueueObjectLayout(child1);
+  wnd_thread->QueueObjectLayout(child2);
+  ComputeQueuedLayout();
+
+  EXPECT_EQ(0, parent->compute_content_size_calls);
+  EXPECT_EQ(1, child1->compute_content_size_calls);
+  EXPECT_EQ(1, child2->compute_content_size_calls);
+}
+}
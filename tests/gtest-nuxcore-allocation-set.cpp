@@ -0,0 +1,90 @@
+#include <gmock/gmock.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "NuxCore/AllocationSet.h"
+
+using namespace testing;
+
+namespace {
+
+TEST(TestAllocationSet, TestInsertEraseContains)
+{
+  nux::AllocationSet set;
+  int a, b;
+
+  EXPECT_FALSE(set.Contains(&a));
+  EXPECT_TRUE(set.Insert(&a));
+  EXPECT_FALSE(set.Insert(&a));
+  EXPECT_TRUE(set.Contains(&a));
+  EXPECT_FALSE(set.Contains(&b));
+  EXPECT_EQ(1u, set.GetSize());
+
+  EXPECT_FALSE(set.Erase(&b));
+  EXPECT_TRUE(set.Erase(&a));
+  EXPECT_FALSE(set.Contains(&a));
+  EXPECT_EQ(0u, set.GetSize());
+}
+
+TEST(TestAllocationSet, TestManyAddresses)
+{
+  nux::AllocationSet set;
+  std::vector<char> buffer(100000 * 16);
+  std::set<void*> expected;
+
+  for (std::size_t i = 0; i < buffer.size(); i += 16)
+  {
+    set.Insert(&buffer[i]);
+    expected.insert(&buffer[i]);
+  }
+
+  ASSERT_EQ(expected.size(), set.GetSize());
+
+  // Remove every other address and check that the remaining ones are still found.
+  for (std::size_t i = 0; i < buffer.size(); i += 32)
+  {
+    ASSERT_TRUE(set.Erase(&buffer[i]));
+    expected.erase(&buffer[i]);
+  }
+
+  for (std::size_t i = 0; i < buffer.size(); i += 16)
+    ASSERT_EQ(expected.count(&buffer[i]) == 1, set.Contains(&buffer[i]));
+
+  std::vector<void*> addresses = set.GetAddresses();
+  EXPECT_EQ(expected, std::set<void*>(addresses.begin(), addresses.end()));
+}
+
+TEST(TestAllocationSet, TestConcurrentThreads)
+{
+  nux::AllocationSet set;
+  const int THREADS = 4;
+  const int OBJECTS = 20000;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < THREADS; ++t)
+  {
+    threads.push_back(std::thread([&set] {
+      std::vector<int*> objects;
+
+      for (int i = 0; i < OBJECTS; ++i)
+      {
+        objects.push_back(new int(i));
+        set.Insert(objects.back());
+      }
+
+      for (int* object : objects)
+      {
+        set.Erase(object);
+        delete object;
+      }
+    }));
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0u, set.GetSize());
+}
+
+}
@@ -350,6 +350,39 @@ TEST(TestEasingCurve, TestInOutQuad) {
   ASSERT_THAT(curve.ValueForProgress(1.5), DoubleEq(1));
 }
 
+const na::EasingCurve::Type CURVE_TYPES[] = {
+  na::EasingCurve::Type::Linear,
+  na::EasingCurve::Type::InQuad,
+  na::EasingCurve::Type::OutQuad,
+  na::EasingCurve::Type::InOutQuad,
+  na::EasingCurve::Type::BackEaseIn,
+  na::EasingCurve::Type::BackEaseOut,
+  na::EasingCurve::Type::BackEaseInOut,
+  na::EasingCurve::Type::BounceIn,
+  na::EasingCurve::Type::BounceOut,
+  na::EasingCurve::Type::BounceInOut,
+  na::EasingCurve::Type::ExpoEaseIn,
+  na::EasingCurve::Type::ExpoEaseOut
+};
+
+TEST(TestEasingCurve, TestValuesForProgress) {
+
+  std::vector<double> progress;
+  for (int i = -10; i <= 110; ++i)
+    progress.push_back(i / 100.0);
+
+  for (auto type : CURVE_TYPES)
+  {
+    na::EasingCurve curve(type);
+    std::vector<double> values(progress.size());
+    curve.ValuesForProgress(&progress[0], &values[0], progress.size());
+
+    // The batch evaluation gives exactly the same values.
+    for (std::size_t i = 0; i < progress.size(); ++i)
+      ASSERT_EQ(curve.ValueForProgress(progress[i]), values[i]) << "progress " << progress[i];
+  }
+}
+
 
 /**
  * Animating values
@@ -782,6 +815,41 @@ TEST_F(TestAnimationHookup, TestTwoAnimation)
   ticker.ms_tick(201);
 }
 
+TEST_F(TestAnimationHookup, TestManyAnimations)
+{
+  // The controller evaluates the curves of all the animations together, the
+  // values are the same as advancing each animation.
+  std::vector<std::shared_ptr<na::AnimateValue<double>>> animations;
+  for (int i = 0; i < 120; ++i)
+  {
+    animations.push_back(std::make_shared<na::AnimateValue<double>>(i, 2 * i, 500 + 10 * i));
+    animations.back()->SetEasingCurve(na::EasingCurve(CURVE_TYPES[i % 12]));
+    animations.back()->Start();
+  }
+
+  // Removing some animations doesn't change the others.
+  for (int i = 0; i < 120; i += 7)
+    animations[i]->Stop();
+
+  for (int tick = 1; tick <= 10; ++tick)
+  {
+    ticker.ms_tick(101);
+    for (int i = 0; i < 120; ++i)
+    {
+      int duration = 500 + 10 * i;
+      double expected = i;
+      if (i % 7 != 0)
+      {
+        if (101 * tick >= duration)
+          expected = 2 * i;
+        else
+          expected = i + (2 * i - i) * na::EasingCurve(CURVE_TYPES[i % 12]).ValueForProgress(101 * tick / static_cast<double>(duration));
+      }
+      ASSERT_THAT(animations[i]->GetCurrentValue(), Eq(expected)) << "animation " << i << ", tick " << tick;
+    }
+  }
+}
+
 TEST_F(TestAnimationHookup, TestIntProperty)
 {
   nux::Property<int> int_property;
@@ -1,5 +1,8 @@
+#include <atomic>
 #include <string>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 #include <iostream>
 
@@ -105,6 +108,97 @@ TEST_F(TestAsyncfileWriter, TestWriteLots) {
   EXPECT_THAT(file_content, MatchesRegex("^x+$"));
 }
 
+TEST_F(TestAsyncfileWriter, TestConcurrentWrites) {
+  std::string filename(TEST_ROOT + "/concurrent-file");
+  const int thread_count = 4;
+  const int loop_count = 1000;
+  {
+    nux::AsyncFileWriter writer(filename);
+    // Small enough for the writers to wait for the main loop.
+    writer.SetMemoryLimit(64 * 1024, nux::AsyncFileWriter::BLOCK_WRITERS);
+
+    std::atomic<int> finished(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+      threads.push_back(std::thread([&writer, &finished, t] {
+        std::string line(99, 'a' + t);
+        line += '\n';
+        for (int i = 0; i < loop_count; ++i)
+          writer.Write(line);
+        ++finished;
+      }));
+    }
+    while (finished != thread_count) {
+      PumpGObjectMainLoop();
+      std::this_thread::yield();
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    writer.Close();
+    bool closed = WaitForClose(writer);
+    EXPECT_TRUE(closed);
+    EXPECT_THAT(writer.GetDroppedBytes(), Eq(0u));
+  }
+  std::string file_content = ReadFile(filename);
+  EXPECT_THAT(file_content.size(), Eq(100u * thread_count * loop_count));
+  // The writes are not interleaved.
+  for (std::size_t i = 0; i < file_content.size(); i += 100) {
+    std::string line(99, file_content[i]);
+    line += '\n';
+    ASSERT_THAT(file_content.substr(i, 100), Eq(line));
+  }
+}
+
+TEST_F(TestAsyncfileWriter, TestDropWrites) {
+  std::string filename(TEST_ROOT + "/drop-file");
+  std::string data(20000, 'x');
+  {
+    nux::AsyncFileWriter writer(filename);
+    writer.SetMemoryLimit(0, nux::AsyncFileWriter::DROP_WRITES);
+    // Nothing is written before the file is opened, the first write is
+    // accepted as nothing is pending and the others go over the limit.
+    writer.Write(data);
+    writer.Write(data);
+    writer.Write(data);
+    EXPECT_THAT(writer.GetDroppedBytes(), Eq(2 * data.size()));
+    writer.Close();
+    bool closed = WaitForClose(writer);
+    EXPECT_TRUE(closed);
+  }
+  EXPECT_THAT(ReadFile(filename), Eq(data));
+}
+
+TEST_F(TestAsyncfileWriter, TestOpenFailureReleasesWriters) {
+  std::string filename(TEST_ROOT + "/missing-directory/file");
+  std::string data(1000, 'x');
+  const int loop_count = 100;
+  {
+    nux::AsyncFileWriter writer(filename);
+    writer.SetMemoryLimit(10 * 1024, nux::AsyncFileWriter::BLOCK_WRITERS);
+
+    // The writer would wait forever for the file to be opened.
+    std::atomic<bool> finished(false);
+    std::thread thread([&writer, &finished, &data, loop_count] {
+      for (int i = 0; i < loop_count; ++i)
+        writer.Write(data);
+      finished = true;
+    });
+
+    TestCallback timed_out;
+    g_timeout_add_seconds(5, &TestCallback::glib_callback, &timed_out);
+    while (!finished && !timed_out.happened) {
+      PumpGObjectMainLoop();
+      std::this_thread::yield();
+    }
+    EXPECT_TRUE(finished);
+    thread.join();
+
+    EXPECT_THAT(writer.GetDroppedBytes(), Eq(data.size() * loop_count));
+  }
+  EXPECT_FALSE(bf::exists(filename));
+}
+
 
 
 } // anon namespace
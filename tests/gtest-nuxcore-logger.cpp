@@ -171,6 +171,52 @@ TEST(TestLoggingWriter, TestWriteMessage) {
   EXPECT_THAT(result, Eq("ERROR 2010-09-10 06:34:45 test.module testfile.cpp:1234 my message\n"));
 }
 
+TEST(TestLoggingWriter, TestAsynchronousWriteMessage) {
+
+  nt::CaptureLogOutput log_output;
+
+  UseTimezone timezone(":Antarctica/Vostok");
+  std::time_t when = 1284078885;
+  Writer::Instance().SetAsynchronous(true);
+  EXPECT_TRUE(Writer::Instance().IsAsynchronous());
+  Writer::Instance().WriteMessage(Level::Error, "test.module", "testfile.cpp",
+                                  1234, when, "my message");
+  Writer::Instance().WriteMessage(Level::Debug, "test.module", "/some/testfile.cpp",
+                                  1235, when, "other message");
+  Writer::Instance().Flush();
+  Writer::Instance().SetAsynchronous(false);
+  EXPECT_FALSE(Writer::Instance().IsAsynchronous());
+
+  std::string result = log_output.GetOutput();
+  EXPECT_THAT(result, Eq("ERROR 2010-09-10 06:34:45 test.module testfile.cpp:1234 my message\n"
+                         "DEBUG 2010-09-10 06:34:45 test.module testfile.cpp:1235 other message\n"));
+}
+
+TEST(TestLoggingWriter, TestAsynchronousDropsWhenFull) {
+
+  nt::CaptureLogOutput log_output;
+
+  std::size_t dropped = Writer::Instance().GetDroppedMessageCount();
+  Writer::Instance().SetAsynchronous(true, 4);
+  const int messages = 1000;
+  for (int i = 0; i < messages; ++i)
+    Writer::Instance().WriteMessage(Level::Info, "test.module", "testfile.cpp",
+                                    i, 0, "message");
+  Writer::Instance().SetAsynchronous(false);
+  dropped = Writer::Instance().GetDroppedMessageCount() - dropped;
+
+  // Every message is either written or counted as dropped.
+  std::string result = log_output.GetOutput();
+  std::size_t written = 0;
+  for (std::string::size_type pos = result.find(" message\n"); pos != std::string::npos;
+       pos = result.find(" message\n", pos + 1))
+    ++written;
+
+  EXPECT_EQ(std::size_t(messages), written + dropped);
+  if (dropped)
+    EXPECT_THAT(result, HasSubstr("messages dropped"));
+}
+
 TEST(TestLogStream, TestSimpleConstruction) {
   // First test is to make sure a LogStream can be constructed and destructed.
   LogStream test(Level::Debug, "module", "filename", 42);
@@ -0,0 +1,226 @@
+#include <gmock/gmock.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "NuxCore/NuxCore.h"
+#include "NuxCore/Math/Vector4.h"
+#include "NuxCore/Math/Matrix4.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+// The float functions are compared with the generic template on doubles.
+typedef Matrix4x4<double> Matrix4d;
+
+const float EPSILON = std::numeric_limits<float>::epsilon();
+const int ITERATIONS = 1000;
+
+float RandomFloat()
+{
+  return (rand() % 20001 - 10000) / 1000.0f;
+}
+
+Matrix4 RandomMatrix()
+{
+  Matrix4 matrix;
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      matrix.m[i][j] = RandomFloat();
+
+  return matrix;
+}
+
+Vector4 RandomVector()
+{
+  return Vector4(RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat());
+}
+
+Matrix4d ToDouble(Matrix4 const& matrix)
+{
+  Matrix4d result;
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      result.m[i][j] = matrix.m[i][j];
+
+  return result;
+}
+
+TEST(TestMatrix4, TestStorageIsAligned)
+{
+  struct Holder
+  {
+    char c;
+    Matrix4 matrix;
+  };
+
+  Holder holder;
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(holder.matrix.m) % 16);
+
+  std::vector<Matrix4> matrices(3);
+  for (auto const& matrix : matrices)
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(matrix.m) % 16);
+}
+
+TEST(TestMatrix4, TestMultiplyMatchesGeneric)
+{
+  srand(42);
+
+  for (int n = 0; n < ITERATIONS; ++n)
+  {
+    Matrix4 a = RandomMatrix();
+    Matrix4 b = RandomMatrix();
+    Matrix4 product = a * b;
+    Matrix4d expected = ToDouble(a) * ToDouble(b);
+
+    for (int i = 0; i < 4; ++i)
+    {
+      for (int j = 0; j < 4; ++j)
+      {
+        // Bound of the rounding errors of the sum of 4 products.
+        double magnitude = 0;
+        for (int k = 0; k < 4; ++k)
+          magnitude += std::fabs(double(a.m[i][k]) * b.m[k][j]);
+
+        EXPECT_NEAR(expected.m[i][j], product.m[i][j], 4 * EPSILON * magnitude) << "element " << i << ", " << j;
+      }
+    }
+  }
+}
+
+TEST(TestMatrix4, TestMultiplyByIdentity)
+{
+  srand(42);
+  Matrix4 a = RandomMatrix();
+
+  EXPECT_TRUE(a * Matrix4::IDENTITY() == a);
+  EXPECT_TRUE(Matrix4::IDENTITY() * a == a);
+}
+
+TEST(TestMatrix4, TestVectorMatchesGeneric)
+{
+  srand(42);
+
+  for (int n = 0; n < ITERATIONS; ++n)
+  {
+    Matrix4 a = RandomMatrix();
+    Vector4 v = RandomVector();
+    Vector4 result = a * v;
+    Vector4 expected = ToDouble(a) * v;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      double magnitude = 0;
+      for (int k = 0; k < 4; ++k)
+        magnitude += std::fabs(double(a.m[i][k]) * v[k]);
+
+      EXPECT_NEAR(expected[i], result[i], 4 * EPSILON * magnitude) << "element " << i;
+    }
+  }
+}
+
+TEST(TestMatrix4, TestTransformPoints)
+{
+  srand(42);
+  Matrix4 a = RandomMatrix();
+
+  std::vector<Vector4> points(37);
+  for (auto& point : points)
+    point = RandomVector();
+
+  std::vector<Vector4> transformed(points.size());
+  a.TransformPoints(&points[0], &transformed[0], points.size());
+
+  for (size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(a * points[i] == transformed[i]) << "point " << i;
+
+  // In place.
+  a.TransformPoints(&points[0], &points[0], points.size());
+  EXPECT_TRUE(points == transformed);
+
+  // Vectors that are not aligned on 16 bytes.
+  std::vector<float> floats(4 * 5 + 1);
+  Vector4* unaligned = reinterpret_cast<Vector4*>(&floats[1]);
+  for (int i = 0; i < 5; ++i)
+    unaligned[i] = transformed[i];
+
+  a.TransformPoints(unaligned, unaligned, 5);
+  for (int i = 0; i < 5; ++i)
+    EXPECT_TRUE(a * transformed[i] == unaligned[i]) << "point " << i;
+}
+
+TEST(TestMatrix4, TestInverseMatchesGeneric)
+{
+  srand(42);
+
+  for (int n = 0; n < ITERATIONS; ++n)
+  {
+    // Diagonally dominant matrices are far from singular.
+    Matrix4 a = RandomMatrix();
+    for (int i = 0; i < 4; ++i)
+      a.m[i][i] += (a.m[i][i] < 0 ? -40.0f : 40.0f);
+
+    Matrix4 inverse = a.GetInverse();
+    Matrix4d expected = ToDouble(a).GetInverse();
+
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        EXPECT_NEAR(expected.m[i][j], inverse.m[i][j], 1e-6) << "element " << i << ", " << j;
+
+    Matrix4 identity = a * inverse;
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        EXPECT_NEAR(i == j ? 1.0 : 0.0, identity.m[i][j], 1e-5) << "element " << i << ", " << j;
+  }
+}
+
+TEST(TestMatrix4, TestInverseOfPermutation)
+{
+  // The 2x2 blocks on the diagonal are not invertible.
+  Matrix4 a(0, 1, 0, 0,
+            1, 0, 0, 0,
+            0, 0, 0, 2,
+            0, 0, 4, 0);
+
+  Matrix4 expected(0, 1, 0, 0,
+                   1, 0, 0, 0,
+                   0, 0, 0, 0.25f,
+                   0, 0, 0.5f, 0);
+
+  a.Inverse();
+  EXPECT_TRUE(a == expected);
+}
+
+TEST(TestMatrix4, TestInverseOfTransforms)
+{
+  Matrix4 transform = Matrix4::TRANSLATE(10, -20, 5) * Matrix4::ROTATEZ(0.5f) * Matrix4::SCALE(2, 4, 8);
+  Matrix4 expected = Matrix4::SCALE(0.5f, 0.25f, 0.125f) * Matrix4::ROTATEZ(-0.5f) * Matrix4::TRANSLATE(-10, 20, -5);
+  Matrix4 inverse = transform.GetInverse();
+
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      EXPECT_NEAR(expected.m[i][j], inverse.m[i][j], 1e-5) << "element " << i << ", " << j;
+}
+
+TEST(TestMatrix4, TestSingularInverseUnchanged)
+{
+  Matrix4 a(1, 2, 3, 4,
+            2, 4, 6, 8,
+            0, 1, 0, 1,
+            1, 0, 1, 0);
+  Matrix4 copy = a;
+
+  a.Inverse();
+  EXPECT_TRUE(a == copy);
+
+  Matrix4 zero = Matrix4::ZERO();
+  zero.Inverse();
+  EXPECT_TRUE(zero == Matrix4::ZERO());
+}
+
+}
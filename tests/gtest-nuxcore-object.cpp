@@ -202,6 +202,57 @@ TEST(TestObject, TestObjectPtr2) {
   EXPECT_FALSE(weak_ptr());
 }
 
+TEST(TestObject, TestObjectPtrMove) {
+
+  OwnedObject *a = new OwnedObject(NUX_TRACKER_LOCATION);
+  nux::ObjectPtr<OwnedObject> obj_ptr(a);
+  a->UnReference();
+
+  nux::ObjectPtr<OwnedObject> moved(std::move(obj_ptr));
+  EXPECT_FALSE(obj_ptr.IsValid());
+  EXPECT_THAT(a->GetReferenceCount(), Eq(1));
+  EXPECT_THAT(a->ObjectPtrCount(), Eq(1));
+
+  obj_ptr = std::move(moved);
+  EXPECT_FALSE(moved.IsValid());
+  EXPECT_THAT(a->GetReferenceCount(), Eq(1));
+  EXPECT_THAT(a->ObjectPtrCount(), Eq(1));
+}
+
+TEST(TestObject, TestObjectWeakPtrOutlivesObject) {
+
+  OwnedObject *a = new OwnedObject(NUX_TRACKER_LOCATION);
+  nux::ObjectWeakPtr<OwnedObject> weak_ptr(a);
+  nux::ObjectWeakPtr<nux::Object> base_weak_ptr(weak_ptr);
+
+  EXPECT_THAT(a->GetReferenceCount(), Eq(1));
+  EXPECT_TRUE(base_weak_ptr == a);
+
+  EXPECT_TRUE(a->UnReference());
+
+  EXPECT_FALSE(weak_ptr.IsValid());
+  EXPECT_FALSE(base_weak_ptr.IsValid());
+  EXPECT_THAT(weak_ptr.GetPointer(), IsNull());
+
+  // Copies of an expired weak pointer are null.
+  nux::ObjectWeakPtr<OwnedObject> copy(weak_ptr);
+  EXPECT_TRUE(copy.IsNull());
+  copy = base_weak_ptr;
+  EXPECT_TRUE(copy.IsNull());
+}
+
+TEST(TestObject, TestObjectWeakPtrOnStackObject) {
+
+  nux::ObjectWeakPtr<OwnedObject> weak_ptr;
+  {
+    OwnedObject b(NUX_TRACKER_LOCATION);
+    weak_ptr = &b;
+    EXPECT_TRUE(weak_ptr.IsValid());
+  }
+
+  EXPECT_FALSE(weak_ptr.IsValid());
+}
+
 bool g_signal_called = false;
 
 void on_destroyed_cb (nux::Object * /* obj */)
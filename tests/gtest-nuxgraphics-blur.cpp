@@ -0,0 +1,148 @@
+#include <gmock/gmock.h>
+#include <cstdlib>
+#include <vector>
+
+#include "NuxGraphics/ImageBlur.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+// The blur of CairoGraphics before the SIMD implementations, for images of 4 bytes per pixel without padding.
+void ReferenceBlur(unsigned char* pixels, int width, int height, int radius)
+{
+  const int aprec = 16;
+  const int zprec = 7;
+  int alpha = (int) ((1 << aprec) * (1.0f - expf(-2.3f / (radius + 1.f))));
+  int z[4];
+
+  auto inner = [&] (unsigned char* pixel)
+  {
+    for (int c = 0; c < 4; ++c)
+    {
+      z[c] += (alpha * ((pixel[c] << zprec) - z[c])) >> aprec;
+      pixel[c] = z[c] >> zprec;
+    }
+  };
+
+  for (int row = 0; row < height; ++row)
+  {
+    unsigned char* scanline = pixels + row * width * 4;
+    for (int c = 0; c < 4; ++c)
+      z[c] = scanline[c] << zprec;
+
+    for (int index = 0; index < width; ++index)
+      inner(&scanline[index * 4]);
+    for (int index = width - 2; index >= 0; --index)
+      inner(&scanline[index * 4]);
+  }
+
+  for (int col = 0; col < width; ++col)
+  {
+    unsigned char* ptr = pixels + col * 4;
+    for (int c = 0; c < 4; ++c)
+      z[c] = ptr[c] << zprec;
+
+    for (int index = width; index < (height - 1) * width; index += width)
+      inner(&ptr[index * 4]);
+    for (int index = (height - 2) * width; index >= 0; index -= width)
+      inner(&ptr[index * 4]);
+  }
+}
+
+std::vector<unsigned char> RandomImage(int size)
+{
+  std::vector<unsigned char> pixels(size);
+  srand(42);
+
+  for (auto& pixel : pixels)
+    pixel = rand() % 256;
+
+  return pixels;
+}
+
+const BlurImplementation IMPLEMENTATIONS[] = { BLUR_SCALAR, BLUR_SSE2, BLUR_AVX2, BLUR_NEON };
+
+TEST(TestImageBlur, TestMatchesReference)
+{
+  const int width = 67, height = 45;
+  std::vector<unsigned char> reference = RandomImage(width * height * 4);
+  std::vector<unsigned char> original = reference;
+  ReferenceBlur(&reference[0], width, height, 5);
+
+  for (auto implementation : IMPLEMENTATIONS)
+  {
+    if (!IsBlurImplementationSupported(implementation))
+      continue;
+
+    std::vector<unsigned char> pixels = original;
+    ExpBlur(&pixels[0], width, height, width * 4, 4, 5, implementation, 1);
+    EXPECT_EQ(reference, pixels) << "implementation " << implementation;
+  }
+}
+
+TEST(TestImageBlur, TestImplementationsMatch)
+{
+  const int width = 131, height = 70, stride = 136;
+
+  for (int channels = 1; channels <= 4; ++channels)
+  {
+    std::vector<unsigned char> original = RandomImage(stride * channels * height);
+    std::vector<unsigned char> scalar = original;
+    ExpBlur(&scalar[0], width, height, stride * channels, channels, 12, BLUR_SCALAR, 1);
+
+    for (auto implementation : IMPLEMENTATIONS)
+    {
+      if (!IsBlurImplementationSupported(implementation))
+        continue;
+
+      for (int threads = 1; threads <= 3; ++threads)
+      {
+        std::vector<unsigned char> pixels = original;
+        ExpBlur(&pixels[0], width, height, stride * channels, channels, 12, implementation, threads);
+        EXPECT_EQ(scalar, pixels) << "implementation " << implementation << ", channels " << channels << ", threads " << threads;
+      }
+    }
+  }
+}
+
+TEST(TestImageBlur, TestSubRectangle)
+{
+  const int width = 64, height = 64, stride = width * 4;
+  std::vector<unsigned char> original = RandomImage(stride * height);
+
+  // Blurring a sub-rectangle is blurring an image that starts at its first pixel.
+  std::vector<unsigned char> pixels = original;
+  ExpBlur(&pixels[10 * stride + 8 * 4], 20, 30, stride, 4, 3);
+
+  std::vector<unsigned char> expected(20 * 4 * 30);
+  for (int y = 0; y < 30; ++y)
+    std::copy(&original[(10 + y) * stride + 8 * 4], &original[(10 + y) * stride + 28 * 4], &expected[y * 20 * 4]);
+  ExpBlur(&expected[0], 20, 30, 20 * 4, 4, 3);
+
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < stride; ++x)
+    {
+      int offset = y * stride + x;
+
+      if (y >= 10 && y < 40 && x >= 8 * 4 && x < 28 * 4)
+        ASSERT_EQ(expected[(y - 10) * 20 * 4 + x - 8 * 4], pixels[offset]);
+      else
+        ASSERT_EQ(original[offset], pixels[offset]);
+    }
+  }
+}
+
+TEST(TestImageBlur, TestUniformImageIsUnchanged)
+{
+  std::vector<unsigned char> pixels(32 * 32, 200);
+  ExpBlur(&pixels[0], 32, 32, 32, 1, 8);
+
+  for (auto pixel : pixels)
+    ASSERT_EQ(200, pixel);
+}
+
+}
@@ -0,0 +1,281 @@
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "NuxCore/NuxCore.h"
+#include "NuxCore/Color.h"
+#include "NuxGraphics/ImageKernels.h"
+#include "NuxGraphics/ImageSurface.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+std::vector<unsigned char> RandomImage(int size)
+{
+  std::vector<unsigned char> pixels(size);
+  srand(42);
+
+  for (auto& pixel : pixels)
+    pixel = rand() % 256;
+
+  return pixels;
+}
+
+int GetBytesPerPixel(BitmapFormat format)
+{
+  int offsets[4];
+  IsByteChannelFormat(format, offsets);
+  return *std::max_element(offsets, offsets + 4) + 1;
+}
+
+const PixelKernelImplementation IMPLEMENTATIONS[] = { PIXEL_KERNELS_SCALAR, PIXEL_KERNELS_SSE2, PIXEL_KERNELS_AVX2 };
+
+const BitmapFormat FORMATS[] = { BITFMT_R8G8B8A8, BITFMT_B8G8R8A8, BITFMT_R8G8B8, BITFMT_A8,
+                                 BITFMT_A8R8G8B8, BITFMT_A8B8G8R8, BITFMT_B8G8R8 };
+
+// Widths around the sizes of the vectors, with the padding of the rows.
+const int WIDTHS[] = { 1, 3, 7, 8, 15, 16, 17, 33, 64, 67, 129 };
+const int HEIGHT = 5;
+const int PADDING = 7;
+
+TEST(TestImageKernels, TestSumMatchesReference)
+{
+  for (int width : WIDTHS)
+  {
+    for (int bytes = 1; bytes <= 4; ++bytes)
+    {
+      int stride = width * bytes + PADDING;
+      std::vector<unsigned char> pixels = RandomImage(stride * HEIGHT);
+
+      unsigned long long expected[4] = {0, 0, 0, 0};
+      for (int y = 0; y < HEIGHT; ++y)
+        for (int x = 0; x < width * bytes; ++x)
+          expected[x % bytes] += pixels[y * stride + x];
+
+      for (auto implementation : IMPLEMENTATIONS)
+      {
+        if (!IsPixelKernelImplementationSupported(implementation))
+          continue;
+
+        unsigned long long sums[4];
+        SumPixelBytes(&pixels[0], width, HEIGHT, stride, bytes, sums, implementation);
+
+        for (int k = 0; k < 4; ++k)
+          EXPECT_EQ(expected[k], sums[k]) << "implementation " << implementation << ", width " << width << ", bytes " << bytes;
+      }
+    }
+  }
+}
+
+TEST(TestImageKernels, TestReverseMatchesReference)
+{
+  for (int width : WIDTHS)
+  {
+    for (int bytes = 1; bytes <= 4; ++bytes)
+    {
+      int stride = width * bytes + PADDING;
+      std::vector<unsigned char> original = RandomImage(stride * HEIGHT);
+
+      std::vector<unsigned char> expected = original;
+      for (int y = 0; y < HEIGHT; ++y)
+        for (int x = 0; x < width; ++x)
+          std::copy_n(&original[y * stride + (width - 1 - x) * bytes], bytes, &expected[y * stride + x * bytes]);
+
+      for (auto implementation : IMPLEMENTATIONS)
+      {
+        if (!IsPixelKernelImplementationSupported(implementation))
+          continue;
+
+        std::vector<unsigned char> pixels = original;
+        ReversePixelRows(&pixels[0], width, HEIGHT, stride, bytes, implementation);
+        EXPECT_EQ(expected, pixels) << "implementation " << implementation << ", width " << width << ", bytes " << bytes;
+      }
+    }
+  }
+}
+
+TEST(TestImageKernels, TestConvertMatchesReference)
+{
+  for (auto src_format : FORMATS)
+  {
+    for (auto dst_format : FORMATS)
+    {
+      int src_offsets[4], dst_offsets[4];
+      IsByteChannelFormat(src_format, src_offsets);
+      IsByteChannelFormat(dst_format, dst_offsets);
+      int src_bytes = GetBytesPerPixel(src_format);
+      int dst_bytes = GetBytesPerPixel(dst_format);
+
+      for (int width : WIDTHS)
+      {
+        int src_stride = width * src_bytes + PADDING;
+        int dst_stride = width * dst_bytes + PADDING;
+        std::vector<unsigned char> src = RandomImage(src_stride * HEIGHT);
+
+        // The padding of the destination is not written.
+        std::vector<unsigned char> expected(dst_stride * HEIGHT, 0x5A);
+        for (int y = 0; y < HEIGHT; ++y)
+        {
+          for (int x = 0; x < width; ++x)
+          {
+            for (int channel = 0; channel < 4; ++channel)
+            {
+              if (dst_offsets[channel] < 0)
+                continue;
+
+              unsigned char value = (channel == 3) ? 255 : 0;
+              if (src_offsets[channel] >= 0)
+                value = src[y * src_stride + x * src_bytes + src_offsets[channel]];
+
+              expected[y * dst_stride + x * dst_bytes + dst_offsets[channel]] = value;
+            }
+          }
+        }
+
+        for (auto implementation : IMPLEMENTATIONS)
+        {
+          if (!IsPixelKernelImplementationSupported(implementation))
+            continue;
+
+          std::vector<unsigned char> dst(dst_stride * HEIGHT, 0x5A);
+          EXPECT_TRUE(ConvertPixels(&src[0], src_stride, src_format, &dst[0], dst_stride, dst_format, width, HEIGHT, implementation));
+          EXPECT_EQ(expected, dst) << "implementation " << implementation << ", formats " << src_format << " to " << dst_format << ", width " << width;
+
+          if (src_bytes != dst_bytes)
+            continue;
+
+          // In place.
+          std::vector<unsigned char> pixels = src;
+          ConvertPixels(&pixels[0], src_stride, src_format, &pixels[0], src_stride, dst_format, width, HEIGHT, implementation);
+          for (int y = 0; y < HEIGHT; ++y)
+          {
+            ASSERT_TRUE(std::equal(&pixels[y * src_stride], &pixels[y * src_stride + width * dst_bytes], &expected[y * dst_stride]))
+              << "implementation " << implementation << ", formats " << src_format << " to " << dst_format << ", width " << width;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestImageKernels, TestUnsupportedFormats)
+{
+  std::vector<unsigned char> pixels(64);
+
+  EXPECT_FALSE(ConvertPixels(&pixels[0], 16, BITFMT_R5G6B5, &pixels[0], 16, BITFMT_R8G8B8A8, 4, 4));
+  EXPECT_FALSE(ConvertPixels(&pixels[0], 16, BITFMT_R8G8B8A8, &pixels[0], 16, BITFMT_DXT1, 4, 4));
+  EXPECT_FALSE(PremultiplyAlpha(&pixels[0], 12, &pixels[0], 12, 4, 4, BITFMT_R8G8B8));
+  EXPECT_FALSE(UnpremultiplyAlpha(&pixels[0], 4, &pixels[0], 4, 4, 4, BITFMT_A8));
+}
+
+// All the pairs of color and alpha, in both positions of the alpha channel.
+TEST(TestImageKernels, TestAlphaMatchesReference)
+{
+  const int width = 256 * 256 + 5;
+
+  for (auto format : { BITFMT_R8G8B8A8, BITFMT_A8R8G8B8 })
+  {
+    int alpha = (format == BITFMT_R8G8B8A8) ? 3 : 0;
+
+    std::vector<unsigned char> src(width * 4);
+    for (int i = 0; i < width; ++i)
+    {
+      unsigned char* pixel = &src[i * 4];
+      pixel[alpha] = (i / 256) % 256;
+      for (int k = 0; k < 4; ++k)
+      {
+        if (k != alpha)
+          pixel[k] = (i + k * 85) % 256;
+      }
+    }
+
+    std::vector<unsigned char> premultiplied(src.size()), unpremultiplied(src.size());
+    for (int i = 0; i < width * 4; ++i)
+    {
+      unsigned int a = src[i / 4 * 4 + alpha];
+      unsigned int c = src[i];
+      bool is_alpha = (i % 4 == alpha);
+
+      premultiplied[i] = is_alpha ? a : c * a / 255;
+      unpremultiplied[i] = is_alpha ? a : (a == 0) ? 0 : std::min(255u, (c * 255 + a / 2) / a);
+    }
+
+    for (auto implementation : IMPLEMENTATIONS)
+    {
+      if (!IsPixelKernelImplementationSupported(implementation))
+        continue;
+
+      std::vector<unsigned char> dst(src.size());
+      EXPECT_TRUE(PremultiplyAlpha(&src[0], 0, &dst[0], 0, width, 1, format, implementation));
+      EXPECT_EQ(premultiplied, dst) << "implementation " << implementation << ", format " << format;
+
+      EXPECT_TRUE(UnpremultiplyAlpha(&src[0], 0, &dst[0], 0, width, 1, format, implementation));
+      EXPECT_EQ(unpremultiplied, dst) << "implementation " << implementation << ", format " << format;
+
+      dst = src;
+      PremultiplyAlpha(&dst[0], 0, &dst[0], 0, width, 1, format, implementation);
+      EXPECT_EQ(premultiplied, dst) << "implementation " << implementation << ", format " << format;
+    }
+  }
+}
+
+TEST(TestImageKernels, TestSwizzleRedBlue)
+{
+  const unsigned char rgba[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+  unsigned char bgra[8];
+
+  SwizzleRedBlue(rgba, 8, bgra, 8, 2, 1);
+
+  const unsigned char expected[] = { 3, 2, 1, 4, 7, 6, 5, 8 };
+  EXPECT_TRUE(std::equal(expected, expected + 8, bgra));
+}
+
+TEST(TestImageKernels, TestSurfaceAverageColor)
+{
+  ImageSurface surface(BITFMT_B8G8R8A8, 3, 2);
+  unsigned char* pixels = surface.GetPtrRawData();
+
+  for (int y = 0; y < 2; ++y)
+  {
+    for (int x = 0; x < 3; ++x)
+    {
+      unsigned char* pixel = pixels + y * surface.GetPitch() + x * 4;
+      pixel[0] = 255;
+      pixel[1] = (y == 0) ? 0 : 255;
+      pixel[2] = 0;
+      pixel[3] = 51;
+    }
+  }
+
+  Color average = surface.AverageColor();
+  EXPECT_FLOAT_EQ(0.0f, average.red);
+  EXPECT_FLOAT_EQ(0.5f, average.green);
+  EXPECT_FLOAT_EQ(1.0f, average.blue);
+  EXPECT_FLOAT_EQ(0.2f, average.alpha);
+
+  ImageSurface rgb(BITFMT_R8G8B8, 4, 4);
+  EXPECT_FLOAT_EQ(1.0f, rgb.AverageColor().alpha);
+}
+
+TEST(TestImageKernels, TestSurfaceFlips)
+{
+  ImageSurface surface(BITFMT_R8G8B8, 5, 3);
+
+  for (int y = 0; y < 3; ++y)
+    for (int x = 0; x < 5; ++x)
+      surface.Write24b(x, y, (y << 8) | x);
+
+  ImageSurface flipped = surface;
+  flipped.FlipHorizontal();
+  flipped.FlipVertical();
+
+  for (int y = 0; y < 3; ++y)
+    for (int x = 0; x < 5; ++x)
+      EXPECT_EQ(surface.Read(4 - x, 2 - y), flipped.Read(x, y)) << x << ", " << y;
+}
+
+}
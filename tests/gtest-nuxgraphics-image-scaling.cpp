@@ -0,0 +1,216 @@
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "NuxCore/NuxCore.h"
+#include "NuxGraphics/ImageScaling.h"
+#include "NuxGraphics/ImageSurface.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+std::vector<unsigned char> RandomImage(int size)
+{
+  std::vector<unsigned char> pixels(size);
+  srand(42);
+
+  for (auto& pixel : pixels)
+    pixel = rand() % 256;
+
+  return pixels;
+}
+
+int GetBytesPerPixel(BitmapFormat format)
+{
+  int offsets[4];
+  IsByteChannelFormat(format, offsets);
+  return *std::max_element(offsets, offsets + 4) + 1;
+}
+
+const PixelKernelImplementation IMPLEMENTATIONS[] = { PIXEL_KERNELS_SCALAR, PIXEL_KERNELS_SSE2, PIXEL_KERNELS_AVX2 };
+const ImageFilter FILTERS[] = { IMAGE_FILTER_BOX, IMAGE_FILTER_LANCZOS };
+const BitmapFormat FORMATS[] = { BITFMT_R8G8B8A8, BITFMT_A8R8G8B8, BITFMT_R8G8B8, BITFMT_A8 };
+
+// Source and destination sizes: reductions, enlargements and odd ratios.
+const int SIZES[][4] = { { 256, 256, 32, 32 }, { 64, 48, 7, 5 }, { 33, 17, 16, 8 }, { 5, 3, 19, 11 }, { 40, 40, 40, 40 }, { 1, 1, 3, 2 } };
+
+TEST(TestImageScaling, TestImplementationsMatch)
+{
+  for (auto format : FORMATS)
+  {
+    int bytes = GetBytesPerPixel(format);
+
+    for (auto const& size : SIZES)
+    {
+      int src_stride = size[0] * bytes + 3;
+      int dst_stride = size[2] * bytes + 3;
+      std::vector<unsigned char> src = RandomImage(src_stride * size[1]);
+
+      for (auto filter : FILTERS)
+      {
+        std::vector<unsigned char> expected(dst_stride * size[3], 0x5A);
+        EXPECT_TRUE(ScalePixels(&src[0], src_stride, size[0], size[1], &expected[0], dst_stride, size[2], size[3],
+                                format, filter, PIXEL_KERNELS_SCALAR));
+
+        for (auto implementation : IMPLEMENTATIONS)
+        {
+          if (!IsPixelKernelImplementationSupported(implementation))
+            continue;
+
+          std::vector<unsigned char> dst(dst_stride * size[3], 0x5A);
+          ScalePixels(&src[0], src_stride, size[0], size[1], &dst[0], dst_stride, size[2], size[3],
+                      format, filter, implementation);
+          EXPECT_EQ(expected, dst) << "implementation " << implementation << ", format " << format
+                                   << ", filter " << filter << ", size " << size[0] << "x" << size[1];
+        }
+      }
+    }
+  }
+}
+
+TEST(TestImageScaling, TestThreadsMatch)
+{
+  const int width = 600, height = 500, scaled_width = 150, scaled_height = 125;
+  std::vector<unsigned char> src = RandomImage(width * height * 4);
+  std::vector<unsigned char> single(scaled_width * scaled_height * 4), threaded(single.size());
+
+  ScalePixels(&src[0], width * 4, width, height, &single[0], scaled_width * 4, scaled_width, scaled_height,
+              BITFMT_R8G8B8A8, IMAGE_FILTER_LANCZOS, PIXEL_KERNELS_AUTO, 1);
+  ScalePixels(&src[0], width * 4, width, height, &threaded[0], scaled_width * 4, scaled_width, scaled_height,
+              BITFMT_R8G8B8A8, IMAGE_FILTER_LANCZOS, PIXEL_KERNELS_AUTO, 3);
+
+  EXPECT_EQ(single, threaded);
+}
+
+TEST(TestImageScaling, TestBoxHalvesAverageSquares)
+{
+  const int width = 16, height = 6;
+  std::vector<unsigned char> src = RandomImage(width * height * 3);
+  std::vector<unsigned char> dst(width * height * 3 / 4);
+
+  ScalePixels(&src[0], width * 3, width, height, &dst[0], width / 2 * 3, width / 2, height / 2,
+              BITFMT_R8G8B8, IMAGE_FILTER_BOX);
+
+  for (int y = 0; y < height / 2; ++y)
+  {
+    for (int x = 0; x < width / 2; ++x)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        int sum = src[(2 * y * width + 2 * x) * 3 + k] + src[(2 * y * width + 2 * x + 1) * 3 + k] +
+                  src[((2 * y + 1) * width + 2 * x) * 3 + k] + src[((2 * y + 1) * width + 2 * x + 1) * 3 + k];
+        EXPECT_NEAR(sum / 4.0, dst[(y * width / 2 + x) * 3 + k], 0.5) << x << ", " << y << ", " << k;
+      }
+    }
+  }
+}
+
+TEST(TestImageScaling, TestConstantImage)
+{
+  const unsigned char pixel[] = { 10, 128, 250, 200 };
+
+  for (auto filter : FILTERS)
+  {
+    for (auto const& size : SIZES)
+    {
+      std::vector<unsigned char> src(size[0] * size[1] * 4);
+      for (size_t i = 0; i < src.size(); ++i)
+        src[i] = pixel[i % 4];
+
+      std::vector<unsigned char> dst(size[2] * size[3] * 4);
+      ScalePixels(&src[0], size[0] * 4, size[0], size[1], &dst[0], size[2] * 4, size[2], size[3],
+                  BITFMT_R8G8B8A8, filter);
+
+      for (size_t i = 0; i < dst.size(); ++i)
+        ASSERT_NEAR(pixel[i % 4], dst[i], 1) << "filter " << filter << ", size " << size[0] << "x" << size[1];
+    }
+  }
+}
+
+// The color of the transparent pixels must not darken the edges of an icon.
+TEST(TestImageScaling, TestTransparentPixelsDoNotBleed)
+{
+  const int width = 32, height = 32;
+  std::vector<unsigned char> src(width * height * 4, 0);
+
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width / 2; ++x)
+    {
+      unsigned char* pixel = &src[(y * width + x) * 4];
+      pixel[0] = 255;
+      pixel[3] = 255;
+    }
+  }
+
+  for (auto filter : FILTERS)
+  {
+    std::vector<unsigned char> dst(5 * 5 * 4);
+    ScalePixels(&src[0], width * 4, width, height, &dst[0], 5 * 4, 5, 5, BITFMT_R8G8B8A8, filter);
+
+    for (int i = 0; i < 5 * 5; ++i)
+    {
+      unsigned char* pixel = &dst[i * 4];
+      if (pixel[3] == 0)
+        continue;
+
+      EXPECT_EQ(255, pixel[0]) << "filter " << filter << ", pixel " << i;
+      EXPECT_EQ(0, pixel[1]) << "filter " << filter << ", pixel " << i;
+    }
+  }
+}
+
+TEST(TestImageScaling, TestUnsupportedFormat)
+{
+  std::vector<unsigned char> pixels(64);
+  EXPECT_FALSE(ScalePixels(&pixels[0], 16, 4, 4, &pixels[0], 8, 2, 2, BITFMT_R5G6B5));
+  EXPECT_TRUE(ScaleImageSurface(ImageSurface(BITFMT_DXT1, 8, 8), 4, 4).IsNull());
+}
+
+TEST(TestImageScaling, TestScaleImageSurface)
+{
+  ImageSurface surface(BITFMT_R8G8B8A8, 64, 64);
+  std::fill(surface.GetPtrRawData(), surface.GetPtrRawData() + surface.GetPitch() * 64, 77);
+
+  ImageSurface scaled = ScaleImageSurface(surface, 24, 12);
+  ASSERT_EQ(24, scaled.GetWidth());
+  ASSERT_EQ(12, scaled.GetHeight());
+  EXPECT_EQ(BITFMT_R8G8B8A8, scaled.GetFormat());
+  EXPECT_EQ(77, scaled.GetPtrRawData()[11 * scaled.GetPitch() + 23 * 4]);
+}
+
+TEST(TestImageScaling, TestGenerateMipmaps)
+{
+  NTextureData texture(BITFMT_R8G8B8A8, 64, 16, 0);
+  ASSERT_EQ(7, texture.GetNumMipmap());
+
+  ImageSurface& surface = texture.GetSurface(0);
+  std::fill(surface.GetPtrRawData(), surface.GetPtrRawData() + surface.GetPitch() * 16, 200);
+
+  EXPECT_TRUE(GenerateMipmaps(texture));
+
+  for (int level = 1; level < texture.GetNumMipmap(); ++level)
+  {
+    ImageSurface const& mipmap = texture.GetSurface(level);
+    EXPECT_EQ(std::max(1, 64 >> level), mipmap.GetWidth());
+    EXPECT_EQ(std::max(1, 16 >> level), mipmap.GetHeight());
+    EXPECT_EQ(200, mipmap.GetPtrRawData()[0]) << "level " << level;
+  }
+}
+
+TEST(TestImageScaling, TestFitTextureData)
+{
+  NTextureData texture(BITFMT_R8G8B8A8, 256, 128, 1);
+  EXPECT_FALSE(FitTextureData(texture, 256, 128));
+
+  EXPECT_TRUE(FitTextureData(texture, 32, 32));
+  EXPECT_EQ(32, texture.GetWidth());
+  EXPECT_EQ(16, texture.GetHeight());
+  EXPECT_EQ(1, texture.GetNumMipmap());
+}
+
+}
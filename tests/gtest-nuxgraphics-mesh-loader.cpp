@@ -0,0 +1,176 @@
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+#include "NuxGraphics/MeshData.h"
+#include "NuxGraphics/MeshFileLoader-OBJ.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+const int VERTEX_FLOATS = 9;
+
+std::unique_ptr<MeshData> Parse(std::string const& text, int max_threads = 1)
+{
+  return std::unique_ptr<MeshData>(ParseMeshData_OBJ(text.data(), text.size(), max_threads));
+}
+
+const float* GetVertex(MeshData const& mesh, int index)
+{
+  return reinterpret_cast<const float*>(mesh._vertex_data) + VERTEX_FLOATS * index;
+}
+
+int GetIndex(MeshData const& mesh, int i)
+{
+  return reinterpret_cast<const int*>(mesh._index_data)[i];
+}
+
+// A grid of quads, with a texcoord and a normal per position.
+std::string MakeGrid(int size)
+{
+  std::string text = "# grid\no grid\n";
+  char line[128];
+
+  for (int y = 0; y <= size; ++y)
+  {
+    for (int x = 0; x <= size; ++x)
+    {
+      snprintf(line, sizeof(line), "v %f %f %f\nvt %f %f\nvn 0 0 1\n", x * 0.25f, y * -0.5f, (x * y) % 7 * 1e-3f,
+               float(x) / size, float(y) / size);
+      text += line;
+    }
+  }
+
+  for (int y = 0; y < size; ++y)
+  {
+    for (int x = 0; x < size; ++x)
+    {
+      int a = y * (size + 1) + x + 1;
+      int b = a + 1, c = a + size + 2, d = a + size + 1;
+      snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, c, c, c, d, d, d);
+      text += line;
+    }
+  }
+
+  return text;
+}
+
+TEST(TestMeshLoader, TestTriangle)
+{
+  auto mesh = Parse("v 1 2 3\nv 4 5 6\nv 7 8 9\nvt 0.5 0.25\nvn 0 1 0\nf 1/1/1 2/1/1 3/1/1\n");
+  ASSERT_TRUE(mesh != nullptr);
+
+  EXPECT_EQ(NUX_MESH_TRIANGLE, mesh->_mesh_primitive_type);
+  EXPECT_EQ(3, mesh->_num_element);
+  EXPECT_EQ(VERTEX_FLOATS * int(sizeof(float)), mesh->_element_size);
+  ASSERT_EQ(3, mesh->_num_index);
+
+  const float expected[] = { 4, 5, 6, 1, 0, 1, 0, 0.5f, 0.25f };
+  int index = GetIndex(*mesh, 1);
+  for (int i = 0; i < VERTEX_FLOATS; ++i)
+    EXPECT_FLOAT_EQ(expected[i], GetVertex(*mesh, index)[i]) << i;
+}
+
+TEST(TestMeshLoader, TestMergesVertices)
+{
+  auto mesh = Parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3\nf 1 3 4\n");
+  ASSERT_TRUE(mesh != nullptr);
+
+  EXPECT_EQ(4, mesh->_num_element);
+  ASSERT_EQ(6, mesh->_num_index);
+  EXPECT_EQ(GetIndex(*mesh, 0), GetIndex(*mesh, 3));
+  EXPECT_EQ(GetIndex(*mesh, 2), GetIndex(*mesh, 4));
+}
+
+TEST(TestMeshLoader, TestPolygonsAreFans)
+{
+  auto mesh = Parse("v 0 0 0\nv 1 0 0\nv 2 1 0\nv 1 2 0\nv 0 1 0\nf 1 2 3 4 5 # pentagon\n");
+  ASSERT_TRUE(mesh != nullptr);
+
+  ASSERT_EQ(9, mesh->_num_index);
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_FLOAT_EQ(0.0f, GetVertex(*mesh, GetIndex(*mesh, 3 * i))[0]);
+    EXPECT_FLOAT_EQ(0.0f, GetVertex(*mesh, GetIndex(*mesh, 3 * i))[1]);
+  }
+}
+
+TEST(TestMeshLoader, TestIndexFormats)
+{
+  auto mesh = Parse("v 1 0 0\r\nv 0 1 0\r\nvn 0 0 -1\r\nv 0 0 1\r\nf -3//-1 -2//1 -1//-1\r\nf 1/ 2 3\r\n");
+  ASSERT_TRUE(mesh != nullptr);
+  ASSERT_EQ(6, mesh->_num_index);
+
+  const float* vertex = GetVertex(*mesh, GetIndex(*mesh, 0));
+  EXPECT_FLOAT_EQ(1.0f, vertex[0]);
+  EXPECT_FLOAT_EQ(-1.0f, vertex[6]);
+  EXPECT_FLOAT_EQ(0.0f, vertex[7]);
+
+  // Missing attributes are 0.
+  vertex = GetVertex(*mesh, GetIndex(*mesh, 5));
+  EXPECT_FLOAT_EQ(1.0f, vertex[2]);
+  EXPECT_FLOAT_EQ(1.0f, vertex[3]);
+  EXPECT_FLOAT_EQ(0.0f, vertex[6]);
+}
+
+TEST(TestMeshLoader, TestFloats)
+{
+  const char* numbers[] = { "0", "-0.5", "+3", ".25", "12.", "1e-3", "-2.5E+2", "3.14159265358979323846",
+                            "123456789012345678901234", "0.000000000000000000000000012345", "6.02214076e23" };
+
+  for (auto number : numbers)
+  {
+    std::string text = std::string("v ") + number + " 0 0\nf 1 1 1\n";
+    auto mesh = Parse(text);
+    ASSERT_TRUE(mesh != nullptr);
+    EXPECT_FLOAT_EQ(strtof(number, NULL), GetVertex(*mesh, 0)[0]) << number;
+  }
+}
+
+TEST(TestMeshLoader, TestNoFace)
+{
+  EXPECT_TRUE(Parse("v 0 0 0\nv 1 1 1\n") == nullptr);
+  EXPECT_TRUE(Parse("") == nullptr);
+  EXPECT_TRUE(LoadMeshFile_OBJ("/nonexistent/mesh.obj") == nullptr);
+}
+
+TEST(TestMeshLoader, TestThreadsMatch)
+{
+  std::string text = MakeGrid(64);
+  auto single = Parse(text, 1);
+  auto threaded = Parse(text, 4);
+
+  ASSERT_TRUE(single != nullptr);
+  ASSERT_TRUE(threaded != nullptr);
+  EXPECT_EQ(65 * 65, single->_num_element);
+  ASSERT_EQ(single->_num_element, threaded->_num_element);
+  ASSERT_EQ(single->_num_index, threaded->_num_index);
+  EXPECT_EQ(0, memcmp(single->_vertex_data, threaded->_vertex_data, single->_num_element * single->_element_size));
+  EXPECT_EQ(0, memcmp(single->_index_data, threaded->_index_data, single->_num_index * single->_index_size));
+}
+
+TEST(TestMeshLoader, TestLoadFile)
+{
+  char filename[] = "/tmp/gtest-nux-mesh-XXXXXX";
+  int fd = mkstemp(filename);
+  ASSERT_NE(-1, fd);
+
+  std::string text = MakeGrid(8);
+  ASSERT_EQ(ssize_t(text.size()), write(fd, text.data(), text.size()));
+  close(fd);
+
+  std::unique_ptr<MeshData> mesh(LoadMeshFile_OBJ(filename));
+  unlink(filename);
+
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_EQ(9 * 9, mesh->_num_element);
+  EXPECT_EQ(8 * 8 * 6, mesh->_num_index);
+}
+
+}
@@ -0,0 +1,95 @@
+#include <gmock/gmock.h>
+#include <glib.h>
+
+#include "Nux/Nux.h"
+
+#include "NuxGraphics/NuxGraphics.h"
+#include "NuxGraphics/GraphicsEngine.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+const char *DISABLE_BATCHING_ENV = "NUX_DISABLE_QUAD_BATCHING";
+
+class TestQuadBatcher : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    g_unsetenv(DISABLE_BATCHING_ENV);
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("nux::TestQuadBatcher", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+    graphics_engine = GetGraphicsDisplay()->GetGraphicsEngine();
+  }
+
+  bool BatchingSupported()
+  {
+    return graphics_engine->UsingGLSLCodePath() &&
+      GetGraphicsDisplay()->GetGpuDevice()->GetGpuInfo().Support_ARB_Vertex_Buffer_Object();
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+  GraphicsEngine* graphics_engine;
+};
+
+TEST_F(TestQuadBatcher, TestConsecutiveQuadsAreBatched)
+{
+  if (!BatchingSupported())
+    return;
+
+  ASSERT_TRUE(graphics_engine->IsQuadBatchingEnabled());
+  graphics_engine->ResetStats();
+
+  for (int i = 0; i < 10; ++i)
+    graphics_engine->QRP_Color(i * 10, 0, 10, 10, color::Red);
+
+  EXPECT_EQ(0, graphics_engine->GetQuadBatchDrawCallCount());
+
+  graphics_engine->FlushQuadBatch();
+  EXPECT_EQ(10, graphics_engine->GetBatchedQuadCount());
+  EXPECT_EQ(1, graphics_engine->GetQuadBatchDrawCallCount());
+}
+
+TEST_F(TestQuadBatcher, TestRenderStateChangeFlushes)
+{
+  if (!BatchingSupported())
+    return;
+
+  graphics_engine->ResetStats();
+
+  graphics_engine->QRP_Color(0, 0, 10, 10, color::Red);
+  graphics_engine->GetRenderStates().SetBlend(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  EXPECT_EQ(1, graphics_engine->GetQuadBatchDrawCallCount());
+
+  graphics_engine->QRP_Color(10, 0, 10, 10, color::Red);
+  graphics_engine->SetScissor(0, 0, 100, 100);
+  EXPECT_EQ(2, graphics_engine->GetQuadBatchDrawCallCount());
+
+  graphics_engine->GetRenderStates().SetBlend(false);
+}
+
+TEST_F(TestQuadBatcher, TestDisableBatching)
+{
+  graphics_engine->EnableQuadBatching(false);
+  graphics_engine->ResetStats();
+
+  EXPECT_FALSE(graphics_engine->IsQuadBatchingEnabled());
+
+  graphics_engine->QRP_Color(0, 0, 10, 10, color::Red);
+  graphics_engine->FlushQuadBatch();
+  EXPECT_EQ(0, graphics_engine->GetBatchedQuadCount());
+}
+
+TEST_F(TestQuadBatcher, TestDisableBatchingFromEnvironment)
+{
+  g_setenv(DISABLE_BATCHING_ENV, "TRUE", TRUE);
+  wnd_thread.reset(nux::CreateNuxWindow("nux::TestQuadBatcher", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+  g_unsetenv(DISABLE_BATCHING_ENV);
+
+  EXPECT_FALSE(GetGraphicsDisplay()->GetGraphicsEngine()->IsQuadBatchingEnabled());
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <gmock/gmock.h>
+#include <vector>
+
+#include "Nux/Nux.h"
+
+#include "NuxGraphics/NuxGraphics.h"
+#include "NuxGraphics/GLDeviceObjects.h"
+#include "NuxGraphics/TextureReadback.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+class TestTextureReadback : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("nux::TestTextureReadback", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+  }
+
+  ObjectPtr<IOpenGLBaseTexture> CreateTexture(int width, int height, int seed)
+  {
+    ObjectPtr<IOpenGLBaseTexture> texture =
+      GetGraphicsDisplay()->GetGpuDevice()->CreateSystemCapableDeviceTexture(width, height, 1, BITFMT_R8G8B8A8, NUX_TRACKER_LOCATION);
+
+    SURFACE_LOCKED_RECT lock_rect;
+    texture->LockRect(0, &lock_rect, NULL);
+
+    unsigned char* pixels = static_cast<unsigned char*>(lock_rect.pBits);
+    for (int y = 0; y < height; ++y)
+    {
+      for (int x = 0; x < width * 4; ++x)
+        pixels[y * lock_rect.Pitch + x] = (x * 7 + y * 13 + seed) & 0xFF;
+    }
+
+    texture->UnlockRect(0);
+    return texture;
+  }
+
+  std::vector<unsigned char> ReadSynchronously(ObjectPtr<IOpenGLBaseTexture> const& texture)
+  {
+    int width, height, stride;
+    unsigned char* data = texture->GetSurfaceData(0, width, height, stride);
+    std::vector<unsigned char> pixels(data, data + height * stride);
+    delete [] data;
+    return pixels;
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+};
+
+TEST_F(TestTextureReadback, TestMatchesSynchronousRead)
+{
+  TextureReadback readback;
+  ObjectPtr<IOpenGLBaseTexture> texture = CreateTexture(37, 21, 0);
+  std::vector<unsigned char> expected = ReadSynchronously(texture);
+  std::vector<unsigned char> pixels;
+
+  ASSERT_TRUE(readback.Read(texture, 0, [&pixels] (unsigned char const* data, int width, int height, int stride)
+  {
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(37, width);
+    EXPECT_EQ(21, height);
+    EXPECT_EQ(37 * 4, stride);
+    pixels.assign(data, data + height * stride);
+  }));
+
+  EXPECT_EQ(1, readback.GetPendingReadCount());
+  readback.Poll(true);
+
+  EXPECT_EQ(0, readback.GetPendingReadCount());
+  EXPECT_EQ(expected, pixels);
+}
+
+TEST_F(TestTextureReadback, TestReadsCompleteInOrder)
+{
+  const int reads = 10;
+  TextureReadback readback(3);
+  std::vector<ObjectPtr<IOpenGLBaseTexture> > textures;
+  std::vector<std::vector<unsigned char> > expected;
+  std::vector<int> completed;
+
+  for (int i = 0; i < reads; ++i)
+  {
+    textures.push_back(CreateTexture(16 + i, 8 + 3 * i, i));
+    expected.push_back(ReadSynchronously(textures.back()));
+
+    ASSERT_TRUE(readback.Read(textures.back(), 0, [&, i] (unsigned char const* data, int /* width */, int height, int stride)
+    {
+      EXPECT_EQ(expected[i], std::vector<unsigned char>(data, data + height * stride)) << "read " << i;
+      completed.push_back(i);
+    }));
+
+    // At most 3 reads are in flight.
+    EXPECT_GE(3, readback.GetPendingReadCount());
+    readback.Poll();
+  }
+
+  readback.Poll(true);
+
+  ASSERT_EQ(reads, static_cast<int>(completed.size()));
+  for (int i = 0; i < reads; ++i)
+    EXPECT_EQ(i, completed[i]);
+
+  TextureReadback::Stats const& stats = readback.GetStats();
+  EXPECT_EQ(reads, stats.reads);
+  EXPECT_EQ(reads, stats.completed_reads);
+}
+
+TEST_F(TestTextureReadback, TestInvalidLevel)
+{
+  TextureReadback readback;
+  ObjectPtr<IOpenGLBaseTexture> texture = CreateTexture(8, 8, 0);
+
+  EXPECT_FALSE(readback.Read(texture, 1, [] (unsigned char const*, int, int, int) {}));
+  EXPECT_FALSE(readback.Read(ObjectPtr<IOpenGLBaseTexture>(), 0, [] (unsigned char const*, int, int, int) {}));
+  EXPECT_EQ(0, readback.GetPendingReadCount());
+}
+
+}
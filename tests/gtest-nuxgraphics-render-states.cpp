@@ -0,0 +1,139 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <gmock/gmock.h>
+
+#include "Nux/Nux.h"
+
+#include "NuxGraphics/NuxGraphics.h"
+#include "NuxGraphics/GLDeviceObjects.h"
+#include "NuxGraphics/GraphicsEngine.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+class TestRenderStates : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("nux::TestRenderStates", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+    graphics_engine = &wnd_thread->GetGraphicsEngine();
+    graphics_engine->EnableQuadBatching(false);
+  }
+
+  virtual void TearDown()
+  {
+    graphics_engine->GetRenderStates().SetBindingTracking(true);
+    graphics_engine->EnableQuadBatching(true);
+  }
+
+  ObjectPtr<IOpenGLBaseTexture> CreateTexture()
+  {
+    return GetGraphicsDisplay()->GetGpuDevice()->CreateSystemCapableDeviceTexture(4, 4, 1, BITFMT_R8G8B8A8, NUX_TRACKER_LOCATION);
+  }
+
+  GLuint GetBinding(GLenum name)
+  {
+    GLint value = 0;
+    glGetIntegerv(name, &value);
+    return value;
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+  GraphicsEngine* graphics_engine;
+};
+
+TEST_F(TestRenderStates, TestRedundantBindingsAreSuppressed)
+{
+  ObjectPtr<IOpenGLBaseTexture> texture = CreateTexture();
+  graphics_engine->SetTexture(GL_TEXTURE0, texture);
+  graphics_engine->ResetStats();
+
+  graphics_engine->SetTexture(GL_TEXTURE0, texture);
+  graphics_engine->SetScissor(0, 0, 20, 20);
+  graphics_engine->SetScissor(0, 0, 20, 20);
+
+  EXPECT_EQ(texture->GetOpenGLID(), GetBinding(GL_TEXTURE_BINDING_2D));
+  // The texture is already bound and the second scissor is the same as the first one.
+  EXPECT_EQ(1, graphics_engine->GetIssuedBindingCount());
+  EXPECT_LT(0, graphics_engine->GetSuppressedBindingCount());
+}
+
+TEST_F(TestRenderStates, TestRepeatedQuadsSuppressBindings)
+{
+  if (!graphics_engine->UsingGLSLCodePath())
+    return;
+
+  ObjectPtr<IOpenGLBaseTexture> texture = CreateTexture();
+  TexCoordXForm texxform;
+
+  graphics_engine->QRP_1Tex(0, 0, 10, 10, texture, texxform, color::White);
+  graphics_engine->ResetStats();
+  graphics_engine->QRP_1Tex(10, 0, 10, 10, texture, texxform, color::White);
+
+  // The program, texture and buffers of the second quad are those of the first one.
+  EXPECT_LT(0, graphics_engine->GetSuppressedBindingCount());
+  EXPECT_EQ(texture->GetOpenGLID(), GetBinding(GL_TEXTURE_BINDING_2D));
+  EXPECT_EQ(0u, GetBinding(GL_ARRAY_BUFFER_BINDING));
+}
+
+TEST_F(TestRenderStates, TestDeletedTextureIsForgotten)
+{
+  ObjectPtr<IOpenGLBaseTexture> texture = CreateTexture();
+  graphics_engine->SetTexture(GL_TEXTURE0, texture);
+  texture.Release();
+
+  // OpenGL reverts the binding of the deleted texture to 0, and may give its name to the next texture.
+  EXPECT_EQ(0u, GetBinding(GL_TEXTURE_BINDING_2D));
+
+  texture = CreateTexture();
+  graphics_engine->SetTexture(GL_TEXTURE0, texture);
+  EXPECT_EQ(texture->GetOpenGLID(), GetBinding(GL_TEXTURE_BINDING_2D));
+}
+
+TEST_F(TestRenderStates, TestBindingsAreIssuedWithoutTracking)
+{
+  GpuRenderStates& render_states = graphics_engine->GetRenderStates();
+  render_states.SetBindingTracking(false);
+  graphics_engine->ResetStats();
+
+  render_states.ActiveTexture(GL_TEXTURE0);
+  render_states.ActiveTexture(GL_TEXTURE0);
+  render_states.DisableVertexAttribArray(0);
+  render_states.DisableVertexAttribArray(0);
+
+  EXPECT_EQ(4, graphics_engine->GetIssuedBindingCount());
+  EXPECT_EQ(0, graphics_engine->GetSuppressedBindingCount());
+
+  // Code that isn't aware of the render states changes the bindings.
+  glActiveTextureARB(GL_TEXTURE1);
+  render_states.SetBindingTracking(true);
+  graphics_engine->ResetStats();
+
+  render_states.ActiveTexture(GL_TEXTURE0);
+  EXPECT_EQ(1, graphics_engine->GetIssuedBindingCount());
+  EXPECT_EQ(static_cast<GLuint>(GL_TEXTURE0), GetBinding(GL_ACTIVE_TEXTURE));
+}
+
+}
@@ -0,0 +1,232 @@
+#include <gmock/gmock.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "Nux/Nux.h"
+
+#include "NuxGraphics/NuxGraphics.h"
+#include "NuxGraphics/GraphicsEngine.h"
+#include "NuxGraphics/ShaderProgramCache.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+const char* VERTEX_SHADER =
+  NUX_VERTEX_SHADER_HEADER
+  "uniform mat4 ViewProjectionMatrix;                \n\
+  uniform float Weights[3];                          \n\
+  attribute vec4 AVertex;                            \n\
+  void main()                                        \n\
+  {                                                  \n\
+    gl_Position = ViewProjectionMatrix * AVertex * (Weights[0] + Weights[1] + Weights[2]); \n\
+  }";
+
+const char* FRAGMENT_SHADER =
+  NUX_FRAGMENT_SHADER_HEADER
+  "uniform vec4 Color;            \n\
+  void main()                    \n\
+  {                              \n\
+    gl_FragColor = Color;        \n\
+  }";
+
+class TestShaderProgram : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("nux::TestShaderProgram", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+  }
+
+  ObjectPtr<IOpenGLShaderProgram> CreateProgram()
+  {
+    GpuDevice* gpu_device = GetGraphicsDisplay()->GetGpuDevice();
+    ObjectPtr<IOpenGLVertexShader> vs = gpu_device->CreateVertexShader();
+    ObjectPtr<IOpenGLPixelShader> ps = gpu_device->CreatePixelShader();
+    vs->SetShaderCode(VERTEX_SHADER);
+    ps->SetShaderCode(FRAGMENT_SHADER);
+
+    ObjectPtr<IOpenGLShaderProgram> program = gpu_device->CreateShaderProgram();
+    program->AddShaderObject(vs);
+    program->AddShaderObject(ps);
+    program->Link();
+    return program;
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+};
+
+TEST(TestShaderProgramNameHandle, TestSameNameSameHandle)
+{
+  int handle = IOpenGLShaderProgram::GetNameHandle("TestShaderProgramNameHandle");
+
+  EXPECT_GE(handle, 0);
+  EXPECT_EQ(handle, IOpenGLShaderProgram::GetNameHandle("TestShaderProgramNameHandle"));
+  EXPECT_NE(handle, IOpenGLShaderProgram::GetNameHandle("TestShaderProgramNameHandle2"));
+}
+
+TEST_F(TestShaderProgram, TestLocationsFromHandles)
+{
+  if (!GetGraphicsDisplay()->GetGraphicsEngine()->UsingGLSLCodePath())
+    return;
+
+  ObjectPtr<IOpenGLShaderProgram> program = CreateProgram();
+  GLuint id = program->GetOpenGLID();
+
+  EXPECT_EQ(glGetUniformLocationARB(id, "Color"), program->GetUniformLocationARB("Color"));
+  EXPECT_EQ(glGetUniformLocationARB(id, "Weights"), program->GetUniformLocationARB("Weights"));
+  EXPECT_EQ(-1, program->GetUniformLocationARB("NotAUniform"));
+
+  EXPECT_EQ(program->GetUniformLocationARB("ViewProjectionMatrix"),
+            program->GetUniformLocation(IOpenGLShaderProgram::GetNameHandle("ViewProjectionMatrix")));
+  EXPECT_EQ(program->GetAttributeLocation("AVertex"),
+            program->GetAttributeLocation(IOpenGLShaderProgram::GetNameHandle("AVertex")));
+  EXPECT_EQ(-1, program->GetAttributeLocation(IOpenGLShaderProgram::GetNameHandle("NotAnAttribute")));
+}
+
+TEST_F(TestShaderProgram, TestUniformValuesAreUploaded)
+{
+  if (!GetGraphicsDisplay()->GetGraphicsEngine()->UsingGLSLCodePath())
+    return;
+
+  ObjectPtr<IOpenGLShaderProgram> program = CreateProgram();
+  int location = program->GetUniformLocationARB("Color");
+  GLfloat value[4];
+
+  program->Begin();
+
+  program->SetUniform4f(location, 1.0f, 0.5f, 0.25f, 1.0f);
+  program->SetUniform4f(location, 1.0f, 0.5f, 0.25f, 1.0f);
+  glGetUniformfvARB(program->GetOpenGLID(), location, value);
+  EXPECT_EQ(0.5f, value[1]);
+
+  program->SetUniform4f(location, 0.0f, 0.0f, 0.0f, 0.0f);
+  glGetUniformfvARB(program->GetOpenGLID(), location, value);
+  EXPECT_EQ(0.0f, value[1]);
+
+  // A value set behind the back of the program is only known after the cache is reset.
+  glUniform4fARB(location, 1.0f, 1.0f, 1.0f, 1.0f);
+  program->ResetUniformValueCache();
+  program->SetUniform4f(location, 0.0f, 0.0f, 0.0f, 0.0f);
+  glGetUniformfvARB(program->GetOpenGLID(), location, value);
+  EXPECT_EQ(0.0f, value[1]);
+
+  program->End();
+}
+
+TEST_F(TestShaderProgram, TestWarmUp)
+{
+  GraphicsEngine* graphics_engine = GetGraphicsDisplay()->GetGraphicsEngine();
+  if (!graphics_engine->UsingGLSLCodePath())
+    return;
+
+  int left = graphics_engine->WarmUpShaderPrograms(0);
+  ASSERT_LT(0, left);
+
+  EXPECT_EQ(left - 1, graphics_engine->WarmUpShaderPrograms(1));
+  EXPECT_EQ(0, graphics_engine->WarmUpShaderPrograms());
+  EXPECT_EQ(0, graphics_engine->WarmUpShaderPrograms(0));
+}
+
+class TestShaderProgramCache : public TestShaderProgram
+{
+public:
+  virtual void SetUp()
+  {
+    TestShaderProgram::SetUp();
+
+    char* directory_name = g_dir_make_tmp("nux-shader-cache-XXXXXX", NULL);
+    directory = directory_name;
+    g_free(directory_name);
+
+    previous_directory = GetCache().GetDirectory();
+    GetCache().SetDirectory(directory);
+  }
+
+  virtual void TearDown()
+  {
+    GetCache().SetDirectory(previous_directory);
+
+    for (std::string const& file : GetFiles())
+      g_remove(file.c_str());
+    g_rmdir(directory.c_str());
+  }
+
+  ShaderProgramCache& GetCache()
+  {
+    return GetGraphicsDisplay()->GetGpuDevice()->GetShaderProgramCache();
+  }
+
+  std::vector<std::string> GetFiles()
+  {
+    std::vector<std::string> files;
+    GDir* dir = g_dir_open(directory.c_str(), 0, NULL);
+
+    while (const char* name = (dir ? g_dir_read_name(dir) : NULL))
+    {
+      char* file = g_build_filename(directory.c_str(), name, NULL);
+      files.push_back(file);
+      g_free(file);
+    }
+
+    if (dir)
+      g_dir_close(dir);
+    return files;
+  }
+
+  std::string directory;
+  std::string previous_directory;
+};
+
+TEST_F(TestShaderProgramCache, TestProgramIsLoadedFromBinary)
+{
+  if (!GetCache().IsEnabled())
+    return;
+
+  ShaderProgramCache::Stats stats = GetCache().GetStats();
+  ObjectPtr<IOpenGLShaderProgram> compiled = CreateProgram();
+
+  EXPECT_EQ(stats.misses + 1, GetCache().GetStats().misses);
+  EXPECT_EQ(stats.stores + 1, GetCache().GetStats().stores);
+  EXPECT_EQ(1u, GetFiles().size());
+
+  ObjectPtr<IOpenGLShaderProgram> loaded = CreateProgram();
+  EXPECT_EQ(stats.hits + 1, GetCache().GetStats().hits);
+
+  // The loaded program works like the compiled one.
+  int location = loaded->GetUniformLocationARB("Color");
+  EXPECT_EQ(glGetUniformLocationARB(loaded->GetOpenGLID(), "Color"), location);
+  ASSERT_NE(-1, location);
+
+  GLfloat value[4];
+  loaded->Begin();
+  loaded->SetUniform4f(location, 1.0f, 0.5f, 0.25f, 1.0f);
+  glGetUniformfvARB(loaded->GetOpenGLID(), location, value);
+  EXPECT_EQ(0.25f, value[2]);
+  loaded->End();
+}
+
+TEST_F(TestShaderProgramCache, TestInvalidBinaryIsRejected)
+{
+  if (!GetCache().IsEnabled())
+    return;
+
+  CreateProgram();
+
+  std::vector<std::string> files = GetFiles();
+  ASSERT_EQ(1u, files.size());
+  ASSERT_TRUE(g_file_set_contents(files[0].c_str(), "NUXSHBIN not a program binary", -1, NULL));
+
+  ShaderProgramCache::Stats stats = GetCache().GetStats();
+  ObjectPtr<IOpenGLShaderProgram> program = CreateProgram();
+
+  // The program is compiled from its sources and stored again.
+  EXPECT_EQ(stats.rejects + 1, GetCache().GetStats().rejects);
+  EXPECT_EQ(stats.stores + 1, GetCache().GetStats().stores);
+  EXPECT_NE(-1, program->GetUniformLocationARB("Color"));
+}
+
+}
@@ -0,0 +1,186 @@
+#include <gmock/gmock.h>
+#include <glib.h>
+#include <vector>
+
+#include "Nux/Nux.h"
+
+#include "NuxGraphics/NuxGraphics.h"
+#include "NuxGraphics/GraphicsEngine.h"
+#include "NuxGraphics/TextureAtlas.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+bool Overlap(Geometry const& a, Geometry const& b)
+{
+  return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+TEST(TestAtlasAllocator, TestRectanglesDoNotOverlap)
+{
+  AtlasAllocator allocator(256, 256);
+  std::vector<Geometry> rects;
+  Geometry rect;
+
+  for (int i = 0; i < 100; ++i)
+  {
+    ASSERT_TRUE(allocator.Allocate(10 + i % 13, 8 + i % 7, rect));
+    EXPECT_LE(rect.x + rect.width, 256);
+    EXPECT_LE(rect.y + rect.height, 256);
+
+    for (auto const& other : rects)
+      EXPECT_FALSE(Overlap(rect, other));
+
+    rects.push_back(rect);
+  }
+
+  EXPECT_EQ(100, allocator.GetAllocationCount());
+}
+
+TEST(TestAtlasAllocator, TestFull)
+{
+  AtlasAllocator allocator(64, 64);
+  Geometry rect;
+
+  for (int i = 0; i < 16; ++i)
+    ASSERT_TRUE(allocator.Allocate(16, 16, rect));
+
+  EXPECT_EQ(64 * 64, allocator.GetUsedArea());
+  EXPECT_FALSE(allocator.Allocate(1, 1, rect));
+  EXPECT_FALSE(allocator.Allocate(65, 1, rect));
+}
+
+TEST(TestAtlasAllocator, TestFreedSpaceIsReused)
+{
+  AtlasAllocator allocator(64, 64);
+  Geometry rects[16];
+
+  for (int i = 0; i < 16; ++i)
+    ASSERT_TRUE(allocator.Allocate(16, 16, rects[i]));
+
+  allocator.Free(rects[5]);
+  allocator.Free(rects[6]);
+
+  Geometry rect;
+  ASSERT_TRUE(allocator.Allocate(32, 16, rect));
+  EXPECT_EQ(rects[5].x, rect.x);
+  EXPECT_EQ(rects[5].y, rect.y);
+}
+
+TEST(TestAtlasAllocator, TestEmptyShelvesAreClosed)
+{
+  AtlasAllocator allocator(64, 64);
+  Geometry small, large;
+
+  ASSERT_TRUE(allocator.Allocate(64, 8, small));
+  allocator.Free(small);
+
+  ASSERT_TRUE(allocator.Allocate(64, 64, large));
+  EXPECT_EQ(0, large.y);
+
+  allocator.Free(large);
+  EXPECT_EQ(0, allocator.GetUsedArea());
+  EXPECT_EQ(0, allocator.GetAllocationCount());
+}
+
+class TestTextureAtlas : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("nux::TestTextureAtlas", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+    pixels.assign(32 * 32 * 4, 0xFF);
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+  std::vector<unsigned char> pixels;
+};
+
+TEST_F(TestTextureAtlas, TestRegionsShareAPage)
+{
+  TextureAtlas atlas(256);
+
+  TextureAtlas::Handle a = atlas.Add(32, 32, &pixels[0], 32 * 4);
+  TextureAtlas::Handle b = atlas.Add(16, 16, &pixels[0], 32 * 4);
+
+  ASSERT_TRUE(atlas.Contains(a));
+  ASSERT_TRUE(atlas.Contains(b));
+  EXPECT_EQ(atlas.GetTexture(a), atlas.GetTexture(b));
+  EXPECT_FALSE(Overlap(atlas.GetRect(a), atlas.GetRect(b)));
+
+  TexCoordXForm texxform;
+  atlas.SetTexCoords(b, texxform);
+  Geometry rect = atlas.GetRect(b);
+  EXPECT_FLOAT_EQ(rect.x / 256.0f, texxform.u0);
+  EXPECT_FLOAT_EQ((rect.y + rect.height) / 256.0f, texxform.v1);
+
+  TextureAtlas::Stats stats = atlas.GetStats();
+  EXPECT_EQ(1, stats.pages);
+  EXPECT_EQ(2, stats.regions);
+  EXPECT_EQ(32 * 32 + 16 * 16, stats.used_area);
+  EXPECT_FLOAT_EQ(float(32 * 32 + 16 * 16) / (256 * 256), stats.GetOccupancy());
+}
+
+TEST_F(TestTextureAtlas, TestLargeTexturesAreRefused)
+{
+  TextureAtlas atlas(64);
+  EXPECT_EQ(TextureAtlas::INVALID_HANDLE, atlas.Add(32, 32, &pixels[0], 32 * 4));
+}
+
+TEST_F(TestTextureAtlas, TestLeastRecentlyUsedRegionIsEvicted)
+{
+  // A 64x64 page holds sixteen 14x14 regions and their padding.
+  TextureAtlas atlas(64, BITFMT_R8G8B8A8, 1);
+  std::vector<TextureAtlas::Handle> evicted;
+  atlas.region_evicted.connect([&evicted] (TextureAtlas::Handle handle) { evicted.push_back(handle); });
+
+  TextureAtlas::Handle handles[16];
+  for (int i = 0; i < 16; ++i)
+  {
+    handles[i] = atlas.Add(14, 14, &pixels[0], 32 * 4, true);
+    ASSERT_NE(TextureAtlas::INVALID_HANDLE, handles[i]);
+  }
+
+  EXPECT_TRUE(evicted.empty());
+
+  atlas.Touch(handles[0]);
+  TextureAtlas::Handle handle = atlas.Add(14, 14, &pixels[0], 32 * 4, true);
+
+  // The atlas is full: the first region that was not touched is evicted.
+  ASSERT_NE(TextureAtlas::INVALID_HANDLE, handle);
+  ASSERT_EQ(1u, evicted.size());
+  EXPECT_EQ(handles[1], evicted[0]);
+  EXPECT_FALSE(atlas.Contains(handles[1]));
+  EXPECT_TRUE(atlas.Contains(handles[0]));
+  EXPECT_EQ(1, atlas.GetStats().evictions);
+}
+
+TEST_F(TestTextureAtlas, TestDefragmentReleasesPages)
+{
+  TextureAtlas atlas(64, BITFMT_R8G8B8A8, 4);
+  std::vector<TextureAtlas::Handle> handles;
+
+  for (int i = 0; i < 32; ++i)
+    handles.push_back(atlas.Add(14, 14, &pixels[0], 32 * 4));
+
+  EXPECT_EQ(2, atlas.GetStats().pages);
+
+  for (int i = 0; i < 32; i += 2)
+    atlas.Remove(handles[i]);
+
+  atlas.Defragment();
+
+  TextureAtlas::Stats stats = atlas.GetStats();
+  EXPECT_EQ(1, stats.pages);
+  EXPECT_EQ(16, stats.regions);
+  EXPECT_EQ(1, stats.defragmentations);
+
+  for (int i = 1; i < 32; i += 2)
+    EXPECT_TRUE(atlas.Contains(handles[i]));
+}
+
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2014 Inalogic Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License, as
+ * published by the  Free Software Foundation; either version 2.1 or 3.0
+ * of the License.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranties of
+ * MERCHANTABILITY, SATISFACTORY QUALITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the applicable version of the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of both the GNU Lesser General Public
+ * License along with this program. If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <gmock/gmock.h>
+#include <vector>
+
+#include "Nux/Nux.h"
+
+#include "NuxGraphics/NuxGraphics.h"
+#include "NuxGraphics/GLDeviceObjects.h"
+#include "NuxGraphics/GraphicsEngine.h"
+#include "NuxGraphics/TextureUploadRing.h"
+
+
+using namespace testing;
+using namespace nux;
+
+namespace {
+
+class TestTextureUploadRing : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    nux::NuxInitialize(0);
+    wnd_thread.reset(nux::CreateNuxWindow("nux::TestTextureUploadRing", 300, 200, nux::WINDOWSTYLE_NORMAL, NULL, false, NULL, NULL));
+    wnd_thread->GetGraphicsEngine().ResetStats();
+  }
+
+  virtual void TearDown()
+  {
+    GetUploadRing().SetEnabled(true);
+  }
+
+  TextureUploadRing& GetUploadRing()
+  {
+    return GetGraphicsDisplay()->GetGpuDevice()->GetTextureUploadRing();
+  }
+
+  ObjectPtr<IOpenGLBaseTexture> CreateTexture(int width, int height)
+  {
+    ObjectPtr<IOpenGLBaseTexture> texture =
+      GetGraphicsDisplay()->GetGpuDevice()->CreateSystemCapableDeviceTexture(width, height, 1, BITFMT_R8G8B8A8, NUX_TRACKER_LOCATION);
+    expected.assign(width * height * 4, 0);
+    Update(texture, 0, 0, width, height, 0);
+    return texture;
+  }
+
+  // Update a rectangle of the texture and of the expected pixels.
+  void Update(ObjectPtr<IOpenGLBaseTexture> const& texture, int x0, int y0, int x1, int y1, int seed)
+  {
+    SURFACE_RECT rect;
+    rect.left = x0;
+    rect.top = y0;
+    rect.right = x1;
+    rect.bottom = y1;
+
+    SURFACE_LOCKED_RECT lock_rect;
+    ASSERT_EQ(OGL_OK, texture->LockRect(0, &lock_rect, &rect));
+
+    int texture_width = texture->GetWidth();
+    unsigned char* pixels = static_cast<unsigned char*>(lock_rect.pBits);
+    for (int y = y0; y < y1; ++y)
+    {
+      for (int x = x0 * 4; x < x1 * 4; ++x)
+      {
+        unsigned char value = (x * 7 + y * 13 + seed) & 0xFF;
+        pixels[(y - y0) * lock_rect.Pitch + x - x0 * 4] = value;
+        expected[y * texture_width * 4 + x] = value;
+      }
+    }
+
+    texture->UnlockRect(0);
+  }
+
+  std::vector<unsigned char> Read(ObjectPtr<IOpenGLBaseTexture> const& texture)
+  {
+    int width, height, stride;
+    unsigned char* data = texture->GetSurfaceData(0, width, height, stride);
+    std::vector<unsigned char> pixels(data, data + height * stride);
+    delete [] data;
+    return pixels;
+  }
+
+  std::unique_ptr<nux::WindowThread> wnd_thread;
+  std::vector<unsigned char> expected;
+};
+
+TEST_F(TestTextureUploadRing, TestUpdatesWithAndWithoutRing)
+{
+  for (bool enabled : {true, false})
+  {
+    GetUploadRing().SetEnabled(enabled);
+    ObjectPtr<IOpenGLBaseTexture> texture = CreateTexture(256, 128);
+
+    // Enough small updates to wrap around the ring twice.
+    for (int i = 0; i < 2000; ++i)
+    {
+      int x = (i * 5) % 192;
+      int y = (i * 3) % 80;
+      Update(texture, x, y, x + 16 + i % 48, y + 8 + i % 40, i);
+    }
+
+    EXPECT_EQ(expected, Read(texture)) << "ring enabled: " << enabled;
+  }
+}
+
+TEST_F(TestTextureUploadRing, TestStats)
+{
+  GraphicsEngine& graphics_engine = wnd_thread->GetGraphicsEngine();
+  ObjectPtr<IOpenGLBaseTexture> texture = CreateTexture(16, 16);
+  graphics_engine.ResetStats();
+
+  Update(texture, 0, 0, 16, 16, 1);
+  Update(texture, 4, 4, 8, 6, 2);
+
+  EXPECT_EQ(2, graphics_engine.GetTextureUploadCount());
+  EXPECT_EQ(16 * 16 * 4 + 4 * 2 * 4, graphics_engine.GetTextureUploadBytes());
+
+  if (GetUploadRing().IsEnabled())
+    EXPECT_EQ(2, GetUploadRing().GetStats().ring_uploads);
+
+  graphics_engine.ResetStats();
+  EXPECT_EQ(0, graphics_engine.GetTextureUploadCount());
+  EXPECT_EQ(0, graphics_engine.GetTextureUploadBytes());
+}
+
+TEST_F(TestTextureUploadRing, TestLargeUpdateFallsBack)
+{
+  // The update is larger than a segment of the ring.
+  ObjectPtr<IOpenGLBaseTexture> texture = CreateTexture(1024, 512);
+  EXPECT_EQ(0, GetUploadRing().GetStats().ring_uploads);
+  EXPECT_FALSE(GetUploadRing().IsLocked());
+
+  Update(texture, 10, 10, 20, 20, 3);
+  EXPECT_EQ(expected, Read(texture));
+}
+
+}